@@ -0,0 +1,563 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <GLFW/glfw3.h>
+
+#include <QuasarEngine/Asset/AssetManager.h>
+#include <QuasarEngine/Renderer/RendererAPI.h>
+#include <QuasarEngine/Renderer/RenderCommand.h>
+#include <QuasarEngine/Renderer/Renderer.h>
+#include <QuasarEngine/Renderer/Renderer2D.h>
+#include <QuasarEngine/Physic/PhysicEngine.h>
+#include <QuasarEngine/Resources/Mesh.h>
+#include <QuasarEngine/Resources/Model.h>
+#include <QuasarEngine/Scene/BaseCamera.h>
+#include <QuasarEngine/Scene/Scene.h>
+#include <QuasarEngine/Scene/SceneObject.h>
+#include <QuasarEngine/Scene/SceneSerializer.h>
+#include <QuasarEngine/Entity/Entity.h>
+#include <QuasarEngine/Entity/Components/MeshComponent.h>
+#include <QuasarEngine/Entity/Components/MaterialComponent.h>
+#include <QuasarEngine/Entity/Components/MeshRendererComponent.h>
+#include <QuasarEngine/Entity/Components/TransformComponent.h>
+#include <QuasarEngine/Entity/Components/WorldTransformComponent.h>
+#include <QuasarEngine/Entity/Components/LightComponent.h>
+#include <QuasarEngine/UI/UIRenderer.h>
+
+#include <Platform/Null/NullRendererAPI.h>
+
+// Runs the CPU side of a frame (scene update, culling, batching, uniform staging, 2D and UI)
+// on the null backend, so regressions show up without a GPU or a window.
+namespace QuasarEngine
+{
+    struct BenchOptions
+    {
+        std::string assets;
+        std::string scene;
+        int frames = 600;
+        int warmup = 60;
+        int grid = 32;
+        int width = 1920;
+        int height = 1080;
+
+        // Model file, or a directory whose largest models are benchmarked.
+        std::string models;
+        int loadRuns = 3;
+
+        // Entities in the component view iteration bench, 0 to skip it.
+        int entities = 100000;
+    };
+
+    class BenchCamera : public BaseCamera
+    {
+    public:
+        void Update(float t, float radius, float aspect)
+        {
+            m_Position = { std::cos(t) * radius, radius * 0.4f, std::sin(t) * radius };
+            m_Front = glm::normalize(-m_Position);
+            m_View = glm::lookAt(m_Position, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            m_Projection = glm::perspective(glm::radians(60.0f), aspect, 0.1f, radius * 4.0f);
+        }
+
+        const glm::mat4& getViewMatrix() const override { return m_View; }
+        const glm::mat4& getProjectionMatrix() const override { return m_Projection; }
+
+        glm::vec3 GetPosition() const override { return m_Position; }
+        glm::mat4 GetTransform() const override { return glm::inverse(m_View); }
+        glm::vec3 GetFront() const override { return m_Front; }
+
+    private:
+        glm::mat4 m_View{ 1.0f };
+        glm::mat4 m_Projection{ 1.0f };
+        glm::vec3 m_Position{ 0.0f };
+        glm::vec3 m_Front{ 0.0f, 0.0f, -1.0f };
+    };
+
+    struct StageTimes
+    {
+        const char* name;
+        std::vector<double> samples;
+
+        void Report() const
+        {
+            if (samples.empty())
+                return;
+
+            std::vector<double> sorted = samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            double sum = 0.0;
+            for (double s : sorted) sum += s;
+
+            const double mean = sum / sorted.size();
+            const double p95 = sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+
+            std::printf("  %-14s mean %8.3f ms   p95 %8.3f ms   max %8.3f ms\n", name, mean, p95, sorted.back());
+        }
+    };
+
+    template<typename Func>
+    double TimeMs(Func&& func)
+    {
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        func();
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+
+    // Vertex layout is the default Mesh one: position, normal, uv, tangent, color.
+    void PushVertex(std::vector<float>& v, const glm::vec3& p, const glm::vec3& n, const glm::vec2& uv, const glm::vec3& t)
+    {
+        v.insert(v.end(), { p.x, p.y, p.z, n.x, n.y, n.z, uv.x, uv.y, t.x, t.y, t.z, 1.0f, 1.0f, 1.0f, 1.0f });
+    }
+
+    std::unique_ptr<Mesh> CreateCubeMesh()
+    {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+
+        const glm::vec3 normals[6] = { {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1} };
+        for (const glm::vec3& n : normals)
+        {
+            const glm::vec3 up = std::abs(n.y) > 0.5f ? glm::vec3(0, 0, 1) : glm::vec3(0, 1, 0);
+            const glm::vec3 t = glm::cross(up, n);
+            const glm::vec3 b = glm::cross(n, t);
+
+            const unsigned int base = static_cast<unsigned int>(vertices.size() / 15);
+            PushVertex(vertices, (n - t - b) * 0.5f, n, { 0, 0 }, t);
+            PushVertex(vertices, (n + t - b) * 0.5f, n, { 1, 0 }, t);
+            PushVertex(vertices, (n + t + b) * 0.5f, n, { 1, 1 }, t);
+            PushVertex(vertices, (n - t + b) * 0.5f, n, { 0, 1 }, t);
+            indices.insert(indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+        }
+
+        return std::make_unique<Mesh>(vertices, indices);
+    }
+
+    std::unique_ptr<Mesh> CreateSphereMesh(unsigned int segments)
+    {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+
+        const float PI = 3.14159265359f;
+        for (unsigned int y = 0; y <= segments; ++y)
+        {
+            for (unsigned int x = 0; x <= segments; ++x)
+            {
+                const float u = (float)x / (float)segments;
+                const float v = (float)y / (float)segments;
+                const float theta = u * 2.0f * PI;
+                const float phi = v * PI;
+
+                const glm::vec3 n{ std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi) };
+                const glm::vec3 t{ -std::sin(theta), 0.0f, std::cos(theta) };
+                PushVertex(vertices, n * 0.5f, n, { u, v }, t);
+            }
+        }
+
+        for (unsigned int y = 0; y < segments; ++y)
+        {
+            for (unsigned int x = 0; x < segments; ++x)
+            {
+                const unsigned int i0 = y * (segments + 1) + x;
+                const unsigned int i1 = i0 + segments + 1;
+                indices.insert(indices.end(), { i0, i1, i0 + 1, i0 + 1, i1, i1 + 1 });
+            }
+        }
+
+        return std::make_unique<Mesh>(vertices, indices);
+    }
+
+    void BuildGridScene(Scene& scene, int grid, const std::vector<Mesh*>& meshes)
+    {
+        Entity sun = scene.CreateEntity("Sun");
+        sun.GetComponent<TransformComponent>().Rotation = { glm::radians(-45.0f), glm::radians(30.0f), 0.0f };
+        sun.AddComponent<LightComponent>(LightComponent::LightType::DIRECTIONAL);
+
+        const float spacing = 2.5f;
+        const float offset = (grid - 1) * spacing * 0.5f;
+
+        for (int z = 0; z < grid; ++z)
+        {
+            for (int x = 0; x < grid; ++x)
+            {
+                const int i = z * grid + x;
+                Entity e = scene.CreateEntity("Object " + std::to_string(i));
+
+                auto& tr = e.GetComponent<TransformComponent>();
+                tr.Position = { x * spacing - offset, 0.0f, z * spacing - offset };
+                tr.Rotation = { 0.0f, i * 0.1f, 0.0f };
+
+                e.AddComponent<MeshComponent>().SetMesh(meshes[i % meshes.size()]);
+
+                MaterialSpecification spec;
+                spec.Albedo = { (x % 4) / 3.0f, (z % 4) / 3.0f, 0.5f, 1.0f };
+                e.AddComponent<MaterialComponent>(spec);
+                e.AddComponent<MeshRendererComponent>();
+            }
+        }
+    }
+
+    bool ParseOptions(int argc, char** argv, BenchOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--assets" && hasValue) options.assets = argv[++i];
+            else if (arg == "--scene" && hasValue) options.scene = argv[++i];
+            else if (arg == "--frames" && hasValue) options.frames = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--warmup" && hasValue) options.warmup = std::max(0, std::atoi(argv[++i]));
+            else if (arg == "--grid" && hasValue) options.grid = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--models" && hasValue) options.models = argv[++i];
+            else if (arg == "--load-runs" && hasValue) options.loadRuns = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--entities" && hasValue) options.entities = std::max(0, std::atoi(argv[++i]));
+            else
+            {
+                std::printf("usage: QuasarEngine-Bench [--assets <dir>] [--scene <file>] [--frames N] [--warmup N] [--grid N] [--models <file|dir>] [--load-runs N] [--entities N]\n");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::filesystem::path> FindLargestModels(const std::filesystem::path& root, size_t count)
+    {
+        if (!std::filesystem::is_directory(root))
+            return { root };
+
+        std::vector<std::pair<uintmax_t, std::filesystem::path>> found;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root, ec))
+        {
+            if (!entry.is_regular_file())
+                continue;
+
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            if (ext == ".fbx" || ext == ".gltf" || ext == ".glb" || ext == ".obj" || ext == ".dae")
+                found.emplace_back(entry.file_size(), entry.path());
+        }
+
+        std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        std::vector<std::filesystem::path> paths;
+        for (size_t i = 0; i < found.size() && i < count; ++i)
+            paths.push_back(found[i].second);
+        return paths;
+    }
+
+    // Cold Assimp import against the model cache, meshes included (uploads go to the null backend).
+    void RunModelLoadBench(const BenchOptions& options)
+    {
+        const std::filesystem::path cacheDir = std::filesystem::temp_directory_path() / "QuasarEngineBench" / "Models";
+
+        std::printf("==== Model load (%d runs) ====\n", options.loadRuns);
+        for (const std::filesystem::path& path : FindLargestModels(options.models, 4))
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(cacheDir, ec);
+
+            ModelImportOptions cold;
+            cold.useCache = false;
+
+            ModelImportOptions cached;
+            cached.cacheDir = cacheDir.string();
+
+            StageTimes assimp{ "assimp" }, cache{ "cached" };
+            size_t meshes = 0;
+
+            for (int i = 0; i < options.loadRuns; ++i)
+                assimp.samples.push_back(TimeMs([&] { meshes = Model::CreateModel(path.string(), cold)->GetLoadedInfo().meshes.size(); }));
+
+            // First cached load imports and writes the entry.
+            const double first = TimeMs([&] { Model::CreateModel(path.string(), cached); });
+
+            for (int i = 0; i < options.loadRuns; ++i)
+                cache.samples.push_back(TimeMs([&] { Model::CreateModel(path.string(), cached); }));
+
+            uintmax_t entryBytes = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(cacheDir, ec))
+                entryBytes += entry.file_size();
+
+            std::printf("  %s: %.1f MB source, %zu meshes, %.1f MB cache entry, first load %.3f ms\n",
+                path.filename().string().c_str(), std::filesystem::file_size(path, ec) / (1024.0 * 1024.0), meshes,
+                entryBytes / (1024.0 * 1024.0), first);
+            assimp.Report();
+            cache.Report();
+        }
+
+        std::error_code ec;
+        std::filesystem::remove_all(cacheDir, ec);
+    }
+
+    // The component layout before the lean base: a vtable plus the owner handle in every instance.
+    struct LegacyComponent
+    {
+        entt::entity entt_entity{ entt::null };
+        Registry* registry = nullptr;
+
+        virtual ~LegacyComponent() = default;
+    };
+
+    template<typename T>
+    struct Legacy : LegacyComponent
+    {
+        T value;
+    };
+
+    template<typename T> T& Unwrap(T& component) { return component; }
+    template<typename T> T& Unwrap(Legacy<T>& component) { return component.value; }
+
+    // One TransformSystem-like pass: read the local values, write the world matrix.
+    template<typename TransformT, typename WorldT>
+    StageTimes TimeViewIteration(const char* name, int entities, int runs)
+    {
+        entt::registry registry;
+        for (int i = 0; i < entities; ++i)
+        {
+            const entt::entity e = registry.create();
+            Unwrap(registry.emplace<TransformT>(e)).Position = glm::vec3((float)(i % 512), 0.0f, (float)(i / 512));
+            registry.emplace<WorldT>(e);
+        }
+
+        StageTimes times{ name };
+        float checksum = 0.0f;
+        auto view = registry.view<TransformT, WorldT>();
+        for (int r = 0; r < runs; ++r)
+        {
+            times.samples.push_back(TimeMs([&] {
+                for (auto [e, tr, wt] : view.each())
+                {
+                    const TransformComponent& local = Unwrap(tr);
+                    WorldTransformComponent& world = Unwrap(wt);
+                    world.World = glm::scale(glm::translate(glm::mat4(1.0f), local.Position), local.Scale);
+                    checksum += world.World[3].x;
+                }
+            }));
+        }
+
+        // Keeps the loop from being optimised away.
+        if (checksum < 0.0f)
+            std::printf("  (checksum %f)\n", checksum);
+        return times;
+    }
+
+    void RunComponentViewBench(const BenchOptions& options)
+    {
+        constexpr int runs = 50;
+
+        std::printf("==== Component view (%d entities, %d runs) ====\n", options.entities, runs);
+        std::printf("  sizeof Transform %zu -> %zu bytes, WorldTransform %zu -> %zu bytes\n",
+            sizeof(Legacy<TransformComponent>), sizeof(TransformComponent),
+            sizeof(Legacy<WorldTransformComponent>), sizeof(WorldTransformComponent));
+
+        TimeViewIteration<Legacy<TransformComponent>, Legacy<WorldTransformComponent>>("virtual base", options.entities, runs).Report();
+        TimeViewIteration<TransformComponent, WorldTransformComponent>("lean", options.entities, runs).Report();
+    }
+
+    int RunBench(const BenchOptions& options)
+    {
+        if (!options.assets.empty())
+        {
+            std::error_code ec;
+            std::filesystem::current_path(options.assets, ec);
+            if (ec) {
+                std::printf("Cannot use assets directory %s: %s\n", options.assets.c_str(), ec.message().c_str());
+                return 1;
+            }
+        }
+
+        // Nothing renderer side may exist before this.
+        RendererAPI::SetAPI(RendererAPI::API::None);
+
+        // Only for the clock, no window is created.
+        glfwInit();
+
+        AssetManager::Instance().Initialize("");
+        RenderCommand::Instance().Initialize();
+        Renderer::Instance().Initialize();
+        Renderer2D::Instance().Initialize();
+        PhysicEngine::Instance().Initialize(2, physx::PxVec3(0.f, -9.81f, 0.f), true, false);
+
+        if (!options.models.empty())
+            RunModelLoadBench(options);
+
+        if (options.entities > 0)
+            RunComponentViewBench(options);
+
+        std::vector<std::unique_ptr<Mesh>> meshes;
+        std::unique_ptr<SceneObject> sceneObject = std::make_unique<SceneObject>();
+        Scene& scene = sceneObject->GetScene();
+
+        if (!options.scene.empty())
+        {
+            SceneSerializer serializer(*sceneObject, std::filesystem::current_path());
+            if (!serializer.Deserialize(options.scene)) {
+                std::printf("Cannot load scene %s, falling back to the grid\n", options.scene.c_str());
+            }
+            scene.RebuildEntityCaches();
+        }
+
+        const bool gridScene = options.scene.empty() || scene.GetAllEntitiesWith<MeshComponent>().empty();
+        if (gridScene)
+        {
+            meshes.push_back(CreateCubeMesh());
+            meshes.push_back(CreateSphereMesh(32));
+            BuildGridScene(scene, options.grid, { meshes[0].get(), meshes[1].get() });
+        }
+
+        std::unique_ptr<UIRenderer> ui = std::make_unique<UIRenderer>();
+
+        BenchCamera camera;
+        const float radius = options.grid * 2.5f;
+        const float aspect = (float)options.width / (float)options.height;
+        const double dt = 1.0 / 60.0;
+
+        StageTimes update{ "update" }, lights{ "lights" }, render{ "render" }, quads{ "2d" }, overlay{ "ui" }, frame{ "frame" };
+
+        NullRendererStats totals{};
+        uint64_t visible = 0, culled = 0, drawCalls = 0, drawsSaved = 0;
+
+        const int total = options.warmup + options.frames;
+        for (int f = 0; f < total; ++f)
+        {
+            const bool measured = f >= options.warmup;
+            NullRendererAPI::ResetStats();
+
+            camera.Update(f * 0.01f, radius, aspect);
+
+            const auto t0 = std::chrono::high_resolution_clock::now();
+
+            const double tUpdate = TimeMs([&] {
+                AssetManager::Instance().Update();
+                scene.Update(dt);
+            });
+
+            const double tLights = TimeMs([&] {
+                RenderCommand::Instance().ClearColor({ 0.8f, 0.8f, 0.8f, 1.0f });
+                RenderCommand::Instance().Clear();
+                RenderCommand::Instance().SetViewport(0, 0, options.width, options.height);
+                RenderCommand::Instance().SetScissor(0, 0, options.width, options.height);
+
+                Renderer::Instance().BeginScene(scene);
+                Renderer::Instance().BuildLight();
+            });
+
+            const double tRender = TimeMs([&] {
+                Renderer::Instance().RenderSkybox(camera.getViewMatrix(), camera.getProjectionMatrix());
+                Renderer::Instance().Render(camera.getViewMatrix(), camera.getProjectionMatrix(), camera.GetPosition());
+                Renderer::Instance().EndScene();
+            });
+
+            const double tQuads = TimeMs([&] {
+                Renderer2D::Instance().BeginScene(camera);
+                for (int i = 0; i < 1000; ++i)
+                {
+                    const glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3((i % 40) * 1.1f, (i / 40) * 1.1f, 0.0f));
+                    Renderer2D::Instance().DrawQuad(t, nullptr, { 1.0f, 0.5f, 0.2f, 1.0f });
+                }
+                Renderer2D::Instance().EndScene();
+            });
+
+            const double tOverlay = TimeMs([&] {
+                ui->Begin(options.width, options.height);
+                for (int i = 0; i < 200; ++i)
+                {
+                    const Rect r{ 10.0f + (i % 20) * 90.0f, 10.0f + (i / 20) * 30.0f, 80.0f, 24.0f };
+                    ui->Batcher().PushRect(r, ui->Ctx().whiteTex, PackRGBA8({ 0.2f, 0.22f, 0.25f, 1.0f }), nullptr);
+                    ui->Ctx().CtxDrawText("Benchmark", r.x + 4.0f, r.y + 4.0f, { 1.0f, 1.0f, 1.0f, 1.0f });
+                }
+                ui->End();
+            });
+
+            const auto t1 = std::chrono::high_resolution_clock::now();
+
+            if (!measured)
+                continue;
+
+            update.samples.push_back(tUpdate);
+            lights.samples.push_back(tLights);
+            render.samples.push_back(tRender);
+            quads.samples.push_back(tQuads);
+            overlay.samples.push_back(tOverlay);
+            frame.samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+
+            const NullRendererStats& s = NullRendererAPI::GetStats();
+            totals.drawCalls += s.drawCalls;
+            totals.instancedDrawCalls += s.instancedDrawCalls;
+            totals.indices += s.indices;
+            totals.instances += s.instances;
+            totals.stateChanges += s.stateChanges;
+            totals.bufferUploads += s.bufferUploads;
+            totals.bufferBytes += s.bufferBytes;
+            totals.shaderBinds += s.shaderBinds;
+            totals.uniformBytes += s.uniformBytes;
+            totals.textureBinds += s.textureBinds;
+
+            const Renderer::Stats& rs = Renderer::Instance().GetStats();
+            visible += rs.visibleObjects;
+            culled += rs.culledObjects;
+            drawCalls += rs.drawCalls;
+            drawsSaved += rs.drawsSaved;
+        }
+
+        const double n = (double)options.frames;
+        std::printf("==== Null backend frame (%d frames, %d warmup) ====\n", options.frames, options.warmup);
+        update.Report();
+        lights.Report();
+        render.Report();
+        quads.Report();
+        overlay.Report();
+        frame.Report();
+
+        std::printf("  per frame: visible %.0f, culled %.0f, draws %.0f (saved %.0f)\n",
+            visible / n, culled / n, drawCalls / n, drawsSaved / n);
+        std::printf("  per frame: api draws %.0f (instanced %.0f), indices %.0f, instances %.0f, state changes %.0f\n",
+            totals.drawCalls / n, totals.instancedDrawCalls / n, totals.indices / n, totals.instances / n, totals.stateChanges / n);
+        std::printf("  per frame: buffer uploads %.0f (%.1f KB), shader binds %.0f, uniforms %.1f KB, texture binds %.0f\n",
+            totals.bufferUploads / n, totals.bufferBytes / n / 1024.0, totals.shaderBinds / n, totals.uniformBytes / n / 1024.0, totals.textureBinds / n);
+
+        // Grid cells repeat 2 meshes x 16 materials, each cell owning its own Material instance.
+        int status = 0;
+        if (gridScene && visible > 0 && drawsSaved == 0)
+        {
+            std::printf("  FAILED: no draws were merged on the grid scene, instancing is not batching\n");
+            status = 1;
+        }
+
+        ui.reset();
+        sceneObject.reset();
+        meshes.clear();
+
+        PhysicEngine::Instance().Shutdown();
+        AssetManager::Instance().Shutdown();
+        Renderer2D::Instance().Shutdown();
+        Renderer::Instance().Shutdown();
+        RenderCommand::Instance().Shutdown();
+
+        glfwTerminate();
+        return status;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    QuasarEngine::BenchOptions options;
+    if (!QuasarEngine::ParseOptions(argc, argv, options))
+        return 1;
+
+    return QuasarEngine::RunBench(options);
+}
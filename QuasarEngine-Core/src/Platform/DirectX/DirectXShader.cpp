@@ -301,6 +301,31 @@ namespace QuasarEngine
         return true;
     }
 
+    bool DirectXShader::SetUniform(UniformHandle handle, const void* data, size_t size)
+    {
+        const ShaderUniformDesc* u = ResolveUniform(handle);
+        if (!u || !data || size == 0) return false;
+
+        std::vector<uint8_t>& block = (handle & ObjectUniformBit) ? m_ObjectUniformData : m_GlobalUniformData;
+        std::memcpy(block.data() + u->offset, data, std::min(size_t(u->size), size));
+        return true;
+    }
+
+    bool DirectXShader::SetTexture(SamplerHandle handle, Texture* texture, SamplerType type)
+    {
+        if (handle >= m_Description.samplers.size()) return false;
+
+        return SetTexture(m_Description.samplers[handle].name, texture, type);
+    }
+
+    bool DirectXShader::SetObjectUniforms(const void* data, size_t size)
+    {
+        if (!data) return false;
+
+        std::memcpy(m_ObjectUniformData.data(), data, std::min(size, m_ObjectUniformData.size()));
+        return true;
+    }
+
     bool DirectXShader::SetStorageBuffer(const std::string& name, const void* data, size_t size)
     {
         if (!data || size == 0)
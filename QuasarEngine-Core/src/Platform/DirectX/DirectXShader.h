@@ -32,6 +32,13 @@ namespace QuasarEngine
 		bool SetTexture(const std::string& name, Texture* texture, SamplerType type) override;
 		bool SetStorageBuffer(const std::string& name, const void* data, size_t size) override;
 
+		bool SetUniform(UniformHandle handle, const void* data, size_t size) override;
+		bool SetTexture(SamplerHandle handle, Texture* texture, SamplerType type) override;
+		bool SetObjectUniforms(const void* data, size_t size) override;
+
+	protected:
+		const ShaderDescription& GetDescription() const override { return m_Description; }
+
 	private:
 		void ApplyPipelineStates();
 		void LinkProgram(const std::vector<uint32_t>& shaders);
@@ -0,0 +1,64 @@
+#include "qepch.h"
+#include "NullBuffer.h"
+#include "NullRendererAPI.h"
+
+namespace QuasarEngine
+{
+	namespace
+	{
+		void CountUpload(uint32_t size)
+		{
+			NullRendererStats& stats = NullRendererAPI::GetStats();
+			++stats.bufferUploads;
+			stats.bufferBytes += size;
+		}
+	}
+
+	NullVertexBuffer::NullVertexBuffer(uint32_t size) : m_Size(size)
+	{
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const void* data, uint32_t size) : m_Size(size)
+	{
+		if (data && size)
+			CountUpload(size);
+	}
+
+	void NullVertexBuffer::Upload(const void* data, uint32_t size)
+	{
+		if (!data || size == 0)
+			return;
+
+		m_Size = std::max<size_t>(m_Size, size);
+		CountUpload(size);
+	}
+
+	void NullVertexBuffer::Reserve(uint32_t size)
+	{
+		m_Size = std::max<size_t>(m_Size, size);
+	}
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t size) : m_Size(size)
+	{
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const void* data, uint32_t size) : m_Size(size)
+	{
+		if (data && size)
+			CountUpload(size);
+	}
+
+	void NullIndexBuffer::Upload(const void* data, uint32_t size)
+	{
+		if (!data || size == 0)
+			return;
+
+		m_Size = std::max<size_t>(m_Size, size);
+		CountUpload(size);
+	}
+
+	void NullIndexBuffer::Reserve(uint32_t size)
+	{
+		m_Size = std::max<size_t>(m_Size, size);
+	}
+}
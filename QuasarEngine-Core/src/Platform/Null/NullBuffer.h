@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QuasarEngine/Renderer/Buffer.h>
+
+namespace QuasarEngine
+{
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer() = default;
+		NullVertexBuffer(uint32_t size);
+		NullVertexBuffer(const void* data, uint32_t size);
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		void Upload(const void* data, uint32_t size) override;
+
+		void Reserve(uint32_t size) override;
+
+		size_t GetSize() const override { return m_Size; }
+
+		const BufferLayout& GetLayout() const override { return m_Layout; }
+		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+	private:
+		size_t m_Size = 0;
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer() = default;
+		NullIndexBuffer(uint32_t size);
+		NullIndexBuffer(const void* data, uint32_t size);
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		void Upload(const void* data, uint32_t size) override;
+
+		void Reserve(uint32_t size) override;
+
+		size_t GetSize() const override { return m_Size; }
+		uint32_t GetCount() const override { return (uint32_t)(m_Size / sizeof(uint32_t)); }
+
+	private:
+		size_t m_Size = 0;
+	};
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "QuasarEngine/Renderer/GraphicsContext.h"
+
+namespace QuasarEngine {
+
+	class NullContext : public GraphicsContext
+	{
+	public:
+		void BeginFrame() override {}
+		void EndFrame() override {}
+		void Resize(unsigned int width, unsigned int height) override {}
+	};
+}
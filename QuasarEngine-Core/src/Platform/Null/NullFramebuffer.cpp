@@ -0,0 +1,62 @@
+#include "qepch.h"
+#include "NullFramebuffer.h"
+#include "NullRendererAPI.h"
+
+namespace QuasarEngine
+{
+	NullFramebuffer::NullFramebuffer(const FramebufferSpecification& spec) : Framebuffer(spec)
+	{
+	}
+
+	void NullFramebuffer::ClearAttachment(uint32_t attachmentIndex, float r, float g, float b, float a)
+	{
+		++NullRendererAPI::GetStats().clears;
+	}
+
+	void NullFramebuffer::ClearColor(float r, float g, float b, float a)
+	{
+		++NullRendererAPI::GetStats().clears;
+	}
+
+	void NullFramebuffer::ClearDepth(float d)
+	{
+		++NullRendererAPI::GetStats().clears;
+	}
+
+	void NullFramebuffer::Clear(ClearFlags flags)
+	{
+		if (flags != ClearFlags::None)
+			++NullRendererAPI::GetStats().clears;
+	}
+
+	void NullFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0)
+			return;
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+	}
+
+	void NullFramebuffer::Bind() const
+	{
+		++NullRendererAPI::GetStats().framebufferBinds;
+	}
+
+	void NullFramebuffer::BindColorAttachment(uint32_t index) const
+	{
+		++NullRendererAPI::GetStats().textureBinds;
+	}
+
+	void NullFramebuffer::SetColorAttachment(uint32_t index, const AttachmentRef& ref)
+	{
+		if (index >= m_ColorRefs.size())
+			m_ColorRefs.resize(index + 1);
+		m_ColorRefs[index] = ref;
+	}
+
+	std::shared_ptr<Texture> NullFramebuffer::GetColorAttachmentTexture(uint32_t index) const
+	{
+		return index < m_ColorRefs.size() ? m_ColorRefs[index].texture : nullptr;
+	}
+}
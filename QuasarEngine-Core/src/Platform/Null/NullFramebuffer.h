@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QuasarEngine/Renderer/Framebuffer.h>
+
+namespace QuasarEngine
+{
+	class NullFramebuffer : public Framebuffer
+	{
+	public:
+		NullFramebuffer(const FramebufferSpecification& spec);
+
+		void* GetColorAttachment(uint32_t index) const override { return nullptr; }
+		void* GetDepthAttachment() const override { return nullptr; }
+
+		int ReadPixel(uint32_t attachmentIndex, int x, int y) override { return -1; }
+
+		void ClearAttachment(uint32_t attachmentIndex, float r, float g, float b, float a) override;
+		void ClearColor(float r, float g, float b, float a) override;
+		void ClearDepth(float d = 1.0f) override;
+		void Clear(ClearFlags flags = ClearFlags::All) override;
+
+		void Resize(uint32_t width, uint32_t height) override;
+		void Invalidate() override {}
+		void Resolve() override {}
+
+		void Bind() const override;
+		void Unbind() const override {}
+
+		void BindColorAttachment(uint32_t index = 0) const override;
+
+		void SetColorAttachment(uint32_t index, const AttachmentRef& ref) override;
+
+		std::shared_ptr<Texture> GetColorAttachmentTexture(uint32_t index) const override;
+		std::shared_ptr<Texture> GetDepthAttachmentTexture() const override { return nullptr; }
+
+	private:
+		std::vector<AttachmentRef> m_ColorRefs;
+	};
+}
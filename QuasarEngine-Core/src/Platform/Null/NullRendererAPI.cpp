@@ -0,0 +1,55 @@
+#include "qepch.h"
+#include "NullRendererAPI.h"
+
+namespace QuasarEngine {
+
+	NullRendererStats NullRendererAPI::s_Stats{};
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		++s_Stats.stateChanges;
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		++s_Stats.clears;
+	}
+
+	void NullRendererAPI::DrawArrays(DrawMode drawMode, uint32_t size)
+	{
+		++s_Stats.drawCalls;
+		s_Stats.vertices += size;
+	}
+
+	void NullRendererAPI::DrawArraysInstanced(DrawMode drawMode, uint32_t size, uint32_t instanceCount)
+	{
+		++s_Stats.drawCalls;
+		++s_Stats.instancedDrawCalls;
+		s_Stats.vertices += uint64_t(size) * instanceCount;
+		s_Stats.instances += instanceCount;
+	}
+
+	void NullRendererAPI::DrawElements(DrawMode drawMode, uint32_t count, uint32_t firstIndex, int32_t baseVertex)
+	{
+		++s_Stats.drawCalls;
+		s_Stats.indices += count;
+	}
+
+	void NullRendererAPI::DrawElementsInstanced(DrawMode drawMode, uint32_t count, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex)
+	{
+		++s_Stats.drawCalls;
+		++s_Stats.instancedDrawCalls;
+		s_Stats.indices += uint64_t(count) * instanceCount;
+		s_Stats.instances += instanceCount;
+	}
+
+	void NullRendererAPI::EnableScissor(bool enable)
+	{
+		++s_Stats.stateChanges;
+	}
+
+	void NullRendererAPI::SetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		++s_Stats.stateChanges;
+	}
+}
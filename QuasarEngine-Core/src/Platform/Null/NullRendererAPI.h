@@ -0,0 +1,60 @@
+#pragma once
+
+#include "QuasarEngine/Renderer/RendererAPI.h"
+
+#include <cstdint>
+
+namespace QuasarEngine {
+
+	// What the null backend was asked to do, nothing reaches a GPU. Updated from the
+	// render thread only, like every other backend.
+	struct NullRendererStats
+	{
+		uint64_t drawCalls = 0;
+		uint64_t instancedDrawCalls = 0;
+		uint64_t indices = 0;
+		uint64_t vertices = 0;
+		uint64_t instances = 0;
+
+		uint64_t clears = 0;
+		uint64_t stateChanges = 0;
+
+		uint64_t bufferUploads = 0;
+		uint64_t bufferBytes = 0;
+		uint64_t textureUploads = 0;
+		uint64_t textureBytes = 0;
+
+		uint64_t shaderBinds = 0;
+		uint64_t uniformBytes = 0;
+		uint64_t textureBinds = 0;
+		uint64_t framebufferBinds = 0;
+	};
+
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		void Initialize() override {}
+		void Shutdown() override {}
+
+		void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		void ClearColor(const glm::vec4& color) override {}
+		void Clear() override;
+
+		void SetSeamlessCubemap(bool enable) override {}
+
+		void DrawArrays(DrawMode drawMode, uint32_t size) override;
+		void DrawArraysInstanced(DrawMode drawMode, uint32_t size, uint32_t instanceCount) override;
+		void DrawElements(DrawMode drawMode, uint32_t count, uint32_t firstIndex, int32_t baseVertex) override;
+		void DrawElementsInstanced(DrawMode drawMode, uint32_t count, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex) override;
+
+		void EnableScissor(bool enable) override;
+		void SetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		static NullRendererStats& GetStats() { return s_Stats; }
+		static void ResetStats() { s_Stats = {}; }
+
+	private:
+		static NullRendererStats s_Stats;
+	};
+}
@@ -0,0 +1,138 @@
+#include "qepch.h"
+#include "NullShader.h"
+#include "NullRendererAPI.h"
+
+#include <QuasarEngine/Core/Logger.h>
+
+#include <cstring>
+
+namespace QuasarEngine
+{
+	NullShader::NullShader(const ShaderDescription& desc)
+		: m_Description(desc)
+	{
+		size_t globalSize = 0;
+		for (const auto& uniform : m_Description.globalUniforms)
+			globalSize = std::max(globalSize, uniform.offset + uniform.size);
+		m_GlobalUniformData.resize(globalSize);
+
+		size_t objectSize = 0;
+		for (const auto& uniform : m_Description.objectUniforms)
+			objectSize = std::max(objectSize, uniform.offset + uniform.size);
+		m_ObjectUniformData.resize(objectSize);
+
+		m_SamplerTextures.assign(m_Description.samplers.size(), nullptr);
+
+		for (const auto& uniform : m_Description.globalUniforms)
+			m_GlobalUniformMap[uniform.name] = &uniform;
+		for (const auto& uniform : m_Description.objectUniforms)
+			m_ObjectUniformMap[uniform.name] = &uniform;
+
+		for (const auto& sbDesc : m_Description.storageBuffers)
+			m_StorageBuffers[sbDesc.name];
+	}
+
+	void NullShader::Use()
+	{
+		++NullRendererAPI::GetStats().shaderBinds;
+	}
+
+	bool NullShader::UpdateGlobalState()
+	{
+		NullRendererAPI::GetStats().uniformBytes += m_GlobalUniformData.size();
+		return true;
+	}
+
+	bool NullShader::UpdateObject(Material* /*material*/)
+	{
+		NullRendererStats& stats = NullRendererAPI::GetStats();
+		stats.uniformBytes += m_ObjectUniformData.size();
+
+		for (Texture* texture : m_SamplerTextures)
+			if (texture)
+				++stats.textureBinds;
+
+		return true;
+	}
+
+	bool NullShader::SetUniform(const std::string& name, void* data, size_t size)
+	{
+		if (auto gIt = m_GlobalUniformMap.find(name); gIt != m_GlobalUniformMap.end())
+		{
+			const auto* desc = gIt->second;
+			const size_t copySize = std::min(size, desc->size);
+			if (desc->offset + copySize <= m_GlobalUniformData.size())
+				std::memcpy(m_GlobalUniformData.data() + desc->offset, data, copySize);
+			return true;
+		}
+
+		if (auto oIt = m_ObjectUniformMap.find(name); oIt != m_ObjectUniformMap.end())
+		{
+			const auto* desc = oIt->second;
+			const size_t copySize = std::min(size, desc->size);
+			if (desc->offset + copySize <= m_ObjectUniformData.size())
+				std::memcpy(m_ObjectUniformData.data() + desc->offset, data, copySize);
+			return true;
+		}
+
+		Q_WARNING("Uniform not found : " + name);
+		return false;
+	}
+
+	bool NullShader::SetTexture(const std::string& name, Texture* texture, SamplerType type)
+	{
+		const SamplerHandle handle = GetSamplerHandle(name);
+		if (handle == InvalidHandle)
+		{
+			Q_ERROR("Sampler " + name + " not found in shader description!");
+			return false;
+		}
+
+		return SetTexture(handle, texture, type);
+	}
+
+	bool NullShader::SetUniform(UniformHandle handle, const void* data, size_t size)
+	{
+		const ShaderUniformDesc* desc = ResolveUniform(handle);
+		if (!desc || !data)
+			return false;
+
+		std::vector<uint8_t>& block = (handle & ObjectUniformBit) ? m_ObjectUniformData : m_GlobalUniformData;
+
+		const size_t copySize = std::min(size, desc->size);
+		if (desc->offset + copySize <= block.size())
+			std::memcpy(block.data() + desc->offset, data, copySize);
+		return true;
+	}
+
+	bool NullShader::SetTexture(SamplerHandle handle, Texture* texture, SamplerType type)
+	{
+		if (handle >= m_SamplerTextures.size())
+			return false;
+
+		m_SamplerTextures[handle] = texture;
+		return true;
+	}
+
+	bool NullShader::SetObjectUniforms(const void* data, size_t size)
+	{
+		if (!data)
+			return false;
+
+		std::memcpy(m_ObjectUniformData.data(), data, std::min(size, m_ObjectUniformData.size()));
+		return true;
+	}
+
+	bool NullShader::SetStorageBuffer(const std::string& name, const void* data, size_t size)
+	{
+		auto it = m_StorageBuffers.find(name);
+		if (it == m_StorageBuffers.end()) {
+			Q_WARNING("Storage buffer not found : " + name);
+			return false;
+		}
+
+		it->second.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+		NullRendererAPI::GetStats().bufferBytes += size;
+		return true;
+	}
+}
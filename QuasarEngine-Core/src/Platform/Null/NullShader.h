@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QuasarEngine/Shader/Shader.h>
+
+namespace QuasarEngine
+{
+	// Keeps the uniform staging of the GL backend (name lookups, block copies, sampler slots)
+	// so the CPU side costs the same, without compiling or uploading anything.
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const ShaderDescription& desc);
+
+		void Use() override;
+		void Unuse() override {}
+		void Reset() override {}
+
+		bool UpdateGlobalState() override;
+		bool UpdateObject(Material* material) override;
+
+		bool AcquireResources(Material*) override { return true; }
+		void ReleaseResources(Material*) override {}
+
+		bool SetUniform(const std::string& name, void* data, size_t size) override;
+		bool SetTexture(const std::string& name, Texture* texture, SamplerType type) override;
+		bool SetStorageBuffer(const std::string& name, const void* data, size_t size) override;
+
+		bool SetUniform(UniformHandle handle, const void* data, size_t size) override;
+		bool SetTexture(SamplerHandle handle, Texture* texture, SamplerType type) override;
+		bool SetObjectUniforms(const void* data, size_t size) override;
+
+	protected:
+		const ShaderDescription& GetDescription() const override { return m_Description; }
+
+	private:
+		ShaderDescription m_Description;
+
+		std::unordered_map<std::string, const ShaderUniformDesc*> m_GlobalUniformMap;
+		std::unordered_map<std::string, const ShaderUniformDesc*> m_ObjectUniformMap;
+
+		std::vector<uint8_t> m_GlobalUniformData;
+		std::vector<uint8_t> m_ObjectUniformData;
+
+		std::vector<Texture*> m_SamplerTextures;
+
+		std::unordered_map<std::string, std::vector<uint8_t>> m_StorageBuffers;
+	};
+}
@@ -0,0 +1,75 @@
+#include "qepch.h"
+#include "NullTexture2D.h"
+#include "NullTextureUtils.h"
+#include "NullRendererAPI.h"
+
+#include <QuasarEngine/File/FileUtils.h>
+#include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Resources/TextureCompression.h>
+
+namespace QuasarEngine
+{
+	NullTexture2D::NullTexture2D(const TextureSpecification& specification)
+		: Texture2D(specification), m_Handle(Utils::NextNullTextureHandle())
+	{
+	}
+
+	bool NullTexture2D::LoadFromPath(const std::string& path)
+	{
+		auto bytes = FileUtils::ReadFileBinary(path);
+		if (bytes.empty()) {
+			Q_ERROR("NullTexture2D: failed to read file: " + path);
+			return false;
+		}
+		return LoadFromMemory(ByteView{ bytes.data(), bytes.size() });
+	}
+
+	bool NullTexture2D::LoadFromMemory(ByteView data)
+	{
+		if (!m_Specification.compressed)
+			return LoadFromData(data);
+
+		const std::size_t bytes = Utils::DecodeNullTexture(data, m_Specification);
+		if (bytes == 0)
+			return false;
+
+		Utils::CountNullTextureUpload(bytes);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTexture2D::LoadFromData(ByteView data)
+	{
+		if (data.empty() || m_Specification.width == 0 || m_Specification.height == 0)
+			return false;
+
+		Utils::CountNullTextureUpload(data.size);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTexture2D::LoadCompressed(const CompressedTexture& texture)
+	{
+		if (texture.levels.empty() || texture.width == 0 || texture.height == 0)
+			return false;
+
+		m_Specification.format = texture.format;
+		m_Specification.internal_format = texture.format;
+		m_Specification.width = texture.width;
+		m_Specification.height = texture.height;
+		m_Specification.mip_levels = static_cast<uint32_t>(texture.levels.size());
+
+		std::size_t bytes = 0;
+		for (const auto& level : texture.levels)
+			bytes += level.size();
+
+		Utils::CountNullTextureUpload(bytes);
+		m_Loaded = true;
+		return true;
+	}
+
+	void NullTexture2D::Bind(int index) const
+	{
+		++NullRendererAPI::GetStats().textureBinds;
+	}
+}
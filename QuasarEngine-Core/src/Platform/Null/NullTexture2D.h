@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QuasarEngine/Resources/Texture2D.h>
+
+namespace QuasarEngine
+{
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		explicit NullTexture2D(const TextureSpecification& specification);
+
+		TextureHandle GetHandle() const noexcept override { return m_Handle; }
+		bool IsLoaded() const noexcept override { return m_Loaded; }
+
+		bool LoadFromPath(const std::string& path) override;
+		bool LoadFromMemory(ByteView data) override;
+		bool LoadFromData(ByteView data) override;
+		bool LoadCompressed(const CompressedTexture& texture) override;
+
+		glm::vec4 Sample(const glm::vec2& uv) const override { return glm::vec4(0.0f); }
+
+		void Bind(int index = 0) const override;
+		void Unbind() const override {}
+
+		void GenerateMips() override {}
+
+	private:
+		TextureHandle m_Handle = 0;
+		bool m_Loaded = false;
+	};
+}
@@ -0,0 +1,65 @@
+#include "qepch.h"
+#include "NullTextureArray.h"
+#include "NullTextureUtils.h"
+#include "NullRendererAPI.h"
+
+#include <QuasarEngine/File/FileUtils.h>
+#include <QuasarEngine/Core/Logger.h>
+
+namespace QuasarEngine
+{
+	NullTextureArray::NullTextureArray(const TextureSpecification& specification)
+		: TextureArray(specification), m_Handle(Utils::NextNullTextureHandle())
+	{
+	}
+
+	bool NullTextureArray::LoadFromPath(const std::string& path)
+	{
+		return LoadFromFiles({ path });
+	}
+
+	bool NullTextureArray::LoadFromMemory(ByteView data)
+	{
+		const std::size_t bytes = Utils::DecodeNullTexture(data, m_Specification);
+		if (bytes == 0)
+			return false;
+
+		Utils::CountNullTextureUpload(bytes);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTextureArray::LoadFromData(ByteView data)
+	{
+		if (data.empty() || m_Specification.width == 0 || m_Specification.height == 0)
+			return false;
+
+		Utils::CountNullTextureUpload(data.size);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTextureArray::LoadFromFiles(const std::vector<std::string>& paths)
+	{
+		if (paths.empty()) {
+			Q_ERROR("NullTextureArray::LoadFromFiles: empty path list");
+			return false;
+		}
+
+		for (const auto& path : paths)
+		{
+			auto bytes = FileUtils::ReadFileBinary(path);
+			if (bytes.empty() || !LoadFromMemory(ByteView{ bytes.data(), bytes.size() })) {
+				Q_ERROR("NullTextureArray: failed to load layer: " + path);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void NullTextureArray::Bind(int index) const
+	{
+		++NullRendererAPI::GetStats().textureBinds;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QuasarEngine/Resources/TextureArray.h>
+
+namespace QuasarEngine
+{
+	class NullTextureArray : public TextureArray
+	{
+	public:
+		explicit NullTextureArray(const TextureSpecification& specification);
+
+		TextureHandle GetHandle() const noexcept override { return m_Handle; }
+		bool IsLoaded() const noexcept override { return m_Loaded; }
+
+		bool LoadFromPath(const std::string& path) override;
+		bool LoadFromMemory(ByteView data) override;
+		bool LoadFromData(ByteView data) override;
+
+		bool LoadFromFiles(const std::vector<std::string>& paths) override;
+
+		void Bind(int index = 0) const override;
+		void Unbind() const override {}
+
+		void GenerateMips() override {}
+
+	private:
+		TextureHandle m_Handle = 0;
+		bool m_Loaded = false;
+	};
+}
@@ -0,0 +1,87 @@
+#include "qepch.h"
+#include "NullTextureCubeMap.h"
+#include "NullTextureUtils.h"
+#include "NullRendererAPI.h"
+
+#include <QuasarEngine/File/FileUtils.h>
+#include <QuasarEngine/Core/Logger.h>
+
+namespace QuasarEngine
+{
+	NullTextureCubeMap::NullTextureCubeMap(const TextureSpecification& specification)
+		: TextureCubeMap(specification), m_Handle(Utils::NextNullTextureHandle())
+	{
+	}
+
+	bool NullTextureCubeMap::LoadFromPath(const std::string& path)
+	{
+		auto bytes = FileUtils::ReadFileBinary(path);
+		if (bytes.empty()) {
+			Q_ERROR("NullTextureCubeMap: failed to read file: " + path);
+			return false;
+		}
+		return LoadFromMemory(ByteView{ bytes.data(), bytes.size() });
+	}
+
+	bool NullTextureCubeMap::LoadFromMemory(ByteView data)
+	{
+		// Same image on every face, as in the GL backend.
+		const std::size_t bytes = Utils::DecodeNullTexture(data, m_Specification);
+		if (bytes == 0)
+			return false;
+
+		Utils::CountNullTextureUpload(bytes * 6);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTextureCubeMap::LoadFromData(ByteView data)
+	{
+		if (data.empty())
+			return false;
+
+		Utils::CountNullTextureUpload(data.size);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTextureCubeMap::LoadFaceFromPath(Face face, const std::string& path)
+	{
+		auto bytes = FileUtils::ReadFileBinary(path);
+		if (bytes.empty()) {
+			Q_ERROR("NullTextureCubeMap: failed to read file: " + path);
+			return false;
+		}
+		return LoadFaceFromMemory(face, ByteView{ bytes.data(), bytes.size() });
+	}
+
+	bool NullTextureCubeMap::LoadFaceFromMemory(Face face, ByteView data)
+	{
+		const std::size_t bytes = Utils::DecodeNullTexture(data, m_Specification);
+		if (bytes == 0)
+			return false;
+
+		Utils::CountNullTextureUpload(bytes);
+		m_Loaded = true;
+		return true;
+	}
+
+	bool NullTextureCubeMap::LoadFaceFromData(Face face, ByteView data, uint32_t w, uint32_t h, uint32_t channels)
+	{
+		if (data.empty() || w == 0 || h == 0)
+			return false;
+
+		m_Specification.width = w;
+		m_Specification.height = h;
+		m_Specification.channels = channels;
+
+		Utils::CountNullTextureUpload(data.size);
+		m_Loaded = true;
+		return true;
+	}
+
+	void NullTextureCubeMap::Bind(int index) const
+	{
+		++NullRendererAPI::GetStats().textureBinds;
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QuasarEngine/Resources/TextureCubeMap.h>
+
+namespace QuasarEngine
+{
+	class NullTextureCubeMap : public TextureCubeMap
+	{
+	public:
+		explicit NullTextureCubeMap(const TextureSpecification& specification);
+
+		TextureHandle GetHandle() const noexcept override { return m_Handle; }
+		bool IsLoaded() const noexcept override { return m_Loaded; }
+
+		bool LoadFromPath(const std::string& path) override;
+		bool LoadFromMemory(ByteView data) override;
+		bool LoadFromData(ByteView data) override;
+
+		bool LoadFaceFromPath(Face face, const std::string& path) override;
+		bool LoadFaceFromMemory(Face face, ByteView data) override;
+		bool LoadFaceFromData(Face face, ByteView data, uint32_t w, uint32_t h, uint32_t channels) override;
+
+		void Bind(int index = 0) const override;
+		void Unbind() const override {}
+
+		void GenerateMips() override {}
+
+	private:
+		TextureHandle m_Handle = 0;
+		bool m_Loaded = false;
+	};
+}
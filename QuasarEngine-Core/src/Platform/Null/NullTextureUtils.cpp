@@ -0,0 +1,107 @@
+#include "qepch.h"
+#include "NullTextureUtils.h"
+#include "NullRendererAPI.h"
+
+#include <stb_image.h>
+
+#include <QuasarEngine/Core/Logger.h>
+
+#include <atomic>
+
+namespace QuasarEngine
+{
+	namespace Utils
+	{
+		namespace
+		{
+			int DesiredNullChannels(TextureFormat fmt)
+			{
+				switch (fmt) {
+				case TextureFormat::RED:
+				case TextureFormat::RED8:
+				case TextureFormat::R16F:
+				case TextureFormat::R32F:
+				case TextureFormat::R32I:
+					return 1;
+				case TextureFormat::RG16F:
+					return 2;
+				case TextureFormat::RGB:
+				case TextureFormat::RGB8:
+				case TextureFormat::SRGB:
+				case TextureFormat::SRGB8:
+				case TextureFormat::RGB16F:
+				case TextureFormat::RGB32F:
+				case TextureFormat::R11G11B10F:
+					return 3;
+				case TextureFormat::RGBA:
+				case TextureFormat::RGBA8:
+				case TextureFormat::SRGBA:
+				case TextureFormat::SRGB8A8:
+				case TextureFormat::RGBA16F:
+				case TextureFormat::RGBA32F:
+					return 4;
+				default:
+					return 0;
+				}
+			}
+
+			bool IsFloatNullFormat(TextureFormat fmt)
+			{
+				switch (fmt) {
+				case TextureFormat::R16F:
+				case TextureFormat::RG16F:
+				case TextureFormat::RGB16F:
+				case TextureFormat::RGBA16F:
+				case TextureFormat::R32F:
+				case TextureFormat::RGB32F:
+				case TextureFormat::RGBA32F:
+				case TextureFormat::R11G11B10F:
+					return true;
+				default:
+					return false;
+				}
+			}
+		}
+
+		TextureHandle NextNullTextureHandle()
+		{
+			static std::atomic<TextureHandle> s_Next{ 1 };
+			return s_Next.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void CountNullTextureUpload(std::size_t bytes)
+		{
+			NullRendererStats& stats = NullRendererAPI::GetStats();
+			++stats.textureUploads;
+			stats.textureBytes += bytes;
+		}
+
+		std::size_t DecodeNullTexture(ByteView data, TextureSpecification& spec)
+		{
+			if (data.empty())
+				return 0;
+
+			stbi_set_flip_vertically_on_load(spec.flip);
+
+			const bool wantFloat = IsFloatNullFormat(spec.internal_format)
+				|| stbi_is_hdr_from_memory((const stbi_uc*)data.data, (int)data.size) != 0;
+			const int desired = DesiredNullChannels(spec.internal_format);
+
+			int w = 0, h = 0, n = 0;
+			void* decoded = wantFloat
+				? (void*)stbi_loadf_from_memory((const stbi_uc*)data.data, (int)data.size, &w, &h, &n, desired)
+				: (void*)stbi_load_from_memory((const stbi_uc*)data.data, (int)data.size, &w, &h, &n, desired);
+			if (!decoded) {
+				Q_ERROR(std::string("NullTexture: stb_image failed: ") + stbi_failure_reason());
+				return 0;
+			}
+			stbi_image_free(decoded);
+
+			spec.width = (uint32_t)w;
+			spec.height = (uint32_t)h;
+			spec.channels = (uint32_t)(desired > 0 ? desired : n);
+
+			return (std::size_t)w * (std::size_t)h * spec.channels * (wantFloat ? sizeof(float) : 1u);
+		}
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QuasarEngine/Resources/Texture.h>
+
+namespace QuasarEngine
+{
+	namespace Utils
+	{
+		// Unique non-zero handle, code checking GetHandle() != 0 keeps working.
+		TextureHandle NextNullTextureHandle();
+
+		void CountNullTextureUpload(std::size_t bytes);
+
+		// Decodes with stb_image like the GL backend so the decode stays in the measured time,
+		// then only keeps the size in the specification. Returns the decoded byte count, 0 on failure.
+		std::size_t DecodeNullTexture(ByteView data, TextureSpecification& spec);
+	}
+}
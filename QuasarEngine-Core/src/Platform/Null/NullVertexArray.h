@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QuasarEngine/Renderer/VertexArray.h>
+
+namespace QuasarEngine
+{
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray() = default;
+		virtual ~NullVertexArray() = default;
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer) override { m_VertexBuffers.push_back(vertexBuffer); }
+		virtual void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		virtual const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
+		virtual const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
+	private:
+		std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffers;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+	};
+}
@@ -2,6 +2,7 @@
 #include "OpenGLBuffer.h"
 
 #include <glad/glad.h>
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -58,6 +59,47 @@ namespace QuasarEngine
 
 	GLuint OpenGLUniformBuffer::GetID() const { return m_ID; }
 
+	OpenGLUniformRingBuffer::OpenGLUniformRingBuffer(size_t blockSize, uint32_t binding, size_t blockCount)
+		: m_BlockSize(blockSize), m_Binding(binding)
+	{
+		if (m_BlockSize == 0) return;
+
+		GLint alignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		const size_t align = alignment > 0 ? static_cast<size_t>(alignment) : 256;
+
+		m_Stride = (m_BlockSize + align - 1) / align * align;
+		m_Capacity = m_Stride * std::max<size_t>(blockCount, 1);
+
+		glCreateBuffers(1, &m_ID);
+		glNamedBufferData(m_ID, m_Capacity, nullptr, GL_STREAM_DRAW);
+	}
+
+	OpenGLUniformRingBuffer::~OpenGLUniformRingBuffer()
+	{
+		if (m_ID) glDeleteBuffers(1, &m_ID);
+	}
+
+	void OpenGLUniformRingBuffer::Push(const void* data, size_t size)
+	{
+		if (m_ID == 0 || !data || size == 0) return;
+
+		if (size > m_BlockSize)
+			throw std::runtime_error("Uniform ring block exceeded: requested " +
+				std::to_string(size) + " > " + std::to_string(m_BlockSize));
+
+		if (m_Head + m_Stride > m_Capacity)
+		{
+			glNamedBufferData(m_ID, m_Capacity, nullptr, GL_STREAM_DRAW);
+			m_Head = 0;
+		}
+
+		glNamedBufferSubData(m_ID, m_Head, size, data);
+		glBindBufferRange(GL_UNIFORM_BUFFER, m_Binding, m_ID, m_Head, m_BlockSize);
+
+		m_Head += m_Stride;
+	}
+
 	OpenGLVertexBuffer::OpenGLVertexBuffer()
 		: m_Size(0), m_Layout(), m_ID(0), m_IsPersistent(false), m_Mapped(nullptr)
 	{
@@ -21,6 +21,27 @@ namespace QuasarEngine
 		uint32_t m_Binding = 0;
 	};
 
+	// Per-draw uniform blocks: each Push writes the next slot and binds it with glBindBufferRange.
+	// The storage is orphaned when the ring wraps, so slots still in flight are never overwritten.
+	class OpenGLUniformRingBuffer
+	{
+	public:
+		OpenGLUniformRingBuffer(size_t blockSize, uint32_t binding, size_t blockCount = 1024);
+		~OpenGLUniformRingBuffer();
+
+		void Push(const void* data, size_t size);
+
+		size_t GetBlockSize() const { return m_BlockSize; }
+
+	private:
+		uint32_t m_ID = 0;
+		size_t m_BlockSize = 0;
+		size_t m_Stride = 0;
+		size_t m_Capacity = 0;
+		size_t m_Head = 0;
+		uint32_t m_Binding = 0;
+	};
+
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
@@ -1,10 +1,12 @@
 #include "qepch.h"
 #include "OpenGLShader.h"
 
+#include <chrono>
 #include <fstream>
 #include <sstream>
 
 #include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Shader/ShaderCache.h>
 #include <glad/glad.h>
 
 namespace QuasarEngine
@@ -137,6 +139,87 @@ namespace QuasarEngine
         return s;
     }
 
+    std::string OpenGLShader::StageName(uint32_t type)
+    {
+        switch (type)
+        {
+        case GL_VERTEX_SHADER:          return "Vertex";
+        case GL_FRAGMENT_SHADER:        return "Fragment";
+        case GL_GEOMETRY_SHADER:        return "Geometry";
+        case GL_COMPUTE_SHADER:         return "Compute";
+        case GL_TESS_CONTROL_SHADER:    return "TessControl";
+        case GL_TESS_EVALUATION_SHADER: return "TessEval";
+        default:                        return "Unknown";
+        }
+    }
+
+    bool OpenGLShader::SupportsProgramBinary()
+    {
+        static const bool supported = []() {
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            return formats > 0;
+            }();
+        return supported;
+    }
+
+    const std::string& OpenGLShader::GetDriverString()
+    {
+        static const std::string driver = []() {
+            auto str = [](GLenum name) {
+                const GLubyte* value = glGetString(name);
+                return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+                };
+            return str(GL_VENDOR) + "|" + str(GL_RENDERER) + "|" + str(GL_VERSION);
+            }();
+        return driver;
+    }
+
+    bool OpenGLShader::LoadProgramBinary(uint64_t key)
+    {
+        ShaderCache& cache = ShaderCache::Instance();
+
+        uint32_t format = 0;
+        std::vector<uint8_t> binary;
+        if (!cache.Load(key, format, binary))
+            return false;
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            // Drivers may refuse binaries from another build even with the same version string.
+            glDeleteProgram(program);
+            cache.Remove(key);
+            cache.RecordRejected();
+            return false;
+        }
+
+        m_ID = program;
+        return true;
+    }
+
+    void OpenGLShader::StoreProgramBinary(uint64_t key)
+    {
+        GLint length = 0;
+        glGetProgramiv(m_ID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<uint8_t> binary(static_cast<size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(m_ID, length, &written, &format, binary.data());
+        if (written <= 0)
+            return;
+
+        binary.resize(static_cast<size_t>(written));
+        ShaderCache::Instance().Store(key, format, binary);
+    }
+
     std::string OpenGLShader::ReadFile(const std::string& path)
     {
         std::ifstream file(path);
@@ -161,14 +244,7 @@ namespace QuasarEngine
         {
             char log[2048]; GLsizei len = 0;
             glGetShaderInfoLog(shader, sizeof(log), &len, log);
-            std::string stage =
-                (type == GL_VERTEX_SHADER ? "Vertex" :
-                    type == GL_FRAGMENT_SHADER ? "Fragment" :
-                    type == GL_GEOMETRY_SHADER ? "Geometry" :
-                    type == GL_COMPUTE_SHADER ? "Compute" :
-                    type == GL_TESS_CONTROL_SHADER ? "TessControl" :
-                    type == GL_TESS_EVALUATION_SHADER ? "TessEval" : "Unknown");
-            throw std::runtime_error("[" + stage + "] compile error:\n" + std::string(log, len));
+            throw std::runtime_error("[" + StageName(type) + "] compile error:\n" + std::string(log, len));
         }
         return shader;
     }
@@ -179,6 +255,7 @@ namespace QuasarEngine
         for (uint32_t shader : shaders)
             glAttachShader(m_ID, shader);
 
+        glProgramParameteri(m_ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         glLinkProgram(m_ID);
 
         GLint success = GL_FALSE;
@@ -228,7 +305,10 @@ namespace QuasarEngine
         for (const auto& uniform : m_Description.objectUniforms)
             objectSize = std::max(objectSize, uniform.offset + uniform.size);
         m_ObjectUniformData.resize(objectSize);
-        m_ObjectUBO = (objectSize > 0) ? std::make_unique<OpenGLUniformBuffer>(objectSize, 1) : nullptr;
+        m_ObjectUBO = (objectSize > 0) ? std::make_unique<OpenGLUniformRingBuffer>(objectSize, 1) : nullptr;
+
+        m_SamplerTextures.assign(m_Description.samplers.size(), nullptr);
+        m_SamplerTypes.assign(m_Description.samplers.size(), SamplerType::Sampler2D);
 
         for (const auto& uniform : m_Description.globalUniforms)
             m_GlobalUniformMap[uniform.name] = &uniform;
@@ -244,20 +324,18 @@ namespace QuasarEngine
             m_StorageBuffers.emplace(sbDesc.name, std::move(data));
         }
 
-        std::vector<uint32_t> compiledShaders;
-        compiledShaders.reserve(desc.modules.size());
-
-        for (const auto& module : desc.modules)
+        struct StageSource
         {
+            GLenum stage = 0;
+            std::string path;
             std::string source;
-            try {
-                source = ReadFile(module.path);
-            }
-            catch (const std::exception& e) {
-                Q_ERROR("Shader reading failed (" + module.path + "): " + std::string(e.what()));
-                continue;
-            }
+        };
 
+        std::vector<StageSource> stages;
+        stages.reserve(desc.modules.size());
+
+        for (const auto& module : desc.modules)
+        {
             GLenum glStage = 0;
             switch (module.stage)
             {
@@ -271,25 +349,86 @@ namespace QuasarEngine
             }
             if (!glStage) continue;
 
+            // Generated shaders (shader graph, GLSL generator) carry their source inline.
+            if (!module.source.empty())
+            {
+                stages.push_back({ glStage, module.path, module.source });
+                continue;
+            }
+
             try {
-                uint32_t shader = CompileShader(source, glStage);
-                compiledShaders.push_back(shader);
+                stages.push_back({ glStage, module.path, ReadFile(module.path) });
             }
             catch (const std::exception& e) {
-                Q_ERROR("Compilation failed (" + module.path + "): " + std::string(e.what()));
+                Q_ERROR("Shader reading failed (" + module.path + "): " + std::string(e.what()));
             }
         }
 
-        try {
-            LinkProgram(compiledShaders);
+        ShaderCache& cache = ShaderCache::Instance();
+        const bool useCache = cache.IsEnabled() && SupportsProgramBinary();
+
+        uint64_t cacheKey = 0;
+        if (useCache)
+        {
+            std::vector<std::string> sources;
+            sources.reserve(stages.size());
+            for (const auto& stage : stages)
+                sources.push_back(stage.source);
+
+            cacheKey = ShaderCache::ComputeKey(m_Description, sources, GetDriverString());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsedMs = [&]() {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            };
+
+        if (useCache && LoadProgramBinary(cacheKey))
+        {
+            cache.RecordHit(elapsedMs());
         }
-        catch (const std::exception& e) {
-            Q_ERROR("Error linking shader : " + std::string(e.what()));
-            throw;
+        else
+        {
+            std::vector<uint32_t> compiledShaders;
+            compiledShaders.reserve(stages.size());
+
+            for (const StageSource& stage : stages)
+            {
+                try {
+                    uint32_t shader = CompileShader(stage.source, stage.stage);
+                    compiledShaders.push_back(shader);
+                }
+                catch (const std::exception& e) {
+                    Q_ERROR("Compilation failed (" + (stage.path.empty() ? StageName(stage.stage) : stage.path) + "): " + std::string(e.what()));
+                }
+            }
+
+            try {
+                LinkProgram(compiledShaders);
+            }
+            catch (const std::exception& e) {
+                Q_ERROR("Error linking shader : " + std::string(e.what()));
+                throw;
+            }
+
+            if (useCache)
+                StoreProgramBinary(cacheKey);
+
+            cache.RecordMiss(elapsedMs());
         }
 
         ExtractUniformLocations();
 
+        // Block bindings and sampler units never change, set them once instead of per draw.
+        if (GLuint index = glGetUniformBlockIndex(m_ID, "local_uniform_object"); index != GL_INVALID_INDEX)
+            glUniformBlockBinding(m_ID, index, 1);
+
+        for (const auto& samplerDesc : m_Description.samplers)
+        {
+            if (auto itLoc = m_UniformLocations.find(samplerDesc.name); itLoc != m_UniformLocations.end() && itLoc->second >= 0)
+                glProgramUniform1i(m_ID, itLoc->second, static_cast<GLint>(samplerDesc.binding));
+        }
+
         TextureSpecification spec;
         spec.width = 2;
         spec.height = 2;
@@ -410,42 +549,35 @@ namespace QuasarEngine
 
     bool OpenGLShader::UpdateObject(Material* /*material*/)
     {
-        if (m_ObjectUBO) {
-            if (!m_ObjectUniformData.empty()) {
-                m_ObjectUBO->SetData(m_ObjectUniformData.data(), m_ObjectUniformData.size());
-            }
-            m_ObjectUBO->BindToShader(m_ID, "local_uniform_object");
-        }
+        if (m_ObjectUBO && !m_ObjectUniformData.empty())
+            m_ObjectUBO->Push(m_ObjectUniformData.data(), m_ObjectUniformData.size());
 
         for (auto& [name, sb] : m_StorageBuffers)
         {
             if (!sb.buffer)
                 continue;
 
-            if (!sb.cpuData.empty())
+            if (sb.dirty && !sb.cpuData.empty())
                 sb.buffer->SetData(sb.cpuData.data(), sb.cpuData.size());
+            sb.dirty = false;
 
             sb.buffer->BindToShader(m_ID, name.c_str());
         }
 
-        for (const auto& samplerDesc : m_Description.samplers)
+        for (size_t i = 0; i < m_Description.samplers.size(); ++i)
         {
-            const std::string& sname = samplerDesc.name;
-
-            SamplerType st = SamplerType::Sampler2D;
-            if (auto itT = m_ObjectTextureTypes.find(sname); itT != m_ObjectTextureTypes.end())
-                st = itT->second;
+            const auto& samplerDesc = m_Description.samplers[i];
 
-            Texture* texObj = m_DefaultBlueTexture;
-            if (auto it = m_ObjectTextures.find(sname); it != m_ObjectTextures.end() && it->second)
-                texObj = it->second;
-            else if (st == SamplerType::SamplerCube)
-                texObj = m_DefaultBlackCubemap;
+            Texture* texObj = m_SamplerTextures[i];
+            if (!texObj)
+                texObj = (m_SamplerTypes[i] == SamplerType::SamplerCube)
+                    ? static_cast<Texture*>(m_DefaultBlackCubemap)
+                    : static_cast<Texture*>(m_DefaultBlueTexture);
 
-            if (!texObj) { Q_ERROR("No texture bound for sampler " + sname); continue; }
+            if (!texObj) { Q_ERROR("No texture bound for sampler " + samplerDesc.name); continue; }
 
             const GLuint handle = static_cast<GLuint>(texObj->GetHandle());
-            if (handle == 0) { Q_ERROR("Invalid GL handle for sampler " + sname); continue; }
+            if (handle == 0) { Q_ERROR("Invalid GL handle for sampler " + samplerDesc.name); continue; }
 
             const GLint unit = samplerDesc.binding;
 
@@ -454,9 +586,6 @@ namespace QuasarEngine
                 texObj->Bind(unit);
                 bound.handle = handle;
             }
-
-            if (auto itLoc = m_UniformLocations.find(sname); itLoc != m_UniformLocations.end() && itLoc->second >= 0)
-                glUniform1i(itLoc->second, unit);
         }
 
         return true;
@@ -488,24 +617,46 @@ namespace QuasarEngine
 
     bool OpenGLShader::SetTexture(const std::string& name, Texture* texture, SamplerType type)
     {
-        auto itSampler = std::find_if(
-            m_Description.samplers.begin(), m_Description.samplers.end(),
-            [&](const ShaderSamplerDesc& desc) { return desc.name == name; });
-
-        if (itSampler == m_Description.samplers.end())
+        const SamplerHandle handle = GetSamplerHandle(name);
+        if (handle == InvalidHandle)
         {
             Q_ERROR("Sampler " + name + " not found in shader description!");
             return false;
         }
 
-        /*if (!texture)
-        {
-            Q_WARNING("Setting null texture for sampler " + name);
-		}*/
+        return SetTexture(handle, texture, type);
+    }
+
+    bool OpenGLShader::SetUniform(UniformHandle handle, const void* data, size_t size)
+    {
+        const ShaderUniformDesc* desc = ResolveUniform(handle);
+        if (!desc || !data)
+            return false;
 
-        m_ObjectTextures[name] = texture;
-        m_ObjectTextureTypes[name] = type;
+        std::vector<uint8_t>& block = (handle & ObjectUniformBit) ? m_ObjectUniformData : m_GlobalUniformData;
+
+        const size_t copySize = std::min(size, desc->size);
+        if (desc->offset + copySize <= block.size())
+            std::memcpy(block.data() + desc->offset, data, copySize);
+        return true;
+    }
+
+    bool OpenGLShader::SetTexture(SamplerHandle handle, Texture* texture, SamplerType type)
+    {
+        if (handle >= m_SamplerTextures.size())
+            return false;
+
+        m_SamplerTextures[handle] = texture;
+        m_SamplerTypes[handle] = type;
+        return true;
+    }
+
+    bool OpenGLShader::SetObjectUniforms(const void* data, size_t size)
+    {
+        if (!data)
+            return false;
 
+        std::memcpy(m_ObjectUniformData.data(), data, std::min(size, m_ObjectUniformData.size()));
         return true;
     }
 
@@ -520,6 +671,7 @@ namespace QuasarEngine
         StorageBufferData& sb = it->second;
         sb.cpuData.resize(size);
         std::memcpy(sb.cpuData.data(), data, size);
+        sb.dirty = true;
         return true;
     }
 }
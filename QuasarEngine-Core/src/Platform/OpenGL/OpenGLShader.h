@@ -74,12 +74,26 @@ namespace QuasarEngine
         bool SetTexture(const std::string& name, Texture* texture, SamplerType type) override;
         bool SetStorageBuffer(const std::string& name, const void* data, size_t size) override;
 
+        bool SetUniform(UniformHandle handle, const void* data, size_t size) override;
+        bool SetTexture(SamplerHandle handle, Texture* texture, SamplerType type) override;
+        bool SetObjectUniforms(const void* data, size_t size) override;
+
+    protected:
+        const ShaderDescription& GetDescription() const override { return m_Description; }
+
     private:
         void LinkProgram(const std::vector<uint32_t>& shaders);
         void ExtractUniformLocations();
         std::string ReadFile(const std::string& path);
         uint32_t CompileShader(const std::string& source, uint32_t type);
 
+        bool LoadProgramBinary(uint64_t key);
+        void StoreProgramBinary(uint64_t key);
+
+        static bool SupportsProgramBinary();
+        static const std::string& GetDriverString();
+        static std::string StageName(uint32_t type);
+
         static GLenum DepthFuncToGL(Shader::DepthFunc func);
         static GLenum SamplerTypeToGL(Shader::SamplerType type);
 
@@ -94,12 +108,13 @@ namespace QuasarEngine
         std::unordered_map<std::string, const ShaderUniformDesc*> m_ObjectUniformMap;
 
         std::unique_ptr<OpenGLUniformBuffer> m_GlobalUBO;
-        std::unique_ptr<OpenGLUniformBuffer> m_ObjectUBO;
+        std::unique_ptr<OpenGLUniformRingBuffer> m_ObjectUBO;
         std::vector<uint8_t> m_GlobalUniformData;
         std::vector<uint8_t> m_ObjectUniformData;
 
-        std::unordered_map<std::string, Texture*> m_ObjectTextures;
-        std::unordered_map<std::string, Shader::SamplerType> m_ObjectTextureTypes;
+        // Indexed like m_Description.samplers.
+        std::vector<Texture*> m_SamplerTextures;
+        std::vector<Shader::SamplerType> m_SamplerTypes;
 
         struct BoundTex { GLuint handle = 0; GLenum target = GL_TEXTURE_2D; };
         std::unordered_map<int, BoundTex> m_BoundPerUnit;
@@ -111,6 +126,7 @@ namespace QuasarEngine
             std::unique_ptr<OpenGLShaderStorageBuffer> buffer;
             std::vector<uint8_t> cpuData;
             const ShaderStorageBufferDesc* desc = nullptr;
+            bool dirty = false;
         };
         std::unordered_map<std::string, StorageBufferData> m_StorageBuffers;
 
@@ -7,6 +7,7 @@
 
 #include <QuasarEngine/File/FileUtils.h>
 #include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Resources/TextureCompression.h>
 
 #include <algorithm>
 #include <cctype>
@@ -199,6 +200,53 @@ namespace QuasarEngine
         return UploadPixelsDSA(pixels, Utils::IsFloatInternal(m_Specification.internal_format));
     }
 
+    bool OpenGLTexture2D::LoadCompressed(const CompressedTexture& texture)
+    {
+        const auto glInt = Utils::ToGLFormat(texture.format);
+        if (!IsBlockCompressed(texture.format) || texture.levels.empty() || texture.width == 0 || texture.height == 0)
+            return false;
+
+        // BC1-3 come from S3TC, which core GL never absorbed; BC5/BC7 are core since 3.0/4.2.
+        const bool s3tc = texture.format == TextureFormat::BC1 || texture.format == TextureFormat::BC1_SRGB ||
+            texture.format == TextureFormat::BC3 || texture.format == TextureFormat::BC3_SRGB;
+        if (s3tc && !::GLAD_GL_EXT_texture_compression_s3tc)
+            return false;
+
+        m_Specification.format = texture.format;
+        m_Specification.internal_format = texture.format;
+        m_Specification.width = texture.width;
+        m_Specification.height = texture.height;
+        m_Specification.mip_levels = static_cast<uint32_t>(texture.levels.size());
+        m_Specification.auto_generate_mips = false;
+        m_Specification.channels = static_cast<uint32_t>(glInt.channels);
+
+        if (m_ID) { glDeleteTextures(1, &m_ID); m_ID = 0; m_Loaded = false; }
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
+
+        const uint32_t levels = m_Specification.mip_levels;
+        glTextureStorage2D(m_ID, (GLint)levels, glInt.internal,
+            (GLint)m_Specification.width, (GLint)m_Specification.height);
+
+        ConfigureTextureFixedState(m_ID, m_Specification, glInt, levels);
+
+        ConfigureOrCreateSampler(m_SamplerID, m_Specification);
+
+        for (uint32_t level = 0; level < levels; ++level)
+        {
+            const GLsizei w = (GLsizei)std::max(1u, texture.width >> level);
+            const GLsizei h = (GLsizei)std::max(1u, texture.height >> level);
+            const auto& data = texture.levels[level];
+            glCompressedTextureSubImage2D(m_ID, (GLint)level, 0, 0, w, h, glInt.internal, (GLsizei)data.size(), data.data());
+        }
+
+        m_Loaded = true;
+
+        m_CPUDataValid = false;
+        m_CPUData.clear();
+
+        return true;
+    }
+
     bool OpenGLTexture2D::AllocateStorage()
     {
         if (m_ID) { glDeleteTextures(1, &m_ID); m_ID = 0; m_Loaded = false; }
@@ -407,6 +455,28 @@ namespace QuasarEngine
         m_CPUDataValid = true;
     }
 
+    bool OpenGLTexture2D::ReadPixels(std::vector<float>& out) const
+    {
+        if (!m_ID || !m_Loaded || m_Specification.width == 0 || m_Specification.height == 0)
+            return false;
+
+        const auto glExt = Utils::ToGLFormat(m_Specification.format);
+        const GLint channels = Utils::DesiredChannels(m_Specification.internal_format);
+        if (glExt.external == 0 || channels == 0)
+            return false;
+
+        out.resize((size_t)m_Specification.width * m_Specification.height * channels);
+
+        GLint oldPack = 4;
+        glGetIntegerv(GL_PACK_ALIGNMENT, &oldPack);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        glGetTextureImage(m_ID, 0, glExt.external, GL_FLOAT, (GLsizei)(out.size() * sizeof(float)), out.data());
+
+        glPixelStorei(GL_PACK_ALIGNMENT, oldPack);
+        return true;
+    }
+
     glm::vec4 OpenGLTexture2D::Sample(const glm::vec2& uv) const
     {
         if (!m_Loaded ||
@@ -446,7 +516,8 @@ namespace QuasarEngine
 
     void OpenGLTexture2D::GenerateMips()
     {
-        if (!m_ID) return;
+        // Block-compressed chains arrive complete and GL cannot render into them.
+        if (!m_ID || m_Specification.is_block_compressed()) return;
         glGenerateTextureMipmap(m_ID);
     }
 
@@ -18,11 +18,13 @@ namespace QuasarEngine
 		bool LoadFromPath(const std::string& path) override;
 		bool LoadFromMemory(ByteView data) override;
 		bool LoadFromData(ByteView data) override;
+		bool LoadCompressed(const CompressedTexture& texture) override;
 
 		void Bind(int index = 0) const override;
 		void Unbind() const override;
 
 		glm::vec4 Sample(const glm::vec2& uv) const override;
+		bool ReadPixels(std::vector<float>& out) const override;
 
 		void GenerateMips() override;
 		bool AllocateStorage();
@@ -471,6 +471,54 @@ namespace QuasarEngine
         return UploadFaceDSA(face, data, w, h, pixelsAreFloat);
     }
 
+    bool OpenGLTextureCubeMap::LoadFaceMipFromData(Face face, uint32_t mip, ByteView data, uint32_t w, uint32_t h)
+    {
+        if (!m_StorageAllocated || data.empty() || mip >= Utils::CalcMipLevelsFromSpec(m_Specification))
+            return false;
+
+        const auto glExt = Utils::ToGLFormat(m_Specification.format);
+        if (glExt.external == 0) {
+            Q_ERROR("OpenGLTextureCubeMap: unsupported external format");
+            return false;
+        }
+
+        GLint oldUnpack = 4;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &oldUnpack);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        const GLenum uploadType = Utils::IsFloatInternal(m_Specification.internal_format) ? GL_FLOAT : glExt.type;
+        glTextureSubImage3D(m_ID, (GLint)mip, 0, 0, Utils::FaceIndex(face), (GLint)w, (GLint)h, 1,
+            glExt.external, uploadType, data.data);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, oldUnpack);
+        return true;
+    }
+
+    bool OpenGLTextureCubeMap::ReadFaceMip(Face face, uint32_t mip, std::vector<float>& out) const
+    {
+        if (!m_StorageAllocated || mip >= Utils::CalcMipLevelsFromSpec(m_Specification))
+            return false;
+
+        const auto glExt = Utils::ToGLFormat(m_Specification.format);
+        const GLint channels = Utils::DesiredChannels(m_Specification.internal_format);
+        if (glExt.external == 0 || channels == 0)
+            return false;
+
+        const uint32_t w = std::max(1u, m_Specification.width >> mip);
+        const uint32_t h = std::max(1u, m_Specification.height >> mip);
+        out.resize((size_t)w * h * channels);
+
+        GLint oldPack = 4;
+        glGetIntegerv(GL_PACK_ALIGNMENT, &oldPack);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        glGetTextureSubImage(m_ID, (GLint)mip, 0, 0, Utils::FaceIndex(face), (GLsizei)w, (GLsizei)h, 1,
+            glExt.external, GL_FLOAT, (GLsizei)(out.size() * sizeof(float)), out.data());
+
+        glPixelStorei(GL_PACK_ALIGNMENT, oldPack);
+        return true;
+    }
+
     void OpenGLTextureCubeMap::Bind(int index) const
     {
         if (!m_ID) return;
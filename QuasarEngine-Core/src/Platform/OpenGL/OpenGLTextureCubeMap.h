@@ -22,6 +22,9 @@ namespace QuasarEngine
         bool LoadFaceFromMemory(Face face, ByteView data) override;
         bool LoadFaceFromData(Face face, ByteView data, uint32_t w, uint32_t h, uint32_t channels) override;
 
+        bool LoadFaceMipFromData(Face face, uint32_t mip, ByteView data, uint32_t w, uint32_t h) override;
+        bool ReadFaceMip(Face face, uint32_t mip, std::vector<float>& out) const override;
+
         void Bind(int index = 0) const override;
         void Unbind() const override;
 
@@ -87,6 +87,22 @@ namespace QuasarEngine
             case TextureFormat::DEPTH24STENCIL8:
                 out.internal = GL_DEPTH24_STENCIL8; out.external = GL_DEPTH_STENCIL;    out.type = GL_UNSIGNED_INT_24_8;     out.channels = 1; break;
 
+            // Block formats are uploaded with glCompressedTextureSubImage2D; external/type only serve readback.
+            case TextureFormat::BC1:
+                out.internal = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;        out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4; break;
+            case TextureFormat::BC1_SRGB:
+                out.internal = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;       out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4; break;
+            case TextureFormat::BC3:
+                out.internal = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;       out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4; break;
+            case TextureFormat::BC3_SRGB:
+                out.internal = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT; out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4; break;
+            case TextureFormat::BC5:
+                out.internal = GL_COMPRESSED_RG_RGTC2;                 out.external = GL_RG;   out.type = GL_UNSIGNED_BYTE; out.channels = 2; break;
+            case TextureFormat::BC7:
+                out.internal = GL_COMPRESSED_RGBA_BPTC_UNORM;          out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4; break;
+            case TextureFormat::BC7_SRGB:
+                out.internal = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;    out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4; break;
+
             default:
                 out.internal = GL_RGBA8; out.external = GL_RGBA; out.type = GL_UNSIGNED_BYTE; out.channels = 4;
                 break;
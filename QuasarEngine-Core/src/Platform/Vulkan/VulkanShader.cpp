@@ -887,4 +887,42 @@ namespace QuasarEngine
     {
         return false;
     }
+
+    bool VulkanShader::SetUniform(UniformHandle handle, const void* data, size_t size)
+    {
+        const ShaderUniformDesc* d = ResolveUniform(handle);
+        if (!d || !data) {
+            Q_ERROR("Invalid uniform handle %u", handle);
+            return false;
+        }
+
+        std::vector<uint8_t>& block = (handle & ObjectUniformBit) ? m_ObjectUniformData : m_GlobalUniformData;
+        if (size != d->size || d->offset + size > block.size()) {
+            Q_ERROR("Uniform '%s' size mismatch (got %zu, expected %zu)", d->name.c_str(), size, d->size);
+            return false;
+        }
+
+        std::memcpy(block.data() + d->offset, data, size);
+        return true;
+    }
+
+    bool VulkanShader::SetTexture(SamplerHandle handle, Texture* texture, SamplerType type)
+    {
+        if (handle >= m_Description.samplers.size())
+            return false;
+
+        return SetTexture(m_Description.samplers[handle].name, texture, type);
+    }
+
+    bool VulkanShader::SetObjectUniforms(const void* data, size_t size)
+    {
+        if (!data || m_ObjectUniformData.empty()) {
+            Q_ERROR("Shader has no object uniform block");
+            return false;
+        }
+
+        // The C++ struct may carry trailing padding the block does not have.
+        std::memcpy(m_ObjectUniformData.data(), data, std::min(size, m_ObjectUniformData.size()));
+        return true;
+    }
 }
@@ -1,6 +1,8 @@
 #include "qepch.h"
 #include "Animation.h"
 
+#include <QuasarEngine/Resources/ModelCache.h>
+
 #include <cmath>
 
 #include <assimp/scene.h>
@@ -110,6 +112,19 @@ namespace QuasarEngine
     {
         std::vector<AnimationClip> clips;
 
+        // Clip entries live next to the model ones, keyed apart by the context string.
+        const uint64_t cacheKey = ModelCache::ComputeKey(path, nullptr, "AnimationClips");
+        const std::filesystem::path cachePath = ModelCache::GetCachePath(ModelImportOptions{}.cacheDir, cacheKey);
+        if (cacheKey != 0)
+        {
+            ModelCacheView cache;
+            if (cache.Open(cachePath, cacheKey))
+            {
+                cache.ReadClips(clips);
+                return clips;
+            }
+        }
+
         Assimp::Importer importer;
         const aiScene* scene = importer.ReadFile(
             path,
@@ -118,7 +133,7 @@ namespace QuasarEngine
             aiProcess_LimitBoneWeights
         );
 
-        if (!scene || !scene->mRootNode || scene->mNumAnimations == 0)
+        if (!scene || !scene->mRootNode)
             return clips;
 
         clips.reserve(scene->mNumAnimations);
@@ -154,6 +169,14 @@ namespace QuasarEngine
             clips.push_back(std::move(clip));
         }
 
+        // Files without animations get an empty entry too, so they are not imported again.
+        if (cacheKey != 0)
+        {
+            ModelCacheWriter writer;
+            writer.SetClips(clips);
+            writer.Save(cachePath, cacheKey);
+        }
+
         return clips;
     }
 }
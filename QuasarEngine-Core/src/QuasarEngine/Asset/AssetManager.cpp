@@ -8,12 +8,44 @@
 
 #include <QuasarEngine/Asset/AssetHeader.h>
 #include <QuasarEngine/Resources/Model.h>
+#include <QuasarEngine/Resources/TextureCompression.h>
+#include <QuasarEngine/Entity/Entity.h>
 #include <QuasarEngine/Entity/Components/MeshComponent.h>
 #include <QuasarEngine/Core/Logger.h>
 #include <QuasarEngine/Thread/JobSystem.h>
+#include <QuasarEngine/Tools/Profiler.h>
+#include <QuasarEngine/File/FileUtils.h>
+
+#include <chrono>
+#include <thread>
+
+#include <stb_image.h>
 
 namespace QuasarEngine
 {
+	namespace
+	{
+		// Meshes created per upload step, a large model spreads over several frames.
+		constexpr size_t ModelUploadBatch = 8;
+	}
+
+	struct AssetManager::StreamingAsset
+	{
+		AssetToLoad asset;
+
+		TextureSpecification spec;
+		std::vector<std::uint8_t> bytes;
+		std::vector<std::uint8_t> pixels;
+		bool decoded = false;
+
+		CompressedTexture compressed;
+		bool hasCompressed = false;
+
+		std::shared_ptr<Model> model;
+
+		uint64_t generation = 0;
+	};
+
 	AssetType AssetManager::InferTypeFromPath(const std::filesystem::path& p) const
 	{
 		if (p.empty())
@@ -78,6 +110,22 @@ namespace QuasarEngine
 
 	void AssetManager::Shutdown()
 	{
+		// Workers still decoding hold a pointer to this manager.
+		while (m_StreamingJobs.load(std::memory_order_acquire) > 0)
+			std::this_thread::yield();
+
+		{
+			std::lock_guard<std::mutex> lock(m_UploadMutex);
+			m_AssetsToUpload.clear();
+		}
+		m_CurrentUpload.reset();
+		m_MeshBindings.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(m_AssetMutex);
+			m_LoadStates.clear();
+		}
+
 		for (auto& pair : m_LoadedAssets)
 		{
 			if (pair.second)
@@ -116,6 +164,8 @@ namespace QuasarEngine
 
 	void AssetManager::Update()
 	{
+		QE_PROFILE_FUNCTION();
+
 		while (!m_AssetsToUnload.empty())
 		{
 			std::string id = m_AssetsToUnload.front();
@@ -128,6 +178,9 @@ namespace QuasarEngine
 				m_LoadedAssets[id].reset();
 				m_LoadedAssets.erase(it);
 			}
+
+			// A load still streaming is dropped when it reaches the upload.
+			m_LoadStates.erase(id);
 		}
 
 		while (!m_AssetsToLoad.empty())
@@ -138,99 +191,25 @@ namespace QuasarEngine
 			switch (asset.type)
 			{
 			case AssetType::TEXTURE:
-			{
-				if (isAssetLoaded(asset.id))
-					break;
-
-				//std::cout << "[AssetManager] Loading TEXTURE '" << asset.id << "'...\n";
-
-				TextureSpecification spec;
-				if (std::holds_alternative<TextureSpecification>(asset.spec))
-					spec = std::get<TextureSpecification>(asset.spec);
-
-				auto texture = Texture2D::Create(spec);
-
-				if (asset.data)
-				{
-					if (spec.compressed)
-					{
-						texture->LoadFromMemory({ static_cast<unsigned char*>(asset.data), asset.size });
-						texture->GenerateMips();
-					}
-					else
-					{
-						texture->LoadFromData({ static_cast<unsigned char*>(asset.data), asset.size });
-						texture->GenerateMips();
-					}
-				}
-				else
-				{
-					if (asset.path.empty())
-					{
-						Q_ERROR("AssetManager: TEXTURE '" + asset.id + "' error, path missing and no data");
-						break;
-					}
-					texture->LoadFromPath(asset.path);
-					texture->GenerateMips();
-				}
-
-				{
-					std::lock_guard<std::mutex> lock(m_AssetMutex);
-					m_LoadedAssets[asset.id] = std::move(texture);
-				}
-
-				break;
-			}
 			case AssetType::MODEL:
 			{
-				if (isAssetLoaded(asset.id))
-					break;
-
-				if (asset.path.empty()) {
+				if (asset.type == AssetType::MODEL && asset.path.empty()) {
 					Q_ERROR("AssetManager: MODEL path missing: " + asset.id);
 					break;
 				}
 
-				std::cout << "[AssetManager] Loading MODEL '" << asset.id << "'...\n";
-
-				std::shared_ptr<Model> model;
-				if (std::holds_alternative<ModelImportOptions>(asset.spec)) {
-					const auto& opts = std::get<ModelImportOptions>(asset.spec);
-					model = Model::CreateModel(asset.path, opts);
-				}
-				else {
-					model = Model::CreateModel(asset.path);
-				}
+				const AssetLoadState state = GetLoadState(asset.id);
+				if (state == AssetLoadState::Ready || state == AssetLoadState::Queued
+					|| state == AssetLoadState::Decoding || state == AssetLoadState::Uploading)
+					break;
 
-				{
-					std::lock_guard<std::mutex> lock(m_AssetMutex);
-					m_LoadedAssets[asset.id] = model;
-				}
+				StartStreaming(std::move(asset));
 				break;
 			}
 			case AssetType::MESH:
 			{
 				if (asset.handle.has_value())
-				{
-					auto* mc = std::any_cast<MeshComponent*>(asset.handle);
-					if (mc && isAssetLoaded(asset.id))
-					{
-						std::shared_ptr<Model> model = getAsset<Model>(asset.id);
-						if (model)
-						{
-							auto meshPtr = model->FindMeshByInstanceName(mc->GetName());
-							//auto meshPtr = model->FindMeshByPathAndName(mc->GetNodePath(), mc->GetName());
-							if (meshPtr)
-							{
-								mc->m_Mesh = meshPtr.get();
-							}
-							else
-							{
-								Q_ERROR("AssetManager: MESH instance '" + mc->GetName() + "' missing on '" + asset.id + "'");
-							}
-						}
-					}
-				}
+					m_MeshBindings.push_back(std::move(asset));
 				break;
 			}
 			default:
@@ -238,6 +217,9 @@ namespace QuasarEngine
 			}
 		}
 
+		UploadStreamedAssets();
+		BindMeshes();
+
 		while (!m_AssetsToUpdate.empty())
 		{
 			AssetToLoad asset = m_AssetsToUpdate.front();
@@ -310,6 +292,293 @@ namespace QuasarEngine
 		}
 	}
 
+	void AssetManager::StartStreaming(AssetToLoad asset)
+	{
+		auto job = std::make_shared<StreamingAsset>();
+		job->asset = std::move(asset);
+
+		if (std::holds_alternative<TextureSpecification>(job->asset.spec))
+			job->spec = std::get<TextureSpecification>(job->asset.spec);
+
+		{
+			std::lock_guard<std::mutex> lock(m_AssetMutex);
+			job->generation = ++m_NextGeneration;
+			m_LoadStates[job->asset.id] = { AssetLoadState::Queued, job->generation };
+		}
+
+		// Caller memory is only guaranteed until this Update returns, it is copied here.
+		if (job->asset.data && job->asset.type == AssetType::TEXTURE)
+		{
+			const auto* begin = static_cast<const std::uint8_t*>(job->asset.data);
+			if (!job->spec.compressed)
+			{
+				job->pixels.assign(begin, begin + job->asset.size);
+				job->decoded = true;
+
+				AdvanceLoadState(*job, AssetLoadState::Uploading);
+				std::lock_guard<std::mutex> lock(m_UploadMutex);
+				m_AssetsToUpload.push_back(std::move(job));
+				return;
+			}
+
+			job->bytes.assign(begin, begin + job->asset.size);
+			job->asset.data = nullptr;
+
+			++m_StreamingJobs;
+			JobSystem::Instance().Submit(JobPriority::NORMAL, JobPoolType::GENERAL, [this, job]() { DecodeStreamingAsset(job); });
+			return;
+		}
+
+		// Assimp resolves the files a model references itself, so models skip the read stage.
+		++m_StreamingJobs;
+		if (job->asset.type == AssetType::MODEL)
+		{
+			JobSystem::Instance().Submit(JobPriority::NORMAL, JobPoolType::GENERAL, [this, job]() { DecodeStreamingAsset(job); });
+			return;
+		}
+
+		JobSystem::Instance().Submit(JobPriority::NORMAL, JobPoolType::IO, [this, job]()
+			{
+				QE_PROFILE_SCOPE("AssetManager::Read");
+
+				// A baked KTX2 next to the source replaces both the read and the decode. One that is
+				// older than the source or was baked for another spec is baked again here.
+				if (job->asset.type == AssetType::TEXTURE && job->spec.compressed)
+				{
+					const auto baked = TextureCompression::GetCompressedPath(job->asset.path);
+					job->hasCompressed = TextureCompression::IsUpToDate(job->asset.path, baked)
+						&& TextureCompression::LoadKtx2(baked, job->compressed)
+						&& TextureCompression::MatchesSpecification(job->compressed, job->asset.path, job->spec);
+
+					std::error_code ec;
+					if (!job->hasCompressed && std::filesystem::exists(baked, ec))
+					{
+						job->hasCompressed = TextureCompression::CompressFile(job->asset.path, baked, job->spec)
+							&& TextureCompression::LoadKtx2(baked, job->compressed);
+					}
+				}
+
+				if (!job->hasCompressed)
+					job->bytes = FileUtils::ReadFileBinary(job->asset.path);
+
+				JobSystem::Instance().Submit(JobPriority::NORMAL, JobPoolType::GENERAL, [this, job]() { DecodeStreamingAsset(job); });
+			});
+	}
+
+	void AssetManager::DecodeStreamingAsset(const std::shared_ptr<StreamingAsset>& job)
+	{
+		QE_PROFILE_FUNCTION();
+
+		AdvanceLoadState(*job, AssetLoadState::Decoding);
+
+		try
+		{
+			if (job->asset.type == AssetType::TEXTURE)
+			{
+				// Float and HDR images keep the backend decode path, on the main thread.
+				const int size = static_cast<int>(job->bytes.size());
+				if (!job->bytes.empty() && !job->spec.is_float() && !stbi_is_hdr_from_memory(job->bytes.data(), size))
+				{
+					stbi_set_flip_vertically_on_load_thread(job->spec.flip);
+
+					const int desired = static_cast<int>(job->spec.decode_channels());
+					int w = 0, h = 0, n = 0;
+					unsigned char* decoded = stbi_load_from_memory(job->bytes.data(), size, &w, &h, &n, desired);
+					if (decoded)
+					{
+						job->spec.width = static_cast<uint32_t>(w);
+						job->spec.height = static_cast<uint32_t>(h);
+						job->spec.channels = static_cast<uint32_t>(desired > 0 ? desired : n);
+
+						job->pixels.assign(decoded, decoded + static_cast<size_t>(w) * h * job->spec.channels);
+						job->decoded = true;
+						stbi_image_free(decoded);
+
+						std::vector<std::uint8_t>().swap(job->bytes);
+					}
+				}
+			}
+			else if (job->asset.type == AssetType::MODEL)
+			{
+				std::cout << "[AssetManager] Loading MODEL '" << job->asset.id << "'...\n";
+
+				if (std::holds_alternative<ModelImportOptions>(job->asset.spec))
+					job->model = Model::ImportModel(job->asset.path, &std::get<ModelImportOptions>(job->asset.spec));
+				else
+					job->model = Model::ImportModel(job->asset.path);
+			}
+
+			AdvanceLoadState(*job, AssetLoadState::Uploading);
+			{
+				std::lock_guard<std::mutex> lock(m_UploadMutex);
+				m_AssetsToUpload.push_back(job);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			Q_ERROR("AssetManager: decoding '" + job->asset.id + "' failed: " + e.what());
+			AdvanceLoadState(*job, AssetLoadState::Failed);
+		}
+
+		--m_StreamingJobs;
+	}
+
+	void AssetManager::UploadStreamedAssets()
+	{
+		QE_PROFILE_FUNCTION();
+
+		const auto begin = std::chrono::steady_clock::now();
+		bool first = true;
+
+		while (first || std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() < m_UploadBudgetMs)
+		{
+			if (!m_CurrentUpload)
+			{
+				std::lock_guard<std::mutex> lock(m_UploadMutex);
+				if (m_AssetsToUpload.empty())
+					break;
+
+				m_CurrentUpload = std::move(m_AssetsToUpload.front());
+				m_AssetsToUpload.pop_front();
+			}
+
+			first = false;
+
+			if (FinishUpload(*m_CurrentUpload))
+				m_CurrentUpload.reset();
+		}
+	}
+
+	bool AssetManager::FinishUpload(StreamingAsset& job)
+	{
+		// Unloaded, or unloaded and requested again, since this job started: nothing to upload.
+		{
+			std::lock_guard<std::mutex> lock(m_AssetMutex);
+			auto it = m_LoadStates.find(job.asset.id);
+			if (it == m_LoadStates.end() || it->second.generation != job.generation)
+				return true;
+		}
+
+		std::shared_ptr<Asset> result;
+
+		if (job.asset.type == AssetType::TEXTURE)
+		{
+			// The read stage got nothing: no texture is created and the asset never turns Ready.
+			if (!job.decoded && !job.hasCompressed && job.bytes.empty())
+			{
+				Q_ERROR("AssetManager: TEXTURE '" + job.asset.id + "' error, failed to read " + job.asset.path);
+				AdvanceLoadState(job, AssetLoadState::Failed);
+				return true;
+			}
+
+			auto texture = Texture2D::Create(job.spec);
+
+			// Baked mips go up as they are; backends without BC support decode the source instead.
+			if (!job.hasCompressed || !texture->LoadCompressed(job.compressed))
+			{
+				if (job.decoded)
+					texture->LoadFromData({ job.pixels.data(), job.pixels.size() });
+				else if (!job.bytes.empty())
+					texture->LoadFromMemory({ job.bytes.data(), job.bytes.size() });
+				else
+					texture->LoadFromPath(job.asset.path);
+
+				texture->GenerateMips();
+			}
+
+			result = std::move(texture);
+		}
+		else if (job.asset.type == AssetType::MODEL)
+		{
+			if (!job.model->UploadPendingMeshes(ModelUploadBatch))
+				return false;
+
+			result = job.model;
+		}
+
+		std::lock_guard<std::mutex> lock(m_AssetMutex);
+		auto it = m_LoadStates.find(job.asset.id);
+		if (it != m_LoadStates.end() && it->second.generation == job.generation)
+		{
+			m_LoadedAssets[job.asset.id] = std::move(result);
+			it->second.state = AssetLoadState::Ready;
+		}
+		return true;
+	}
+
+	void AssetManager::BindMeshes()
+	{
+		for (auto it = m_MeshBindings.begin(); it != m_MeshBindings.end();)
+		{
+			const AssetLoadState state = GetLoadState(it->id);
+			if (state == AssetLoadState::Queued || state == AssetLoadState::Decoding || state == AssetLoadState::Uploading)
+			{
+				++it;
+				continue;
+			}
+
+			// The entity may have been destroyed, or lost its mesh, since the scene queued it.
+			const Entity entity = std::any_cast<Entity>(it->handle);
+			auto* mc = entity.IsValid() ? entity.GetRegistry()->GetRegistry().try_get<MeshComponent>(entity) : nullptr;
+			if (mc && state == AssetLoadState::Ready)
+			{
+				std::shared_ptr<Model> model = getAsset<Model>(it->id);
+				if (model)
+				{
+					auto meshPtr = model->FindMeshByInstanceName(mc->GetName());
+					//auto meshPtr = model->FindMeshByPathAndName(mc->GetNodePath(), mc->GetName());
+					if (meshPtr)
+					{
+						mc->m_Mesh = meshPtr.get();
+					}
+					else
+					{
+						Q_ERROR("AssetManager: MESH instance '" + mc->GetName() + "' missing on '" + it->id + "'");
+					}
+				}
+			}
+
+			it = m_MeshBindings.erase(it);
+		}
+	}
+
+	void AssetManager::CancelMeshBindings(const Registry* registry)
+	{
+		auto bound = [registry](const AssetToLoad& asset)
+			{
+				return asset.type == AssetType::MESH && std::any_cast<Entity>(asset.handle).GetRegistry() == registry;
+			};
+
+		m_MeshBindings.erase(std::remove_if(m_MeshBindings.begin(), m_MeshBindings.end(), bound), m_MeshBindings.end());
+
+		std::queue<AssetToLoad> pending;
+		while (!m_AssetsToLoad.empty())
+		{
+			if (!bound(m_AssetsToLoad.front()))
+				pending.push(std::move(m_AssetsToLoad.front()));
+			m_AssetsToLoad.pop();
+		}
+		m_AssetsToLoad = std::move(pending);
+	}
+
+	void AssetManager::AdvanceLoadState(const StreamingAsset& job, AssetLoadState state)
+	{
+		std::lock_guard<std::mutex> lock(m_AssetMutex);
+		auto it = m_LoadStates.find(job.asset.id);
+		if (it != m_LoadStates.end() && it->second.generation == job.generation)
+			it->second.state = state;
+	}
+
+	AssetLoadState AssetManager::GetLoadState(const std::string& id) const
+	{
+		std::lock_guard<std::mutex> lock(m_AssetMutex);
+		if (m_LoadedAssets.find(id) != m_LoadedAssets.end())
+			return AssetLoadState::Ready;
+
+		auto it = m_LoadStates.find(id);
+		return it != m_LoadStates.end() ? it->second.state : AssetLoadState::None;
+	}
+
 	void AssetManager::loadAsset(AssetToLoad asset)
 	{
 		if (!asset.data && asset.path.empty())
@@ -399,41 +668,8 @@ namespace QuasarEngine
 			}
 		}
 
-		JobSystem::Instance().Submit(
-			JobPriority::HIGH,
-			JobPoolType::IO,
-			[this, asset]()
-			{
-				if (asset.type != AssetType::TEXTURE)
-					return;
-
-				if (isAssetLoaded(asset.id))
-					return;
-
-				TextureSpecification spec;
-				if (std::holds_alternative<TextureSpecification>(asset.spec))
-					spec = std::get<TextureSpecification>(asset.spec);
-
-				auto texture = Texture2D::Create(spec);
-
-				if (asset.data)
-				{
-					texture->LoadFromMemory({ static_cast<unsigned char*>(asset.data), asset.size });
-				}
-				else
-				{
-					texture->LoadFromPath(asset.path);
-				}
-
-				{
-					std::lock_guard<std::mutex> lock(m_AssetMutex);
-					m_LoadedAssets[asset.id] = std::move(texture);
-				}
-
-				std::cout << "[JOB] Chargement texture : id=" << asset.id
-					<< " path=" << asset.path << std::endl;
-			}
-		);
+		// Decoding already runs on the workers, only the GPU upload stays on the main thread.
+		m_AssetsToLoad.push(asset);
 	}
 
 	AssetType AssetManager::getTypeFromExtention(const std::string& str)
@@ -7,6 +7,10 @@
 #include <any>
 #include <future>
 #include <mutex>
+#include <deque>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
 
 #include "Asset.h"
 #include "AssetRegistry.h"
@@ -20,6 +24,20 @@
 
 namespace QuasarEngine
 {
+	class Registry;
+
+	// Queued: waiting for the IO read, Decoding: decode/import on a worker,
+	// Uploading: waiting for its GPU upload on the main thread.
+	enum class AssetLoadState : uint8_t
+	{
+		None,
+		Queued,
+		Decoding,
+		Uploading,
+		Ready,
+		Failed
+	};
+
 	struct AssetToLoad {
 		std::string id;
 		std::string path;
@@ -29,6 +47,7 @@ namespace QuasarEngine
 		size_t size = 0;
 		void* data = nullptr;
 
+		// MESH: the Entity whose MeshComponent is bound once the model is Ready.
 		std::any handle;
 
 		std::shared_ptr<std::vector<unsigned char>> hold;
@@ -76,7 +95,35 @@ namespace QuasarEngine
 
 		mutable std::mutex m_AssetMutex;
 
+		struct StreamingAsset;
+
+		// Each load gets the next generation; a job only publishes while its id still holds it,
+		// so one that outlived an unload and reload of the same id is dropped.
+		struct LoadStatus
+		{
+			AssetLoadState state = AssetLoadState::None;
+			uint64_t generation = 0;
+		};
+		std::unordered_map<std::string, LoadStatus> m_LoadStates;
+		uint64_t m_NextGeneration = 0;
+
+		std::deque<std::shared_ptr<StreamingAsset>> m_AssetsToUpload;
+		std::shared_ptr<StreamingAsset> m_CurrentUpload;
+		std::mutex m_UploadMutex;
+
+		std::vector<AssetToLoad> m_MeshBindings;
+
+		std::atomic<int> m_StreamingJobs{ 0 };
+		double m_UploadBudgetMs = 4.0;
+
 		AssetType InferTypeFromPath(const std::filesystem::path& p) const;
+
+		void StartStreaming(AssetToLoad asset);
+		void DecodeStreamingAsset(const std::shared_ptr<StreamingAsset>& job);
+		void UploadStreamedAssets();
+		bool FinishUpload(StreamingAsset& job);
+		void BindMeshes();
+		void AdvanceLoadState(const StreamingAsset& job, AssetLoadState state);
 	public:
 		AssetManager();
 		~AssetManager();
@@ -97,12 +144,20 @@ namespace QuasarEngine
 		void updateAsset(AssetToLoad asset);
 		void unloadAsset(std::string id);
 
+		// Drops the mesh bindings still queued for entities of this registry, before it goes away.
+		void CancelMeshBindings(const Registry* registry);
+
 		void instLoadAsset(std::string id, std::shared_ptr<Asset> asset);
 
 		std::shared_ptr<Asset> getAsset(std::string id);
 
 		bool isAssetLoaded(std::string id) const;
 
+		AssetLoadState GetLoadState(const std::string& id) const;
+
+		// Main thread time spent on GPU uploads per Update, at least one upload always runs.
+		void SetUploadBudget(double milliseconds) { m_UploadBudgetMs = milliseconds; }
+
 		template<typename T>
 		std::shared_ptr<T> getAsset(std::string id)
 		{
@@ -5,6 +5,8 @@
 #include "Application.h"
 #include "QuasarEngine/Renderer/Renderer.h"
 #include "QuasarEngine/Core/Logger.h"
+#include "QuasarEngine/Core/Input.h"
+#include "QuasarEngine/Tools/Profiler.h"
 
 #ifndef QE_PROFILE_APP_TIMERS
 #if !defined(NDEBUG)
@@ -119,8 +121,31 @@ namespace QuasarEngine
         const bool capImGui = (m_Specification.ImGuiMaxFPS > 0);
         const double imguiMs = capImGui ? (1000.0 / m_Specification.ImGuiMaxFPS) : 0.0;
 
+        QE_PROFILE_THREAD("Main");
+
+        const bool pipelined = m_Specification.PipelinedFrames;
+        if (pipelined)
+        {
+            m_FrameWorker = std::make_unique<ThreadPool>(1);
+            m_FrameWorker->Enqueue([]() { QE_PROFILE_THREAD("Frame Update"); });
+
+            // The first frame has nothing extracted to draw yet.
+            Input::Update();
+            for (Layer* layer : m_LayerManager)
+            {
+                if (!layer->IsPipelined())
+                    continue;
+
+                layer->OnUpdate(0.0);
+                layer->OnExtract();
+            }
+            ExecuteMainThreadQueue();
+        }
+
         while (m_Running)
         {
+            QE_PROFILE_FRAME();
+
             const auto frameBegin = clock::now();
             const double dt = std::chrono::duration<double>(frameBegin - lastFrameBegin).count();
             lastFrameBegin = frameBegin;
@@ -129,21 +154,83 @@ namespace QuasarEngine
 
 #if QE_PROFILE_APP_TIMERS
             ApplicationInfos nextInfos{};
+            nextInfos.pipelined = pipelined;
+#endif
+
+            // Sampled here, on the main thread, before any update of this frame starts.
+            Input::Update();
+
+            if (pipelined)
+            {
+#if QE_PROFILE_APP_TIMERS
+                clock::time_point updateBegin{}, updateEnd{};
 #endif
+                std::future<void> update = m_FrameWorker->Enqueue([&]() {
+#if QE_PROFILE_APP_TIMERS
+                    updateBegin = clock::now();
+#endif
+                    QE_PROFILE_SCOPE("Layers::Update");
+                    for (Layer* layer : m_LayerManager)
+                    {
+                        if (layer->IsPipelined())
+                            layer->OnUpdate(deltaTime);
+                    }
+#if QE_PROFILE_APP_TIMERS
+                    updateEnd = clock::now();
+#endif
+                    });
+
+#if QE_PROFILE_APP_TIMERS
+                auto r0 = clock::now();
+#endif
+                {
+                    QE_PROFILE_SCOPE("Layers::Render");
+                    for (Layer* layer : m_LayerManager)
+                    {
+                        if (layer->IsPipelined())
+                            layer->OnRender();
+                    }
+                }
+#if QE_PROFILE_APP_TIMERS
+                auto r1 = clock::now();
+#endif
+                {
+                    QE_PROFILE_SCOPE("Layers::WaitUpdate");
+                    update.get();
+                }
+#if QE_PROFILE_APP_TIMERS
+                auto r2 = clock::now();
+                nextInfos.update_latency += std::chrono::duration<double, std::milli>(updateEnd - updateBegin).count();
+                nextInfos.render_latency += std::chrono::duration<double, std::milli>(r1 - r0).count();
+                nextInfos.wait_latency = std::chrono::duration<double, std::milli>(r2 - r1).count();
+
+                const auto overlapBegin = std::max(updateBegin, r0);
+                const auto overlapEnd = std::min(updateEnd, r1);
+                if (overlapEnd > overlapBegin)
+                    nextInfos.overlap_latency = std::chrono::duration<double, std::milli>(overlapEnd - overlapBegin).count();
+#endif
+            }
 
             for (Layer* layer : m_LayerManager)
             {
+                if (pipelined && layer->IsPipelined())
+                    continue;
+
 #if QE_PROFILE_APP_TIMERS
                 auto t0 = clock::now();
 #endif
+                QE_PROFILE_SCOPE("Layer");
                 layer->OnUpdate(deltaTime);
 #if QE_PROFILE_APP_TIMERS
                 auto t1 = clock::now();
                 nextInfos.update_latency += std::chrono::duration<double, std::milli>(t1 - t0).count();
 #endif
 
+                layer->OnExtract();
+
 #if QE_PROFILE_APP_TIMERS
                 auto t2 = clock::now();
+                nextInfos.extract_latency += std::chrono::duration<double, std::milli>(t2 - t1).count();
 #endif
                 layer->OnRender();
 #if QE_PROFILE_APP_TIMERS
@@ -155,7 +242,10 @@ namespace QuasarEngine
 #if QE_PROFILE_APP_TIMERS
             auto tb0 = clock::now();
 #endif
-            m_Window->BeginFrame();
+            {
+                QE_PROFILE_SCOPE("Window::BeginFrame");
+                m_Window->BeginFrame();
+            }
 #if QE_PROFILE_APP_TIMERS
             auto tb1 = clock::now();
             nextInfos.begin_latency = std::chrono::duration<double, std::milli>(tb1 - tb0).count();
@@ -168,6 +258,7 @@ namespace QuasarEngine
 #if QE_PROFILE_APP_TIMERS
                 auto ti0 = clock::now();
 #endif
+                QE_PROFILE_SCOPE("ImGui");
                 m_ImGuiLayer->Begin();
                 for (Layer* layer : m_LayerManager)
                     layer->OnGuiRender();
@@ -182,7 +273,10 @@ namespace QuasarEngine
 #if QE_PROFILE_APP_TIMERS
             auto te0 = clock::now();
 #endif
-            m_Window->EndFrame();
+            {
+                QE_PROFILE_SCOPE("Window::EndFrame");
+                m_Window->EndFrame();
+            }
 #if QE_PROFILE_APP_TIMERS
             auto te1 = clock::now();
             nextInfos.end_latency = std::chrono::duration<double, std::milli>(te1 - te0).count();
@@ -192,27 +286,30 @@ namespace QuasarEngine
             auto tev0 = clock::now();
 #endif
 
-            switch (m_Specification.EventMode)
             {
-            case ApplicationSpecification::EventPumpMode::Poll:
-                m_Window->PollEvents();
-                break;
-            case ApplicationSpecification::EventPumpMode::Wait:
-                if (m_Window->WaitEventsTimeout(m_Specification.EventWaitTimeoutSec) == false)
+                QE_PROFILE_SCOPE("Events");
+                switch (m_Specification.EventMode)
+                {
+                case ApplicationSpecification::EventPumpMode::Poll:
                     m_Window->PollEvents();
-                break;
-            case ApplicationSpecification::EventPumpMode::Adaptive:
-            default:
-            {
-                if (capFps) {
+                    break;
+                case ApplicationSpecification::EventPumpMode::Wait:
                     if (m_Window->WaitEventsTimeout(m_Specification.EventWaitTimeoutSec) == false)
                         m_Window->PollEvents();
+                    break;
+                case ApplicationSpecification::EventPumpMode::Adaptive:
+                default:
+                {
+                    if (capFps) {
+                        if (m_Window->WaitEventsTimeout(m_Specification.EventWaitTimeoutSec) == false)
+                            m_Window->PollEvents();
+                    }
+                    else {
+                        m_Window->PollEvents();
+                    }
+                    break;
                 }
-                else {
-                    m_Window->PollEvents();
                 }
-                break;
-            }
             }
 
 #if QE_PROFILE_APP_TIMERS
@@ -229,6 +326,26 @@ namespace QuasarEngine
             nextInfos.asset_latency = std::chrono::duration<double, std::milli>(ta1 - ta0).count();
 #endif
 
+            ExecuteMainThreadQueue();
+
+            // Nothing runs on the worker here: copy frame N+1 for the next iteration to draw.
+            if (pipelined)
+            {
+#if QE_PROFILE_APP_TIMERS
+                auto tx0 = clock::now();
+#endif
+                QE_PROFILE_SCOPE("Layers::Extract");
+                for (Layer* layer : m_LayerManager)
+                {
+                    if (layer->IsPipelined())
+                        layer->OnExtract();
+                }
+#if QE_PROFILE_APP_TIMERS
+                auto tx1 = clock::now();
+                nextInfos.extract_latency += std::chrono::duration<double, std::milli>(tx1 - tx0).count();
+#endif
+            }
+
             const auto frameEnd = clock::now();
             const double frameTimeMs = dmsec(frameEnd - frameBegin).count();
 
@@ -252,10 +369,30 @@ namespace QuasarEngine
 #endif
         }
 
+        m_FrameWorker.reset();
+
         for (Layer* layer : m_LayerManager)
             layer->OnDetach();
     }
 
+	void Application::SubmitToMainThread(std::function<void()> function)
+	{
+		std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
+		m_MainThreadQueue.emplace_back(std::move(function));
+	}
+
+	void Application::ExecuteMainThreadQueue()
+	{
+		std::vector<std::function<void()>> queue;
+		{
+			std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
+			std::swap(queue, m_MainThreadQueue);
+		}
+
+		for (auto& function : queue)
+			function();
+	}
+
 	void Application::CalculPerformance(double frameTimeMs)
 	{
 		using clock = std::chrono::steady_clock;
@@ -9,6 +9,10 @@
 #include "QuasarEngine/ImGui/ImGuiLayer.h"
 #include "QuasarEngine/Renderer/Renderer.h"
 #include <QuasarEngine/Events/MouseEvent.h>
+#include <QuasarEngine/Thread/ThreadPool.h>
+
+#include <functional>
+#include <mutex>
 
 int main(int argc, char** argv);
 
@@ -42,6 +46,9 @@ namespace QuasarEngine
 		enum class EventPumpMode { Poll, Wait, Adaptive };
 		EventPumpMode EventMode = EventPumpMode::Adaptive;
 		double EventWaitTimeoutSec = 0.01;
+
+		// Update frame N+1 of the pipelined layers on a worker while frame N is rendered.
+		bool   PipelinedFrames = false;
 	};
 
 	struct ApplicationInfos
@@ -51,6 +58,11 @@ namespace QuasarEngine
 		double app_latency = 0.0;
 
 		double begin_latency = 0, update_latency = 0, render_latency = 0, end_latency = 0, event_latency = 0, asset_latency = 0, imgui_latency = 0;
+
+		// Pipelined frames: extract copies, wait is the main thread blocked on the update,
+		// overlap the time update and render really ran together.
+		bool pipelined = false;
+		double extract_latency = 0, wait_latency = 0, overlap_latency = 0;
 	};
 
 	class Application
@@ -76,12 +88,16 @@ namespace QuasarEngine
 		const ApplicationInfos& GetAppInfos() const { return m_appInfos; }
 
 		void Close();
+
+		// Runs at the end of the frame on the main thread, for window calls made from an update.
+		void SubmitToMainThread(std::function<void()> function);
 	private:
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
 		bool OnMouseMove(MouseMovedEvent& e);
 
 		void CalculPerformance(double frameTimeMs);
+		void ExecuteMainThreadQueue();
 	private:
 		ApplicationSpecification m_Specification;
 
@@ -100,6 +116,11 @@ namespace QuasarEngine
 		std::unique_ptr<Window> m_Window;
 		std::unique_ptr<ImGuiLayer> m_ImGuiLayer;
 		LayerManager m_LayerManager;
+
+		std::unique_ptr<ThreadPool> m_FrameWorker;
+
+		std::mutex m_MainThreadQueueMutex;
+		std::vector<std::function<void()>> m_MainThreadQueue;
 	};
 
 	Application* CreateApplication(ApplicationCommandLineArgs args);
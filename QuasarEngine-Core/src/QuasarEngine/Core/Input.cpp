@@ -9,6 +9,8 @@
 namespace QuasarEngine {
 	std::unordered_map<KeyCode, bool> Input::s_KeyStates;
 	std::unordered_map<KeyCode, bool> Input::s_KeyPressedThisFrame;
+	std::array<bool, Input::MouseButtonCount> Input::s_MouseButtons{};
+	glm::vec2 Input::s_MousePosition{ 0.0f };
 
 	bool Input::IsKeyPressed(const KeyCode key)
 	{
@@ -22,18 +24,13 @@ namespace QuasarEngine {
 
 	bool Input::IsMouseButtonPressed(const MouseCode button)
 	{
-		auto* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		auto state = glfwGetMouseButton(window, static_cast<int32_t>(button));
-		return state == GLFW_PRESS;
+		const auto index = static_cast<std::size_t>(button);
+		return index < s_MouseButtons.size() && s_MouseButtons[index];
 	}
 
 	glm::vec2 Input::GetMousePosition()
 	{
-		auto* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		double xpos, ypos;
-		glfwGetCursorPos(window, &xpos, &ypos);
-
-		return { (float)xpos, (float)ypos };
+		return s_MousePosition;
 	}
 
 	float Input::GetMouseX()
@@ -62,5 +59,13 @@ namespace QuasarEngine {
 
 			s_KeyStates[key] = isDown;
 		}
+
+		// GLFW state may only be read on the main thread, updates read this copy.
+		for (std::size_t button = 0; button < s_MouseButtons.size(); ++button)
+			s_MouseButtons[button] = glfwGetMouseButton(window, static_cast<int>(button)) == GLFW_PRESS;
+
+		double xpos, ypos;
+		glfwGetCursorPos(window, &xpos, &ypos);
+		s_MousePosition = { (float)xpos, (float)ypos };
 	}
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <unordered_map>
+
 namespace QuasarEngine {
 	class Input
 	{
@@ -18,10 +21,15 @@ namespace QuasarEngine {
 		static float GetMouseX();
 		static float GetMouseY();
 
+		// Called by the application on the main thread once per frame, before the updates.
 		static void Update();
 
 	private:
+		static constexpr std::size_t MouseButtonCount = 8;
+
 		static std::unordered_map<KeyCode, bool> s_KeyStates;
 		static std::unordered_map<KeyCode, bool> s_KeyPressedThisFrame;
+		static std::array<bool, MouseButtonCount> s_MouseButtons;
+		static glm::vec2 s_MousePosition;
 	};
 }
\ No newline at end of file
@@ -12,9 +12,16 @@ namespace QuasarEngine
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 		virtual void OnUpdate(double dt) {}
+		// Main thread, once OnUpdate is done and before OnRender: copy what OnRender reads,
+		// so a pipelined layer can update the next frame while this one is drawn.
+		virtual void OnExtract() {}
 		virtual void OnRender() {}
 		virtual void OnGuiRender() {}
 		virtual void OnEvent(Event& event) {}
+
+		// With ApplicationSpecification::PipelinedFrames, OnUpdate runs on the frame worker next to
+		// the previous frame's OnRender. OnRender must then only read what OnExtract copied.
+		virtual bool IsPipelined() const { return false; }
 	protected:
 		std::string m_Name;
 	};
@@ -64,6 +64,7 @@ namespace QuasarEngine
         case RendererAPI::API::OpenGL:
             glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
             break;
+        case RendererAPI::API::None:
         case RendererAPI::API::Vulkan:
         case RendererAPI::API::DirectX:
             glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
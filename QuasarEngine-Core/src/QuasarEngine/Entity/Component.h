@@ -6,13 +6,19 @@ namespace QuasarEngine
 {
 	class Registry;
 
+	// Tag base for everything stored in the registry. It carries no state and no vtable, so
+	// components stay plain data and pack tightly in their pools; systems that need the owner
+	// receive the entity alongside the component.
 	class Component
 	{
+	};
+
+	// For the few components that call back into their owner on their own (physics actors,
+	// scripts, chunks). Entity::AddComponent fills the handle in after the component is stored.
+	class EntityBoundComponent : public Component
+	{
 	public:
 		entt::entity entt_entity{ entt::null };
-		Registry* registry;
-
-		Component() : registry(nullptr){}
-		virtual ~Component() {}
+		Registry* registry = nullptr;
 	};
 }
\ No newline at end of file
@@ -80,4 +80,14 @@ namespace QuasarEngine
         m_Mesh = new Mesh(vertices, indices, layout, drawMode);
         m_OwnsMesh = true;
     }
+
+    void MeshComponent::GenerateMesh(const void* vertexData, uint32_t vertexCount, const BufferLayout& layout,
+        const std::vector<unsigned int>& indices, MeshVertexFormat format,
+        const glm::vec3& boundsPosition, const glm::vec3& boundsSize)
+    {
+        releaseOwnedMesh();
+
+        m_Mesh = new Mesh(vertexData, vertexCount, layout, indices, format, boundsPosition, boundsSize);
+        m_OwnsMesh = true;
+    }
 }
\ No newline at end of file
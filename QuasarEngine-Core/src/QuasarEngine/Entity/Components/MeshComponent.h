@@ -19,7 +19,7 @@ namespace QuasarEngine
         MeshComponent();
         MeshComponent(std::string name, Mesh* mesh, std::string modelPath);
         explicit MeshComponent(std::string name);
-        ~MeshComponent() override;
+        ~MeshComponent();
 
         MeshComponent(const MeshComponent&) = delete;
         MeshComponent& operator=(const MeshComponent&) = delete;
@@ -53,6 +53,9 @@ namespace QuasarEngine
             std::vector<unsigned int>& indices,
             std::optional<BufferLayout> layout = {},
             DrawMode drawMode = DrawMode::TRIANGLES);
+        void GenerateMesh(const void* vertexData, uint32_t vertexCount, const BufferLayout& layout,
+            const std::vector<unsigned int>& indices, MeshVertexFormat format,
+            const glm::vec3& boundsPosition, const glm::vec3& boundsSize);
 
         void SetMesh(Mesh* mesh) { releaseOwnedMesh(); m_Mesh = mesh; m_OwnsMesh = false; }
 
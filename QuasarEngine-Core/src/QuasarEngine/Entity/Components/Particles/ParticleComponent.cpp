@@ -7,9 +7,6 @@
 
 #include <QuasarEngine/Renderer/RenderContext.h>
 
-#include <QuasarEngine/Entity/Entity.h>
-#include <QuasarEngine/Entity/Components/TransformComponent.h>
-
 namespace QuasarEngine
 {
     ParticleComponent::ParticleComponent()
@@ -145,7 +142,7 @@ namespace QuasarEngine
         m_System->Emit(p);
     }
 
-    void ParticleComponent::Update(float dt)
+    void ParticleComponent::Update(float dt, const glm::vec3& ownerPosition)
     {
         if (!m_System || !m_Enabled)
             return;
@@ -165,9 +162,7 @@ namespace QuasarEngine
             m_System->SetSimulationSettings(s);
         }
 
-		Entity owner{ entt_entity, registry };
-        glm::vec3 worldEmitterPos = owner.GetComponent<TransformComponent>().Position;
-        worldEmitterPos += m_EmitterOffset;
+        glm::vec3 worldEmitterPos = ownerPosition + m_EmitterOffset;
 
         if (m_Emitting && m_SpawnRate > 0.0f)
         {
@@ -193,6 +188,14 @@ namespace QuasarEngine
         m_System->Update(dt);
     }
 
+    void ParticleComponent::Extract()
+    {
+        if (!m_System || !m_Enabled)
+            return;
+
+        m_System->Extract();
+    }
+
     void ParticleComponent::Render(RenderContext& ctx)
     {
         if (!m_System || !m_Enabled)
@@ -23,7 +23,9 @@ namespace QuasarEngine
         void ClearTexture();
         void RebuildSystem();
 
-        void Update(float dt);
+        // The owner's position comes from the caller; the component keeps no handle back to it.
+        void Update(float dt, const glm::vec3& ownerPosition);
+        void Extract();
         void Render(RenderContext& ctx);
 
         bool m_Enabled = true;
@@ -4,7 +4,7 @@
 
 namespace QuasarEngine
 {
-    class PrimitiveColliderComponent : public Component
+    class PrimitiveColliderComponent : public EntityBoundComponent
     {
     public:
         float mass = 1.0f;
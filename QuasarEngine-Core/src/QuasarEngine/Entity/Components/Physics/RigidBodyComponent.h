@@ -12,7 +12,7 @@
 
 namespace QuasarEngine
 {
-    class RigidBodyComponent : public Component
+    class RigidBodyComponent : public EntityBoundComponent
     {
     public:
         std::string bodyTypeString = "DYNAMIC";
@@ -32,7 +32,7 @@ namespace QuasarEngine
         float density = 10.f;
 
         RigidBodyComponent();
-        ~RigidBodyComponent() override;
+        ~RigidBodyComponent();
 
         RigidBodyComponent(const RigidBodyComponent& other);
         RigidBodyComponent& operator=(const RigidBodyComponent& other);
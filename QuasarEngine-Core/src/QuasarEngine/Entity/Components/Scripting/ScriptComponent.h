@@ -8,7 +8,7 @@
 
 namespace QuasarEngine
 {
-    class ScriptComponent : public Component 
+    class ScriptComponent : public EntityBoundComponent 
 	{
 	public:
 		ScriptComponent();
@@ -1,6 +1,7 @@
 #include "qepch.h"
 #include "TransformComponent.h"
 #include "HierarchyComponent.h"
+#include "WorldTransformComponent.h"
 
 #include <QuasarEngine/Entity/Entity.h>
 #include <QuasarEngine/Renderer/Renderer.h>
@@ -21,11 +22,20 @@ namespace QuasarEngine
 		return glm::translate(glm::mat4(1.0f), Position) * glm::toMat4(glm::quat(Rotation)) * glm::scale(glm::mat4(1.0f), Scale);
 	}
 
-	glm::mat4 TransformComponent::GetGlobalTransform() const
+	glm::mat4 TransformComponent::GetGlobalTransform(Entity entity) const
 	{
+		if (!entity.IsValid())
+			return GetLocalTransform();
+
+		auto& reg = entity.GetRegistry()->GetRegistry();
+		// The world matrix of the last TransformSystem pass. Edits made since then are picked up by
+		// the pass the renderer runs before it syncs (Scene::UpdateWorldTransforms), not here.
+		if (const auto* world = reg.try_get<WorldTransformComponent>(static_cast<entt::entity>(entity)); world && world->Valid)
+			return world->World;
+
+		// Not seen by a pass yet: compose the hierarchy by hand.
 		glm::mat4 globalTransform = GetLocalTransform();
 
-		Entity entity{ entt_entity, registry };
 		UUID parentID = (entity.HasComponent<HierarchyComponent>()) ? entity.GetComponent<HierarchyComponent>().m_Parent : UUID::Null();
 
 		while (parentID != UUID::Null())
@@ -74,9 +84,9 @@ namespace QuasarEngine
 		return CalculateViewMatrix(GetLocalTransform());
 	}
 
-	glm::mat4 TransformComponent::GetGlobalViewMatrix() const
+	glm::mat4 TransformComponent::GetGlobalViewMatrix(Entity entity) const
 	{
 		//return glm::inverse(GetGlobalTransform());
-		return CalculateViewMatrix(GetGlobalTransform());
+		return CalculateViewMatrix(GetGlobalTransform(entity));
 	}
 }
\ No newline at end of file
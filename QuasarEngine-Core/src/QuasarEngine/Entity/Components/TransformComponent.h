@@ -6,6 +6,8 @@
 
 namespace QuasarEngine
 {
+	class Entity;
+
 	class TransformComponent : public Component
 	{
 	private:
@@ -22,10 +24,11 @@ namespace QuasarEngine
 		void SetRotation(const glm::vec3& rotation) { Rotation = rotation; }
 		void SetScale(const glm::vec3& scale) { Scale = scale; }
 
-		glm::mat4 GetGlobalTransform() const;
+		// The owner is passed in rather than stored, so the component stays three vectors wide.
+		glm::mat4 GetGlobalTransform(Entity entity) const;
 		glm::mat4 GetLocalTransform() const;
 
 		glm::mat4 GetLocalViewMatrix() const;
-		glm::mat4 GetGlobalViewMatrix() const;
+		glm::mat4 GetGlobalViewMatrix(Entity entity) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QuasarEngine/Entity/Component.h>
+#include <QuasarEngine/Core/UUID.h>
+
+#include <glm/glm.hpp>
+
+namespace QuasarEngine
+{
+	class WorldTransformComponent : public Component
+	{
+	public:
+		glm::mat4 World = glm::mat4(1.0f);
+		glm::mat4 Local = glm::mat4(1.0f);
+
+		// Snapshot of the TransformComponent values Local was built from.
+		glm::vec3 CachedPosition = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 CachedRotation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 CachedScale = { 1.0f, 1.0f, 1.0f };
+
+		UUID CachedParent = UUID::Null();
+		entt::entity ParentHandle{ entt::null };
+
+		uint32_t Depth = 0;
+		uint64_t ChangedFrame = 0;
+		bool Dirty = true;
+		bool Valid = false;
+
+		WorldTransformComponent() = default;
+
+		bool Matches(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) const
+		{
+			return Valid && CachedPosition == position && CachedRotation == rotation && CachedScale == scale;
+		}
+	};
+}
\ No newline at end of file
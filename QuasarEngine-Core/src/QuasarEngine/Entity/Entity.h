@@ -1,10 +1,12 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <entt.hpp>
 
 #include <QuasarEngine/ECS/Registry.h>
+#include <QuasarEngine/Entity/Component.h>
 #include <QuasarEngine/Entity/Components/IDComponent.h>
 #include <QuasarEngine/Entity/Components/TagComponent.h>
 
@@ -26,8 +28,7 @@ namespace QuasarEngine
 				return GetComponent<T>();
 
 			T& component = m_Registry->GetRegistry().emplace<T>(m_EntityHandle, std::forward<Args>(args)...);
-			component.entt_entity = m_EntityHandle;
-			component.registry = m_Registry;
+			BindOwner(component);
 			return component;
 		}
 
@@ -35,8 +36,7 @@ namespace QuasarEngine
 		T& AddOrReplaceComponent(Args&&... args)
 		{
 			T& component = m_Registry->GetRegistry().emplace_or_replace<T>(m_EntityHandle, std::forward<Args>(args)...);
-			component.entt_entity = m_EntityHandle;
-			component.registry = m_Registry;
+			BindOwner(component);
 			return component;
 		}
 
@@ -58,6 +58,8 @@ namespace QuasarEngine
 			m_Registry->GetRegistry().remove<T>(m_EntityHandle);
 		}
 
+		Registry* GetRegistry() const { return m_Registry; }
+
 		operator bool() const { return m_EntityHandle != entt::null; }
 		operator entt::entity() const { return m_EntityHandle; }
 		operator uint32_t() const { return (uint32_t)m_EntityHandle; }
@@ -79,6 +81,16 @@ namespace QuasarEngine
 			return !(*this == other);
 		}
 	private:
+		template<typename T>
+		void BindOwner(T& component)
+		{
+			if constexpr (std::is_base_of_v<EntityBoundComponent, T>)
+			{
+				component.entt_entity = m_EntityHandle;
+				component.registry = m_Registry;
+			}
+		}
+
 		entt::entity m_EntityHandle{ entt::null };
 		Registry* m_Registry = nullptr;
 	};
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace QuasarEngine::FileUtils
@@ -18,6 +21,48 @@ namespace QuasarEngine::FileUtils
         return buffer;
     }
 
+    // Writes through a temporary next to path and renames it over path, so a crash or a reader
+    // never sees a truncated file. The temporary is per thread, two writers of the same path
+    // never share one. Returns false, leaving path untouched, when anything fails.
+    inline bool WriteFileAtomic(const std::filesystem::path& path, const std::function<void(std::ofstream&)>& write)
+    {
+        std::error_code ec;
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::filesystem::path temp = path;
+        temp += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+
+            write(out);
+            out.flush();
+            if (!out)
+            {
+                out.close();
+                std::filesystem::remove(temp, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    inline bool WriteFileAtomic(const std::filesystem::path& path, const void* data, size_t size)
+    {
+        return WriteFileAtomic(path, [&](std::ofstream& out) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            });
+    }
+
 	inline std::unique_ptr<unsigned char[]> ReadFileToBuffer(const std::string& path, size_t& outSize)
 	{
 		outSize = 0;
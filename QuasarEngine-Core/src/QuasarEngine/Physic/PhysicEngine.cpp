@@ -8,6 +8,7 @@
 
 #include <QuasarEngine/Entity/Entity.h>
 #include <QuasarEngine/Renderer/Renderer.h>
+#include <QuasarEngine/Tools/Profiler.h>
 
 namespace QuasarEngine
 {
@@ -164,6 +165,8 @@ namespace QuasarEngine
 
     void PhysicEngine::Step(double dt, double fixedTimestep, uint32_t maxSubsteps)
     {
+        QE_PROFILE_FUNCTION();
+
         if (!m_Scene) return;
 
         if (dt < 0.0) dt = 0.0;
@@ -5,6 +5,7 @@
 #include "Platform/Vulkan/VulkanBuffer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
 #include "Platform/DirectX/DirectXBuffer.h"
+#include "Platform/Null/NullBuffer.h"
 
 namespace QuasarEngine
 {
@@ -12,7 +13,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullVertexBuffer>();
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanVertexBuffer>();
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLVertexBuffer>();
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXVertexBuffer>();
@@ -25,7 +26,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullVertexBuffer>(size);
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanVertexBuffer>(size);
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLVertexBuffer>(size);
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXVertexBuffer>(size);
@@ -38,7 +39,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullVertexBuffer>(data, size);
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanVertexBuffer>(data, size);
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLVertexBuffer>(data, size);
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXVertexBuffer>(data, size);
@@ -51,7 +52,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullIndexBuffer>();
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanIndexBuffer>();
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLIndexBuffer>();
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXIndexBuffer>();
@@ -64,7 +65,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullIndexBuffer>(size);
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanIndexBuffer>(size);
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLIndexBuffer>(size);
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXIndexBuffer>(size);
@@ -77,7 +78,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullIndexBuffer>(data, size);
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanIndexBuffer>(data, size);
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLIndexBuffer>(data, size);
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXIndexBuffer>(data, size);
@@ -5,6 +5,7 @@
 #include <Platform/Vulkan/VulkanFramebuffer.h>
 #include <Platform/OpenGL/OpenGLFramebuffer.h>
 #include <Platform/DirectX/DirectXFramebuffer.h>
+#include <Platform/Null/NullFramebuffer.h>
 
 namespace QuasarEngine
 {
@@ -12,7 +13,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullFramebuffer>(spec);
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanFramebuffer>(spec);
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLFramebuffer>(spec);
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXFramebuffer>(spec);
@@ -0,0 +1,148 @@
+#include "qepch.h"
+
+#include <cmath>
+#include <limits>
+
+#include <QuasarEngine/Renderer/FrustumCuller.h>
+#include <QuasarEngine/Resources/Mesh.h>
+#include <QuasarEngine/Thread/JobSystem.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QE_CULLING_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace QuasarEngine
+{
+	namespace
+	{
+		// Skinned meshes only know their bind pose bounds, animation can push vertices past them.
+		constexpr float kSkinnedBoundsScale = 1.5f;
+
+		constexpr std::size_t kCullGrain = 256;
+	}
+
+	std::size_t FrustumCuller::Cull(const glm::mat4& viewProjection, const std::vector<RenderObject>& objects, std::vector<uint8_t>& visible)
+	{
+		const std::size_t count = objects.size();
+
+		m_CenterX.resize(count); m_CenterY.resize(count); m_CenterZ.resize(count);
+		m_ExtentX.resize(count); m_ExtentY.resize(count); m_ExtentZ.resize(count);
+		visible.resize(count);
+
+		if (count == 0)
+			return 0;
+
+		const Math::Frustum frustum = Math::CalculateFrustum(viewProjection);
+
+		JobSystem::Instance().ParallelForRange(count, kCullGrain, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const RenderObject& obj = objects[i];
+					const glm::vec3 size = obj.mesh->GetBoundingBoxSize();
+
+					if (!(size.x >= 0.0f && size.y >= 0.0f && size.z >= 0.0f) || !std::isfinite(size.x + size.y + size.z))
+					{
+						// No usable bounds: never cull.
+						m_CenterX[i] = m_CenterY[i] = m_CenterZ[i] = 0.0f;
+						m_ExtentX[i] = m_ExtentY[i] = m_ExtentZ[i] = std::numeric_limits<float>::max();
+						continue;
+					}
+
+					glm::vec3 half = 0.5f * size;
+					if (HasFlag(obj.flags, RenderFlags::Skinned))
+						half *= kSkinnedBoundsScale;
+
+					const glm::mat4& m = obj.model;
+					const glm::vec3 center = glm::vec3(m * glm::vec4(obj.mesh->GetBoundingBoxPosition() + 0.5f * size, 1.0f));
+					const glm::vec3 extents = glm::abs(glm::vec3(m[0])) * half.x
+						+ glm::abs(glm::vec3(m[1])) * half.y
+						+ glm::abs(glm::vec3(m[2])) * half.z;
+
+					m_CenterX[i] = center.x; m_CenterY[i] = center.y; m_CenterZ[i] = center.z;
+					m_ExtentX[i] = extents.x; m_ExtentY[i] = extents.y; m_ExtentZ[i] = extents.z;
+				}
+
+				TestBounds(frustum,
+					m_CenterX.data() + begin, m_CenterY.data() + begin, m_CenterZ.data() + begin,
+					m_ExtentX.data() + begin, m_ExtentY.data() + begin, m_ExtentZ.data() + begin,
+					end - begin, visible.data() + begin);
+			});
+
+		std::size_t visibleCount = 0;
+		for (uint8_t v : visible)
+			visibleCount += v;
+
+		return visibleCount;
+	}
+
+	void FrustumCuller::TestBounds(const Math::Frustum& frustum,
+		const float* centerX, const float* centerY, const float* centerZ,
+		const float* extentX, const float* extentY, const float* extentZ,
+		std::size_t count, uint8_t* visible)
+	{
+		std::size_t i = 0;
+
+#ifdef QE_CULLING_SSE
+		__m128 nx[6], ny[6], nz[6], ax[6], ay[6], az[6], pd[6];
+		for (int p = 0; p < 6; ++p)
+		{
+			const Math::Plane& plane = frustum.planes[p];
+			nx[p] = _mm_set1_ps(plane.n.x);
+			ny[p] = _mm_set1_ps(plane.n.y);
+			nz[p] = _mm_set1_ps(plane.n.z);
+			ax[p] = _mm_set1_ps(std::abs(plane.n.x));
+			ay[p] = _mm_set1_ps(std::abs(plane.n.y));
+			az[p] = _mm_set1_ps(std::abs(plane.n.z));
+			pd[p] = _mm_set1_ps(plane.d);
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(centerX + i);
+			const __m128 cy = _mm_loadu_ps(centerY + i);
+			const __m128 cz = _mm_loadu_ps(centerZ + i);
+			const __m128 ex = _mm_loadu_ps(extentX + i);
+			const __m128 ey = _mm_loadu_ps(extentY + i);
+			const __m128 ez = _mm_loadu_ps(extentZ + i);
+
+			__m128 outside = _mm_setzero_ps();
+			for (int p = 0; p < 6; ++p)
+			{
+				const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)),
+					_mm_add_ps(_mm_mul_ps(nz[p], cz), pd[p]));
+				const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+					_mm_mul_ps(az[p], ez));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), zero));
+			}
+
+			const int mask = _mm_movemask_ps(outside);
+			visible[i + 0] = (mask & 1) ? 0 : 1;
+			visible[i + 1] = (mask & 2) ? 0 : 1;
+			visible[i + 2] = (mask & 4) ? 0 : 1;
+			visible[i + 3] = (mask & 8) ? 0 : 1;
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			uint8_t inside = 1;
+			for (int p = 0; p < 6; ++p)
+			{
+				const Math::Plane& plane = frustum.planes[p];
+				const float dist = (plane.n.x * centerX[i] + plane.n.y * centerY[i]) + (plane.n.z * centerZ[i] + plane.d);
+				const float radius = std::abs(plane.n.x) * extentX[i] + std::abs(plane.n.y) * extentY[i] + std::abs(plane.n.z) * extentZ[i];
+				if (dist + radius < 0.0f)
+				{
+					inside = 0;
+					break;
+				}
+			}
+			visible[i] = inside;
+		}
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QuasarEngine/Tools/Math.h>
+#include <QuasarEngine/Renderer/RenderObject.h>
+
+namespace QuasarEngine
+{
+	class FrustumCuller
+	{
+	public:
+		// Tests the world-space AABB of each object against the frustum of viewProjection.
+		// visible[i] is set to 1 when objects[i] has to be drawn. Returns the visible count.
+		std::size_t Cull(const glm::mat4& viewProjection, const std::vector<RenderObject>& objects, std::vector<uint8_t>& visible);
+
+		// Structure-of-arrays AABB test (center / half extents), 4 boxes per iteration when SSE is available.
+		static void TestBounds(const Math::Frustum& frustum,
+			const float* centerX, const float* centerY, const float* centerZ,
+			const float* extentX, const float* extentY, const float* extentZ,
+			std::size_t count, uint8_t* visible);
+
+	private:
+		std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+		std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+	};
+}
@@ -5,6 +5,7 @@
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/OpenGL/OpenGLContext.h"
 #include "Platform/DirectX/DirectXContext.h"
+#include "Platform/Null/NullContext.h"
 
 namespace QuasarEngine {
 
@@ -12,7 +13,7 @@ namespace QuasarEngine {
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_unique<NullContext>();
 		case RendererAPI::API::Vulkan:  return std::make_unique<VulkanContext>(static_cast<GLFWwindow*>(window));
 		case RendererAPI::API::OpenGL:  return std::make_unique<OpenGLContext>(static_cast<GLFWwindow*>(window));
 		case RendererAPI::API::DirectX:  return std::make_unique<DirectXContext>(static_cast<GLFWwindow*>(window));
@@ -1,9 +1,9 @@
 #include "qepch.h"
 
+#include <cstring>
+
 #include <QuasarEngine/Renderer/PBRSkinTechnique.h>
 
-#include <QuasarEngine/Entity/Components/Animation/AnimationComponent.h>
-#include <QuasarEngine/Entity/Components/HierarchyComponent.h>
 
 namespace QuasarEngine
 {
@@ -101,27 +101,6 @@ namespace QuasarEngine
 			{"dirLights",		Shader::ShaderUniformType::Unknown, sizeof(DirectionalLight) * 4,	offsetof(GlobalUniforms, dirLights), 0, 0, globalUniformsFlags}
 		};
 
-		struct alignas(16) ObjectUniforms {
-			glm::mat4 model;
-
-			glm::vec4 albedo;
-
-			float roughness;
-			float metallic;
-			float ao;
-
-			int has_albedo_texture;
-			int has_normal_texture;
-			int has_roughness_texture;
-			int has_metallic_texture;
-			int has_ao_texture;
-
-			glm::mat4 finalBonesMatrices[QE_MAX_BONES];
-		};
-
-		static_assert(sizeof(ObjectUniforms) % 16 == 0, "ObjectUniforms must be 16-aligned");
-
-
 		static_assert(sizeof(ObjectUniforms) % 16 == 0, "ObjectUniforms must be 16-aligned");
 
 		constexpr Shader::ShaderStageFlags objectUniformsFlags =
@@ -172,6 +151,17 @@ namespace QuasarEngine
 
 		for (int i = 0; i < QE_MAX_BONES; ++i)
 			m_IdentityBones[i] = glm::mat4(1.0f);
+
+		if (m_Shader)
+		{
+			m_MaterialSamplers = {
+				m_Shader->GetSamplerHandle("albedo_texture"),
+				m_Shader->GetSamplerHandle("normal_texture"),
+				m_Shader->GetSamplerHandle("roughness_texture"),
+				m_Shader->GetSamplerHandle("metallic_texture"),
+				m_Shader->GetSamplerHandle("ao_texture")
+			};
+		}
 	}
 
 	PBRSkinTechnique::~PBRSkinTechnique()
@@ -217,85 +207,35 @@ namespace QuasarEngine
 		if (HasFlag(obj.flags, RenderFlags::PointCloud)) return;
 		if (HasFlag(obj.flags, RenderFlags::Terrain))    return;
 
-		auto FindAnimatorForEntity = [&](Entity e) -> AnimationComponent*
-			{
-				Entity current = e;
-
-				while (current.IsValid())
-				{
-					if (current.HasComponent<AnimationComponent>())
-						return &current.GetComponent<AnimationComponent>();
-
-					if (!current.HasComponent<HierarchyComponent>())
-						break;
-
-					const auto& h = current.GetComponent<HierarchyComponent>();
-					if (h.m_Parent == UUID::Null())
-						break;
-
-					auto parentOpt = ctx.scene->GetEntityByUUID(h.m_Parent);
-					if (!parentOpt.has_value())
-						break;
-
-					current = *parentOpt;
-				}
-
-				return nullptr;
-			};
-
-
 		Material& material = *obj.material;
 
-		m_Shader->SetUniform("model", &obj.model, sizeof(glm::mat4));
-
-		m_Shader->SetUniform("albedo", &material.GetAlbedo(), sizeof(glm::vec4));
-		float rough = material.GetRoughness();
-		float metal = material.GetMetallic();
-		float ao = material.GetAO();
-		m_Shader->SetUniform("roughness", &rough, sizeof(float));
-		m_Shader->SetUniform("metallic", &metal, sizeof(float));
-		m_Shader->SetUniform("ao", &ao, sizeof(float));
-
-		int hasA = material.HasTexture(TextureType::Albedo) ? 1 : 0;
-		int hasN = material.HasTexture(TextureType::Normal) ? 1 : 0;
-		int hasR = material.HasTexture(TextureType::Roughness) ? 1 : 0;
-		int hasM = material.HasTexture(TextureType::Metallic) ? 1 : 0;
-		int hasO = material.HasTexture(TextureType::AO) ? 1 : 0;
-
-		m_Shader->SetUniform("has_albedo_texture", &hasA, sizeof(int));
-		m_Shader->SetUniform("has_normal_texture", &hasN, sizeof(int));
-		m_Shader->SetUniform("has_roughness_texture", &hasR, sizeof(int));
-		m_Shader->SetUniform("has_metallic_texture", &hasM, sizeof(int));
-		m_Shader->SetUniform("has_ao_texture", &hasO, sizeof(int));
-
-		m_Shader->SetTexture("albedo_texture", material.GetTexture(TextureType::Albedo));
-		m_Shader->SetTexture("normal_texture", material.GetTexture(TextureType::Normal));
-		m_Shader->SetTexture("roughness_texture", material.GetTexture(TextureType::Roughness));
-		m_Shader->SetTexture("metallic_texture", material.GetTexture(TextureType::Metallic));
-		m_Shader->SetTexture("ao_texture", material.GetTexture(TextureType::AO));
-
-		m_Shader->SetTexture("irradiance_map", m_Skybox->GetIrradianceMap().get());
-		m_Shader->SetTexture("prefilter_map", m_Skybox->GetPrefilterMap().get());
-		m_Shader->SetTexture("brdf_lut", m_Skybox->GetBrdfLUT().get());
-
-		const AnimationComponent* anim = FindAnimatorForEntity(obj.entity);
-		if (anim && !anim->GetFinalBoneMatrices().empty()) {
-			std::vector<glm::mat4> mats = anim->GetFinalBoneMatrices();
-			const size_t n = std::min(mats.size(), (size_t)QE_MAX_BONES);
-			if (n == (size_t)QE_MAX_BONES) {
-				m_Shader->SetUniform("finalBonesMatrices", mats.data(), sizeof(glm::mat4) * QE_MAX_BONES);
-			}
-			else {
-				std::array<glm::mat4, QE_MAX_BONES> tmp = m_IdentityBones;
-				std::memcpy(tmp.data(), mats.data(), sizeof(glm::mat4) * n);
-				m_Shader->SetUniform("finalBonesMatrices", tmp.data(), sizeof(glm::mat4) * QE_MAX_BONES);
-			}
-		}
-		else {
-			m_Shader->SetUniform("finalBonesMatrices",
-				m_IdentityBones.data(),
-				sizeof(glm::mat4) * QE_MAX_BONES);
-		}
+		ObjectUniforms& data = m_ObjectData;
+		data.model = obj.model;
+		data.albedo = material.GetAlbedo();
+		data.roughness = material.GetRoughness();
+		data.metallic = material.GetMetallic();
+		data.ao = material.GetAO();
+
+		data.has_albedo_texture = material.HasTexture(TextureType::Albedo) ? 1 : 0;
+		data.has_normal_texture = material.HasTexture(TextureType::Normal) ? 1 : 0;
+		data.has_roughness_texture = material.HasTexture(TextureType::Roughness) ? 1 : 0;
+		data.has_metallic_texture = material.HasTexture(TextureType::Metallic) ? 1 : 0;
+		data.has_ao_texture = material.HasTexture(TextureType::AO) ? 1 : 0;
+
+		// Copied from the animator when the scene was synced, never more than QE_MAX_BONES.
+		const size_t boneCount = obj.boneMatrices ? obj.boneCount : 0;
+		if (boneCount > 0)
+			std::memcpy(data.finalBonesMatrices, obj.boneMatrices, sizeof(glm::mat4) * boneCount);
+		if (boneCount < (size_t)QE_MAX_BONES)
+			std::memcpy(data.finalBonesMatrices + boneCount, m_IdentityBones.data() + boneCount, sizeof(glm::mat4) * (QE_MAX_BONES - boneCount));
+
+		m_Shader->SetObjectUniforms(&data, sizeof(ObjectUniforms));
+
+		m_Shader->SetTexture(m_MaterialSamplers[0], material.GetTexture(TextureType::Albedo));
+		m_Shader->SetTexture(m_MaterialSamplers[1], material.GetTexture(TextureType::Normal));
+		m_Shader->SetTexture(m_MaterialSamplers[2], material.GetTexture(TextureType::Roughness));
+		m_Shader->SetTexture(m_MaterialSamplers[3], material.GetTexture(TextureType::Metallic));
+		m_Shader->SetTexture(m_MaterialSamplers[4], material.GetTexture(TextureType::AO));
 
 		m_Shader->UpdateObject(&material);
 
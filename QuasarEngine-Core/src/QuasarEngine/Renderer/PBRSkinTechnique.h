@@ -17,8 +17,29 @@ namespace QuasarEngine
 		void End() override;
 
 	private:
+		struct alignas(16) ObjectUniforms {
+			glm::mat4 model;
+
+			glm::vec4 albedo;
+
+			float roughness;
+			float metallic;
+			float ao;
+
+			int has_albedo_texture;
+			int has_normal_texture;
+			int has_roughness_texture;
+			int has_metallic_texture;
+			int has_ao_texture;
+
+			glm::mat4 finalBonesMatrices[QE_MAX_BONES];
+		};
+
 		std::shared_ptr<Shader> m_Shader;
 		SkyboxHDR* m_Skybox;
 		std::array<glm::mat4, QE_MAX_BONES> m_IdentityBones;
+
+		ObjectUniforms m_ObjectData{};
+		std::array<Shader::SamplerHandle, 5> m_MaterialSamplers{};
 	};
 }
\ No newline at end of file
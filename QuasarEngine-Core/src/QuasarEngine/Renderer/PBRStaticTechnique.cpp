@@ -96,25 +96,6 @@ namespace QuasarEngine
 			{"dirLights",		Shader::ShaderUniformType::Unknown, sizeof(DirectionalLight) * 4,	offsetof(GlobalUniforms, dirLights), 0, 0, globalUniformsFlags}
 		};
 
-		struct alignas(16) ObjectUniforms {
-			glm::mat4 model;
-
-			glm::vec4 albedo;
-
-			float roughness;
-			float metallic;
-			float ao;
-
-			int has_albedo_texture;
-			int has_normal_texture;
-			int has_roughness_texture;
-			int has_metallic_texture;
-			int has_ao_texture;
-		};
-
-		static_assert(sizeof(ObjectUniforms) % 16 == 0, "ObjectUniforms must be 16-aligned");
-
-
 		static_assert(sizeof(ObjectUniforms) % 16 == 0, "ObjectUniforms must be 16-aligned");
 
 		constexpr Shader::ShaderStageFlags objectUniformsFlags =
@@ -137,6 +118,20 @@ namespace QuasarEngine
 			{"has_ao_texture",			Shader::ShaderUniformType::Int,		sizeof(int),		offsetof(ObjectUniforms, has_ao_texture),			1, 0, objectUniformsFlags}
 		};
 
+		// Only the GL shader declares the instance buffer for now, the null backend follows the GL path.
+		m_InstancingSupported = (api == RendererAPI::API::OpenGL || api == RendererAPI::API::None);
+		if (m_InstancingSupported)
+		{
+			desc.objectUniforms.push_back({"use_instancing", Shader::ShaderUniformType::Int, sizeof(int), offsetof(ObjectUniforms, use_instancing), 1, 0, objectUniformsFlags});
+
+			Shader::ShaderStorageBufferDesc instances{};
+			instances.name = "InstanceBuffer";
+			instances.size = sizeof(glm::mat4) * MaxInstancesPerDraw;
+			instances.binding = 3;
+			instances.stages = Shader::StageToBit(Shader::ShaderStageType::Vertex);
+			desc.storageBuffers.push_back(instances);
+		}
+
 		desc.samplers = {
 			{"albedo_texture",   1, 1, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
 			{"normal_texture",   1, 2, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
@@ -160,6 +155,17 @@ namespace QuasarEngine
 		desc.enableDynamicLineWidth = false;
 
 		m_Shader = Shader::Create(desc);
+
+		if (m_Shader)
+		{
+			m_MaterialSamplers = {
+				m_Shader->GetSamplerHandle("albedo_texture"),
+				m_Shader->GetSamplerHandle("normal_texture"),
+				m_Shader->GetSamplerHandle("roughness_texture"),
+				m_Shader->GetSamplerHandle("metallic_texture"),
+				m_Shader->GetSamplerHandle("ao_texture")
+			};
+		}
 	}
 
 	PBRStaticTechnique::~PBRStaticTechnique()
@@ -208,44 +214,41 @@ namespace QuasarEngine
 
 		Material& material = *obj.material;
 
-		m_Shader->SetUniform("model", &obj.model, sizeof(glm::mat4));
-
-		m_Shader->SetUniform("albedo", &material.GetAlbedo(), sizeof(glm::vec4));
-		float rough = material.GetRoughness();
-		float metal = material.GetMetallic();
-		float ao = material.GetAO();
-		m_Shader->SetUniform("roughness", &rough, sizeof(float));
-		m_Shader->SetUniform("metallic", &metal, sizeof(float));
-		m_Shader->SetUniform("ao", &ao, sizeof(float));
-
-		int hasA = material.HasTexture(TextureType::Albedo) ? 1 : 0;
-		int hasN = material.HasTexture(TextureType::Normal) ? 1 : 0;
-		int hasR = material.HasTexture(TextureType::Roughness) ? 1 : 0;
-		int hasM = material.HasTexture(TextureType::Metallic) ? 1 : 0;
-		int hasO = material.HasTexture(TextureType::AO) ? 1 : 0;
-
-		m_Shader->SetUniform("has_albedo_texture", &hasA, sizeof(int));
-		m_Shader->SetUniform("has_normal_texture", &hasN, sizeof(int));
-		m_Shader->SetUniform("has_roughness_texture", &hasR, sizeof(int));
-		m_Shader->SetUniform("has_metallic_texture", &hasM, sizeof(int));
-		m_Shader->SetUniform("has_ao_texture", &hasO, sizeof(int));
-
-		m_Shader->SetTexture("albedo_texture", material.GetTexture(TextureType::Albedo));
-		m_Shader->SetTexture("normal_texture", material.GetTexture(TextureType::Normal));
-		m_Shader->SetTexture("roughness_texture", material.GetTexture(TextureType::Roughness));
-		m_Shader->SetTexture("metallic_texture", material.GetTexture(TextureType::Metallic));
-		m_Shader->SetTexture("ao_texture", material.GetTexture(TextureType::AO));
-
-		m_Shader->SetTexture("irradiance_map", m_Skybox->GetIrradianceMap().get());
-		m_Shader->SetTexture("prefilter_map", m_Skybox->GetPrefilterMap().get());
-		m_Shader->SetTexture("brdf_lut", m_Skybox->GetBrdfLUT().get());
+		const bool instanced = m_InstancingSupported && HasFlag(obj.flags, RenderFlags::Instanced)
+			&& obj.instanceTransforms && obj.instanceCount > 1;
+
+		ObjectUniforms& data = m_ObjectData;
+		data.model = instanced ? obj.instanceTransforms[0] : obj.model;
+		data.albedo = material.GetAlbedo();
+		data.roughness = material.GetRoughness();
+		data.metallic = material.GetMetallic();
+		data.ao = material.GetAO();
+
+		data.has_albedo_texture = material.HasTexture(TextureType::Albedo) ? 1 : 0;
+		data.has_normal_texture = material.HasTexture(TextureType::Normal) ? 1 : 0;
+		data.has_roughness_texture = material.HasTexture(TextureType::Roughness) ? 1 : 0;
+		data.has_metallic_texture = material.HasTexture(TextureType::Metallic) ? 1 : 0;
+		data.has_ao_texture = material.HasTexture(TextureType::AO) ? 1 : 0;
+
+		data.use_instancing = instanced ? 1 : 0;
+
+		m_Shader->SetObjectUniforms(&data, sizeof(ObjectUniforms));
+
+		if (instanced)
+			m_Shader->SetStorageBuffer("InstanceBuffer", obj.instanceTransforms, sizeof(glm::mat4) * obj.instanceCount);
+
+		m_Shader->SetTexture(m_MaterialSamplers[0], material.GetTexture(TextureType::Albedo));
+		m_Shader->SetTexture(m_MaterialSamplers[1], material.GetTexture(TextureType::Normal));
+		m_Shader->SetTexture(m_MaterialSamplers[2], material.GetTexture(TextureType::Roughness));
+		m_Shader->SetTexture(m_MaterialSamplers[3], material.GetTexture(TextureType::Metallic));
+		m_Shader->SetTexture(m_MaterialSamplers[4], material.GetTexture(TextureType::AO));
 
 		m_Shader->UpdateObject(&material);
 
-		//if (obj.instanceCount > 1)
-			//obj.mesh->drawInstanced(obj.instanceCount);
-		//else
-		obj.mesh->draw();
+		if (instanced)
+			obj.mesh->drawInstanced(obj.instanceCount);
+		else
+			obj.mesh->draw();
 
 		m_Shader->Reset();
 	}
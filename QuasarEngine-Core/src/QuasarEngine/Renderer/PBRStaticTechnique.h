@@ -14,8 +14,35 @@ namespace QuasarEngine
 		void Submit(RenderContext& ctx, RenderObject& obj) override;
 		void End() override;
 
+		// Instanced submits are only taken when the backend shader reads the instance buffer.
+		bool SupportsInstancing() const { return m_InstancingSupported; }
+
+		static constexpr uint32_t MaxInstancesPerDraw = 1024;
+
 	private:
+		struct alignas(16) ObjectUniforms {
+			glm::mat4 model;
+
+			glm::vec4 albedo;
+
+			float roughness;
+			float metallic;
+			float ao;
+
+			int has_albedo_texture;
+			int has_normal_texture;
+			int has_roughness_texture;
+			int has_metallic_texture;
+			int has_ao_texture;
+
+			int use_instancing;
+		};
+
 		std::shared_ptr<Shader> m_Shader;
 		SkyboxHDR* m_Skybox;
+		bool m_InstancingSupported = false;
+
+		ObjectUniforms m_ObjectData{};
+		std::array<Shader::SamplerHandle, 5> m_MaterialSamplers{};
 	};
 }
\ No newline at end of file
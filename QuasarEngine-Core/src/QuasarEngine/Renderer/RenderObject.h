@@ -12,6 +12,7 @@ namespace QuasarEngine
 		Terrain = 1 << 1,
 		PointCloud = 1 << 2,
 		Instanced = 1 << 3,
+		Voxel = 1 << 4,
 	};
 
 	inline RenderFlags operator|(RenderFlags a, RenderFlags b) {
@@ -33,6 +34,11 @@ namespace QuasarEngine
 		Entity entity;
 
 		uint32_t instanceCount = 1;
+		// World transforms of every instance when RenderFlags::Instanced is set, model is then unused.
+		const glm::mat4* instanceTransforms = nullptr;
+		// Skinned meshes: final bone matrices copied when the scene is synced.
+		const glm::mat4* boneMatrices = nullptr;
+		uint32_t boneCount = 0;
 		RenderFlags flags = RenderFlags::None;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "qepch.h"
+
+#include <array>
+#include <cstring>
+
+#include <QuasarEngine/Renderer/RenderQueue.h>
+#include <QuasarEngine/Scene/Scene.h>
+#include <QuasarEngine/Entity/Entity.h>
+#include <QuasarEngine/Entity/Components/TransformComponent.h>
+#include <QuasarEngine/Entity/Components/MeshComponent.h>
+#include <QuasarEngine/Entity/Components/MaterialComponent.h>
+#include <QuasarEngine/Entity/Components/MeshRendererComponent.h>
+#include <QuasarEngine/Resources/Mesh.h>
+
+namespace QuasarEngine
+{
+	void RenderQueue::Sync(Scene& scene)
+	{
+		if (scene.GetRegistry() != m_Registry)
+		{
+			Clear();
+			m_Registry = scene.GetRegistry();
+		}
+
+		++m_Frame;
+
+		auto& registry = m_Registry->GetRegistry();
+		auto view = registry.view<TransformComponent, MeshComponent, MaterialComponent, MeshRendererComponent>();
+		for (auto e : view)
+		{
+			auto& tr = view.get<TransformComponent>(e);
+			auto& mc = view.get<MeshComponent>(e);
+			auto& matc = view.get<MaterialComponent>(e);
+			auto& mr = view.get<MeshRendererComponent>(e);
+
+			if (!mr.m_Rendered || !mc.HasMesh()) continue;
+
+			const auto id = static_cast<std::size_t>(entt::to_entity(e));
+			if (id >= m_Sparse.size())
+				m_Sparse.resize(id + 1, InvalidSlot);
+
+			uint32_t slot = m_Sparse[id];
+			if (slot == InvalidSlot || m_Entities[slot] != e)
+				slot = Insert(e);
+
+			RenderObject& obj = m_Objects[slot];
+
+			Mesh* mesh = &mc.GetMesh();
+			if (obj.mesh != mesh)
+			{
+				obj.mesh = mesh;
+				Reassign(m_MeshIdTable, m_MeshIds[slot], reinterpret_cast<uintptr_t>(mesh));
+			}
+
+			// Every MaterialComponent owns its Material, so ids follow the content, not the instance.
+			Material* material = &matc.GetMaterial();
+			obj.material = material;
+
+			const uint64_t materialHash = material->GetContentHash();
+			if (m_MaterialHashes[slot] != materialHash || m_MaterialIds[slot] == SortIdTable::None)
+			{
+				m_MaterialHashes[slot] = materialHash;
+				Reassign(m_MaterialIdTable, m_MaterialIds[slot], materialHash);
+			}
+
+			obj.model = tr.GetGlobalTransform(Entity{ e, m_Registry });
+			if (mc.HasLocalNodeTransform()) obj.model *= mc.GetLocalNodeTransform();
+
+			obj.flags = RenderFlags::None;
+			if (mesh->HasSkinning())
+				obj.flags = obj.flags | RenderFlags::Skinned;
+			if (mesh->IsCloudPoint())
+				obj.flags = obj.flags | RenderFlags::PointCloud;
+			if (mesh->GetVertexFormat() == MeshVertexFormat::PackedVoxel)
+				obj.flags = obj.flags | RenderFlags::Voxel;
+
+			m_LastSeen[slot] = m_Frame;
+		}
+
+		for (std::size_t slot = m_Objects.size(); slot-- > 0;)
+		{
+			if (m_LastSeen[slot] != m_Frame)
+				Remove(slot);
+		}
+	}
+
+	void RenderQueue::Sort(const std::vector<uint8_t>& visibility, const glm::vec3& cameraPosition)
+	{
+		m_Sorted.clear();
+
+		for (std::size_t i = 0; i < m_Objects.size(); ++i)
+		{
+			if (!visibility[i]) continue;
+
+			const RenderObject& obj = m_Objects[i];
+			const RenderTechniqueId technique = GetTechnique(obj.flags);
+			if (technique == RenderTechniqueId::PointCloud) continue;
+
+			const glm::vec3 delta = glm::vec3(obj.model[3]) - cameraPosition;
+			m_Sorted.push_back({ MakeKey(technique, m_MaterialIds[i], m_MeshIds[i], glm::dot(delta, delta)), static_cast<uint32_t>(i) });
+		}
+
+		RadixSort(m_Sorted, m_Scratch);
+	}
+
+	void RenderQueue::Clear()
+	{
+		m_Registry = nullptr;
+
+		m_Objects.clear();
+		m_Entities.clear();
+		m_LastSeen.clear();
+		m_MaterialIds.clear();
+		m_MaterialHashes.clear();
+		m_MeshIds.clear();
+		m_Sparse.clear();
+
+		m_MaterialIdTable.Clear();
+		m_MeshIdTable.Clear();
+
+		m_Sorted.clear();
+	}
+
+	RenderTechniqueId RenderQueue::GetTechnique(RenderFlags flags)
+	{
+		if (HasFlag(flags, RenderFlags::PointCloud))
+			return RenderTechniqueId::PointCloud;
+		if (HasFlag(flags, RenderFlags::Skinned))
+			return RenderTechniqueId::Skinned;
+		if (HasFlag(flags, RenderFlags::Voxel))
+			return RenderTechniqueId::Voxel;
+		return RenderTechniqueId::Static;
+	}
+
+	uint64_t RenderQueue::MakeKey(RenderTechniqueId technique, uint32_t materialId, uint32_t meshId, float distanceSq)
+	{
+		// Positive floats keep their order when compared as integers, the top 24 bits are enough for front-to-back.
+		uint32_t depthBits = 0;
+		if (distanceSq > 0.0f)
+			std::memcpy(&depthBits, &distanceSq, sizeof(float));
+
+		return (uint64_t(technique) << kTechniqueShift)
+			| (uint64_t(materialId & 0xFFFFFu) << kMaterialShift)
+			| (uint64_t(meshId & 0xFFFFu) << kMeshShift)
+			| uint64_t(depthBits >> 8);
+	}
+
+	void RenderQueue::RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch)
+	{
+		const std::size_t count = items.size();
+		if (count < 2)
+			return;
+
+		scratch.resize(count);
+
+		std::array<std::array<uint32_t, 256>, 8> histograms{};
+		for (const SortItem& item : items)
+			for (int pass = 0; pass < 8; ++pass)
+				++histograms[pass][(item.key >> (pass * 8)) & 0xFF];
+
+		SortItem* src = items.data();
+		SortItem* dst = scratch.data();
+
+		for (int pass = 0; pass < 8; ++pass)
+		{
+			auto& histogram = histograms[pass];
+			const int shift = pass * 8;
+
+			// Every key shares this byte: the pass would not move anything.
+			if (histogram[(src[0].key >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (auto& bucket : histogram)
+			{
+				const uint32_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+
+			for (std::size_t i = 0; i < count; ++i)
+				dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+			std::swap(src, dst);
+		}
+
+		if (src != items.data())
+			std::copy(src, src + count, items.data());
+	}
+
+	uint32_t RenderQueue::Insert(entt::entity entity)
+	{
+		const auto slot = static_cast<uint32_t>(m_Objects.size());
+
+		RenderObject obj{};
+		obj.entity = Entity{ entity, m_Registry };
+
+		m_Objects.push_back(obj);
+		m_Entities.push_back(entity);
+		m_LastSeen.push_back(0);
+		m_MaterialIds.push_back(SortIdTable::None);
+		m_MaterialHashes.push_back(0);
+		m_MeshIds.push_back(SortIdTable::None);
+
+		m_Sparse[static_cast<std::size_t>(entt::to_entity(entity))] = slot;
+		return slot;
+	}
+
+	void RenderQueue::Remove(std::size_t slot)
+	{
+		const std::size_t last = m_Objects.size() - 1;
+
+		const auto removedId = static_cast<std::size_t>(entt::to_entity(m_Entities[slot]));
+		if (m_Sparse[removedId] == slot)
+			m_Sparse[removedId] = InvalidSlot;
+
+		Reassign(m_MaterialIdTable, m_MaterialIds[slot], 0);
+		Reassign(m_MeshIdTable, m_MeshIds[slot], 0);
+
+		if (slot != last)
+		{
+			m_Objects[slot] = m_Objects[last];
+			m_Entities[slot] = m_Entities[last];
+			m_LastSeen[slot] = m_LastSeen[last];
+			m_MaterialIds[slot] = m_MaterialIds[last];
+			m_MaterialHashes[slot] = m_MaterialHashes[last];
+			m_MeshIds[slot] = m_MeshIds[last];
+
+			const auto movedId = static_cast<std::size_t>(entt::to_entity(m_Entities[slot]));
+			if (m_Sparse[movedId] == last)
+				m_Sparse[movedId] = static_cast<uint32_t>(slot);
+		}
+
+		m_Objects.pop_back();
+		m_Entities.pop_back();
+		m_LastSeen.pop_back();
+		m_MaterialIds.pop_back();
+		m_MaterialHashes.pop_back();
+		m_MeshIds.pop_back();
+	}
+
+	void RenderQueue::Reassign(SortIdTable& table, uint32_t& id, uint64_t key)
+	{
+		if (id != SortIdTable::None)
+			table.Release(id);
+
+		id = key ? table.Acquire(key) : SortIdTable::None;
+	}
+
+	uint32_t RenderQueue::SortIdTable::Acquire(uint64_t key)
+	{
+		auto it = m_Ids.find(key);
+		if (it != m_Ids.end())
+		{
+			++m_RefCounts[it->second];
+			return it->second;
+		}
+
+		uint32_t id;
+		if (!m_Free.empty())
+		{
+			id = m_Free.back();
+			m_Free.pop_back();
+		}
+		else
+		{
+			id = static_cast<uint32_t>(m_Keys.size());
+			m_Keys.push_back(0);
+			m_RefCounts.push_back(0);
+		}
+
+		m_Keys[id] = key;
+		m_RefCounts[id] = 1;
+		m_Ids.emplace(key, id);
+		return id;
+	}
+
+	void RenderQueue::SortIdTable::Release(uint32_t id)
+	{
+		if (--m_RefCounts[id] != 0)
+			return;
+
+		// The object behind the key may be gone; a new one at the same address starts over.
+		m_Ids.erase(m_Keys[id]);
+		m_Free.push_back(id);
+	}
+
+	void RenderQueue::SortIdTable::Clear()
+	{
+		m_Ids.clear();
+		m_Keys.clear();
+		m_RefCounts.clear();
+		m_Free.clear();
+	}
+}
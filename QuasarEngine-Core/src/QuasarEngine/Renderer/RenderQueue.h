@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <entt.hpp>
+#include <glm/glm.hpp>
+
+#include <QuasarEngine/Renderer/RenderObject.h>
+
+namespace QuasarEngine
+{
+	class Scene;
+	class Registry;
+
+	enum class RenderTechniqueId : uint8_t
+	{
+		Static = 0,
+		Skinned = 1,
+		PointCloud = 2,
+		Voxel = 3
+	};
+
+	// Mesh renderers kept across frames: entries are only created or removed when the
+	// scene changes, each frame just refreshes them and sorts the visible ones by key.
+	class RenderQueue
+	{
+	public:
+		struct SortItem
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		// Key layout, high to low: technique (4) | material (20) | mesh (16) | depth (24).
+		static constexpr int kTechniqueShift = 60;
+		static constexpr int kMaterialShift = 40;
+		static constexpr int kMeshShift = 24;
+
+		void Sync(Scene& scene);
+		void Sort(const std::vector<uint8_t>& visibility, const glm::vec3& cameraPosition);
+		void Clear();
+
+		std::vector<RenderObject>& GetObjects() { return m_Objects; }
+		const std::vector<SortItem>& GetSorted() const { return m_Sorted; }
+
+		// Materials with the same content share an id, so their objects can be drawn as one.
+		uint32_t GetMaterialId(uint32_t index) const { return m_MaterialIds[index]; }
+
+		static RenderTechniqueId GetTechnique(uint64_t key) { return RenderTechniqueId(key >> kTechniqueShift); }
+		static RenderTechniqueId GetTechnique(RenderFlags flags);
+
+		static uint64_t MakeKey(RenderTechniqueId technique, uint32_t materialId, uint32_t meshId, float distanceSq);
+		static void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+		// Compact ids for the key fields. An id is recycled once no entry refers to its key any more,
+		// so the ids stay bounded by what is live rather than by everything ever streamed in.
+		class SortIdTable
+		{
+		public:
+			static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+			uint32_t Acquire(uint64_t key);
+			void Release(uint32_t id);
+			void Clear();
+
+			std::size_t GetLiveCount() const { return m_Ids.size(); }
+
+		private:
+			std::unordered_map<uint64_t, uint32_t> m_Ids;
+			std::vector<uint64_t> m_Keys;
+			std::vector<uint32_t> m_RefCounts;
+			std::vector<uint32_t> m_Free;
+		};
+
+	private:
+		static constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+		uint32_t Insert(entt::entity entity);
+		void Remove(std::size_t slot);
+
+		static void Reassign(SortIdTable& table, uint32_t& id, uint64_t key);
+
+		Registry* m_Registry = nullptr;
+		uint64_t m_Frame = 0;
+
+		std::vector<RenderObject> m_Objects;
+		std::vector<entt::entity> m_Entities;
+		std::vector<uint64_t> m_LastSeen;
+		std::vector<uint32_t> m_MaterialIds;
+		std::vector<uint64_t> m_MaterialHashes;
+		std::vector<uint32_t> m_MeshIds;
+		std::vector<uint32_t> m_Sparse;
+
+		SortIdTable m_MaterialIdTable;
+		SortIdTable m_MeshIdTable;
+
+		std::vector<SortItem> m_Sorted;
+		std::vector<SortItem> m_Scratch;
+	};
+}
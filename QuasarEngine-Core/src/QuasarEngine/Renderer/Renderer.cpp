@@ -31,6 +31,9 @@
 #include <QuasarEngine/Renderer/RenderCommand.h>
 #include <QuasarEngine/Renderer/RendererAPI.h>
 #include <QuasarEngine/Physic/PhysicEngine.h>
+#include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Shader/ShaderCache.h>
+#include <QuasarEngine/Tools/Profiler.h>
 #include <limits>
 
 #include <QuasarEngine/Renderer/RenderContext.h>
@@ -38,6 +41,36 @@
 
 namespace QuasarEngine
 {
+	namespace
+	{
+		// Nearest AnimationComponent up the hierarchy, skinned children follow their rig's animator.
+		const AnimationComponent* FindAnimator(Scene& scene, Entity entity)
+		{
+			Entity current = entity;
+
+			while (current.IsValid())
+			{
+				if (current.HasComponent<AnimationComponent>())
+					return &current.GetComponent<AnimationComponent>();
+
+				if (!current.HasComponent<HierarchyComponent>())
+					break;
+
+				const auto& h = current.GetComponent<HierarchyComponent>();
+				if (h.m_Parent == UUID::Null())
+					break;
+
+				auto parentOpt = scene.GetEntityByUUID(h.m_Parent);
+				if (!parentOpt.has_value())
+					break;
+
+				current = *parentOpt;
+			}
+
+			return nullptr;
+		}
+	}
+
 	void Renderer::Initialize()
 	{
 		auto extFor = [](RendererAPI::API api, Shader::ShaderStageType s) {
@@ -148,8 +181,15 @@ namespace QuasarEngine
 		m_SceneData.m_StaticTech = std::make_unique<PBRStaticTechnique>(m_SceneData.m_SkyboxHDR.get());
 		m_SceneData.m_SkinnedTech = std::make_unique<PBRSkinTechnique>(m_SceneData.m_SkyboxHDR.get());
 		m_SceneData.m_TerrainTech = std::make_unique<TerrainTechnique>(m_SceneData.m_SkyboxHDR.get());
+		if (VoxelTechnique::IsSupported())
+			m_SceneData.m_VoxelTech = std::make_unique<VoxelTechnique>(m_SceneData.m_SkyboxHDR.get());
 		//m_PcTech = std::make_unique<PointCloudTechnique>(m_SceneData.m_SkyboxHDR.get());
 
+		// Cold (compiled) vs warm (program cache) startup cost of the built-in techniques.
+		const ShaderCacheStats shaderStats = ShaderCache::Instance().GetStats();
+		Q_INFO("Renderer shaders: " + std::to_string(shaderStats.hits) + " from cache (" + std::to_string(shaderStats.warmMs) + " ms), "
+			+ std::to_string(shaderStats.misses) + " compiled (" + std::to_string(shaderStats.coldMs) + " ms)");
+
 		m_SceneData.m_ScriptSystem = std::make_unique<ScriptSystem>();
 		m_SceneData.m_ScriptSystem->Initialize();
 
@@ -489,15 +529,28 @@ namespace QuasarEngine
 		//m_SceneData.m_UI.reset();
 		m_SceneData.m_ScriptSystem.reset();
 		//m_SceneData.m_SmokeEmitter.reset();
+
+		m_SceneData.m_RenderQueue.Clear();
+		m_SceneData.m_TerrainObjects.clear();
+		m_SceneData.m_TerrainSources.clear();
+		m_SceneData.m_ParticleSources.clear();
+		m_SceneData.m_Extracted = false;
 	}
 
 	void Renderer::BeginScene(Scene& scene)
 	{
 		m_SceneData.m_Scene = &scene;
+
+		// Same flush as ExtractScene, for callers that render without extracting.
+		scene.UpdateWorldTransforms();
+
+		ResetStats();
 	}
 
 	void Renderer::Render(const glm::mat4& viewMat, const glm::mat4& projMat, const glm::vec3& cam_pos)
 	{
+		QE_PROFILE_FUNCTION();
+
 		RenderContext ctx;
 		ctx.view = viewMat;
 		ctx.projection = projMat;
@@ -511,113 +564,115 @@ namespace QuasarEngine
 		ctx.scene = m_SceneData.m_Scene;
 		ctx.skybox = m_SceneData.m_SkyboxHDR.get();
 
-		auto& registry = m_SceneData.m_Scene->GetRegistry()->GetRegistry();
+		if (!m_SceneData.m_Extracted)
+			SyncScene();
 
-		std::vector<RenderObject> staticMeshes;
-		std::vector<RenderObject> skinnedMeshes;
-		std::vector<RenderObject> pointClouds;
-		std::vector<RenderObject> terrains;
+		auto& queue = m_SceneData.m_RenderQueue;
 
-		auto view = registry.view<TransformComponent, MeshComponent, MaterialComponent, MeshRendererComponent>();
-		for (auto e : view)
-		{
-			auto& tr = view.get<TransformComponent>(e);
-			auto& mc = view.get<MeshComponent>(e);
-			auto& matc = view.get<MaterialComponent>(e);
-			auto& mr = view.get<MeshRendererComponent>(e);
-
-			if (!mr.m_Rendered || !mc.HasMesh()) continue;
-
-			RenderObject obj;
-			obj.entity = Entity{ e, m_SceneData.m_Scene->GetRegistry() };
-			obj.mesh = &mc.GetMesh();
-			obj.material = &matc.GetMaterial();
-
-			glm::mat4 model = tr.GetGlobalTransform();
-			if (mc.HasLocalNodeTransform()) model *= mc.GetLocalNodeTransform();
-			obj.model = model;
-
-			if (mc.GetMesh().HasSkinning())
-				obj.flags = obj.flags | RenderFlags::Skinned;
-			if (mc.GetMesh().IsCloudPoint())
-				obj.flags = obj.flags | RenderFlags::PointCloud;
-
-			if (HasFlag(obj.flags, RenderFlags::PointCloud))
-				pointClouds.push_back(obj);
-			else if (HasFlag(obj.flags, RenderFlags::Skinned))
-				skinnedMeshes.push_back(obj);
-			else
-				staticMeshes.push_back(obj);
-		}
+		auto& objects = queue.GetObjects();
+		auto& visibility = m_SceneData.m_CullVisibility;
+		const std::size_t visibleCount = m_SceneData.m_Culler.Cull(ctx.projection * ctx.view, objects, visibility);
 
-		auto viewT = registry.view<TransformComponent, TerrainComponent, MaterialComponent, MeshRendererComponent>();
-		for (auto e : viewT)
-		{
-			auto& tr = viewT.get<TransformComponent>(e);
-			auto& tec = viewT.get<TerrainComponent>(e);
-			auto& matc = viewT.get<MaterialComponent>(e);
-			auto& mr = viewT.get<MeshRendererComponent>(e);
-
-			if (!mr.m_Rendered || !tec.IsGenerated())
-				continue;
+		m_Stats.visibleObjects += static_cast<uint32_t>(visibleCount);
+		m_Stats.culledObjects += static_cast<uint32_t>(objects.size() - visibleCount);
 
-			if (tec.UseQuadtree() && !tec.HasQuadtree())
-				tec.BuildQuadtree();
+		queue.Sort(visibility, ctx.cameraPosition);
 
-			glm::mat4 model = tr.GetGlobalTransform();
+		auto& terrains = m_SceneData.m_TerrainObjects;
+		terrains.clear();
 
-			if (tec.UseQuadtree() && tec.HasQuadtree())
+		for (const TerrainSource& source : m_SceneData.m_TerrainSources)
+		{
+			if (!source.quadtree)
 			{
-				auto* qt = tec.GetQuadtree();
-				std::vector<const TerrainQuadtree::Node*> visibleNodes;
-				qt->CollectVisible(ctx.projection * ctx.view, ctx.cameraPosition, visibleNodes);
-
-				for (const auto* node : visibleNodes)
-				{
-					if (!node->mesh)
-						continue;
+				terrains.push_back(source.object);
+				continue;
+			}
 
-					RenderObject obj;
-					obj.entity = Entity{ e, m_SceneData.m_Scene->GetRegistry() };
-					obj.mesh = node->mesh.get();
-					obj.material = &matc.GetMaterial();
-					obj.model = model;
-					obj.flags = obj.flags | RenderFlags::Terrain;
+			auto& visibleNodes = m_SceneData.m_TerrainNodes;
+			source.quadtree->CollectVisible(ctx.projection * ctx.view, ctx.cameraPosition, visibleNodes);
 
-					terrains.push_back(obj);
-				}
-			}
-			else
+			for (const auto* node : visibleNodes)
 			{
-				RenderObject obj;
-				obj.entity = Entity{ e, m_SceneData.m_Scene->GetRegistry() };
-				obj.mesh = tec.GetMesh().get();
-				obj.material = &matc.GetMaterial();
-				obj.model = model;
-				obj.flags = obj.flags | RenderFlags::Terrain;
+				if (!node->mesh)
+					continue;
+
+				RenderObject obj = source.object;
+				obj.mesh = node->mesh.get();
 				terrains.push_back(obj);
 			}
 		}
 
-		if (!staticMeshes.empty())
+		const auto& sorted = queue.GetSorted();
+		const bool instancing = m_SceneData.m_StaticTech->SupportsInstancing();
+		auto& instanceTransforms = m_SceneData.m_InstanceTransforms;
+
+		IRenderTechnique* activeTech = nullptr;
+		for (std::size_t i = 0; i < sorted.size();)
 		{
-			m_SceneData.m_StaticTech->Begin(ctx);
-			for (auto& obj : staticMeshes)
+			const RenderTechniqueId technique = RenderQueue::GetTechnique(sorted[i].key);
+			IRenderTechnique* tech = nullptr;
+			switch (technique)
 			{
-				m_SceneData.m_StaticTech->Submit(ctx, obj);
+			case RenderTechniqueId::Skinned: tech = m_SceneData.m_SkinnedTech.get(); break;
+			case RenderTechniqueId::Voxel:   tech = m_SceneData.m_VoxelTech.get(); break;
+			default:                         tech = m_SceneData.m_StaticTech.get(); break;
 			}
-			m_SceneData.m_StaticTech->End();
-		}
 
-		if (!skinnedMeshes.empty())
-		{
-			m_SceneData.m_SkinnedTech->Begin(ctx);
-			for (auto& obj : skinnedMeshes)
+			if (!tech)
+			{
+				++i;
+				continue;
+			}
+
+			if (tech != activeTech)
 			{
-				m_SceneData.m_SkinnedTech->Submit(ctx, obj);
+				if (activeTech) activeTech->End();
+				activeTech = tech;
+				activeTech->Begin(ctx);
 			}
-			m_SceneData.m_SkinnedTech->End();
+
+			RenderObject& first = objects[sorted[i].index];
+
+			// The sort keeps same mesh + material neighbours together, static runs go out as one instanced draw.
+			// Materials match on content: the batch is drawn with the first one, which renders the same.
+			std::size_t run = 1;
+			if (instancing && technique == RenderTechniqueId::Static)
+			{
+				const uint32_t materialId = queue.GetMaterialId(sorted[i].index);
+				while (i + run < sorted.size() && run < PBRStaticTechnique::MaxInstancesPerDraw)
+				{
+					const RenderObject& next = objects[sorted[i + run].index];
+					if (RenderQueue::GetTechnique(sorted[i + run].key) != technique || next.mesh != first.mesh
+						|| queue.GetMaterialId(sorted[i + run].index) != materialId)
+						break;
+					++run;
+				}
+			}
+
+			if (run > 1)
+			{
+				instanceTransforms.clear();
+				for (std::size_t j = i; j < i + run; ++j)
+					instanceTransforms.push_back(objects[sorted[j].index].model);
+
+				RenderObject batch = first;
+				batch.flags = batch.flags | RenderFlags::Instanced;
+				batch.instanceCount = static_cast<uint32_t>(run);
+				batch.instanceTransforms = instanceTransforms.data();
+				activeTech->Submit(ctx, batch);
+
+				m_Stats.drawsSaved += static_cast<uint32_t>(run - 1);
+			}
+			else
+			{
+				activeTech->Submit(ctx, first);
+			}
+
+			++m_Stats.drawCalls;
+			i += run;
 		}
+		if (activeTech) activeTech->End();
 
 		if (!terrains.empty())
 		{
@@ -625,11 +680,13 @@ namespace QuasarEngine
 			for (auto& obj : terrains)
 				m_SceneData.m_TerrainTech->Submit(ctx, obj);
 			m_SceneData.m_TerrainTech->End();
+
+			m_Stats.drawCalls += static_cast<uint32_t>(terrains.size());
 		}
 
-		for (auto [e, tr, pc] : m_SceneData.m_Scene->GetRegistry()->GetRegistry().group<TransformComponent, ParticleComponent>().each())
+		for (ParticleComponent* pc : m_SceneData.m_ParticleSources)
 		{
-			pc.Render(ctx);
+			pc->Render(ctx);
 		}
 
 		/*pcTech.Begin(ctx);
@@ -659,7 +716,7 @@ namespace QuasarEngine
 				if (!mesh.IsCloudPoint()) continue;
 				if (mesh.HasSkinning())    continue;
 
-				glm::mat4 model = tr.GetGlobalTransform();
+				glm::mat4 model = tr.GetGlobalTransform(Entity{ e, m_SceneData.m_Scene->GetRegistry() });
 				if (mc.HasLocalNodeTransform())
 					model *= mc.GetLocalNodeTransform();
 
@@ -689,7 +746,7 @@ namespace QuasarEngine
 				if (!spec.Visible) continue;
 
 				Texture* tex = sc.GetTexture();
-				glm::mat4 T = tr.GetGlobalTransform();
+				glm::mat4 T = tr.GetGlobalTransform(entity);
 				glm::vec4 uv = sc.GetEffectiveUV();
 
 				Renderer2D::Instance().DrawQuad(
@@ -740,11 +797,115 @@ namespace QuasarEngine
 
 	void Renderer::EndScene()
 	{
+		m_SceneData.m_Extracted = false;
+	}
+
+	void Renderer::ExtractScene(Scene& scene)
+	{
+		QE_PROFILE_FUNCTION();
+
+		m_SceneData.m_Scene = &scene;
+
+		// Flush transform edits made since the scene update, so BuildLight and SyncScene read
+		// every world matrix straight from WorldTransformComponent.
+		scene.UpdateWorldTransforms();
+
+		ResetStats();
+
+		BuildLight();
+		SyncScene();
 
+		m_SceneData.m_Extracted = true;
+	}
+
+	void Renderer::SyncScene()
+	{
+		Scene& scene = *m_SceneData.m_Scene;
+		auto& registry = scene.GetRegistry()->GetRegistry();
+
+		auto& queue = m_SceneData.m_RenderQueue;
+		queue.Sync(scene);
+
+		// Bones are copied so skinned draws do not read animations the next update is writing.
+		auto& objects = queue.GetObjects();
+		auto& bones = m_SceneData.m_BoneMatrices;
+		bones.clear();
+
+		for (RenderObject& obj : objects)
+		{
+			obj.boneMatrices = nullptr;
+			obj.boneCount = 0;
+
+			if (!HasFlag(obj.flags, RenderFlags::Skinned))
+				continue;
+
+			const AnimationComponent* anim = FindAnimator(scene, obj.entity);
+			if (!anim)
+				continue;
+
+			const auto& finalBones = anim->GetFinalBoneMatrices();
+			const std::size_t count = std::min(finalBones.size(), (std::size_t)QE_MAX_BONES);
+
+			obj.boneCount = static_cast<uint32_t>(count);
+			bones.insert(bones.end(), finalBones.begin(), finalBones.begin() + count);
+		}
+
+		// Pointed once the storage stopped growing, objects with bones come in the order they were added.
+		std::size_t boneOffset = 0;
+		for (RenderObject& obj : objects)
+		{
+			if (obj.boneCount == 0)
+				continue;
+
+			obj.boneMatrices = bones.data() + boneOffset;
+			boneOffset += obj.boneCount;
+		}
+
+		auto& terrains = m_SceneData.m_TerrainSources;
+		terrains.clear();
+
+		auto viewT = registry.view<TransformComponent, TerrainComponent, MaterialComponent, MeshRendererComponent>();
+		for (auto e : viewT)
+		{
+			auto& tr = viewT.get<TransformComponent>(e);
+			auto& tec = viewT.get<TerrainComponent>(e);
+			auto& matc = viewT.get<MaterialComponent>(e);
+			auto& mr = viewT.get<MeshRendererComponent>(e);
+
+			if (!mr.m_Rendered || !tec.IsGenerated())
+				continue;
+
+			if (tec.UseQuadtree() && !tec.HasQuadtree())
+				tec.BuildQuadtree();
+
+			TerrainSource source;
+			source.object.entity = Entity{ e, scene.GetRegistry() };
+			source.object.mesh = tec.GetMesh().get();
+			source.object.material = &matc.GetMaterial();
+			source.object.model = tr.GetGlobalTransform(source.object.entity);
+			source.object.flags = RenderFlags::Terrain;
+
+			// Quadtree nodes depend on the camera, they are picked in Render.
+			if (tec.UseQuadtree() && tec.HasQuadtree())
+				source.quadtree = tec.GetQuadtree();
+
+			terrains.push_back(source);
+		}
+
+		auto& particles = m_SceneData.m_ParticleSources;
+		particles.clear();
+
+		for (auto [e, tr, pc] : registry.group<TransformComponent, ParticleComponent>().each())
+		{
+			pc.Extract();
+			particles.push_back(&pc);
+		}
 	}
 
 	void Renderer::BuildLight()
 	{
+		QE_PROFILE_FUNCTION();
+
 		m_SceneData.nDirs = 0;
 		m_SceneData.nPts = 0;
 
@@ -18,13 +18,25 @@
 #include <QuasarEngine/Renderer/PBRStaticTechnique.h>
 #include <QuasarEngine/Renderer/PBRSkinTechnique.h>
 #include <QuasarEngine/Renderer/TerrainTechnique.h>
+#include <QuasarEngine/Renderer/VoxelTechnique.h>
+#include <QuasarEngine/Renderer/FrustumCuller.h>
+#include <QuasarEngine/Renderer/RenderQueue.h>
+#include <QuasarEngine/Resources/TerrainQuadtree.h>
 
 namespace QuasarEngine
 {
 
+	class ParticleComponent;
+
 	class Renderer : public Singleton<Renderer>
 	{
 	public:
+		struct TerrainSource
+		{
+			RenderObject object;
+			const TerrainQuadtree* quadtree = nullptr;
+		};
+
 		struct SceneData
 		{
 			Scene* m_Scene;
@@ -39,8 +51,23 @@ namespace QuasarEngine
 			std::unique_ptr<PBRStaticTechnique> m_StaticTech;
 			std::unique_ptr<PBRSkinTechnique> m_SkinnedTech;
 			std::unique_ptr<TerrainTechnique> m_TerrainTech;
+			std::unique_ptr<VoxelTechnique> m_VoxelTech;
 			//PointCloudTechnique> m_PcTech;
 
+			FrustumCuller m_Culler;
+			RenderQueue m_RenderQueue;
+			std::vector<uint8_t> m_CullVisibility;
+			std::vector<glm::mat4> m_InstanceTransforms;
+
+			std::vector<RenderObject> m_TerrainObjects;
+			std::vector<const TerrainQuadtree::Node*> m_TerrainNodes;
+
+			// What Render reads from the registry, refreshed by ExtractScene or at each Render.
+			bool m_Extracted = false;
+			std::vector<glm::mat4> m_BoneMatrices;
+			std::vector<TerrainSource> m_TerrainSources;
+			std::vector<ParticleComponent*> m_ParticleSources;
+
 			//std::unique_ptr<UISystem> m_UI;
 
 			std::array<PointLight, 4> m_PointsBuffer;
@@ -49,6 +76,10 @@ namespace QuasarEngine
 		};
 		SceneData m_SceneData;
 
+		struct Stats { uint32_t visibleObjects = 0; uint32_t culledObjects = 0; uint32_t drawCalls = 0; uint32_t drawsSaved = 0; };
+		const Stats& GetStats() const noexcept { return m_Stats; }
+		void ResetStats() noexcept { m_Stats = {}; }
+
 		void Initialize();
 		void Shutdown();
 
@@ -61,6 +92,16 @@ namespace QuasarEngine
 
 		void BuildLight();
 
+		// Main thread, with no update running: copies the lights, render objects, bones, terrains
+		// and particles of the scene. Render draws this copy until EndScene, so the next update can
+		// run next to it. Replaces BeginScene and BuildLight for pipelined layers.
+		void ExtractScene(Scene& scene);
+
 		double GetTime();
+
+	private:
+		void SyncScene();
+
+		Stats m_Stats{};
 	};
 }
\ No newline at end of file
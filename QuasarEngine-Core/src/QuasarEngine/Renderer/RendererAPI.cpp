@@ -5,6 +5,7 @@
 #include "Platform/Vulkan/VulkanRendererAPI.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
 #include "Platform/DirectX/DirectXRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 
 namespace QuasarEngine {
 
@@ -14,7 +15,7 @@ namespace QuasarEngine {
 	{
 		switch (s_API)
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_unique<NullRendererAPI>();
 		case RendererAPI::API::Vulkan:  return std::make_unique<VulkanRendererAPI>();
 		case RendererAPI::API::OpenGL:  return std::make_unique<OpenGLRendererAPI>();
 		case RendererAPI::API::DirectX:  return std::make_unique<DirectXRendererAPI>();
@@ -37,6 +37,8 @@ namespace QuasarEngine {
 		virtual void SetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
 		static API GetAPI() { return s_API; }
+		// Must be called before anything renderer side is created, objects are not recreated.
+		static void SetAPI(API api) { s_API = api; }
 		static std::unique_ptr<RendererAPI> Create();
 	private:
 		static API s_API;
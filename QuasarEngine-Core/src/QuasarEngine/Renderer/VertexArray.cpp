@@ -5,6 +5,7 @@
 #include "Platform/Vulkan/VulkanVertexArray.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
 #include "Platform/DirectX/DirectXVertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 
 namespace QuasarEngine {
 
@@ -12,7 +13,7 @@ namespace QuasarEngine {
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullVertexArray>();
 		case RendererAPI::API::Vulkan:  return std::make_shared<VulkanVertexArray>();
 		case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLVertexArray>();
 		case RendererAPI::API::DirectX:  return std::make_shared<DirectXVertexArray>();
@@ -0,0 +1,233 @@
+#include "qepch.h"
+
+#include <QuasarEngine/Renderer/VoxelTechnique.h>
+
+namespace QuasarEngine
+{
+	VoxelTechnique::VoxelTechnique(SkyboxHDR* skybox)
+		: m_Skybox(skybox)
+	{
+		auto extFor = [](RendererAPI::API api, Shader::ShaderStageType s) {
+			if (api == RendererAPI::API::Vulkan) {
+				switch (s) {
+				case Shader::ShaderStageType::Vertex:     return ".vert.spv";
+				case Shader::ShaderStageType::TessControl:return ".tesc.spv";
+				case Shader::ShaderStageType::TessEval:   return ".tese.spv";
+				case Shader::ShaderStageType::Fragment:   return ".frag.spv";
+				default: return "";
+				}
+			}
+			else {
+				switch (s) {
+				case Shader::ShaderStageType::Vertex:     return ".vert.glsl";
+				case Shader::ShaderStageType::TessControl:return ".tesc.glsl";
+				case Shader::ShaderStageType::TessEval:   return ".tese.glsl";
+				case Shader::ShaderStageType::Fragment:   return ".frag.glsl";
+				default: return "";
+				}
+			}
+		};
+
+		Shader::ShaderDescription desc;
+
+		const auto api = RendererAPI::GetAPI();
+		const std::string basePath = (api == RendererAPI::API::Vulkan)
+			? "Assets/Shaders/vk/spv/"
+			: "Assets/Shaders/gl/";
+
+		// Only the vertex stage differs from the static technique, it unpacks the faces for the shared PBR fragment shader.
+		std::string vertPath = basePath + "voxel" + extFor(api, Shader::ShaderStageType::Vertex);
+		std::string fragPath = basePath + "basic" + extFor(api, Shader::ShaderStageType::Fragment);
+
+		desc.modules = {
+			Shader::ShaderModuleInfo{
+				Shader::ShaderStageType::Vertex,
+				vertPath,
+				"",
+				{
+					{0, Shader::ShaderIOType::IVec2, "inPacked", true, ""}
+				}
+			},
+			Shader::ShaderModuleInfo{
+				Shader::ShaderStageType::Fragment,
+				fragPath,
+				"",
+				{}
+			}
+		};
+
+		struct alignas(16) GlobalUniforms
+		{
+			glm::mat4 view;
+			glm::mat4 projection;
+			glm::vec3 camera_position;
+
+			int usePointLight;
+			int useDirLight;
+
+			int prefilterLevels;
+
+			PointLight pointLights[4];
+			DirectionalLight dirLights[4];
+		};
+		static_assert(offsetof(GlobalUniforms, pointLights) % 16 == 0, "pointLights offset must be 16-aligned");
+		static_assert(offsetof(GlobalUniforms, dirLights) % 16 == 0, "dirLights offset must be 16-aligned");
+
+		static_assert(sizeof(GlobalUniforms) % 16 == 0, "GlobalUniforms must be 16-aligned");
+
+		constexpr Shader::ShaderStageFlags globalUniformsFlags = Shader::StageToBit(Shader::ShaderStageType::Vertex) | Shader::StageToBit(Shader::ShaderStageType::Fragment);
+
+		desc.globalUniforms = {
+			{"view",			Shader::ShaderUniformType::Mat4,	sizeof(glm::mat4),				offsetof(GlobalUniforms, view), 0, 0, globalUniformsFlags},
+			{"projection",		Shader::ShaderUniformType::Mat4,	sizeof(glm::mat4),				offsetof(GlobalUniforms, projection), 0, 0, globalUniformsFlags},
+			{"camera_position", Shader::ShaderUniformType::Vec3,	sizeof(glm::vec3),				offsetof(GlobalUniforms, camera_position), 0, 0, globalUniformsFlags},
+
+			{"usePointLight",	Shader::ShaderUniformType::Int,		sizeof(int),					offsetof(GlobalUniforms, usePointLight), 0, 0, globalUniformsFlags},
+			{"useDirLight",		Shader::ShaderUniformType::Int,		sizeof(int),					offsetof(GlobalUniforms, useDirLight), 0, 0, globalUniformsFlags},
+
+			{"prefilterLevels",	Shader::ShaderUniformType::Int,		sizeof(int),					offsetof(GlobalUniforms, prefilterLevels), 0, 0, globalUniformsFlags},
+
+			{"pointLights",		Shader::ShaderUniformType::Unknown, sizeof(PointLight) * 4,			offsetof(GlobalUniforms, pointLights), 0, 0, globalUniformsFlags},
+			{"dirLights",		Shader::ShaderUniformType::Unknown, sizeof(DirectionalLight) * 4,	offsetof(GlobalUniforms, dirLights), 0, 0, globalUniformsFlags}
+		};
+
+		static_assert(sizeof(ObjectUniforms) % 16 == 0, "ObjectUniforms must be 16-aligned");
+
+		constexpr Shader::ShaderStageFlags objectUniformsFlags =
+			Shader::StageToBit(Shader::ShaderStageType::Vertex) |
+			Shader::StageToBit(Shader::ShaderStageType::Fragment);
+
+		desc.objectUniforms = {
+			{"model",					Shader::ShaderUniformType::Mat4,	sizeof(glm::mat4),  offsetof(ObjectUniforms, model),					1, 0, objectUniformsFlags},
+
+			{"albedo",					Shader::ShaderUniformType::Vec4,	sizeof(glm::vec4),  offsetof(ObjectUniforms, albedo),					1, 0, objectUniformsFlags},
+
+			{"roughness",				Shader::ShaderUniformType::Float,	sizeof(float),      offsetof(ObjectUniforms, roughness),				1, 0, objectUniformsFlags},
+			{"metallic",				Shader::ShaderUniformType::Float,	sizeof(float),      offsetof(ObjectUniforms, metallic),					1, 0, objectUniformsFlags},
+			{"ao",						Shader::ShaderUniformType::Float,	sizeof(float),      offsetof(ObjectUniforms, ao),						1, 0, objectUniformsFlags},
+
+			{"has_albedo_texture",		Shader::ShaderUniformType::Int,		sizeof(int),		offsetof(ObjectUniforms, has_albedo_texture),		1, 0, objectUniformsFlags},
+			{"has_normal_texture",		Shader::ShaderUniformType::Int,		sizeof(int),		offsetof(ObjectUniforms, has_normal_texture),		1, 0, objectUniformsFlags},
+			{"has_roughness_texture",	Shader::ShaderUniformType::Int,		sizeof(int),		offsetof(ObjectUniforms, has_roughness_texture),	1, 0, objectUniformsFlags},
+			{"has_metallic_texture",	Shader::ShaderUniformType::Int,		sizeof(int),		offsetof(ObjectUniforms, has_metallic_texture),		1, 0, objectUniformsFlags},
+			{"has_ao_texture",			Shader::ShaderUniformType::Int,		sizeof(int),		offsetof(ObjectUniforms, has_ao_texture),			1, 0, objectUniformsFlags}
+		};
+
+		// The fragment shader shares the static technique's object block, instancing is never used.
+		desc.objectUniforms.push_back({"use_instancing", Shader::ShaderUniformType::Int, sizeof(int), offsetof(ObjectUniforms, use_instancing), 1, 0, objectUniformsFlags});
+
+		desc.samplers = {
+			{"albedo_texture",   1, 1, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"normal_texture",   1, 2, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"roughness_texture",1, 3, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"metallic_texture", 1, 4, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"ao_texture",       1, 5, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"irradiance_map",   1, 6, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"prefilter_map",    1, 7, Shader::StageToBit(Shader::ShaderStageType::Fragment)},
+			{"brdf_lut",         1, 8, Shader::StageToBit(Shader::ShaderStageType::Fragment)}
+		};
+
+		desc.blendMode = Shader::BlendMode::None;
+		desc.cullMode = Shader::CullMode::Back;
+		desc.fillMode = Shader::FillMode::Solid;
+		desc.depthFunc = Shader::DepthFunc::Less;
+		desc.depthTestEnable = true;
+		desc.depthWriteEnable = true;
+		desc.topology = Shader::PrimitiveTopology::TriangleList;
+		desc.enableDynamicViewport = true;
+		desc.enableDynamicScissor = true;
+		desc.enableDynamicLineWidth = false;
+
+		m_Shader = Shader::Create(desc);
+
+		if (m_Shader)
+		{
+			m_MaterialSamplers = {
+				m_Shader->GetSamplerHandle("albedo_texture"),
+				m_Shader->GetSamplerHandle("normal_texture"),
+				m_Shader->GetSamplerHandle("roughness_texture"),
+				m_Shader->GetSamplerHandle("metallic_texture"),
+				m_Shader->GetSamplerHandle("ao_texture")
+			};
+		}
+	}
+
+	VoxelTechnique::~VoxelTechnique()
+	{
+		m_Shader.reset();
+	}
+
+	void VoxelTechnique::Begin(RenderContext& ctx)
+	{
+		m_Shader->Use();
+
+		m_Shader->SetUniform("view", &ctx.view, sizeof(glm::mat4));
+		m_Shader->SetUniform("projection", &ctx.projection, sizeof(glm::mat4));
+		m_Shader->SetUniform("camera_position",
+			&ctx.cameraPosition, sizeof(glm::vec3));
+
+		m_Shader->SetUniform("usePointLight", &ctx.numPointLights, sizeof(int));
+		m_Shader->SetUniform("useDirLight", &ctx.numDirLights, sizeof(int));
+		m_Shader->SetUniform("pointLights",
+			ctx.pointLights, sizeof(PointLight) * 4);
+		m_Shader->SetUniform("dirLights",
+			ctx.dirLights, sizeof(DirectionalLight) * 4);
+
+		if (m_Skybox)
+		{
+			int prefilterLevels = m_Skybox->GetSettings().prefilterMipLevels;
+			m_Shader->SetUniform("prefilterLevels",
+				&prefilterLevels, sizeof(int));
+
+			m_Shader->SetTexture("irradiance_map",
+				m_Skybox->GetIrradianceMap().get());
+			m_Shader->SetTexture("prefilter_map",
+				m_Skybox->GetPrefilterMap().get());
+			m_Shader->SetTexture("brdf_lut",
+				m_Skybox->GetBrdfLUT().get());
+		}
+
+		m_Shader->UpdateGlobalState();
+	}
+
+	void VoxelTechnique::Submit(RenderContext& ctx, RenderObject& obj)
+	{
+		if (!HasFlag(obj.flags, RenderFlags::Voxel)) return;
+
+		Material& material = *obj.material;
+
+		ObjectUniforms& data = m_ObjectData;
+		data.model = obj.model;
+		data.albedo = material.GetAlbedo();
+		data.roughness = material.GetRoughness();
+		data.metallic = material.GetMetallic();
+		data.ao = material.GetAO();
+
+		data.has_albedo_texture = material.HasTexture(TextureType::Albedo) ? 1 : 0;
+		data.has_normal_texture = material.HasTexture(TextureType::Normal) ? 1 : 0;
+		data.has_roughness_texture = material.HasTexture(TextureType::Roughness) ? 1 : 0;
+		data.has_metallic_texture = material.HasTexture(TextureType::Metallic) ? 1 : 0;
+		data.has_ao_texture = material.HasTexture(TextureType::AO) ? 1 : 0;
+
+		data.use_instancing = 0;
+
+		m_Shader->SetObjectUniforms(&data, sizeof(ObjectUniforms));
+
+		m_Shader->SetTexture(m_MaterialSamplers[0], material.GetTexture(TextureType::Albedo));
+		m_Shader->SetTexture(m_MaterialSamplers[1], material.GetTexture(TextureType::Normal));
+		m_Shader->SetTexture(m_MaterialSamplers[2], material.GetTexture(TextureType::Roughness));
+		m_Shader->SetTexture(m_MaterialSamplers[3], material.GetTexture(TextureType::Metallic));
+		m_Shader->SetTexture(m_MaterialSamplers[4], material.GetTexture(TextureType::AO));
+
+		m_Shader->UpdateObject(&material);
+
+		obj.mesh->draw();
+
+		m_Shader->Reset();
+	}
+
+	void VoxelTechnique::End()
+	{
+		m_Shader->Unuse();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QuasarEngine/Renderer/IRenderTechnique.h>
+#include <QuasarEngine/Renderer/RendererAPI.h>
+
+namespace QuasarEngine
+{
+	// Draws meshes in MeshVertexFormat::PackedVoxel with the static PBR lighting.
+	class VoxelTechnique : public IRenderTechnique
+	{
+	public:
+		VoxelTechnique(SkyboxHDR* skybox);
+		~VoxelTechnique();
+
+		void Begin(RenderContext& ctx) override;
+		void Submit(RenderContext& ctx, RenderObject& obj) override;
+		void End() override;
+
+		// Only the GL backend has the unpacking vertex shader for now, the null one takes any shader.
+		static bool IsSupported() { return RendererAPI::GetAPI() == RendererAPI::API::OpenGL || RendererAPI::GetAPI() == RendererAPI::API::None; }
+
+	private:
+		struct alignas(16) ObjectUniforms {
+			glm::mat4 model;
+
+			glm::vec4 albedo;
+
+			float roughness;
+			float metallic;
+			float ao;
+
+			int has_albedo_texture;
+			int has_normal_texture;
+			int has_roughness_texture;
+			int has_metallic_texture;
+			int has_ao_texture;
+
+			int use_instancing;
+		};
+
+		std::shared_ptr<Shader> m_Shader;
+		SkyboxHDR* m_Skybox;
+
+		ObjectUniforms m_ObjectData{};
+		std::array<Shader::SamplerHandle, 5> m_MaterialSamplers{};
+	};
+}
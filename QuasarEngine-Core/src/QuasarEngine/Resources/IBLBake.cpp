@@ -0,0 +1,569 @@
+#include "qepch.h"
+#include "IBLBake.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <stb_image.h>
+
+#include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Thread/JobSystem.h>
+#include <QuasarEngine/Tools/Hash.h>
+#include <QuasarEngine/File/FileUtils.h>
+
+namespace QuasarEngine
+{
+    namespace
+    {
+        constexpr uint32_t BakeMagic = 0x4C424951; // "QIBL"
+        constexpr uint32_t StampMagic = 0x4B424951; // "QIBK"
+        constexpr float Pi = 3.14159265359f;
+
+        struct BakeHeader
+        {
+            uint32_t magic = BakeMagic;
+            uint32_t version = IBLBake::Version;
+            uint64_t key = 0;
+            uint32_t envRes = 0;
+            uint32_t irradianceRes = 0;
+            uint32_t prefilterRes = 0;
+            uint32_t prefilterLevels = 0;
+            uint32_t brdfRes = 0;
+            uint32_t reserved = 0;
+        };
+
+        // Remembers the content key of an HDR as last seen at its path, size and mtime. There is
+        // one per HDR path, a new size or mtime replaces it.
+        struct KeyStamp
+        {
+            uint32_t magic = StampMagic;
+            uint32_t version = IBLBake::Version;
+            uint64_t stamp = 0;
+            uint64_t key = 0;
+        };
+
+        std::string HexName(uint64_t value, const char* extension)
+        {
+            std::ostringstream name;
+            name << std::hex << std::setw(16) << std::setfill('0') << value << extension;
+            return name.str();
+        }
+
+        uint32_t MipCount(uint32_t res)
+        {
+            uint32_t levels = 1;
+            while (res > 1) { res = std::max(1u, res / 2); ++levels; }
+            return levels;
+        }
+
+        // Inverse of the GL cube face selection: face + texel centre -> direction.
+        glm::vec3 FaceDirection(uint32_t face, uint32_t x, uint32_t y, uint32_t res)
+        {
+            const float u = 2.0f * (x + 0.5f) / res - 1.0f;
+            const float v = 2.0f * (y + 0.5f) / res - 1.0f;
+
+            switch (face)
+            {
+            case 0:  return glm::normalize(glm::vec3(1.0f, -v, -u));
+            case 1:  return glm::normalize(glm::vec3(-1.0f, -v, u));
+            case 2:  return glm::normalize(glm::vec3(u, 1.0f, v));
+            case 3:  return glm::normalize(glm::vec3(u, -1.0f, -v));
+            case 4:  return glm::normalize(glm::vec3(u, -v, 1.0f));
+            default: return glm::normalize(glm::vec3(-u, -v, -1.0f));
+            }
+        }
+
+        // Solid angle of a texel, used to weight the irradiance integral.
+        float TexelSolidAngle(uint32_t x, uint32_t y, uint32_t res)
+        {
+            const float u = 2.0f * (x + 0.5f) / res - 1.0f;
+            const float v = 2.0f * (y + 0.5f) / res - 1.0f;
+            const float d = 1.0f + u * u + v * v;
+            return (4.0f / (static_cast<float>(res) * res)) / (d * std::sqrt(d));
+        }
+
+        struct CubeLevel
+        {
+            uint32_t res = 0;
+            std::vector<float> texels;
+
+            glm::vec3 Texel(uint32_t face, uint32_t x, uint32_t y) const
+            {
+                const float* t = &texels[(static_cast<size_t>(face) * res * res + static_cast<size_t>(y) * res + x) * 3];
+                return glm::vec3(t[0], t[1], t[2]);
+            }
+
+            glm::vec3 Sample(const glm::vec3& dir) const
+            {
+                const glm::vec3 a = glm::abs(dir);
+                uint32_t face;
+                float sc, tc, ma;
+                if (a.x >= a.y && a.x >= a.z) { ma = a.x; face = dir.x > 0 ? 0 : 1; sc = dir.x > 0 ? -dir.z : dir.z; tc = -dir.y; }
+                else if (a.y >= a.z)          { ma = a.y; face = dir.y > 0 ? 2 : 3; sc = dir.x; tc = dir.y > 0 ? dir.z : -dir.z; }
+                else                          { ma = a.z; face = dir.z > 0 ? 4 : 5; sc = dir.z > 0 ? dir.x : -dir.x; tc = -dir.y; }
+
+                const float fx = std::clamp((0.5f * (sc / ma + 1.0f)) * res - 0.5f, 0.0f, res - 1.0f);
+                const float fy = std::clamp((0.5f * (tc / ma + 1.0f)) * res - 0.5f, 0.0f, res - 1.0f);
+                const uint32_t x0 = static_cast<uint32_t>(fx), y0 = static_cast<uint32_t>(fy);
+                const uint32_t x1 = std::min(x0 + 1, res - 1), y1 = std::min(y0 + 1, res - 1);
+                const float tx = fx - x0, ty = fy - y0;
+
+                return glm::mix(
+                    glm::mix(Texel(face, x0, y0), Texel(face, x1, y0), tx),
+                    glm::mix(Texel(face, x0, y1), Texel(face, x1, y1), tx), ty);
+            }
+        };
+
+        // Trilinear lookup over a box-filtered chain, like textureLod on the GPU cubemap.
+        glm::vec3 SampleLod(const std::vector<CubeLevel>& chain, const glm::vec3& dir, float lod)
+        {
+            lod = std::clamp(lod, 0.0f, static_cast<float>(chain.size() - 1));
+            const size_t l0 = static_cast<size_t>(lod);
+            const size_t l1 = std::min(l0 + 1, chain.size() - 1);
+            const glm::vec3 c0 = chain[l0].Sample(dir);
+            return l0 == l1 ? c0 : glm::mix(c0, chain[l1].Sample(dir), lod - l0);
+        }
+
+        CubeLevel Downsample(const CubeLevel& src)
+        {
+            CubeLevel dst;
+            dst.res = std::max(1u, src.res / 2);
+            dst.texels.resize(IBLBakeData::FaceFloats(dst.res) * 6);
+
+            for (uint32_t face = 0; face < 6; ++face)
+                for (uint32_t y = 0; y < dst.res; ++y)
+                    for (uint32_t x = 0; x < dst.res; ++x)
+                    {
+                        const uint32_t sx = std::min(x * 2, src.res - 1), sy = std::min(y * 2, src.res - 1);
+                        const uint32_t sx1 = std::min(sx + 1, src.res - 1), sy1 = std::min(sy + 1, src.res - 1);
+                        const glm::vec3 c = 0.25f * (src.Texel(face, sx, sy) + src.Texel(face, sx1, sy) + src.Texel(face, sx, sy1) + src.Texel(face, sx1, sy1));
+
+                        float* out = &dst.texels[(static_cast<size_t>(face) * dst.res * dst.res + static_cast<size_t>(y) * dst.res + x) * 3];
+                        out[0] = c.r; out[1] = c.g; out[2] = c.b;
+                    }
+            return dst;
+        }
+
+        float RadicalInverse(uint32_t bits)
+        {
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return static_cast<float>(bits) * 2.3283064365386963e-10f;
+        }
+
+        // GGX half vector in tangent space (N = +Z), same sequence as the prefilter / brdf shaders.
+        glm::vec3 ImportanceSampleGGX(uint32_t i, uint32_t count, float roughness)
+        {
+            const float a = roughness * roughness;
+            const float xi0 = static_cast<float>(i) / count;
+            const float xi1 = RadicalInverse(i);
+
+            const float phi = 2.0f * Pi * xi0;
+            const float cosTheta = std::sqrt((1.0f - xi1) / (1.0f + (a * a - 1.0f) * xi1));
+            const float sinTheta = std::sqrt(std::max(1.0f - cosTheta * cosTheta, 0.0f));
+            return glm::vec3(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+        }
+
+        void TangentFrame(const glm::vec3& n, glm::vec3& tangent, glm::vec3& bitangent)
+        {
+            const glm::vec3 up = std::abs(n.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+            tangent = glm::normalize(glm::cross(up, n));
+            bitangent = glm::cross(n, tangent);
+        }
+
+        template<typename Func>
+        void ForEachFaceTexel(uint32_t res, Func&& func)
+        {
+            JobSystem::Instance().ParallelFor(static_cast<size_t>(res) * 6, 1, [&](size_t row)
+                {
+                    const uint32_t face = static_cast<uint32_t>(row / res);
+                    const uint32_t y = static_cast<uint32_t>(row % res);
+                    for (uint32_t x = 0; x < res; ++x)
+                        func(face, x, y);
+                });
+        }
+
+        void Store(std::vector<float>& texels, uint32_t res, uint32_t face, uint32_t x, uint32_t y, const glm::vec3& c)
+        {
+            float* out = &texels[(static_cast<size_t>(face) * res * res + static_cast<size_t>(y) * res + x) * 3];
+            out[0] = c.r; out[1] = c.g; out[2] = c.b;
+        }
+
+        size_t BakeFloatCount(const BakeHeader& h)
+        {
+            size_t count = IBLBakeData::FaceFloats(h.envRes) * 6 + IBLBakeData::FaceFloats(h.irradianceRes) * 6;
+            for (uint32_t mip = 0; mip < h.prefilterLevels; ++mip)
+                count += IBLBakeData::FaceFloats(std::max(1u, h.prefilterRes >> mip)) * 6;
+            return count + static_cast<size_t>(h.brdfRes) * h.brdfRes * 2;
+        }
+    }
+
+    bool IBLBakeData::IsComplete() const
+    {
+        if (environment.size() != FaceFloats(envRes) * 6 || irradiance.size() != FaceFloats(irradianceRes) * 6)
+            return false;
+        if (brdf.size() != static_cast<size_t>(brdfRes) * brdfRes * 2 || prefilter.empty())
+            return false;
+
+        for (size_t mip = 0; mip < prefilter.size(); ++mip)
+            if (prefilter[mip].size() != FaceFloats(std::max(1u, prefilterRes >> mip)) * 6)
+                return false;
+        return true;
+    }
+
+    uint32_t IBLBake::PrefilterLevels(const IBLSettings& settings)
+    {
+        return std::min<uint32_t>(5, MipCount(settings.prefilterRes));
+    }
+
+    uint64_t IBLBake::ComputeKey(const IBLSettings& settings)
+    {
+        std::error_code ec;
+        const std::filesystem::path hdrPath(settings.hdrPath);
+        const uintmax_t size = std::filesystem::file_size(hdrPath, ec);
+        if (ec)
+            return 0;
+        const auto modified = std::filesystem::last_write_time(hdrPath, ec);
+        if (ec)
+            return 0;
+
+        Fnv1a h;
+        h.U32(Version);
+        h.U32(settings.envRes);
+        h.U32(settings.irradianceRes);
+        h.U32(settings.prefilterRes);
+        h.U32(PrefilterLevels(settings));
+        h.U32(settings.brdfRes);
+
+        // Path, size and mtime only check the stamp: while they match, the content hash saved
+        // with it is reused instead of reading the whole HDR at every startup.
+        const std::string absolute = std::filesystem::absolute(hdrPath, ec).generic_string();
+        Fnv1a stamp = h;
+        stamp.String(absolute);
+        stamp.U64(static_cast<uint64_t>(size));
+        stamp.U64(static_cast<uint64_t>(modified.time_since_epoch().count()));
+
+        Fnv1a pathHash;
+        pathHash.String(absolute);
+        const std::filesystem::path stampPath = std::filesystem::path(settings.bakeCacheDir) / HexName(pathHash.hash, ".qeiblkey");
+        {
+            std::ifstream in(stampPath, std::ios::binary);
+            KeyStamp record;
+            if (in.read(reinterpret_cast<char*>(&record), sizeof(record))
+                && record.magic == StampMagic && record.version == Version && record.stamp == stamp.hash && record.key != 0)
+            {
+                return record.key;
+            }
+        }
+
+        std::ifstream in(hdrPath, std::ios::binary);
+        if (!in)
+            return 0;
+
+        // The path is left out of the key on purpose: moving or renaming the HDR keeps its bake.
+        std::vector<char> chunk(1 << 20);
+        while (in)
+        {
+            in.read(chunk.data(), chunk.size());
+            h.Bytes(chunk.data(), static_cast<size_t>(in.gcount()));
+        }
+
+        KeyStamp record;
+        record.stamp = stamp.hash;
+        record.key = h.hash;
+
+        if (!FileUtils::WriteFileAtomic(stampPath, &record, sizeof(record)))
+            Q_WARNING("IBLBake: failed to write " + stampPath.string());
+
+        return h.hash;
+    }
+
+    std::filesystem::path IBLBake::GetCachePath(const IBLSettings& settings, uint64_t key)
+    {
+        return std::filesystem::path(settings.bakeCacheDir) / HexName(key, ".qeibl");
+    }
+
+    bool IBLBake::Save(const std::filesystem::path& path, uint64_t key, const IBLBakeData& data)
+    {
+        if (!data.IsComplete())
+            return false;
+
+        BakeHeader header;
+        header.key = key;
+        header.envRes = data.envRes;
+        header.irradianceRes = data.irradianceRes;
+        header.prefilterRes = data.prefilterRes;
+        header.prefilterLevels = static_cast<uint32_t>(data.prefilter.size());
+        header.brdfRes = data.brdfRes;
+
+        std::vector<uint16_t> halves;
+        halves.reserve(BakeFloatCount(header));
+        auto append = [&](const std::vector<float>& values) {
+            for (float v : values)
+                halves.push_back(glm::packHalf1x16(v));
+            };
+
+        append(data.environment);
+        append(data.irradiance);
+        for (const auto& level : data.prefilter)
+            append(level);
+        append(data.brdf);
+
+        const bool written = FileUtils::WriteFileAtomic(path, [&](std::ofstream& out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(halves.data()), halves.size() * sizeof(uint16_t));
+            });
+        if (!written)
+            Q_WARNING("IBLBake: failed to write " + path.string());
+        return written;
+    }
+
+    bool IBLBake::Load(const std::filesystem::path& path, uint64_t key, IBLBakeData& data)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+
+        BakeHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+
+        if (header.magic != BakeMagic || header.version != Version || header.key != key || header.prefilterLevels == 0)
+            return false;
+
+        std::vector<uint16_t> halves(BakeFloatCount(header));
+        if (!in.read(reinterpret_cast<char*>(halves.data()), halves.size() * sizeof(uint16_t)))
+            return false;
+
+        data.envRes = header.envRes;
+        data.irradianceRes = header.irradianceRes;
+        data.prefilterRes = header.prefilterRes;
+        data.brdfRes = header.brdfRes;
+
+        size_t cursor = 0;
+        auto extract = [&](std::vector<float>& values, size_t count) {
+            values.resize(count);
+            for (size_t i = 0; i < count; ++i)
+                values[i] = glm::unpackHalf1x16(halves[cursor + i]);
+            cursor += count;
+            };
+
+        extract(data.environment, IBLBakeData::FaceFloats(header.envRes) * 6);
+        extract(data.irradiance, IBLBakeData::FaceFloats(header.irradianceRes) * 6);
+        data.prefilter.resize(header.prefilterLevels);
+        for (uint32_t mip = 0; mip < header.prefilterLevels; ++mip)
+            extract(data.prefilter[mip], IBLBakeData::FaceFloats(std::max(1u, header.prefilterRes >> mip)) * 6);
+        extract(data.brdf, static_cast<size_t>(header.brdfRes) * header.brdfRes * 2);
+
+        return data.IsComplete();
+    }
+
+    bool IBLBake::BakeFromEquirect(const float* rgb, uint32_t width, uint32_t height, const IBLSettings& settings,
+        IBLBakeData& out, const IBLCpuBakeOptions& options)
+    {
+        if (!rgb || width == 0 || height == 0)
+            return false;
+
+        out = {};
+        out.envRes = settings.envRes;
+        out.irradianceRes = settings.irradianceRes;
+        out.prefilterRes = settings.prefilterRes;
+        out.brdfRes = settings.brdfRes;
+
+        // Environment: same mapping as equirectangular_to_cubemap, rows of the HDR bottom-up.
+        std::vector<CubeLevel> chain(1);
+        chain[0].res = settings.envRes;
+        chain[0].texels.resize(IBLBakeData::FaceFloats(settings.envRes) * 6);
+
+        auto equirect = [&](uint32_t x, uint32_t y) {
+            const float* p = rgb + (static_cast<size_t>(y) * width + x) * 3;
+            return glm::vec3(p[0], p[1], p[2]);
+            };
+
+        ForEachFaceTexel(settings.envRes, [&](uint32_t face, uint32_t x, uint32_t y)
+            {
+                const glm::vec3 n = FaceDirection(face, x, y, settings.envRes);
+                const float u = std::atan2(n.z, n.x) * 0.1591f + 0.5f;
+                const float v = std::asin(std::clamp(n.y, -1.0f, 1.0f)) * 0.3183f + 0.5f;
+
+                const float fx = u * width - 0.5f;
+                const float fy = std::clamp(v * height - 0.5f, 0.0f, height - 1.0f);
+                const int ix = static_cast<int>(std::floor(fx));
+                const uint32_t x0 = static_cast<uint32_t>((ix % static_cast<int>(width) + width) % width);
+                const uint32_t x1 = (x0 + 1) % width;
+                const uint32_t y0 = static_cast<uint32_t>(fy), y1 = std::min(y0 + 1, height - 1);
+                const float tx = fx - ix, ty = fy - y0;
+
+                const glm::vec3 c = glm::mix(
+                    glm::mix(equirect(x0, y0), equirect(x1, y0), tx),
+                    glm::mix(equirect(x0, y1), equirect(x1, y1), tx), ty);
+                Store(chain[0].texels, settings.envRes, face, x, y, c);
+            });
+
+        while (chain.back().res > 1)
+            chain.push_back(Downsample(chain.back()));
+
+        out.environment = chain[0].texels;
+
+        // Irradiance: cosine-weighted integral over a small copy of the environment.
+        const CubeLevel* source = &chain.back();
+        for (const CubeLevel& level : chain)
+            if (level.res >= options.irradianceSourceRes)
+                source = &level;
+
+        std::vector<glm::vec3> sourceDirs;
+        std::vector<glm::vec3> sourceRadiance;
+        for (uint32_t face = 0; face < 6; ++face)
+            for (uint32_t y = 0; y < source->res; ++y)
+                for (uint32_t x = 0; x < source->res; ++x)
+                {
+                    sourceDirs.push_back(FaceDirection(face, x, y, source->res));
+                    sourceRadiance.push_back(source->Texel(face, x, y) * TexelSolidAngle(x, y, source->res));
+                }
+
+        out.irradiance.resize(IBLBakeData::FaceFloats(settings.irradianceRes) * 6);
+        ForEachFaceTexel(settings.irradianceRes, [&](uint32_t face, uint32_t x, uint32_t y)
+            {
+                const glm::vec3 n = FaceDirection(face, x, y, settings.irradianceRes);
+                glm::vec3 sum(0.0f);
+                for (size_t i = 0; i < sourceDirs.size(); ++i)
+                    sum += sourceRadiance[i] * std::max(glm::dot(n, sourceDirs[i]), 0.0f);
+                Store(out.irradiance, settings.irradianceRes, face, x, y, sum / Pi);
+            });
+
+        // Prefilter: GGX importance sampling with the mip selection of prefilter.frag.
+        const uint32_t levels = PrefilterLevels(settings);
+        const float saTexel = 4.0f * Pi / (6.0f * settings.envRes * settings.envRes);
+
+        struct PrefilterSample { glm::vec3 l; float weight; float lod; };
+
+        out.prefilter.resize(levels);
+        for (uint32_t mip = 0; mip < levels; ++mip)
+        {
+            const uint32_t res = std::max(1u, settings.prefilterRes >> mip);
+            const float roughness = levels <= 1 ? 0.0f : static_cast<float>(mip) / (levels - 1);
+
+            std::vector<PrefilterSample> samples;
+            if (roughness == 0.0f)
+            {
+                samples.push_back({ glm::vec3(0.0f, 0.0f, 1.0f), 1.0f, 0.0f });
+            }
+            else
+            {
+                const uint32_t count = std::max(1u, options.prefilterSamples);
+                const float a2 = roughness * roughness * roughness * roughness;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const glm::vec3 h = ImportanceSampleGGX(i, count, roughness);
+                    const glm::vec3 l = 2.0f * h.z * h - glm::vec3(0.0f, 0.0f, 1.0f);
+                    if (l.z <= 0.0f)
+                        continue;
+
+                    const float denom = h.z * h.z * (a2 - 1.0f) + 1.0f;
+                    const float d = a2 / std::max(Pi * denom * denom, 1e-6f);
+                    // V = N, so NdotH / (4 HdotV) reduces to 1/4.
+                    const float pdf = d / 4.0f + 1e-4f;
+                    const float saSample = 1.0f / (count * pdf + 1e-4f);
+                    samples.push_back({ glm::normalize(l), l.z, 0.5f * std::log2(saSample / saTexel) });
+                }
+            }
+
+            std::vector<float>& target = out.prefilter[mip];
+            target.resize(IBLBakeData::FaceFloats(res) * 6);
+
+            ForEachFaceTexel(res, [&](uint32_t face, uint32_t x, uint32_t y)
+                {
+                    const glm::vec3 n = FaceDirection(face, x, y, res);
+                    glm::vec3 tangent, bitangent;
+                    TangentFrame(n, tangent, bitangent);
+
+                    glm::vec3 color(0.0f);
+                    float total = 0.0f;
+                    for (const PrefilterSample& s : samples)
+                    {
+                        const glm::vec3 l = tangent * s.l.x + bitangent * s.l.y + n * s.l.z;
+                        color += SampleLod(chain, l, s.lod) * s.weight;
+                        total += s.weight;
+                    }
+                    Store(target, res, face, x, y, color / std::max(total, 1e-4f));
+                });
+        }
+
+        // BRDF LUT: split-sum integration, x = NdotV, y = roughness.
+        const uint32_t brdfRes = settings.brdfRes;
+        const uint32_t brdfSamples = std::max(1u, options.brdfSamples);
+        out.brdf.resize(static_cast<size_t>(brdfRes) * brdfRes * 2);
+
+        JobSystem::Instance().ParallelFor(brdfRes, 1, [&](size_t row)
+            {
+                const uint32_t y = static_cast<uint32_t>(row);
+                const float roughness = (y + 0.5f) / brdfRes;
+                const float k = roughness * roughness / 2.0f;
+                auto g1 = [k](float ndot) { return ndot / (ndot * (1.0f - k) + k); };
+
+                for (uint32_t x = 0; x < brdfRes; ++x)
+                {
+                    const float nDotV = (x + 0.5f) / brdfRes;
+                    const glm::vec3 v(std::sqrt(std::max(1.0f - nDotV * nDotV, 0.0f)), 0.0f, nDotV);
+
+                    float a = 0.0f, b = 0.0f;
+                    for (uint32_t i = 0; i < brdfSamples; ++i)
+                    {
+                        const glm::vec3 h = ImportanceSampleGGX(i, brdfSamples, roughness);
+                        const glm::vec3 l = glm::normalize(2.0f * glm::dot(v, h) * h - v);
+
+                        const float nDotL = std::max(l.z, 0.0f);
+                        if (nDotL <= 0.0f)
+                            continue;
+
+                        const float nDotH = std::max(h.z, 0.0f);
+                        const float vDotH = std::max(glm::dot(v, h), 0.0f);
+                        const float gVis = (g1(nDotV) * g1(nDotL) * vDotH) / std::max(nDotH * nDotV, 1e-5f);
+                        const float fc = std::pow(1.0f - vDotH, 5.0f);
+
+                        a += (1.0f - fc) * gVis;
+                        b += fc * gVis;
+                    }
+
+                    float* texel = &out.brdf[(static_cast<size_t>(y) * brdfRes + x) * 2];
+                    texel[0] = a / brdfSamples;
+                    texel[1] = b / brdfSamples;
+                }
+            });
+
+        return out.IsComplete();
+    }
+
+    bool IBLBake::BakeToCache(const IBLSettings& settings, const IBLCpuBakeOptions& options)
+    {
+        const uint64_t key = ComputeKey(settings);
+        if (key == 0)
+        {
+            Q_ERROR("IBLBake: cannot read " + settings.hdrPath);
+            return false;
+        }
+
+        stbi_set_flip_vertically_on_load_thread(true);
+        int w = 0, h = 0, comp = 0;
+        float* hdr = stbi_loadf(settings.hdrPath.c_str(), &w, &h, &comp, 3);
+        if (!hdr)
+        {
+            Q_ERROR("IBLBake: failed to decode " + settings.hdrPath);
+            return false;
+        }
+
+        IBLBakeData data;
+        const bool baked = BakeFromEquirect(hdr, static_cast<uint32_t>(w), static_cast<uint32_t>(h), settings, data, options);
+        stbi_image_free(hdr);
+
+        return baked && Save(GetCachePath(settings, key), key, data);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace QuasarEngine
+{
+    struct IBLSettings
+    {
+        std::string hdrPath = "Assets/HDR/kloofendal_48d_partly_cloudy_puresky_4k.hdr";
+        uint32_t envRes = 1024;
+        uint32_t irradianceRes = 32;
+        uint32_t prefilterRes = 1024;
+        uint32_t brdfRes = 512;
+        uint32_t prefilterMipLevels = 5;
+
+        // Baked maps are reused from here when the HDR and the settings above are unchanged.
+        std::string bakeCacheDir = "Cache/IBL";
+        bool useBakeCache = true;
+    };
+
+    // CPU side of a baked environment. Cubemaps are RGB, stored face by face in GL face order
+    // (+X, -X, +Y, -Y, +Z, -Z), rows bottom-up; the BRDF LUT is RG.
+    struct IBLBakeData
+    {
+        uint32_t envRes = 0;
+        uint32_t irradianceRes = 0;
+        uint32_t prefilterRes = 0;
+        uint32_t brdfRes = 0;
+
+        std::vector<float> environment;
+        std::vector<float> irradiance;
+        std::vector<std::vector<float>> prefilter;
+        std::vector<float> brdf;
+
+        static size_t FaceFloats(uint32_t res) { return static_cast<size_t>(res) * res * 3; }
+
+        bool IsComplete() const;
+    };
+
+    struct IBLCpuBakeOptions
+    {
+        uint32_t prefilterSamples = 256;
+        uint32_t brdfSamples = 512;
+        // Irradiance is integrated over a downsampled copy of the environment.
+        uint32_t irradianceSourceRes = 32;
+    };
+
+    class IBLBake
+    {
+    public:
+        static constexpr uint32_t Version = 1;
+
+        // Number of prefilter levels actually rendered, shared by the GPU and CPU paths.
+        static uint32_t PrefilterLevels(const IBLSettings& settings);
+
+        // Hashes the HDR file content and the bake settings; 0 when the HDR cannot be read.
+        // The content hash is only recomputed when the HDR's path, size or mtime changed.
+        static uint64_t ComputeKey(const IBLSettings& settings);
+        static std::filesystem::path GetCachePath(const IBLSettings& settings, uint64_t key);
+
+        // Maps are stored as half floats, which is what the GPU targets hold anyway.
+        static bool Save(const std::filesystem::path& path, uint64_t key, const IBLBakeData& data);
+        static bool Load(const std::filesystem::path& path, uint64_t key, IBLBakeData& data);
+
+        // Offline path: produces the same maps as SkyboxHDR without a GPU.
+        static bool BakeFromEquirect(const float* rgb, uint32_t width, uint32_t height, const IBLSettings& settings,
+            IBLBakeData& out, const IBLCpuBakeOptions& options = {});
+
+        // Decodes settings.hdrPath, bakes on the CPU and writes the cache entry SkyboxHDR will pick up.
+        static bool BakeToCache(const IBLSettings& settings, const IBLCpuBakeOptions& options = {});
+    };
+}
@@ -2,6 +2,7 @@
 #include "Material.h"
 
 #include <QuasarEngine/Renderer/Renderer.h>
+#include <QuasarEngine/Tools/Hash.h>
 #include "QuasarEngine/Core/Logger.h"
 
 namespace QuasarEngine
@@ -154,4 +155,32 @@ namespace QuasarEngine
         idRef(type).reset();
         touch();
     }
+
+    std::uint64_t Material::GetContentHash() const noexcept
+    {
+        // Texture bindings only change through the setters, which bump the generation.
+        if (m_TextureHashGeneration != m_Generation)
+        {
+            Fnv1a h;
+            for (std::size_t i = 0; i < kTexCount; ++i)
+            {
+                const auto& id = idRef(static_cast<TextureType>(i));
+                h.U64(id.has_value());
+                if (id)
+                    h.String(*id);
+                h.U64(reinterpret_cast<std::uintptr_t>(m_Overrides[i]));
+            }
+
+            m_TextureHash = h.hash;
+            m_TextureHashGeneration = m_Generation;
+        }
+
+        Fnv1a h;
+        h.hash = m_TextureHash;
+        h.Bytes(&m_Specification.Albedo, sizeof(m_Specification.Albedo));
+        h.Bytes(&m_Specification.Metallic, sizeof(float));
+        h.Bytes(&m_Specification.Roughness, sizeof(float));
+        h.Bytes(&m_Specification.AO, sizeof(float));
+        return h.hash;
+    }
 }
\ No newline at end of file
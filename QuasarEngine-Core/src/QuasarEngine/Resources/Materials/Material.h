@@ -60,6 +60,9 @@ namespace QuasarEngine
 
         void touch() noexcept { ++m_Generation; }
 
+        mutable std::uint64_t m_TextureHash = 0;
+        mutable std::uint32_t m_TextureHashGeneration = std::numeric_limits<std::uint32_t>::max();
+
     public:
         explicit Material(const MaterialSpecification& specification);
         ~Material() = default;
@@ -88,6 +91,10 @@ namespace QuasarEngine
 
         void ResetTexture(TextureType type) noexcept;
 
+        // Equal for materials that render the same, whichever instance they are: the renderer
+        // batches on it. Scalars are rehashed every call since they are edited through references.
+        [[nodiscard]] std::uint64_t GetContentHash() const noexcept;
+
         static std::shared_ptr<Material> CreateMaterial(const MaterialSpecification& specification)
         {
             return std::make_shared<Material>(specification);
@@ -41,6 +41,29 @@ namespace QuasarEngine
         GenerateMesh(vertices, indices, std::move(layout));
     }
 
+    Mesh::Mesh(const void* vertexData, uint32_t vertexCount, const BufferLayout& layout,
+        const std::vector<unsigned int>& indices, MeshVertexFormat format,
+        const glm::vec3& boundsPosition, const glm::vec3& boundsSize)
+        : m_vertexFormat(format)
+    {
+        m_vertexArray = VertexArray::Create();
+
+        m_vertexBuffer = VertexBuffer::Create(vertexData, vertexCount * layout.GetStride());
+        m_vertexBuffer->SetLayout(layout);
+        m_vertexArray->AddVertexBuffer(m_vertexBuffer);
+
+        m_indexBuffer = IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size() * sizeof(unsigned int)));
+        m_vertexArray->SetIndexBuffer(m_indexBuffer);
+
+        m_vertexCount = vertexCount;
+        m_indexCount = indices.size();
+
+        m_boundingBoxPosition = boundsPosition;
+        m_boundingBoxSize = boundsSize;
+
+        m_meshGenerated = true;
+    }
+
     Mesh::~Mesh()
     {
         m_boneWeightBuffer.reset();
@@ -72,6 +95,18 @@ namespace QuasarEngine
         //}
     }
 
+    void Mesh::drawInstanced(uint32_t instanceCount) const
+    {
+        if (!m_vertexArray || instanceCount == 0) return;
+
+        m_vertexArray->Bind();
+
+        if (m_indexCount == 0)
+            RenderCommand::Instance().DrawArraysInstanced(m_drawMode, static_cast<uint32_t>(m_vertexCount), instanceCount);
+        else
+            RenderCommand::Instance().DrawElementsInstanced(m_drawMode, m_indexCount, instanceCount);
+    }
+
     void Mesh::GenerateMesh(std::vector<float>& vertices,
         std::vector<unsigned int>& indices,
         std::optional<BufferLayout> layout)
@@ -106,7 +141,7 @@ namespace QuasarEngine
             m_vertexArray->SetIndexBuffer(m_indexBuffer);
         //}
         
-		m_vertexCount = vertices.size() / m_vertexBuffer->GetLayout().GetStride();
+		m_vertexCount = vertices.size() * sizeof(float) / m_vertexBuffer->GetLayout().GetStride();
 		m_indexCount = indices.size();
 
         const uint32_t strideFloats = static_cast<uint32_t>(m_vertexBuffer->GetLayout().GetStride() / sizeof(float));
@@ -163,6 +198,14 @@ namespace QuasarEngine
         return true;
     }
 
+    std::size_t Mesh::GetGPUMemoryUsage() const
+    {
+        if (!m_vertexBuffer)
+            return 0;
+
+        return m_vertexCount * m_vertexBuffer->GetLayout().GetStride() + m_indexCount * sizeof(unsigned int);
+    }
+
     void Mesh::Clear()
     {
         m_vertices.clear();
@@ -15,6 +15,13 @@
 
 namespace QuasarEngine
 {
+    enum class MeshVertexFormat : uint8_t
+    {
+        Standard,
+        // 8 byte voxel faces, drawn by VoxelTechnique.
+        PackedVoxel
+    };
+
     class Mesh : public Asset
     {
     public:
@@ -23,9 +30,15 @@ namespace QuasarEngine
             std::optional<BufferLayout> layout = std::nullopt,
             DrawMode drawMode = DrawMode::TRIANGLES,
             std::optional<MaterialSpecification> material = std::nullopt);
+
+        // Vertices already in their GPU layout. No CPU copy is kept, so the bounds come from the caller.
+        Mesh(const void* vertexData, uint32_t vertexCount, const BufferLayout& layout,
+            const std::vector<unsigned int>& indices, MeshVertexFormat format,
+            const glm::vec3& boundsPosition, const glm::vec3& boundsSize);
         ~Mesh();
 
         void draw() const;
+        void drawInstanced(uint32_t instanceCount) const;
 
         void SetSkinning(const std::vector<int>& boneIDs,
             const std::vector<float>& boneWeights,
@@ -38,6 +51,7 @@ namespace QuasarEngine
             std::optional<BufferLayout> layout = std::nullopt);
 
         glm::vec3 GetBoundingBoxSize() const { return m_boundingBoxSize; }
+        glm::vec3 GetBoundingBoxPosition() const { return m_boundingBoxPosition; }
         bool IsVisible(const Math::Frustum& frustum, const glm::mat4& modelMatrix) const;
         bool IsMeshGenerated() const { return m_meshGenerated; }
 
@@ -60,6 +74,9 @@ namespace QuasarEngine
 
         bool HasSkinning() const { return m_hasSkinning; }
 
+        MeshVertexFormat GetVertexFormat() const { return m_vertexFormat; }
+        std::size_t GetGPUMemoryUsage() const;
+
         static AssetType GetStaticType() { return AssetType::MESH; }
         AssetType GetType() override { return GetStaticType(); }
 
@@ -76,6 +93,7 @@ namespace QuasarEngine
         bool m_hasSkinning = false;
 
         DrawMode m_drawMode = DrawMode::TRIANGLES;
+        MeshVertexFormat m_vertexFormat = MeshVertexFormat::Standard;
 
         std::vector<float> m_vertices;
         std::vector<unsigned int> m_indices;
@@ -9,7 +9,9 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <QuasarEngine/Resources/Model.h>
+#include <QuasarEngine/Resources/ModelCache.h>
 #include <QuasarEngine/Asset/AssetManager.h>
+#include <QuasarEngine/Core/Logger.h>
 
 namespace QuasarEngine
 {
@@ -206,59 +208,74 @@ namespace QuasarEngine
         return out;
     }
 
-    std::unique_ptr<ModelNode> Model::buildNode(const aiNode* src, const aiScene* scene, const ModelImportOptions* opt)
+    std::shared_ptr<Mesh> Model::createMesh(ModelNode* node, const std::string& key, BuiltGeometry&& geom, const ModelImportOptions* opt)
+    {
+        if (opt && !opt->buildMeshes)
+            return nullptr;
+
+        if (m_DeferUpload) {
+            PendingMesh pending;
+            pending.node = node;
+            pending.instance = node->meshes.size();
+            pending.key = key;
+            pending.geometry = std::move(geom);
+            pending.layout = opt ? opt->vertexLayout : std::optional<BufferLayout>{};
+            pending.drawMode = opt ? opt->drawMode : DrawMode::TRIANGLES;
+            m_PendingMeshes.push_back(std::move(pending));
+            return nullptr;
+        }
+
+        if (auto it = m_meshLibrary.find(key); it != m_meshLibrary.end())
+            return it->second;
+
+        auto meshAsset = std::make_shared<Mesh>(
+            geom.vertices,
+            geom.indices,
+            opt ? opt->vertexLayout : std::optional<BufferLayout>{},
+            opt ? opt->drawMode : DrawMode::TRIANGLES,
+            std::nullopt
+        );
+        if (geom.skinned) {
+            meshAsset->SetSkinning(geom.boneIDs, geom.boneWeights, QE_MAX_BONE_INFLUENCE);
+        }
+        m_meshLibrary.emplace(key, meshAsset);
+        return meshAsset;
+    }
+
+    std::unique_ptr<ModelNode> Model::buildNode(const aiNode* src, const aiScene* scene, const ModelImportOptions* opt, int32_t cacheParent)
     {
         auto node = std::make_unique<ModelNode>();
         node->name = src->mName.C_Str();
         node->localTransform = AiToGlmLocal(src->mTransformation);
 
+        const int32_t cacheIndex = m_CacheWriter ? static_cast<int32_t>(m_CacheWriter->AddNode(node->name, node->localTransform, cacheParent)) : -1;
+
         for (unsigned i = 0; i < src->mNumMeshes; ++i)
         {
             const aiMesh* aimesh = scene->mMeshes[src->mMeshes[i]];
             BuiltGeometry geom = opt ? buildMeshGeometry(aimesh, *opt) : buildMeshGeometry(aimesh, ModelImportOptions{});
             const std::string key = node->name + ":" + aimesh->mName.C_Str() + ":" + std::to_string(i);
-            std::shared_ptr<Mesh> meshAsset;
-
-            if (!opt || opt->buildMeshes) {
-                if (auto it = m_meshLibrary.find(key); it == m_meshLibrary.end()) {
-                    meshAsset = std::make_shared<Mesh>(
-                        std::move(geom.vertices),
-                        std::move(geom.indices),
-                        opt ? opt->vertexLayout : std::optional<BufferLayout>{},
-                        opt ? opt->drawMode : DrawMode::TRIANGLES,
-                        std::nullopt
-                    );
-                    if (geom.skinned) {
-                        meshAsset->SetSkinning(geom.boneIDs, geom.boneWeights, QE_MAX_BONE_INFLUENCE);
-                    }
-                    m_meshLibrary.emplace(key, meshAsset);
-                }
-                else {
-                    meshAsset = it->second;
-                }
-            }
-            else {
-                meshAsset = nullptr;
-            }
 
             MeshInstance inst;
             inst.name = aimesh->mName.length ? aimesh->mName.C_Str() : MakeUniqueChildName("mesh", static_cast<int>(i));
-            inst.mesh = meshAsset;
             inst.skinned = geom.skinned;
 
-            MaterialSpecification mat;
             if (!opt || opt->loadMaterials) {
                 if (aimesh->mMaterialIndex >= 0)
-                    mat = loadMaterial(scene->mMaterials[aimesh->mMaterialIndex], m_SourceDir);
+                    inst.material = loadMaterial(scene->mMaterials[aimesh->mMaterialIndex], m_SourceDir);
             }
-            inst.material = std::move(mat);
+
+            if (m_CacheWriter)
+                m_CacheWriter->AddMesh(key, inst.name, inst.material, geom.skinned, geom.vertices, geom.indices, geom.boneIDs, geom.boneWeights);
+
+            inst.mesh = createMesh(node.get(), key, std::move(geom), opt);
 
             node->meshes.push_back(std::move(inst));
         }
 
         node->children.reserve(src->mNumChildren);
         for (unsigned c = 0; c < src->mNumChildren; ++c) {
-            node->children.push_back(buildNode(src->mChildren[c], scene, opt));
+            node->children.push_back(buildNode(src->mChildren[c], scene, opt, cacheIndex));
         }
 
         return node;
@@ -324,6 +341,11 @@ namespace QuasarEngine
         m_SourcePath = std::filesystem::path(path);
         m_SourceDir = m_SourcePath.parent_path();
 
+        uint64_t cacheKey = 0;
+        std::filesystem::path cachePath;
+        if (loadCached(nullptr, cacheKey, cachePath))
+            return;
+
         Assimp::Importer importer;
         importer.SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, QE_MAX_BONE_INFLUENCE);
 
@@ -352,23 +374,17 @@ namespace QuasarEngine
         }
 
         m_Name = scene->mRootNode->mName.C_Str();
+
+        ModelCacheWriter writer;
+        m_CacheWriter = cacheKey ? &writer : nullptr;
         m_root = buildNode(scene->mRootNode, scene, nullptr);
+        m_CacheWriter = nullptr;
 
         glm::mat4 rootM = AiToGlmLocal(scene->mRootNode->mTransformation);
         m_GlobalInverse = glm::inverse(rootM);
 
-        m_Loaded.meshes.clear();
-        ForEachInstance([&](const MeshInstance& inst, const glm::mat4&, const std::string& pathStr) {
-            ModelLoadedInfo::MeshInfo info;
-            info.nodePath = pathStr;
-            info.name = inst.name;
-            info.mesh = inst.mesh;
-            info.material = inst.material;
-            info.skinned = inst.skinned;
-            m_Loaded.meshes.push_back(std::move(info));
-            });
-        m_Loaded.bones = m_boneInfoMap;
-        m_Loaded.globalInverse = m_GlobalInverse;
+        RebuildLoadedInfo();
+        storeCache(writer, cacheKey, cachePath);
     }
 
     void Model::loadFromFile(const std::string& path, const ModelImportOptions& opt)
@@ -376,6 +392,11 @@ namespace QuasarEngine
         m_SourcePath = std::filesystem::path(path);
         m_SourceDir = m_SourcePath.parent_path();
 
+        uint64_t cacheKey = 0;
+        std::filesystem::path cachePath;
+        if (loadCached(&opt, cacheKey, cachePath))
+            return;
+
         Assimp::Importer importer;
         importer.SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, opt.maxBoneWeights);
 
@@ -406,11 +427,108 @@ namespace QuasarEngine
         }
 
         m_Name = scene->mRootNode->mName.C_Str();
+
+        ModelCacheWriter writer;
+        m_CacheWriter = cacheKey ? &writer : nullptr;
         m_root = buildNode(scene->mRootNode, scene, &opt);
+        m_CacheWriter = nullptr;
 
         glm::mat4 rootM = AiToGlmLocal(scene->mRootNode->mTransformation);
         m_GlobalInverse = glm::inverse(rootM);
 
+        RebuildLoadedInfo();
+        storeCache(writer, cacheKey, cachePath);
+    }
+
+    bool Model::loadCached(const ModelImportOptions* opt, uint64_t& key, std::filesystem::path& cachePath)
+    {
+        const ModelImportOptions defaults;
+        const ModelImportOptions& settings = opt ? *opt : defaults;
+
+        key = 0;
+        if (!settings.useCache)
+            return false;
+
+        // Material texture ids are relative to the project, so it takes part in the key.
+        key = ModelCache::ComputeKey(m_SourcePath, opt, AssetManager::Instance().getAssetPath().generic_string());
+        if (key == 0)
+            return false;
+
+        cachePath = ModelCache::GetCachePath(settings.cacheDir, key);
+
+        ModelCacheView cache;
+        return cache.Open(cachePath, key) && loadFromCache(cache, opt);
+    }
+
+    bool Model::loadFromCache(const ModelCacheView& cache, const ModelImportOptions* opt)
+    {
+        const uint32_t nodeCount = cache.GetNodeCount();
+        if (nodeCount == 0)
+            return false;
+
+        std::vector<ModelNode*> nodes(nodeCount, nullptr);
+        for (uint32_t i = 0; i < nodeCount; ++i)
+        {
+            const ModelCacheView::NodeView src = cache.GetNode(i);
+
+            auto node = std::make_unique<ModelNode>();
+            node->name = std::string(src.name);
+            node->localTransform = src.transform;
+            node->meshes.reserve(src.meshCount);
+
+            for (uint32_t m = src.firstMesh; m < src.firstMesh + src.meshCount; ++m)
+            {
+                const ModelCacheView::MeshView mesh = cache.GetMesh(m);
+
+                BuiltGeometry geom;
+                geom.vertices.assign(mesh.vertices, mesh.vertices + mesh.vertexFloats);
+                geom.indices.assign(mesh.indices, mesh.indices + mesh.indexCount);
+                geom.skinned = mesh.skinned;
+                if (mesh.influenceCount) {
+                    geom.boneIDs.assign(mesh.boneIDs, mesh.boneIDs + mesh.influenceCount);
+                    geom.boneWeights.assign(mesh.boneWeights, mesh.boneWeights + mesh.influenceCount);
+                }
+
+                MeshInstance inst;
+                inst.name = std::string(mesh.name);
+                inst.material = cache.GetMeshMaterial(m);
+                inst.skinned = mesh.skinned;
+                inst.mesh = createMesh(node.get(), std::string(mesh.key), std::move(geom), opt);
+
+                node->meshes.push_back(std::move(inst));
+            }
+
+            nodes[i] = node.get();
+            if (src.parent < 0)
+                m_root = std::move(node);
+            else
+                nodes[src.parent]->children.push_back(std::move(node));
+        }
+
+        m_Name = std::string(cache.GetName());
+        m_GlobalInverse = cache.GetGlobalInverse();
+        cache.ReadBones(m_boneInfoMap);
+        m_boneCount = cache.GetBoneIdCounter();
+
+        RebuildLoadedInfo();
+        return true;
+    }
+
+    void Model::storeCache(ModelCacheWriter& writer, uint64_t key, const std::filesystem::path& cachePath)
+    {
+        if (key == 0)
+            return;
+
+        writer.SetName(m_Name);
+        writer.SetGlobalInverse(m_GlobalInverse);
+        writer.SetBones(m_boneInfoMap, m_boneCount);
+
+        if (!writer.Save(cachePath, key))
+            Q_WARNING("Model: failed to write cache entry for " + m_SourcePath.string());
+    }
+
+    void Model::RebuildLoadedInfo()
+    {
         m_Loaded.meshes.clear();
         ForEachInstance([&](const MeshInstance& inst, const glm::mat4&, const std::string& pathStr) {
             ModelLoadedInfo::MeshInfo info;
@@ -425,6 +543,54 @@ namespace QuasarEngine
         m_Loaded.globalInverse = m_GlobalInverse;
     }
 
+    std::shared_ptr<Model> Model::ImportModel(const std::string& path, const ModelImportOptions* options)
+    {
+        std::shared_ptr<Model> model(new Model());
+        model->m_DeferUpload = true;
+
+        if (options)
+            model->loadFromFile(path, *options);
+        else
+            model->loadFromFile(path);
+
+        return model;
+    }
+
+    bool Model::UploadPendingMeshes(size_t maxMeshes)
+    {
+        size_t uploaded = 0;
+        while (m_PendingCursor < m_PendingMeshes.size() && uploaded < maxMeshes)
+        {
+            PendingMesh& pending = m_PendingMeshes[m_PendingCursor++];
+
+            std::shared_ptr<Mesh> mesh;
+            if (auto it = m_meshLibrary.find(pending.key); it != m_meshLibrary.end()) {
+                mesh = it->second;
+            }
+            else {
+                mesh = std::make_shared<Mesh>(pending.geometry.vertices, pending.geometry.indices, pending.layout, pending.drawMode, std::nullopt);
+                if (pending.geometry.skinned)
+                    mesh->SetSkinning(pending.geometry.boneIDs, pending.geometry.boneWeights, QE_MAX_BONE_INFLUENCE);
+                m_meshLibrary.emplace(pending.key, mesh);
+            }
+
+            pending.node->meshes[pending.instance].mesh = std::move(mesh);
+            pending.geometry = BuiltGeometry{};
+            ++uploaded;
+        }
+
+        if (m_PendingCursor < m_PendingMeshes.size())
+            return false;
+
+        if (!m_PendingMeshes.empty())
+        {
+            m_PendingMeshes.clear();
+            m_PendingCursor = 0;
+            RebuildLoadedInfo();
+        }
+        return true;
+    }
+
     void Model::ForEachInstance(const std::function<void(const MeshInstance&, const glm::mat4&, const std::string&)>& fn) const
     {
         if (!m_root) return;
@@ -9,6 +9,7 @@
 #include <optional>
 #include <stack>
 #include <algorithm>
+#include <cstdint>
 
 #include <glm/glm.hpp>
 #include <QuasarEngine/Resources/Mesh.h>
@@ -23,6 +24,9 @@ struct aiMaterial;
 
 namespace QuasarEngine
 {
+    class ModelCacheWriter;
+    class ModelCacheView;
+
     struct MeshInstance {
         std::string name;
         std::shared_ptr<Mesh> mesh;
@@ -60,6 +64,15 @@ namespace QuasarEngine
             DrawMode drawMode = DrawMode::TRIANGLES,
             std::optional<MaterialSpecification> material = std::nullopt);
 
+        // Assimp import only, safe on a worker thread. The meshes stay on the CPU until
+        // UploadPendingMeshes() runs on the render thread.
+        static std::shared_ptr<Model> ImportModel(const std::string& path, const ModelImportOptions* options = nullptr);
+
+        bool HasPendingUploads() const { return !m_PendingMeshes.empty(); }
+
+        // Creates at most maxMeshes GPU meshes, returns true once nothing is left to upload.
+        bool UploadPendingMeshes(size_t maxMeshes = SIZE_MAX);
+
         const ModelNode* GetRoot() const { return m_root.get(); }
         ModelNode* GetRoot() { return m_root.get(); }
 
@@ -84,10 +97,12 @@ namespace QuasarEngine
         AssetType GetType() override { return GetStaticType(); }
 
     private:
+        Model() = default;
+
         void loadFromFile(const std::string& path);
         void loadFromFile(const std::string& path, const ModelImportOptions& options);
 
-        std::unique_ptr<ModelNode> buildNode(const aiNode* src, const aiScene* scene, const ModelImportOptions* opt);
+        std::unique_ptr<ModelNode> buildNode(const aiNode* src, const aiScene* scene, const ModelImportOptions* opt, int32_t cacheParent = -1);
 
         struct BuiltGeometry {
             std::vector<float>         vertices;
@@ -99,6 +114,25 @@ namespace QuasarEngine
 
         BuiltGeometry buildMeshGeometry(const aiMesh* mesh, const ModelImportOptions& opt);
 
+        struct PendingMesh {
+            ModelNode*                   node = nullptr;
+            size_t                       instance = 0;
+            std::string                  key;
+            BuiltGeometry                geometry;
+            std::optional<BufferLayout>  layout;
+            DrawMode                     drawMode = DrawMode::TRIANGLES;
+        };
+
+        // Creates the GPU mesh or queues it for UploadPendingMeshes(); null when deferred or not building meshes.
+        std::shared_ptr<Mesh> createMesh(ModelNode* node, const std::string& key, BuiltGeometry&& geom, const ModelImportOptions* opt);
+
+        // On a miss, key and cachePath are left for storeCache (key stays 0 when caching is off).
+        bool loadCached(const ModelImportOptions* opt, uint64_t& key, std::filesystem::path& cachePath);
+        bool loadFromCache(const ModelCacheView& cache, const ModelImportOptions* opt);
+        void storeCache(ModelCacheWriter& writer, uint64_t key, const std::filesystem::path& cachePath);
+
+        void RebuildLoadedInfo();
+
         MaterialSpecification loadMaterial(const aiMaterial* material, const std::filesystem::path& modelDir);
 
         static std::string MakeUniqueChildName(const std::string& base, int index);
@@ -121,5 +155,12 @@ namespace QuasarEngine
         std::filesystem::path m_SourceDir;
 
         ModelLoadedInfo m_Loaded;
+
+        bool m_DeferUpload = false;
+        std::vector<PendingMesh> m_PendingMeshes;
+        size_t m_PendingCursor = 0;
+
+        // Only set while an import is being recorded for the model cache.
+        ModelCacheWriter* m_CacheWriter = nullptr;
     };
 }
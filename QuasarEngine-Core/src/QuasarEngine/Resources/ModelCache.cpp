@@ -0,0 +1,649 @@
+#include "qepch.h"
+#include <QuasarEngine/Resources/ModelCache.h>
+
+#include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Tools/Hash.h>
+#include <QuasarEngine/File/FileUtils.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+
+#include <glm/gtc/type_ptr.hpp>
+
+namespace QuasarEngine
+{
+    namespace
+    {
+        constexpr uint32_t CacheMagic = 0x434D4551; // "QEMC"
+        constexpr uint64_t SectionAlign = 16;
+
+        static_assert(std::is_trivially_copyable_v<KeyPosition>);
+        static_assert(std::is_trivially_copyable_v<KeyRotation>);
+        static_assert(std::is_trivially_copyable_v<KeyScale>);
+
+        uint64_t AlignUp(uint64_t value) { return (value + SectionAlign - 1) & ~(SectionAlign - 1); }
+
+        void CopyMatrix(float (&dst)[16], const glm::mat4& m) { std::memcpy(dst, glm::value_ptr(m), sizeof(dst)); }
+
+        glm::mat4 ToMatrix(const float (&src)[16]) { return glm::make_mat4(src); }
+
+        template<typename T>
+        bool InRange(uint64_t offset, uint64_t count, uint64_t limit)
+        {
+            return offset <= limit && count <= (limit - offset) / sizeof(T);
+        }
+
+        template<typename T>
+        void CopyKeys(std::vector<T>& dst, const uint8_t* src, uint32_t count)
+        {
+            dst.resize(count);
+            if (count)
+                std::memcpy(dst.data(), src, static_cast<size_t>(count) * sizeof(T));
+        }
+
+        std::string_view Trim(std::string_view text)
+        {
+            const size_t begin = text.find_first_not_of(" \t\r");
+            if (begin == std::string_view::npos)
+                return {};
+            return text.substr(begin, text.find_last_not_of(" \t\r") - begin + 1);
+        }
+
+        template<typename Func>
+        void ForEachLine(std::string_view text, Func&& func)
+        {
+            while (!text.empty())
+            {
+                const size_t end = text.find('\n');
+                func(Trim(text.substr(0, end)));
+                text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
+            }
+        }
+
+        std::string_view LastToken(std::string_view line)
+        {
+            const size_t space = line.find_last_of(" \t");
+            return space == std::string_view::npos ? line : line.substr(space + 1);
+        }
+
+        // Texture maps of an OBJ material library. Options (-bm 1, -clamp on, ...) come before the file name.
+        void CollectMtlDependencies(const std::filesystem::path& library, std::vector<std::filesystem::path>& out)
+        {
+            std::ifstream in(library, std::ios::binary);
+            if (!in)
+                return;
+
+            const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            ForEachLine(text, [&](std::string_view line) {
+                const std::string_view keyword = line.substr(0, line.find_first_of(" \t"));
+                if (keyword.size() == line.size())
+                    return;
+
+                if (keyword.rfind("map_", 0) == 0 || keyword == "bump" || keyword == "disp" || keyword == "decal"
+                    || keyword == "refl" || keyword == "norm")
+                {
+                    out.push_back(library.parent_path() / std::string(LastToken(line)));
+                }
+                });
+        }
+
+        void CollectObjDependencies(const std::filesystem::path& source, std::string_view text, std::vector<std::filesystem::path>& out)
+        {
+            ForEachLine(text, [&](std::string_view line) {
+                if (line.rfind("mtllib", 0) != 0 || line.size() <= 6 || (line[6] != ' ' && line[6] != '\t'))
+                    return;
+
+                // Usually a single library; names with spaces only work as the whole rest of the line.
+                const std::string_view names = Trim(line.substr(6));
+                std::vector<std::filesystem::path> libraries{ source.parent_path() / std::string(names) };
+                if (!std::filesystem::exists(libraries.front()))
+                {
+                    libraries.clear();
+                    for (std::string_view rest = names; !rest.empty();)
+                    {
+                        const size_t space = rest.find_first_of(" \t");
+                        libraries.push_back(source.parent_path() / std::string(rest.substr(0, space)));
+                        rest = space == std::string_view::npos ? std::string_view{} : Trim(rest.substr(space));
+                    }
+                }
+
+                for (const auto& library : libraries)
+                {
+                    out.push_back(library);
+                    CollectMtlDependencies(library, out);
+                }
+                });
+        }
+
+        // External buffers and images of a glTF document; data: URIs are inline and skipped.
+        void CollectGltfDependencies(const std::filesystem::path& source, std::string_view json, std::vector<std::filesystem::path>& out)
+        {
+            for (size_t pos = json.find("\"uri\""); pos != std::string_view::npos; pos = json.find("\"uri\"", pos))
+            {
+                pos = json.find_first_not_of(" \t\r\n:", pos + 5);
+                if (pos == std::string_view::npos || json[pos] != '"')
+                    continue;
+
+                const size_t end = json.find('"', pos + 1);
+                if (end == std::string_view::npos)
+                    return;
+
+                const std::string_view uri = json.substr(pos + 1, end - pos - 1);
+                pos = end;
+                if (uri.rfind("data:", 0) == 0)
+                    continue;
+
+                std::string decoded;
+                for (size_t i = 0; i < uri.size(); ++i)
+                {
+                    if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1]))
+                        && std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+                    {
+                        decoded += static_cast<char>(std::stoi(std::string(uri.substr(i + 1, 2)), nullptr, 16));
+                        i += 2;
+                    }
+                    else if (uri[i] != '\\')
+                    {
+                        decoded += uri[i];
+                    }
+                }
+                out.push_back(source.parent_path() / std::filesystem::u8path(decoded));
+            }
+        }
+
+        // Files the importer reads besides the source itself. Other formats are treated as self-contained.
+        std::vector<std::filesystem::path> ListDependencies(const std::filesystem::path& source, const MappedFile& file)
+        {
+            std::vector<std::filesystem::path> out;
+
+            std::string extension = source.extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            const std::string_view text(reinterpret_cast<const char*>(file.Data()), file.Size());
+            if (extension == ".obj")
+            {
+                CollectObjDependencies(source, text, out);
+            }
+            else if (extension == ".gltf")
+            {
+                CollectGltfDependencies(source, text, out);
+            }
+            else if (extension == ".glb" && file.Size() >= 20)
+            {
+                // 12-byte header, then the JSON chunk: length, type, payload.
+                uint32_t length = 0, type = 0;
+                std::memcpy(&length, file.Data() + 12, sizeof(length));
+                std::memcpy(&type, file.Data() + 16, sizeof(type));
+                if (type == 0x4E4F534A && length <= file.Size() - 20)
+                    CollectGltfDependencies(source, text.substr(20, length), out);
+            }
+
+            return out;
+        }
+    }
+
+    uint64_t ModelCache::ComputeKey(const std::filesystem::path& source, const ModelImportOptions* options, const std::string& context)
+    {
+        MappedFile file;
+        if (!file.Open(source))
+            return 0;
+
+        Fnv1a h;
+        h.U64(Version);
+        h.String(context);
+
+        // The path is left out on purpose: moving or renaming the file keeps its entry.
+        h.U64(file.Size());
+        h.Words(file.Data(), file.Size());
+
+        h.U64(options != nullptr);
+        if (options)
+        {
+            const ModelImportOptions& o = *options;
+            const bool flags[] = {
+                o.loadPositions, o.loadNormals, o.generateNormals, o.loadTangents, o.generateTangents,
+                o.loadTexcoords0, o.flipUVs, o.loadMaterials, o.loadSkinning, o.loadAnimations,
+                o.improveCacheLocality, o.joinIdenticalVertices, o.triangulate, o.genUVIfMissing, o.buildMeshes
+            };
+            for (bool flag : flags)
+                h.U64(flag);
+
+            h.U64(static_cast<uint64_t>(o.maxBoneWeights));
+            h.U64(static_cast<uint64_t>(o.drawMode));
+
+            h.U64(o.vertexLayout.has_value());
+            if (o.vertexLayout)
+            {
+                for (const BufferElement& element : *o.vertexLayout)
+                {
+                    h.String(element.Name);
+                    h.U64(static_cast<uint64_t>(element.Type));
+                    h.U64(element.Normalized);
+                }
+            }
+        }
+
+        // Referenced files are keyed by relative path, size and mtime, so editing a .bin, a texture
+        // or a material library invalidates the entry without hashing their contents.
+        for (const auto& dependency : ListDependencies(source, file))
+        {
+            std::error_code ec;
+            h.String(dependency.lexically_relative(source.parent_path()).generic_string());
+
+            const uintmax_t size = std::filesystem::file_size(dependency, ec);
+            h.U64(ec ? ~0ull : static_cast<uint64_t>(size));
+
+            const auto modified = std::filesystem::last_write_time(dependency, ec);
+            h.U64(ec ? 0 : static_cast<uint64_t>(modified.time_since_epoch().count()));
+        }
+
+        return h.hash;
+    }
+
+    std::filesystem::path ModelCache::GetCachePath(const std::filesystem::path& directory, uint64_t key)
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".qemodel";
+        return directory / name.str();
+    }
+
+    ModelCacheFormat::StringRef ModelCacheWriter::AddString(const std::string& text)
+    {
+        ModelCacheFormat::StringRef ref;
+        ref.offset = static_cast<uint32_t>(m_Strings.size());
+        ref.length = static_cast<uint32_t>(text.size());
+        m_Strings.insert(m_Strings.end(), text.begin(), text.end());
+        return ref;
+    }
+
+    uint64_t ModelCacheWriter::AddData(const void* data, size_t size)
+    {
+        const uint64_t offset = AlignUp(m_Data.size());
+        m_Data.resize(static_cast<size_t>(offset) + size);
+        if (size)
+            std::memcpy(m_Data.data() + offset, data, size);
+        return offset;
+    }
+
+    uint32_t ModelCacheWriter::AddNode(const std::string& name, const glm::mat4& localTransform, int32_t parent)
+    {
+        ModelCacheFormat::Node node;
+        node.name = AddString(name);
+        node.parent = parent;
+        node.firstMesh = static_cast<uint32_t>(m_Meshes.size());
+        CopyMatrix(node.transform, localTransform);
+        m_Nodes.push_back(node);
+        return static_cast<uint32_t>(m_Nodes.size() - 1);
+    }
+
+    void ModelCacheWriter::AddMesh(const std::string& key, const std::string& name, const MaterialSpecification& material, bool skinned,
+        const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+        const std::vector<int>& boneIDs, const std::vector<float>& boneWeights)
+    {
+        if (m_Nodes.empty())
+            return;
+
+        ModelCacheFormat::Mesh mesh;
+        mesh.key = AddString(key);
+        mesh.name = AddString(name);
+        mesh.skinned = skinned ? 1u : 0u;
+
+        mesh.vertexFloats = static_cast<uint32_t>(vertices.size());
+        mesh.vertexOffset = AddData(vertices.data(), vertices.size() * sizeof(float));
+        mesh.indexCount = static_cast<uint32_t>(indices.size());
+        mesh.indexOffset = AddData(indices.data(), indices.size() * sizeof(unsigned int));
+
+        if (skinned && boneIDs.size() == boneWeights.size())
+        {
+            mesh.influenceCount = static_cast<uint32_t>(boneIDs.size());
+            mesh.boneIdOffset = AddData(boneIDs.data(), boneIDs.size() * sizeof(int));
+            mesh.boneWeightOffset = AddData(boneWeights.data(), boneWeights.size() * sizeof(float));
+        }
+
+        const std::optional<std::string>* textures[5] = {
+            &material.AlbedoTexture, &material.NormalTexture, &material.MetallicTexture,
+            &material.RoughnessTexture, &material.AOTexture
+        };
+        for (uint32_t t = 0; t < 5; ++t)
+        {
+            if (!*textures[t])
+                continue;
+            mesh.material.textures[t] = AddString(**textures[t]);
+            mesh.material.textureMask |= 1u << t;
+        }
+        std::memcpy(mesh.material.albedo, glm::value_ptr(material.Albedo), sizeof(mesh.material.albedo));
+        mesh.material.metallic = material.Metallic;
+        mesh.material.roughness = material.Roughness;
+        mesh.material.ao = material.AO;
+
+        m_Meshes.push_back(mesh);
+        ++m_Nodes.back().meshCount;
+    }
+
+    void ModelCacheWriter::SetName(const std::string& name)
+    {
+        m_Header.name = AddString(name);
+    }
+
+    void ModelCacheWriter::SetGlobalInverse(const glm::mat4& globalInverse)
+    {
+        CopyMatrix(m_Header.globalInverse, globalInverse);
+    }
+
+    void ModelCacheWriter::SetBones(const std::unordered_map<std::string, BoneInfo>& bones, int boneIdCounter)
+    {
+        m_Bones.clear();
+        m_Bones.reserve(bones.size());
+        for (const auto& [name, info] : bones)
+        {
+            ModelCacheFormat::Bone bone;
+            bone.name = AddString(name);
+            bone.id = info.id;
+            CopyMatrix(bone.offset, info.offset);
+            m_Bones.push_back(bone);
+        }
+        m_Header.boneIdCounter = boneIdCounter;
+    }
+
+    void ModelCacheWriter::SetClips(const std::vector<AnimationClip>& clips)
+    {
+        m_Clips.clear();
+        m_Channels.clear();
+        for (const AnimationClip& source : clips)
+        {
+            ModelCacheFormat::Clip clip;
+            clip.name = AddString(source.name);
+            clip.duration = source.duration;
+            clip.ticksPerSecond = source.ticksPerSecond;
+            clip.firstChannel = static_cast<uint32_t>(m_Channels.size());
+            clip.channelCount = static_cast<uint32_t>(source.channels.size());
+
+            for (const auto& [nodeName, channel] : source.channels)
+            {
+                ModelCacheFormat::Channel record;
+                record.nodeName = AddString(nodeName);
+                record.positionCount = static_cast<uint32_t>(channel.positions.size());
+                record.rotationCount = static_cast<uint32_t>(channel.rotations.size());
+                record.scaleCount = static_cast<uint32_t>(channel.scales.size());
+                record.positionOffset = AddData(channel.positions.data(), channel.positions.size() * sizeof(KeyPosition));
+                record.rotationOffset = AddData(channel.rotations.data(), channel.rotations.size() * sizeof(KeyRotation));
+                record.scaleOffset = AddData(channel.scales.data(), channel.scales.size() * sizeof(KeyScale));
+                m_Channels.push_back(record);
+            }
+
+            m_Clips.push_back(clip);
+        }
+    }
+
+    bool ModelCacheWriter::Save(const std::filesystem::path& path, uint64_t key) const
+    {
+        ModelCacheFormat::Header header = m_Header;
+        header.magic = CacheMagic;
+        header.version = ModelCache::Version;
+        header.key = key;
+
+        header.nodeCount = static_cast<uint32_t>(m_Nodes.size());
+        header.meshCount = static_cast<uint32_t>(m_Meshes.size());
+        header.boneCount = static_cast<uint32_t>(m_Bones.size());
+        header.clipCount = static_cast<uint32_t>(m_Clips.size());
+        header.channelCount = static_cast<uint32_t>(m_Channels.size());
+
+        uint64_t cursor = AlignUp(sizeof(header));
+        auto place = [&](uint64_t& offset, uint64_t bytes) {
+            offset = cursor;
+            cursor = AlignUp(cursor + bytes);
+            };
+
+        place(header.nodesOffset, m_Nodes.size() * sizeof(ModelCacheFormat::Node));
+        place(header.meshesOffset, m_Meshes.size() * sizeof(ModelCacheFormat::Mesh));
+        place(header.bonesOffset, m_Bones.size() * sizeof(ModelCacheFormat::Bone));
+        place(header.clipsOffset, m_Clips.size() * sizeof(ModelCacheFormat::Clip));
+        place(header.channelsOffset, m_Channels.size() * sizeof(ModelCacheFormat::Channel));
+        header.stringsSize = m_Strings.size();
+        place(header.stringsOffset, header.stringsSize);
+        header.dataSize = m_Data.size();
+        place(header.dataOffset, header.dataSize);
+        header.fileSize = header.dataOffset + header.dataSize;
+
+        // Two loaders may import the same model at once, each writes its own temporary.
+        const bool written = FileUtils::WriteFileAtomic(path, [&](std::ofstream& out) {
+            auto write = [&](uint64_t offset, const void* data, size_t size) {
+                const uint64_t at = static_cast<uint64_t>(out.tellp());
+                if (offset > at)
+                {
+                    static const char zeros[SectionAlign] = {};
+                    out.write(zeros, static_cast<std::streamsize>(offset - at));
+                }
+                if (size)
+                    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                };
+
+            write(0, &header, sizeof(header));
+            write(header.nodesOffset, m_Nodes.data(), m_Nodes.size() * sizeof(ModelCacheFormat::Node));
+            write(header.meshesOffset, m_Meshes.data(), m_Meshes.size() * sizeof(ModelCacheFormat::Mesh));
+            write(header.bonesOffset, m_Bones.data(), m_Bones.size() * sizeof(ModelCacheFormat::Bone));
+            write(header.clipsOffset, m_Clips.data(), m_Clips.size() * sizeof(ModelCacheFormat::Clip));
+            write(header.channelsOffset, m_Channels.data(), m_Channels.size() * sizeof(ModelCacheFormat::Channel));
+            write(header.stringsOffset, m_Strings.data(), m_Strings.size());
+            write(header.dataOffset, m_Data.data(), m_Data.size());
+            });
+        if (!written)
+            Q_WARNING("ModelCache: failed to write " + path.string());
+        return written;
+    }
+
+    bool ModelCacheView::Open(const std::filesystem::path& path, uint64_t key)
+    {
+        Close();
+
+        if (!m_File.Open(path) || m_File.Size() < sizeof(ModelCacheFormat::Header))
+        {
+            m_File.Close();
+            return false;
+        }
+
+        m_Header = reinterpret_cast<const ModelCacheFormat::Header*>(m_File.Data());
+        if (m_Header->magic != CacheMagic || m_Header->version != ModelCache::Version || m_Header->key != key
+            || m_Header->fileSize != m_File.Size() || !Validate())
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void ModelCacheView::Close()
+    {
+        m_Header = nullptr;
+        m_File.Close();
+    }
+
+    bool ModelCacheView::Validate() const
+    {
+        namespace Format = ModelCacheFormat;
+        const Format::Header& h = *m_Header;
+        const uint64_t size = m_File.Size();
+
+        if (!InRange<Format::Node>(h.nodesOffset, h.nodeCount, size) || !InRange<Format::Mesh>(h.meshesOffset, h.meshCount, size)
+            || !InRange<Format::Bone>(h.bonesOffset, h.boneCount, size) || !InRange<Format::Clip>(h.clipsOffset, h.clipCount, size)
+            || !InRange<Format::Channel>(h.channelsOffset, h.channelCount, size)
+            || !InRange<char>(h.stringsOffset, h.stringsSize, size) || !InRange<uint8_t>(h.dataOffset, h.dataSize, size))
+            return false;
+
+        auto stringOk = [&](const Format::StringRef& r) { return InRange<char>(r.offset, r.length, h.stringsSize); };
+        auto blobOk = [&](uint64_t offset, uint64_t bytes) { return InRange<uint8_t>(offset, bytes, h.dataSize); };
+
+        if (!stringOk(h.name))
+            return false;
+
+        const Format::Node* nodes = Records<Format::Node>(h.nodesOffset);
+        for (uint32_t i = 0; i < h.nodeCount; ++i)
+        {
+            const Format::Node& n = nodes[i];
+            if (!stringOk(n.name) || n.parent >= static_cast<int32_t>(i) || (i > 0 && n.parent < 0)
+                || n.firstMesh > h.meshCount || n.meshCount > h.meshCount - n.firstMesh)
+                return false;
+        }
+
+        const Format::Mesh* meshes = Records<Format::Mesh>(h.meshesOffset);
+        for (uint32_t i = 0; i < h.meshCount; ++i)
+        {
+            const Format::Mesh& m = meshes[i];
+            if (!stringOk(m.key) || !stringOk(m.name)
+                || !blobOk(m.vertexOffset, uint64_t(m.vertexFloats) * sizeof(float))
+                || !blobOk(m.indexOffset, uint64_t(m.indexCount) * sizeof(uint32_t))
+                || !blobOk(m.boneIdOffset, uint64_t(m.influenceCount) * sizeof(int32_t))
+                || !blobOk(m.boneWeightOffset, uint64_t(m.influenceCount) * sizeof(float)))
+                return false;
+            for (const Format::StringRef& t : m.material.textures)
+                if (!stringOk(t))
+                    return false;
+        }
+
+        const Format::Bone* bones = Records<Format::Bone>(h.bonesOffset);
+        for (uint32_t i = 0; i < h.boneCount; ++i)
+            if (!stringOk(bones[i].name))
+                return false;
+
+        const Format::Clip* clips = Records<Format::Clip>(h.clipsOffset);
+        for (uint32_t i = 0; i < h.clipCount; ++i)
+            if (!stringOk(clips[i].name) || clips[i].firstChannel > h.channelCount || clips[i].channelCount > h.channelCount - clips[i].firstChannel)
+                return false;
+
+        const Format::Channel* channels = Records<Format::Channel>(h.channelsOffset);
+        for (uint32_t i = 0; i < h.channelCount; ++i)
+        {
+            const Format::Channel& c = channels[i];
+            if (!stringOk(c.nodeName)
+                || !blobOk(c.positionOffset, uint64_t(c.positionCount) * sizeof(KeyPosition))
+                || !blobOk(c.rotationOffset, uint64_t(c.rotationCount) * sizeof(KeyRotation))
+                || !blobOk(c.scaleOffset, uint64_t(c.scaleCount) * sizeof(KeyScale)))
+                return false;
+        }
+
+        return true;
+    }
+
+    std::string_view ModelCacheView::String(const ModelCacheFormat::StringRef& ref) const
+    {
+        return std::string_view(reinterpret_cast<const char*>(m_File.Data() + m_Header->stringsOffset + ref.offset), ref.length);
+    }
+
+    std::string_view ModelCacheView::GetName() const
+    {
+        return String(m_Header->name);
+    }
+
+    glm::mat4 ModelCacheView::GetGlobalInverse() const
+    {
+        return ToMatrix(m_Header->globalInverse);
+    }
+
+    ModelCacheView::NodeView ModelCacheView::GetNode(uint32_t index) const
+    {
+        const ModelCacheFormat::Node& n = Records<ModelCacheFormat::Node>(m_Header->nodesOffset)[index];
+
+        NodeView view;
+        view.name = String(n.name);
+        view.transform = ToMatrix(n.transform);
+        view.parent = n.parent;
+        view.firstMesh = n.firstMesh;
+        view.meshCount = n.meshCount;
+        return view;
+    }
+
+    ModelCacheView::MeshView ModelCacheView::GetMesh(uint32_t index) const
+    {
+        const ModelCacheFormat::Mesh& m = Records<ModelCacheFormat::Mesh>(m_Header->meshesOffset)[index];
+
+        MeshView view;
+        view.key = String(m.key);
+        view.name = String(m.name);
+        view.skinned = m.skinned != 0;
+        view.vertices = reinterpret_cast<const float*>(Blob(m.vertexOffset));
+        view.vertexFloats = m.vertexFloats;
+        view.indices = reinterpret_cast<const uint32_t*>(Blob(m.indexOffset));
+        view.indexCount = m.indexCount;
+        if (m.influenceCount)
+        {
+            view.boneIDs = reinterpret_cast<const int32_t*>(Blob(m.boneIdOffset));
+            view.boneWeights = reinterpret_cast<const float*>(Blob(m.boneWeightOffset));
+            view.influenceCount = m.influenceCount;
+        }
+        return view;
+    }
+
+    MaterialSpecification ModelCacheView::GetMeshMaterial(uint32_t index) const
+    {
+        const ModelCacheFormat::Material& m = Records<ModelCacheFormat::Mesh>(m_Header->meshesOffset)[index].material;
+
+        MaterialSpecification spec;
+        std::optional<std::string>* textures[5] = {
+            &spec.AlbedoTexture, &spec.NormalTexture, &spec.MetallicTexture, &spec.RoughnessTexture, &spec.AOTexture
+        };
+        for (uint32_t t = 0; t < 5; ++t)
+            if (m.textureMask & (1u << t))
+                *textures[t] = std::string(String(m.textures[t]));
+
+        spec.Albedo = glm::vec4(m.albedo[0], m.albedo[1], m.albedo[2], m.albedo[3]);
+        spec.Metallic = m.metallic;
+        spec.Roughness = m.roughness;
+        spec.AO = m.ao;
+        return spec;
+    }
+
+    void ModelCacheView::ReadBones(std::unordered_map<std::string, BoneInfo>& bones) const
+    {
+        const ModelCacheFormat::Bone* records = Records<ModelCacheFormat::Bone>(m_Header->bonesOffset);
+
+        bones.clear();
+        bones.reserve(m_Header->boneCount);
+        for (uint32_t i = 0; i < m_Header->boneCount; ++i)
+        {
+            BoneInfo info;
+            info.id = records[i].id;
+            info.offset = ToMatrix(records[i].offset);
+            bones.emplace(std::string(String(records[i].name)), info);
+        }
+    }
+
+    void ModelCacheView::ReadClips(std::vector<AnimationClip>& clips) const
+    {
+        const ModelCacheFormat::Clip* records = Records<ModelCacheFormat::Clip>(m_Header->clipsOffset);
+        const ModelCacheFormat::Channel* channels = Records<ModelCacheFormat::Channel>(m_Header->channelsOffset);
+
+        clips.clear();
+        clips.reserve(m_Header->clipCount);
+        for (uint32_t i = 0; i < m_Header->clipCount; ++i)
+        {
+            const ModelCacheFormat::Clip& record = records[i];
+
+            AnimationClip clip;
+            clip.name = std::string(String(record.name));
+            clip.duration = record.duration;
+            clip.ticksPerSecond = record.ticksPerSecond;
+            clip.channels.reserve(record.channelCount);
+
+            for (uint32_t c = 0; c < record.channelCount; ++c)
+            {
+                const ModelCacheFormat::Channel& src = channels[record.firstChannel + c];
+
+                Channel channel;
+                channel.nodeName = std::string(String(src.nodeName));
+                CopyKeys(channel.positions, Blob(src.positionOffset), src.positionCount);
+                CopyKeys(channel.rotations, Blob(src.rotationOffset), src.rotationCount);
+                CopyKeys(channel.scales, Blob(src.scaleOffset), src.scaleCount);
+                clip.channels.emplace(channel.nodeName, std::move(channel));
+            }
+
+            clips.push_back(std::move(clip));
+        }
+    }
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QuasarEngine/Animation/Animation.h>
+#include <QuasarEngine/Resources/BoneInfo.h>
+#include <QuasarEngine/Resources/ModelSpec.h>
+#include <QuasarEngine/Tools/MappedFile.h>
+
+namespace QuasarEngine
+{
+    // On-disk layout of an imported model. Everything is fixed size and addressed by offset, so a
+    // mapped entry is used in place: header, record arrays, string table, then the geometry blobs.
+    namespace ModelCacheFormat
+    {
+        struct StringRef
+        {
+            uint32_t offset = 0;
+            uint32_t length = 0;
+        };
+
+        struct Header
+        {
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            uint64_t key = 0;
+            uint64_t fileSize = 0;
+
+            uint32_t nodeCount = 0;
+            uint32_t meshCount = 0;
+            uint32_t boneCount = 0;
+            uint32_t clipCount = 0;
+            uint32_t channelCount = 0;
+            int32_t  boneIdCounter = 0;
+
+            uint64_t nodesOffset = 0;
+            uint64_t meshesOffset = 0;
+            uint64_t bonesOffset = 0;
+            uint64_t clipsOffset = 0;
+            uint64_t channelsOffset = 0;
+            uint64_t stringsOffset = 0;
+            uint64_t stringsSize = 0;
+            uint64_t dataOffset = 0;
+            uint64_t dataSize = 0;
+
+            StringRef name;
+            float globalInverse[16] = {};
+        };
+
+        // Nodes are stored depth first, so a parent always precedes its children.
+        struct Node
+        {
+            StringRef name;
+            int32_t  parent = -1;
+            uint32_t firstMesh = 0;
+            uint32_t meshCount = 0;
+            uint32_t pad = 0;
+            float transform[16] = {};
+        };
+
+        struct Material
+        {
+            // Albedo, normal, metallic, roughness, AO; textureMask marks the ones present.
+            StringRef textures[5];
+            uint32_t textureMask = 0;
+            float albedo[4] = {};
+            float metallic = 0.0f;
+            float roughness = 0.0f;
+            float ao = 0.0f;
+        };
+
+        // Blob offsets are relative to Header::dataOffset.
+        struct Mesh
+        {
+            StringRef key;
+            StringRef name;
+            uint32_t skinned = 0;
+            uint32_t vertexFloats = 0;
+            uint32_t indexCount = 0;
+            uint32_t influenceCount = 0;
+            uint64_t vertexOffset = 0;
+            uint64_t indexOffset = 0;
+            uint64_t boneIdOffset = 0;
+            uint64_t boneWeightOffset = 0;
+            Material material;
+        };
+
+        struct Bone
+        {
+            StringRef name;
+            int32_t  id = -1;
+            uint32_t pad = 0;
+            float offset[16] = {};
+        };
+
+        struct Clip
+        {
+            StringRef name;
+            float duration = 0.0f;
+            float ticksPerSecond = 0.0f;
+            uint32_t firstChannel = 0;
+            uint32_t channelCount = 0;
+        };
+
+        struct Channel
+        {
+            StringRef nodeName;
+            uint32_t positionCount = 0;
+            uint32_t rotationCount = 0;
+            uint32_t scaleCount = 0;
+            uint32_t pad = 0;
+            uint64_t positionOffset = 0;
+            uint64_t rotationOffset = 0;
+            uint64_t scaleOffset = 0;
+        };
+    }
+
+    class ModelCache
+    {
+    public:
+        static constexpr uint32_t Version = 1;
+
+        // Hashes the source file content, the files it references (OBJ materials and maps, glTF
+        // buffers and images, by size and mtime), the import options (nullptr for the default import)
+        // and a context string for anything else the result depends on. 0 when the source cannot be read.
+        static uint64_t ComputeKey(const std::filesystem::path& source, const ModelImportOptions* options, const std::string& context);
+        static std::filesystem::path GetCachePath(const std::filesystem::path& directory, uint64_t key);
+    };
+
+    class ModelCacheWriter
+    {
+    public:
+        uint32_t AddNode(const std::string& name, const glm::mat4& localTransform, int32_t parent);
+
+        // Attaches to the node added last.
+        void AddMesh(const std::string& key, const std::string& name, const MaterialSpecification& material, bool skinned,
+            const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+            const std::vector<int>& boneIDs, const std::vector<float>& boneWeights);
+
+        void SetName(const std::string& name);
+        void SetGlobalInverse(const glm::mat4& globalInverse);
+        void SetBones(const std::unordered_map<std::string, BoneInfo>& bones, int boneIdCounter);
+        void SetClips(const std::vector<AnimationClip>& clips);
+
+        bool Save(const std::filesystem::path& path, uint64_t key) const;
+
+    private:
+        ModelCacheFormat::StringRef AddString(const std::string& text);
+        uint64_t AddData(const void* data, size_t size);
+
+        ModelCacheFormat::Header m_Header;
+
+        std::vector<ModelCacheFormat::Node> m_Nodes;
+        std::vector<ModelCacheFormat::Mesh> m_Meshes;
+        std::vector<ModelCacheFormat::Bone> m_Bones;
+        std::vector<ModelCacheFormat::Clip> m_Clips;
+        std::vector<ModelCacheFormat::Channel> m_Channels;
+
+        std::vector<char> m_Strings;
+        std::vector<uint8_t> m_Data;
+    };
+
+    // A mapped cache entry. Records and blobs are read straight from the mapping; the
+    // pointers handed out stay valid until the view is closed.
+    class ModelCacheView
+    {
+    public:
+        struct NodeView
+        {
+            std::string_view name;
+            glm::mat4 transform{ 1.0f };
+            int32_t parent = -1;
+            uint32_t firstMesh = 0;
+            uint32_t meshCount = 0;
+        };
+
+        struct MeshView
+        {
+            std::string_view key;
+            std::string_view name;
+            bool skinned = false;
+
+            const float* vertices = nullptr;
+            size_t vertexFloats = 0;
+            const uint32_t* indices = nullptr;
+            size_t indexCount = 0;
+
+            // QE_MAX_BONE_INFLUENCE entries per vertex, only when skinned.
+            const int32_t* boneIDs = nullptr;
+            const float* boneWeights = nullptr;
+            size_t influenceCount = 0;
+        };
+
+        // Fails on a missing, truncated or stale entry; offsets are checked once here.
+        bool Open(const std::filesystem::path& path, uint64_t key);
+        void Close();
+        bool IsOpen() const { return m_Header != nullptr; }
+
+        std::string_view GetName() const;
+        glm::mat4 GetGlobalInverse() const;
+        int GetBoneIdCounter() const { return m_Header->boneIdCounter; }
+
+        uint32_t GetNodeCount() const { return m_Header->nodeCount; }
+        NodeView GetNode(uint32_t index) const;
+
+        uint32_t GetMeshCount() const { return m_Header->meshCount; }
+        MeshView GetMesh(uint32_t index) const;
+        MaterialSpecification GetMeshMaterial(uint32_t index) const;
+
+        void ReadBones(std::unordered_map<std::string, BoneInfo>& bones) const;
+        void ReadClips(std::vector<AnimationClip>& clips) const;
+
+    private:
+        template<typename T>
+        const T* Records(uint64_t offset) const { return reinterpret_cast<const T*>(m_File.Data() + offset); }
+
+        std::string_view String(const ModelCacheFormat::StringRef& ref) const;
+        const uint8_t* Blob(uint64_t offset) const { return m_File.Data() + m_Header->dataOffset + offset; }
+
+        bool Validate() const;
+
+        MappedFile m_File;
+        const ModelCacheFormat::Header* m_Header = nullptr;
+    };
+}
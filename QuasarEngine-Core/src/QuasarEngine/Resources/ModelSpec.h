@@ -36,6 +36,10 @@ namespace QuasarEngine
         DrawMode drawMode = DrawMode::TRIANGLES;
 
         bool buildMeshes = true;
+
+        // Imported geometry is reused from here while the file and the options above are unchanged.
+        std::string cacheDir = "Cache/Models";
+        bool useCache = true;
     };
 
     struct ModelLoadedInfo {
@@ -2,6 +2,7 @@
 #include "ParticleSystem.h"
 
 #include <algorithm>
+#include <numeric>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
@@ -43,7 +44,6 @@ namespace QuasarEngine
     {
         m_Particles.resize(m_MaxParticles);
         m_AliveIndices.reserve(m_MaxParticles);
-        m_AliveDistances.reserve(m_MaxParticles);
         m_GPUBuffer.reserve(m_MaxParticles);
 
         TextureSpecification tspec{};
@@ -238,7 +238,6 @@ namespace QuasarEngine
         m_Time += dt;
 
         m_AliveIndices.clear();
-        m_AliveDistances.clear();
 
         for (std::size_t i = 0; i < m_Particles.size(); ++i)
         {
@@ -275,51 +274,14 @@ namespace QuasarEngine
         }
     }
 
-    void ParticleSystem::Render(RenderContext& ctx)
+    void ParticleSystem::Extract()
     {
-        if (!m_Shader || !m_VertexArray)
-            return;
-
-        if (m_AliveIndices.empty())
-            return;
-
-        m_Shader->Use();
-
-        m_Shader->SetUniform("view", &ctx.view, sizeof(glm::mat4));
-        m_Shader->SetUniform("projection", &ctx.projection, sizeof(glm::mat4));
-        m_Shader->SetUniform("camera_position", &ctx.cameraPosition, sizeof(glm::vec3));
-        m_Shader->SetUniform("time", &m_Time, sizeof(float));
-        m_Shader->UpdateGlobalState();
-
-        float sizeExp = m_Settings.sizeOverLifeExponent;
-        float alphaExp = m_Settings.alphaOverLifeExponent;
-        float softFade = 1.0f;
-
-        m_Shader->SetUniform("sizeOverLifeExponent", &sizeExp, sizeof(float));
-        m_Shader->SetUniform("alphaOverLifeExponent", &alphaExp, sizeof(float));
-        m_Shader->SetUniform("softFade", &softFade, sizeof(float));
-
-        if (m_Texture)
-            m_Shader->SetTexture("particle_texture", m_Texture.get());
-
-        m_AliveDistances.resize(m_AliveIndices.size());
-        for (std::size_t idx = 0; idx < m_AliveIndices.size(); ++idx)
-        {
-            const Particle& p = m_Particles[m_AliveIndices[idx]];
-            m_AliveDistances[idx] = glm::length2(p.position - ctx.cameraPosition);
-        }
-
-        std::vector<std::size_t> sorted = m_AliveIndices;
-        std::sort(sorted.begin(), sorted.end(),
-            [&](std::size_t a, std::size_t b)
-            {
-                return glm::length2(m_Particles[a].position - ctx.cameraPosition) > glm::length2(m_Particles[b].position - ctx.cameraPosition);
-            });
+        m_ExtractedTime = m_Time;
+        m_ExtractedSizeExponent = m_Settings.sizeOverLifeExponent;
+        m_ExtractedAlphaExponent = m_Settings.alphaOverLifeExponent;
 
         m_GPUBuffer.clear();
-        m_GPUBuffer.reserve(sorted.size());
-
-        for (std::size_t idx : sorted)
+        for (std::size_t idx : m_AliveIndices)
         {
             const Particle& p = m_Particles[idx];
 
@@ -340,17 +302,56 @@ namespace QuasarEngine
 
             m_GPUBuffer.push_back(gp);
         }
+    }
+
+    void ParticleSystem::Render(RenderContext& ctx)
+    {
+        if (!m_Shader || !m_VertexArray)
+            return;
 
         if (m_GPUBuffer.empty())
-        {
-            m_Shader->Unuse();
             return;
-        }
+
+        m_Shader->Use();
+
+        m_Shader->SetUniform("view", &ctx.view, sizeof(glm::mat4));
+        m_Shader->SetUniform("projection", &ctx.projection, sizeof(glm::mat4));
+        m_Shader->SetUniform("camera_position", &ctx.cameraPosition, sizeof(glm::vec3));
+        m_Shader->SetUniform("time", &m_ExtractedTime, sizeof(float));
+        m_Shader->UpdateGlobalState();
+
+        float softFade = 1.0f;
+
+        m_Shader->SetUniform("sizeOverLifeExponent", &m_ExtractedSizeExponent, sizeof(float));
+        m_Shader->SetUniform("alphaOverLifeExponent", &m_ExtractedAlphaExponent, sizeof(float));
+        m_Shader->SetUniform("softFade", &softFade, sizeof(float));
+
+        if (m_Texture)
+            m_Shader->SetTexture("particle_texture", m_Texture.get());
+
+        // Back to front, from the extracted copy.
+        const std::size_t count = m_GPUBuffer.size();
+        m_GPUDistances.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            m_GPUDistances[i] = glm::length2(m_GPUBuffer[i].position - ctx.cameraPosition);
+
+        m_GPUOrder.resize(count);
+        std::iota(m_GPUOrder.begin(), m_GPUOrder.end(), 0u);
+        std::sort(m_GPUOrder.begin(), m_GPUOrder.end(),
+            [&](uint32_t a, uint32_t b)
+            {
+                return m_GPUDistances[a] > m_GPUDistances[b];
+            });
+
+        m_GPUSorted.clear();
+        m_GPUSorted.reserve(count);
+        for (uint32_t i : m_GPUOrder)
+            m_GPUSorted.push_back(m_GPUBuffer[i]);
 
         m_Shader->SetStorageBuffer(
             "ParticlesBuffer",
-            m_GPUBuffer.data(),
-            m_GPUBuffer.size() * sizeof(GPUParticle)
+            m_GPUSorted.data(),
+            m_GPUSorted.size() * sizeof(GPUParticle)
         );
 
         m_Shader->UpdateObject(nullptr);
@@ -359,7 +360,7 @@ namespace QuasarEngine
         RenderCommand::Instance().DrawElementsInstanced(
             m_DrawMode,
             static_cast<uint32_t>(m_IndexCount),
-            static_cast<uint32_t>(m_GPUBuffer.size())
+            static_cast<uint32_t>(m_GPUSorted.size())
         );
 
         m_Shader->Unuse();
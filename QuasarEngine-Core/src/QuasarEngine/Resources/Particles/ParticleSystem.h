@@ -60,6 +60,9 @@ namespace QuasarEngine
         void Emit(const Particle& spawnData);
 
         void Update(float dt);
+        // Copies the live particles and the settings Render uses, so Render never reads what
+        // Update or SetSimulationSettings write.
+        void Extract();
         void Render(RenderContext& ctx);
 
         void SetSimulationSettings(const SimulationSettings& s) { m_Settings = s; }
@@ -78,7 +81,6 @@ namespace QuasarEngine
         std::size_t m_MaxParticles = 512;
 
         std::vector<std::size_t> m_AliveIndices;
-        std::vector<float> m_AliveDistances;
         
         struct GPUParticle
         {
@@ -94,6 +96,12 @@ namespace QuasarEngine
             float random;
         };
         std::vector<GPUParticle> m_GPUBuffer;
+        std::vector<float> m_GPUDistances;
+        std::vector<uint32_t> m_GPUOrder;
+        std::vector<GPUParticle> m_GPUSorted;
+        float m_ExtractedTime = 0.0f;
+        float m_ExtractedSizeExponent = 1.0f;
+        float m_ExtractedAlphaExponent = 1.0f;
 
         std::shared_ptr<VertexArray> m_VertexArray;
         std::shared_ptr<VertexBuffer> m_VertexBuffer;
@@ -71,6 +71,7 @@ namespace QuasarEngine
 
         void OnRender(RenderContext& ctx)
         {
+            m_Particles.Extract();
             m_Particles.Render(ctx);
         }
 
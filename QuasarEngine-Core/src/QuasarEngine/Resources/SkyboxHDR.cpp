@@ -61,13 +61,85 @@ namespace QuasarEngine
         fbSpec.Samples = 1;
         m_FBO = Framebuffer::Create(fbSpec);
 
-        LoadHDR(m_Settings.hdrPath);
+        // Keyed before CreateTargets, which rewrites prefilterMipLevels.
+        const uint64_t bakeKey = m_Settings.useBakeCache ? IBLBake::ComputeKey(m_Settings) : 0;
+        const std::filesystem::path bakePath = IBLBake::GetCachePath(m_Settings, bakeKey);
+
         CreateTargets();
 
+        IBLBakeData baked;
+        if (bakeKey != 0 && IBLBake::Load(bakePath, bakeKey, baked) && UploadBaked(baked))
+            return;
+
+        LoadHDR(m_Settings.hdrPath);
+
         BuildEnvironment();
         BuildIrradiance();
         BuildPrefilter();
         BuildBrdfLUT();
+
+        if (bakeKey != 0 && ReadBackBaked(baked) && !IBLBake::Save(bakePath, bakeKey, baked))
+            Q_WARNING("SkyboxHDR: failed to write IBL bake " + bakePath.string());
+    }
+
+    bool SkyboxHDR::UploadBaked(const IBLBakeData& data)
+    {
+        if (!data.IsComplete() || data.envRes != m_Settings.envRes || data.irradianceRes != m_Settings.irradianceRes ||
+            data.prefilterRes != m_Settings.prefilterRes || data.brdfRes != m_Settings.brdfRes)
+            return false;
+
+        auto uploadFaces = [](TextureCubeMap& cube, const std::vector<float>& texels, uint32_t mip, uint32_t res) {
+            const size_t faceFloats = IBLBakeData::FaceFloats(res);
+            bool ok = true;
+            for (uint32_t face = 0; face < 6; ++face)
+            {
+                const ByteView view{ reinterpret_cast<const std::uint8_t*>(texels.data() + face * faceFloats), faceFloats * sizeof(float) };
+                ok = ok && cube.LoadFaceMipFromData(TextureCubeMap::Face(face), mip, view, res, res);
+            }
+            return ok;
+            };
+
+        if (!uploadFaces(*m_EnvCubemap, data.environment, 0, data.envRes) ||
+            !uploadFaces(*m_IrradianceMap, data.irradiance, 0, data.irradianceRes))
+            return false;
+
+        for (uint32_t mip = 0; mip < data.prefilter.size(); ++mip)
+            if (!uploadFaces(*m_PrefilterMap, data.prefilter[mip], mip, std::max(1u, data.prefilterRes >> mip)))
+                return false;
+
+        m_EnvCubemap->GenerateMips();
+
+        return m_BrdfLUT->LoadFromData(ByteView{ reinterpret_cast<const std::uint8_t*>(data.brdf.data()), data.brdf.size() * sizeof(float) });
+    }
+
+    bool SkyboxHDR::ReadBackBaked(IBLBakeData& data) const
+    {
+        data = {};
+        data.envRes = m_Settings.envRes;
+        data.irradianceRes = m_Settings.irradianceRes;
+        data.prefilterRes = m_Settings.prefilterRes;
+        data.brdfRes = m_Settings.brdfRes;
+
+        auto readFaces = [](const TextureCubeMap& cube, std::vector<float>& texels, uint32_t mip) {
+            std::vector<float> face;
+            for (uint32_t f = 0; f < 6; ++f)
+            {
+                if (!cube.ReadFaceMip(TextureCubeMap::Face(f), mip, face))
+                    return false;
+                texels.insert(texels.end(), face.begin(), face.end());
+            }
+            return true;
+            };
+
+        if (!readFaces(*m_EnvCubemap, data.environment, 0) || !readFaces(*m_IrradianceMap, data.irradiance, 0))
+            return false;
+
+        data.prefilter.resize(IBLBake::PrefilterLevels(m_Settings));
+        for (uint32_t mip = 0; mip < data.prefilter.size(); ++mip)
+            if (!readFaces(*m_PrefilterMap, data.prefilter[mip], mip))
+                return false;
+
+        return m_BrdfLUT->ReadPixels(data.brdf) && data.IsComplete();
     }
 
     void SkyboxHDR::CreateMeshes()
@@ -493,7 +565,7 @@ namespace QuasarEngine
     {
         if (!m_PrefilterMap || !m_EnvCubemap) return;
 
-        const uint32_t mipMax = std::min<uint32_t>(5, CalcMipCount(m_Settings.prefilterRes, m_Settings.prefilterRes)); // souvent 5
+        const uint32_t mipMax = IBLBake::PrefilterLevels(m_Settings);
         m_PrefilterShader->Use();
 
         for (uint32_t mip = 0; mip < mipMax; ++mip) {
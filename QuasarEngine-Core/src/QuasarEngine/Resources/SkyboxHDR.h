@@ -11,6 +11,7 @@
 #include <QuasarEngine/Renderer/Buffer.h>
 #include <QuasarEngine/Renderer/RenderCommand.h>
 
+#include <QuasarEngine/Resources/IBLBake.h>
 #include <QuasarEngine/Resources/Mesh.h>
 #include <QuasarEngine/Resources/Texture2D.h>
 #include <QuasarEngine/Resources/TextureCubeMap.h>
@@ -22,14 +23,7 @@ namespace QuasarEngine
     class SkyboxHDR
     {
     public:
-        struct Settings {
-            std::string hdrPath = "Assets/HDR/kloofendal_48d_partly_cloudy_puresky_4k.hdr";
-            uint32_t envRes = 1024;
-            uint32_t irradianceRes = 32;
-            uint32_t prefilterRes = 1024;
-            uint32_t brdfRes = 512;
-			uint32_t prefilterMipLevels = 5;
-        };
+        using Settings = IBLSettings;
 
         explicit SkyboxHDR(const Settings& s = {});
         ~SkyboxHDR() = default;
@@ -62,6 +56,9 @@ namespace QuasarEngine
         void BuildPrefilter();
         void BuildBrdfLUT();
 
+        bool UploadBaked(const IBLBakeData& data);
+        bool ReadBackBaked(IBLBakeData& data) const;
+
         Settings m_Settings{};
 
         std::shared_ptr<Mesh>   m_CubeMesh;
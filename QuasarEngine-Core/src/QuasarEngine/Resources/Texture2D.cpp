@@ -6,6 +6,7 @@
 #include <Platform/Vulkan/VulkanTexture2D.h>
 #include <Platform/OpenGL/OpenGLTexture2D.h>
 #include <Platform/DirectX/DirectXTexture2D.h>
+#include <Platform/Null/NullTexture2D.h>
 
 namespace QuasarEngine
 {
@@ -15,7 +16,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullTexture2D>(specification);
 		case RendererAPI::API::Vulkan: return std::make_shared<VulkanTexture2D>(specification);
 		case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTexture2D>(specification);
 		case RendererAPI::API::DirectX: return std::make_shared<DirectXTexture2D>(specification);
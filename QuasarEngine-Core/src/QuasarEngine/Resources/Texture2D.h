@@ -6,6 +6,8 @@
 
 namespace QuasarEngine
 {
+	struct CompressedTexture;
+
 	class Texture2D : public Texture
 	{
 	public:
@@ -24,6 +26,12 @@ namespace QuasarEngine
 
 		virtual glm::vec4 Sample(const glm::vec2& uv) const = 0;
 
+		// Copies mip 0 back as tightly packed floats; false when the backend cannot read back.
+		virtual bool ReadPixels(std::vector<float>& out) const { return false; }
+
+		// Uploads a pre-built block-compressed mip chain as is; false when the backend or driver lacks the format.
+		virtual bool LoadCompressed(const CompressedTexture& texture) { return false; }
+
 		static std::shared_ptr<Texture2D> Create(const TextureSpecification& specification);
 	};
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <Platform/Vulkan/VulkanTextureArray.h>
 #include <Platform/OpenGL/OpenGLTextureArray.h>
 #include <Platform/DirectX/DirectXTextureArray.h>
+#include <Platform/Null/NullTextureArray.h>
 
 namespace QuasarEngine
 {
@@ -14,7 +15,7 @@ namespace QuasarEngine
     std::shared_ptr<TextureArray> TextureArray::Create(const TextureSpecification& specification) {
         switch (RendererAPI::GetAPI())
         {
-        case RendererAPI::API::None:   return nullptr;
+        case RendererAPI::API::None:   return std::make_shared<NullTextureArray>(specification);
         case RendererAPI::API::Vulkan: return std::make_shared<VulkanTextureArray>(specification);
         case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTextureArray>(specification);
         case RendererAPI::API::DirectX:return std::make_shared<DirectXTextureArray>(specification);
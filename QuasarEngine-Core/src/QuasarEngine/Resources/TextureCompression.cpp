@@ -0,0 +1,1130 @@
+#include "qepch.h"
+#include <QuasarEngine/Resources/TextureCompression.h>
+
+#include <QuasarEngine/Thread/JobSystem.h>
+#include <QuasarEngine/Tools/MappedFile.h>
+#include <QuasarEngine/File/FileUtils.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <stb_image.h>
+
+namespace QuasarEngine
+{
+    namespace
+    {
+        struct Block
+        {
+            uint8_t px[16][4];
+        };
+
+        // Edge blocks repeat the last row/column so partial blocks still encode the visible texels well.
+        void FetchBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block& block)
+        {
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                const uint32_t sy = std::min(by * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                    std::memcpy(block.px[y * 4 + x], rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+                }
+            }
+        }
+
+        void StoreBlock(const Block& block, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, uint8_t* rgba)
+        {
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y)
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x)
+                    std::memcpy(rgba + (static_cast<size_t>(by * 4 + y) * width + bx * 4 + x) * 4, block.px[y * 4 + x], 4);
+        }
+
+        float Clamp255(float v) { return std::clamp(v, 0.0f, 255.0f); }
+
+        bool IsSrgbFormat(TextureFormat format)
+        {
+            TextureSpecification spec;
+            spec.internal_format = format;
+            return spec.is_srgb();
+        }
+
+        // Mean and dominant direction of the first N channels, by power iteration on the covariance.
+        template<int N>
+        void FitLine(const Block& block, float (&mean)[N], float (&axis)[N])
+        {
+            float lo[N], hi[N];
+            for (int c = 0; c < N; ++c)
+            {
+                mean[c] = 0.0f;
+                lo[c] = 255.0f;
+                hi[c] = 0.0f;
+            }
+
+            for (int i = 0; i < 16; ++i)
+                for (int c = 0; c < N; ++c)
+                {
+                    const float v = block.px[i][c];
+                    mean[c] += v;
+                    lo[c] = std::min(lo[c], v);
+                    hi[c] = std::max(hi[c], v);
+                }
+
+            for (int c = 0; c < N; ++c)
+                mean[c] /= 16.0f;
+
+            float cov[N][N] = {};
+            for (int i = 0; i < 16; ++i)
+                for (int a = 0; a < N; ++a)
+                    for (int b = 0; b < N; ++b)
+                        cov[a][b] += (block.px[i][a] - mean[a]) * (block.px[i][b] - mean[b]);
+
+            for (int c = 0; c < N; ++c)
+                axis[c] = hi[c] - lo[c];
+
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[N] = {};
+                float length = 0.0f;
+                for (int a = 0; a < N; ++a)
+                {
+                    for (int b = 0; b < N; ++b)
+                        next[a] += cov[a][b] * axis[b];
+                    length += next[a] * next[a];
+                }
+
+                if (length < 1e-12f)
+                    break;
+
+                length = 1.0f / std::sqrt(length);
+                for (int c = 0; c < N; ++c)
+                    axis[c] = next[c] * length;
+            }
+        }
+
+        template<int N>
+        void LineEndpoints(const Block& block, float (&e0)[N], float (&e1)[N])
+        {
+            float mean[N], axis[N];
+            FitLine<N>(block, mean, axis);
+
+            float lo = 0.0f, hi = 0.0f;
+            for (int i = 0; i < 16; ++i)
+            {
+                float t = 0.0f;
+                for (int c = 0; c < N; ++c)
+                    t += (block.px[i][c] - mean[c]) * axis[c];
+                lo = std::min(lo, t);
+                hi = std::max(hi, t);
+            }
+
+            for (int c = 0; c < N; ++c)
+            {
+                e0[c] = Clamp255(mean[c] + axis[c] * lo);
+                e1[c] = Clamp255(mean[c] + axis[c] * hi);
+            }
+        }
+
+        // Least squares endpoints for fixed per texel blend factors (0 = e0, 1 = e1).
+        template<int N>
+        bool RefitEndpoints(const Block& block, const float (&t)[16], float (&e0)[N], float (&e1)[N])
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[N] = {}, bx[N] = {};
+            for (int i = 0; i < 16; ++i)
+            {
+                const float a = 1.0f - t[i];
+                const float b = t[i];
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < N; ++c)
+                {
+                    ax[c] += a * block.px[i][c];
+                    bx[c] += b * block.px[i][c];
+                }
+            }
+
+            const float det = aa * bb - ab * ab;
+            if (std::abs(det) < 1e-6f)
+                return false;
+
+            for (int c = 0; c < N; ++c)
+            {
+                e0[c] = Clamp255((ax[c] * bb - bx[c] * ab) / det);
+                e1[c] = Clamp255((bx[c] * aa - ax[c] * ab) / det);
+            }
+            return true;
+        }
+
+        void WriteU16(uint8_t* out, uint16_t v)
+        {
+            out[0] = static_cast<uint8_t>(v);
+            out[1] = static_cast<uint8_t>(v >> 8);
+        }
+
+        uint16_t ReadU16(const uint8_t* in) { return static_cast<uint16_t>(in[0] | (in[1] << 8)); }
+
+        struct BitWriter
+        {
+            uint8_t* out;
+            uint32_t pos = 0;
+
+            void Put(uint32_t value, uint32_t bits)
+            {
+                for (uint32_t b = 0; b < bits; ++b, ++pos)
+                    if ((value >> b) & 1u)
+                        out[pos >> 3] |= static_cast<uint8_t>(1u << (pos & 7));
+            }
+        };
+
+        struct BitReader
+        {
+            const uint8_t* in;
+            uint32_t pos = 0;
+
+            uint32_t Get(uint32_t bits)
+            {
+                uint32_t value = 0;
+                for (uint32_t b = 0; b < bits; ++b, ++pos)
+                    value |= static_cast<uint32_t>((in[pos >> 3] >> (pos & 7)) & 1u) << b;
+                return value;
+            }
+        };
+
+        // --- BC1 (also the colour half of BC3) ---
+
+        uint16_t To565(const float (&c)[3])
+        {
+            const uint32_t r = static_cast<uint32_t>(std::lround(c[0] * 31.0f / 255.0f));
+            const uint32_t g = static_cast<uint32_t>(std::lround(c[1] * 63.0f / 255.0f));
+            const uint32_t b = static_cast<uint32_t>(std::lround(c[2] * 31.0f / 255.0f));
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void From565(uint16_t v, int (&out)[3])
+        {
+            const int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+            out[0] = (r << 3) | (r >> 2);
+            out[1] = (g << 2) | (g >> 4);
+            out[2] = (b << 3) | (b >> 2);
+        }
+
+        void ColorPalette(uint16_t c0, uint16_t c1, bool fourColor, int (&palette)[4][3])
+        {
+            From565(c0, palette[0]);
+            From565(c1, palette[1]);
+            for (int c = 0; c < 3; ++c)
+            {
+                if (fourColor)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+                else
+                {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+        }
+
+        // Writes the 8 byte colour block and returns its squared error. Always four colour mode.
+        uint32_t EncodeColor(const Block& block, const float (&e0)[3], const float (&e1)[3], uint8_t* out, float (&t)[16])
+        {
+            static constexpr float Blend[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+            uint16_t c0 = To565(e0), c1 = To565(e1);
+            bool swapped = false;
+            if (c0 < c1)
+            {
+                std::swap(c0, c1);
+                swapped = true;
+            }
+
+            int palette[4][3];
+            ColorPalette(c0, c1, true, palette);
+
+            // Equal endpoints would decode in three colour mode, where only index 0 is still the endpoint.
+            const int candidates = c0 == c1 ? 1 : 4;
+
+            uint32_t indices = 0, error = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                uint32_t best = UINT32_MAX, bestIndex = 0;
+                for (int k = 0; k < candidates; ++k)
+                {
+                    uint32_t d = 0;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const int delta = palette[k][c] - block.px[i][c];
+                        d += static_cast<uint32_t>(delta * delta);
+                    }
+                    if (d < best)
+                    {
+                        best = d;
+                        bestIndex = static_cast<uint32_t>(k);
+                    }
+                }
+                error += best;
+                indices |= bestIndex << (2 * i);
+                t[i] = swapped ? 1.0f - Blend[bestIndex] : Blend[bestIndex];
+            }
+
+            WriteU16(out, c0);
+            WriteU16(out + 2, c1);
+            for (int b = 0; b < 4; ++b)
+                out[4 + b] = static_cast<uint8_t>(indices >> (8 * b));
+            return error;
+        }
+
+        void CompressColorBlock(const Block& block, uint8_t* out)
+        {
+            float e0[3], e1[3], t[16];
+            LineEndpoints<3>(block, e0, e1);
+
+            const uint32_t error = EncodeColor(block, e0, e1, out, t);
+            if (error == 0 || !RefitEndpoints<3>(block, t, e0, e1))
+                return;
+
+            uint8_t refined[8];
+            if (EncodeColor(block, e0, e1, refined, t) < error)
+                std::memcpy(out, refined, sizeof(refined));
+        }
+
+        void DecodeColorBlock(const uint8_t* in, bool alwaysFourColor, Block& block)
+        {
+            const uint16_t c0 = ReadU16(in), c1 = ReadU16(in + 2);
+            const bool fourColor = alwaysFourColor || c0 > c1;
+
+            int palette[4][3];
+            ColorPalette(c0, c1, fourColor, palette);
+
+            for (int i = 0; i < 16; ++i)
+            {
+                const int index = (in[4 + i / 4] >> (2 * (i % 4))) & 3;
+                for (int c = 0; c < 3; ++c)
+                    block.px[i][c] = static_cast<uint8_t>(palette[index][c]);
+                block.px[i][3] = (!fourColor && index == 3) ? 0 : 255;
+            }
+        }
+
+        // --- BC4 (the alpha half of BC3 and both halves of BC5) ---
+
+        void ChannelPalette(int a0, int a1, int (&palette)[8])
+        {
+            palette[0] = a0;
+            palette[1] = a1;
+            if (a0 > a1)
+            {
+                for (int k = 2; k < 8; ++k)
+                    palette[k] = ((8 - k) * a0 + (k - 1) * a1) / 7;
+            }
+            else
+            {
+                for (int k = 2; k < 6; ++k)
+                    palette[k] = ((6 - k) * a0 + (k - 1) * a1) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        void CompressChannelBlock(const Block& block, int channel, uint8_t* out)
+        {
+            int lo = 255, hi = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                lo = std::min<int>(lo, block.px[i][channel]);
+                hi = std::max<int>(hi, block.px[i][channel]);
+            }
+
+            std::memset(out, 0, 8);
+            out[0] = static_cast<uint8_t>(hi);
+            out[1] = static_cast<uint8_t>(lo);
+            if (hi == lo)
+                return;
+
+            int palette[8];
+            ChannelPalette(hi, lo, palette);
+
+            uint64_t indices = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                int best = INT32_MAX, bestIndex = 0;
+                for (int k = 0; k < 8; ++k)
+                {
+                    const int d = std::abs(palette[k] - block.px[i][channel]);
+                    if (d < best)
+                    {
+                        best = d;
+                        bestIndex = k;
+                    }
+                }
+                indices |= static_cast<uint64_t>(bestIndex) << (3 * i);
+            }
+
+            for (int b = 0; b < 6; ++b)
+                out[2 + b] = static_cast<uint8_t>(indices >> (8 * b));
+        }
+
+        void DecodeChannelBlock(const uint8_t* in, int channel, Block& block)
+        {
+            int palette[8];
+            ChannelPalette(in[0], in[1], palette);
+
+            uint64_t indices = 0;
+            for (int b = 0; b < 6; ++b)
+                indices |= static_cast<uint64_t>(in[2 + b]) << (8 * b);
+
+            for (int i = 0; i < 16; ++i)
+                block.px[i][channel] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7]);
+        }
+
+        // --- BC7, mode 6 only: one RGBA subset, 7 bit endpoints with a p-bit each, 4 bit indices ---
+
+        constexpr int Bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        int Bc7Interpolate(int e0, int e1, int index)
+        {
+            return ((64 - Bc7Weights[index]) * e0 + Bc7Weights[index] * e1 + 32) >> 6;
+        }
+
+        // Picks the p-bit that lands the 7 bit endpoint closest to the float one. Alpha counts four times
+        // so opaque blocks always keep 255 instead of trading it for a closer colour.
+        void QuantizeBc7Endpoint(const float (&e)[4], uint8_t (&q)[4], uint8_t& pbit, int (&value)[4])
+        {
+            float bestError = FLT_MAX;
+            for (uint8_t p = 0; p < 2; ++p)
+            {
+                uint8_t candidate[4];
+                float error = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    candidate[c] = static_cast<uint8_t>(std::clamp<long>(std::lround((e[c] - p) * 0.5f), 0, 127));
+                    const float delta = static_cast<float>(candidate[c] * 2 + p) - e[c];
+                    error += delta * delta * (c == 3 ? 4.0f : 1.0f);
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    pbit = p;
+                    std::memcpy(q, candidate, sizeof(q));
+                }
+            }
+
+            for (int c = 0; c < 4; ++c)
+                value[c] = q[c] * 2 + pbit;
+        }
+
+        uint32_t EncodeBc7(const Block& block, const float (&e0)[4], const float (&e1)[4], uint8_t* out, float (&t)[16])
+        {
+            uint8_t q[2][4], p[2];
+            int ep[2][4];
+            QuantizeBc7Endpoint(e0, q[0], p[0], ep[0]);
+            QuantizeBc7Endpoint(e1, q[1], p[1], ep[1]);
+
+            uint8_t indices[16];
+            uint32_t error = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                uint32_t best = UINT32_MAX;
+                uint8_t bestIndex = 0;
+                for (int k = 0; k < 16; ++k)
+                {
+                    uint32_t d = 0;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        const int delta = Bc7Interpolate(ep[0][c], ep[1][c], k) - block.px[i][c];
+                        d += static_cast<uint32_t>(delta * delta);
+                    }
+                    if (d < best)
+                    {
+                        best = d;
+                        bestIndex = static_cast<uint8_t>(k);
+                    }
+                }
+                error += best;
+                indices[i] = bestIndex;
+                t[i] = Bc7Weights[bestIndex] / 64.0f;
+            }
+
+            // The first index is stored with its top bit implied zero; flip the subset if it is set.
+            if (indices[0] & 8)
+            {
+                std::swap(q[0], q[1]);
+                std::swap(p[0], p[1]);
+                for (uint8_t& index : indices)
+                    index = static_cast<uint8_t>(15 - index);
+            }
+
+            std::memset(out, 0, 16);
+            BitWriter writer{ out };
+            writer.Put(1u << 6, 7);
+            for (int c = 0; c < 4; ++c)
+            {
+                writer.Put(q[0][c], 7);
+                writer.Put(q[1][c], 7);
+            }
+            writer.Put(p[0], 1);
+            writer.Put(p[1], 1);
+            writer.Put(indices[0], 3);
+            for (int i = 1; i < 16; ++i)
+                writer.Put(indices[i], 4);
+            return error;
+        }
+
+        void CompressBc7Block(const Block& block, uint8_t* out)
+        {
+            float e0[4], e1[4], t[16];
+            LineEndpoints<4>(block, e0, e1);
+
+            const uint32_t error = EncodeBc7(block, e0, e1, out, t);
+            if (error == 0 || !RefitEndpoints<4>(block, t, e0, e1))
+                return;
+
+            uint8_t refined[16];
+            if (EncodeBc7(block, e0, e1, refined, t) < error)
+                std::memcpy(out, refined, sizeof(refined));
+        }
+
+        bool DecodeBc7Block(const uint8_t* in, Block& block)
+        {
+            BitReader reader{ in };
+            if (reader.Get(7) != (1u << 6))
+                return false;
+
+            int ep[2][4];
+            for (int c = 0; c < 4; ++c)
+            {
+                ep[0][c] = static_cast<int>(reader.Get(7)) << 1;
+                ep[1][c] = static_cast<int>(reader.Get(7)) << 1;
+            }
+
+            const int p0 = static_cast<int>(reader.Get(1));
+            const int p1 = static_cast<int>(reader.Get(1));
+            for (int c = 0; c < 4; ++c)
+            {
+                ep[0][c] |= p0;
+                ep[1][c] |= p1;
+            }
+
+            for (int i = 0; i < 16; ++i)
+            {
+                const int index = static_cast<int>(reader.Get(i == 0 ? 3 : 4));
+                for (int c = 0; c < 4; ++c)
+                    block.px[i][c] = static_cast<uint8_t>(Bc7Interpolate(ep[0][c], ep[1][c], index));
+            }
+            return true;
+        }
+
+        // --- Mip chain ---
+
+        float SrgbToLinear(uint8_t v)
+        {
+            const float c = v / 255.0f;
+            return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+
+        uint8_t LinearToSrgb(float c)
+        {
+            c = std::clamp(c, 0.0f, 1.0f);
+            const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            return static_cast<uint8_t>(std::lround(s * 255.0f));
+        }
+
+        // 2x2 box filter. sRGB colour is averaged in linear space and normals are renormalised,
+        // otherwise distant mips darken or flatten.
+        std::vector<uint8_t> Downsample(const uint8_t* src, uint32_t width, uint32_t height, bool srgb, bool normal)
+        {
+            const uint32_t w = std::max(1u, width / 2);
+            const uint32_t h = std::max(1u, height / 2);
+            std::vector<uint8_t> dst(static_cast<size_t>(w) * h * 4);
+
+            static const auto srgbTable = [] {
+                std::array<float, 256> table{};
+                for (int i = 0; i < 256; ++i)
+                    table[i] = SrgbToLinear(static_cast<uint8_t>(i));
+                return table;
+            }();
+
+            JobSystem::Instance().ParallelFor(h, 0, [&](std::size_t y)
+                {
+                    const uint32_t y0 = std::min(static_cast<uint32_t>(y) * 2, height - 1);
+                    const uint32_t y1 = std::min(static_cast<uint32_t>(y) * 2 + 1, height - 1);
+                    for (uint32_t x = 0; x < w; ++x)
+                    {
+                        const uint32_t x0 = std::min(x * 2, width - 1);
+                        const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+                        const uint8_t* taps[4] = {
+                            &src[(static_cast<size_t>(y0) * width + x0) * 4], &src[(static_cast<size_t>(y0) * width + x1) * 4],
+                            &src[(static_cast<size_t>(y1) * width + x0) * 4], &src[(static_cast<size_t>(y1) * width + x1) * 4],
+                        };
+
+                        float sum[4] = {};
+                        for (const uint8_t* tap : taps)
+                            for (int c = 0; c < 4; ++c)
+                                sum[c] += (srgb && c < 3) ? srgbTable[tap[c]] : tap[c] / 255.0f;
+
+                        uint8_t* out = &dst[(static_cast<size_t>(y) * w + x) * 4];
+                        if (normal)
+                        {
+                            float n[3];
+                            for (int c = 0; c < 3; ++c)
+                                n[c] = sum[c] * 0.5f - 1.0f;
+                            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                            length = length > 1e-6f ? 1.0f / length : 0.0f;
+                            for (int c = 0; c < 3; ++c)
+                                out[c] = static_cast<uint8_t>(std::lround(std::clamp(n[c] * length * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+                        }
+                        else
+                        {
+                            for (int c = 0; c < 3; ++c)
+                                out[c] = srgb ? LinearToSrgb(sum[c] * 0.25f) : static_cast<uint8_t>(std::lround(sum[c] * 0.25f * 255.0f));
+                        }
+                        out[3] = static_cast<uint8_t>(std::lround(sum[3] * 0.25f * 255.0f));
+                    }
+                });
+
+            return dst;
+        }
+
+        void CompressLevel(const uint8_t* rgba, uint32_t width, uint32_t height, TextureFormat format, std::vector<uint8_t>& out)
+        {
+            const uint32_t blocksX = (width + 3) / 4;
+            const uint32_t blocksY = (height + 3) / 4;
+            const uint32_t blockBytes = TextureCompression::GetBlockBytes(format);
+            out.assign(static_cast<size_t>(blocksX) * blocksY * blockBytes, 0);
+
+            JobSystem::Instance().ParallelFor(blocksY, 0, [&](std::size_t by)
+                {
+                    Block block;
+                    for (uint32_t bx = 0; bx < blocksX; ++bx)
+                    {
+                        FetchBlock(rgba, width, height, bx, static_cast<uint32_t>(by), block);
+                        uint8_t* dst = &out[(by * blocksX + bx) * blockBytes];
+
+                        switch (format)
+                        {
+                        case TextureFormat::BC1:
+                        case TextureFormat::BC1_SRGB:
+                            CompressColorBlock(block, dst);
+                            break;
+                        case TextureFormat::BC3:
+                        case TextureFormat::BC3_SRGB:
+                            CompressChannelBlock(block, 3, dst);
+                            CompressColorBlock(block, dst + 8);
+                            break;
+                        case TextureFormat::BC5:
+                            CompressChannelBlock(block, 0, dst);
+                            CompressChannelBlock(block, 1, dst + 8);
+                            break;
+                        default:
+                            CompressBc7Block(block, dst);
+                            break;
+                        }
+                    }
+                });
+        }
+
+        // --- KTX2 ---
+
+        constexpr uint8_t Ktx2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+        constexpr size_t Ktx2HeaderSize = 80;
+        constexpr size_t Ktx2LevelEntrySize = 24;
+
+        uint32_t ToVkFormat(TextureFormat format)
+        {
+            switch (format)
+            {
+            case TextureFormat::BC1:      return 131; // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+            case TextureFormat::BC1_SRGB: return 132;
+            case TextureFormat::BC3:      return 137; // VK_FORMAT_BC3_UNORM_BLOCK
+            case TextureFormat::BC3_SRGB: return 138;
+            case TextureFormat::BC5:      return 141; // VK_FORMAT_BC5_UNORM_BLOCK
+            case TextureFormat::BC7:      return 145; // VK_FORMAT_BC7_UNORM_BLOCK
+            case TextureFormat::BC7_SRGB: return 146;
+            default:                      return 0;
+            }
+        }
+
+        bool FromVkFormat(uint32_t vkFormat, TextureFormat& format)
+        {
+            switch (vkFormat)
+            {
+            case 131: format = TextureFormat::BC1;      return true;
+            case 132: format = TextureFormat::BC1_SRGB; return true;
+            case 137: format = TextureFormat::BC3;      return true;
+            case 138: format = TextureFormat::BC3_SRGB; return true;
+            case 141: format = TextureFormat::BC5;      return true;
+            case 145: format = TextureFormat::BC7;      return true;
+            case 146: format = TextureFormat::BC7_SRGB; return true;
+            default:  return false;
+            }
+        }
+
+        struct ByteWriter
+        {
+            std::vector<uint8_t> bytes;
+
+            void U32(uint32_t v) { Raw(&v, sizeof(v)); }
+            void U64(uint64_t v) { Raw(&v, sizeof(v)); }
+            void Raw(const void* data, size_t size)
+            {
+                const uint8_t* p = static_cast<const uint8_t*>(data);
+                bytes.insert(bytes.end(), p, p + size);
+            }
+            void Align(size_t alignment) { bytes.resize((bytes.size() + alignment - 1) / alignment * alignment, 0); }
+            void PatchU32(size_t offset, uint32_t v) { std::memcpy(&bytes[offset], &v, sizeof(v)); }
+            void PatchU64(size_t offset, uint64_t v) { std::memcpy(&bytes[offset], &v, sizeof(v)); }
+        };
+
+        uint32_t ReadU32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+        uint64_t ReadU64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+
+        // Basic data format descriptor (Khronos Data Format 1.3) for the formats above.
+        void WriteDfd(ByteWriter& writer, TextureFormat format)
+        {
+            struct Sample { uint32_t bitOffset; uint32_t bitLength; uint32_t channel; };
+
+            const bool srgb = IsSrgbFormat(format);
+            uint32_t colorModel = 0;
+            Sample samples[2] = {};
+            uint32_t sampleCount = 1;
+
+            switch (format)
+            {
+            case TextureFormat::BC1:
+            case TextureFormat::BC1_SRGB:
+                colorModel = 128; // KHR_DF_MODEL_BC1A
+                samples[0] = { 0, 64, 0 };
+                break;
+            case TextureFormat::BC3:
+            case TextureFormat::BC3_SRGB:
+                colorModel = 130; // KHR_DF_MODEL_BC3
+                samples[0] = { 0, 64, 15 | (srgb ? 0x80u : 0u) };
+                samples[1] = { 64, 64, 0 };
+                sampleCount = 2;
+                break;
+            case TextureFormat::BC5:
+                colorModel = 132; // KHR_DF_MODEL_BC5
+                samples[0] = { 0, 64, 0 };
+                samples[1] = { 64, 64, 1 };
+                sampleCount = 2;
+                break;
+            default:
+                colorModel = 134; // KHR_DF_MODEL_BC7
+                samples[0] = { 0, 128, 0 };
+                break;
+            }
+
+            const uint32_t blockSize = 24 + 16 * sampleCount;
+            writer.U32(4 + blockSize);
+            writer.U32(0);
+            writer.U32(2u | (blockSize << 16));
+            writer.U32(colorModel | (1u << 8) | ((srgb ? 2u : 1u) << 16));
+            writer.U32(3u | (3u << 8));
+            writer.U32(TextureCompression::GetBlockBytes(format));
+            writer.U32(0);
+
+            for (uint32_t i = 0; i < sampleCount; ++i)
+            {
+                writer.U32(samples[i].bitOffset | ((samples[i].bitLength - 1) << 16) | (samples[i].channel << 24));
+                writer.U32(0);
+                writer.U32(0);
+                writer.U32(UINT32_MAX);
+            }
+        }
+
+        void WriteKeyValue(ByteWriter& writer, const std::string& key, const std::string& value)
+        {
+            writer.U32(static_cast<uint32_t>(key.size() + value.size() + 2));
+            writer.Raw(key.c_str(), key.size() + 1);
+            writer.Raw(value.c_str(), value.size() + 1);
+            writer.Align(4);
+        }
+    }
+
+    uint32_t TextureCompression::GetBlockBytes(TextureFormat format)
+    {
+        switch (format)
+        {
+        case TextureFormat::BC1:
+        case TextureFormat::BC1_SRGB: return 8;
+        case TextureFormat::BC3:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
+        case TextureFormat::BC7_SRGB: return 16;
+        default:                      return 0;
+        }
+    }
+
+    size_t TextureCompression::GetLevelBytes(TextureFormat format, uint32_t width, uint32_t height)
+    {
+        return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(format);
+    }
+
+    TextureFormat TextureCompression::ChooseFormat(TextureCompressionUsage usage, bool hasAlpha, bool srgb)
+    {
+        if (usage == TextureCompressionUsage::Normal)
+            return TextureFormat::BC5;
+        if (hasAlpha)
+            return srgb ? TextureFormat::BC7_SRGB : TextureFormat::BC7;
+        return srgb ? TextureFormat::BC1_SRGB : TextureFormat::BC1;
+    }
+
+    TextureCompressionUsage TextureCompression::GuessUsage(const std::filesystem::path& source)
+    {
+        std::filesystem::path name = source.filename();
+        if (name.extension() == ".qasset")
+            name = name.stem();
+
+        std::string stem = name.stem().string();
+        std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        const auto endsWith = [&stem](const char* suffix) {
+            const size_t n = std::strlen(suffix);
+            return stem.size() >= n && stem.compare(stem.size() - n, n, suffix) == 0;
+            };
+
+        if (stem.find("normal") != std::string::npos || endsWith("_n") || endsWith("_nrm") || endsWith("_nor"))
+            return TextureCompressionUsage::Normal;
+        return TextureCompressionUsage::Color;
+    }
+
+    bool TextureCompression::Compress(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureCompressionOptions& options, CompressedTexture& out)
+    {
+        if (!rgba || width == 0 || height == 0 || !IsBlockCompressed(options.format))
+            return false;
+
+        out.format = options.format;
+        out.width = width;
+        out.height = height;
+        out.flipped = options.flipped;
+        out.described = true;
+        out.usage = options.usage;
+        out.srgb = IsSrgbFormat(options.format);
+        out.levels.clear();
+
+        const bool srgb = IsSrgbFormat(options.format);
+        const bool normal = options.usage == TextureCompressionUsage::Normal;
+
+        std::vector<uint8_t> mip;
+        const uint8_t* level = rgba;
+        uint32_t w = width, h = height;
+        while (true)
+        {
+            out.levels.emplace_back();
+            CompressLevel(level, w, h, options.format, out.levels.back());
+
+            if (!options.generateMips || (w == 1 && h == 1))
+                break;
+
+            mip = Downsample(level, w, h, srgb, normal);
+            level = mip.data();
+            w = std::max(1u, w / 2);
+            h = std::max(1u, h / 2);
+        }
+        return true;
+    }
+
+    bool TextureCompression::Decompress(const CompressedTexture& texture, uint32_t level, std::vector<uint8_t>& rgba)
+    {
+        if (level >= texture.levels.size())
+            return false;
+
+        const uint32_t width = std::max(1u, texture.width >> level);
+        const uint32_t height = std::max(1u, texture.height >> level);
+        const std::vector<uint8_t>& data = texture.levels[level];
+        if (data.size() != GetLevelBytes(texture.format, width, height))
+            return false;
+
+        const uint32_t blocksX = (width + 3) / 4;
+        const uint32_t blocksY = (height + 3) / 4;
+        const uint32_t blockBytes = GetBlockBytes(texture.format);
+        rgba.assign(static_cast<size_t>(width) * height * 4, 0);
+
+        for (uint32_t by = 0; by < blocksY; ++by)
+        {
+            for (uint32_t bx = 0; bx < blocksX; ++bx)
+            {
+                const uint8_t* src = &data[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+                Block block{};
+
+                switch (texture.format)
+                {
+                case TextureFormat::BC1:
+                case TextureFormat::BC1_SRGB:
+                    DecodeColorBlock(src, false, block);
+                    break;
+                case TextureFormat::BC3:
+                case TextureFormat::BC3_SRGB:
+                    DecodeColorBlock(src + 8, true, block);
+                    DecodeChannelBlock(src, 3, block);
+                    break;
+                case TextureFormat::BC5:
+                    DecodeChannelBlock(src, 0, block);
+                    DecodeChannelBlock(src + 8, 1, block);
+                    for (auto& px : block.px)
+                        px[3] = 255;
+                    break;
+                default:
+                    if (!DecodeBc7Block(src, block))
+                        return false;
+                    break;
+                }
+
+                StoreBlock(block, width, height, bx, by, rgba.data());
+            }
+        }
+        return true;
+    }
+
+    bool TextureCompression::SaveKtx2(const std::filesystem::path& path, const CompressedTexture& texture)
+    {
+        const uint32_t vkFormat = ToVkFormat(texture.format);
+        if (vkFormat == 0 || texture.levels.empty())
+            return false;
+
+        const uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+
+        ByteWriter writer;
+        writer.Raw(Ktx2Identifier, sizeof(Ktx2Identifier));
+        writer.U32(vkFormat);
+        writer.U32(1);
+        writer.U32(texture.width);
+        writer.U32(texture.height);
+        writer.U32(0);
+        writer.U32(0);
+        writer.U32(1);
+        writer.U32(levelCount);
+        writer.U32(0);
+
+        // Index, patched once the sections are placed.
+        const size_t indexOffset = writer.bytes.size();
+        writer.bytes.resize(Ktx2HeaderSize + levelCount * Ktx2LevelEntrySize, 0);
+
+        const size_t dfdOffset = writer.bytes.size();
+        WriteDfd(writer, texture.format);
+        const size_t dfdLength = writer.bytes.size() - dfdOffset;
+
+        // Keys sorted by byte value, as the format requires.
+        const size_t kvdOffset = writer.bytes.size();
+        WriteKeyValue(writer, "KTXorientation", texture.flipped ? "ru" : "rd");
+        WriteKeyValue(writer, "KTXwriter", "QuasarEngine");
+        if (texture.described)
+        {
+            WriteKeyValue(writer, "QEbake", std::string("usage=") + (texture.usage == TextureCompressionUsage::Normal ? "normal" : "color")
+                + " srgb=" + (texture.srgb ? "1" : "0"));
+        }
+        const size_t kvdLength = writer.bytes.size() - kvdOffset;
+
+        writer.PatchU32(indexOffset + 0, static_cast<uint32_t>(dfdOffset));
+        writer.PatchU32(indexOffset + 4, static_cast<uint32_t>(dfdLength));
+        writer.PatchU32(indexOffset + 8, static_cast<uint32_t>(kvdOffset));
+        writer.PatchU32(indexOffset + 12, static_cast<uint32_t>(kvdLength));
+
+        // Level data runs from the smallest mip to the largest, each aligned to a block.
+        const size_t blockBytes = GetBlockBytes(texture.format);
+        for (uint32_t level = levelCount; level-- > 0;)
+        {
+            writer.Align(blockBytes);
+            const size_t entry = Ktx2HeaderSize + level * Ktx2LevelEntrySize;
+            const std::vector<uint8_t>& data = texture.levels[level];
+            writer.PatchU64(entry + 0, writer.bytes.size());
+            writer.PatchU64(entry + 8, data.size());
+            writer.PatchU64(entry + 16, data.size());
+            writer.Raw(data.data(), data.size());
+        }
+
+        return FileUtils::WriteFileAtomic(path, writer.bytes.data(), writer.bytes.size());
+    }
+
+    bool TextureCompression::ParseKtx2(ByteView data, CompressedTexture& out)
+    {
+        if (data.empty() || data.size < Ktx2HeaderSize || std::memcmp(data.data, Ktx2Identifier, sizeof(Ktx2Identifier)) != 0)
+            return false;
+
+        const uint8_t* p = data.data;
+        TextureFormat format;
+        if (!FromVkFormat(ReadU32(p + 12), format))
+            return false;
+
+        const uint32_t width = ReadU32(p + 20);
+        const uint32_t height = ReadU32(p + 24);
+        const uint32_t depth = ReadU32(p + 28);
+        const uint32_t layers = ReadU32(p + 32);
+        const uint32_t faces = ReadU32(p + 36);
+        const uint32_t levelCount = ReadU32(p + 40);
+        const uint32_t supercompression = ReadU32(p + 44);
+
+        if (width == 0 || height == 0 || depth != 0 || layers > 1 || faces != 1 || supercompression != 0)
+            return false;
+
+        uint32_t maxLevels = 1;
+        while ((std::max(width, height) >> maxLevels) > 0)
+            ++maxLevels;
+        if (levelCount == 0 || levelCount > maxLevels)
+            return false;
+        if (Ktx2HeaderSize + static_cast<size_t>(levelCount) * Ktx2LevelEntrySize > data.size)
+            return false;
+
+        // No orientation key means the KTX default, top row first.
+        out.flipped = false;
+        out.described = false;
+        out.usage = TextureCompressionUsage::Color;
+        out.srgb = false;
+        const uint64_t kvdOffset = ReadU32(p + 56);
+        const uint64_t kvdLength = ReadU32(p + 60);
+        if (kvdLength > 0 && kvdOffset + kvdLength <= data.size)
+        {
+            uint64_t cursor = kvdOffset;
+            const uint64_t end = kvdOffset + kvdLength;
+            while (cursor + 4 <= end)
+            {
+                const uint32_t length = ReadU32(p + cursor);
+                cursor += 4;
+                if (length > end - cursor)
+                    break;
+
+                const char* entry = reinterpret_cast<const char*>(p + cursor);
+                const void* terminator = std::memchr(entry, 0, length);
+                const size_t keyLength = terminator ? static_cast<size_t>(static_cast<const char*>(terminator) - entry) : length;
+                const std::string_view key(entry, keyLength);
+                if (keyLength < length && key == "KTXorientation" && keyLength + 2 < length)
+                    out.flipped = entry[keyLength + 2] == 'u';
+
+                if (keyLength < length && key == "QEbake")
+                {
+                    std::string_view value(entry + keyLength + 1, length - keyLength - 1);
+                    value = value.substr(0, value.find('\0'));
+
+                    const bool normal = value.find("usage=normal") != std::string_view::npos;
+                    const bool color = value.find("usage=color") != std::string_view::npos;
+                    const bool srgb = value.find("srgb=1") != std::string_view::npos;
+                    const bool linear = value.find("srgb=0") != std::string_view::npos;
+                    if ((normal != color) && (srgb != linear))
+                    {
+                        out.described = true;
+                        out.usage = normal ? TextureCompressionUsage::Normal : TextureCompressionUsage::Color;
+                        out.srgb = srgb;
+                    }
+                }
+
+                cursor += (length + 3) & ~3u;
+            }
+        }
+
+        out.format = format;
+        out.width = width;
+        out.height = height;
+        out.levels.assign(levelCount, {});
+
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            const uint8_t* entry = p + Ktx2HeaderSize + level * Ktx2LevelEntrySize;
+            const uint64_t offset = ReadU64(entry);
+            const uint64_t length = ReadU64(entry + 8);
+            const size_t expected = GetLevelBytes(format, std::max(1u, width >> level), std::max(1u, height >> level));
+
+            if (length != expected || offset > data.size || length > data.size - offset)
+                return false;
+
+            out.levels[level].assign(p + offset, p + offset + length);
+        }
+        return true;
+    }
+
+    bool TextureCompression::LoadKtx2(const std::filesystem::path& path, CompressedTexture& out)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+            return false;
+        return ParseKtx2(ByteView{ file.Data(), file.Size() }, out);
+    }
+
+    std::filesystem::path TextureCompression::GetCompressedPath(const std::filesystem::path& source)
+    {
+        std::filesystem::path path = source;
+        if (path.extension() == ".qasset")
+            return path.replace_extension(".ktx2");
+        return path += ".ktx2";
+    }
+
+    bool TextureCompression::CompressFile(const std::filesystem::path& source, const std::filesystem::path& destination, const TextureSpecification& specification)
+    {
+        std::ifstream file(source, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+
+        std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (bytes.empty() || !file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+            return false;
+
+        // HDR sources would need BC6H; they stay on the float upload path.
+        const int size = static_cast<int>(bytes.size());
+        if (specification.is_float() || stbi_is_hdr_from_memory(bytes.data(), size))
+            return false;
+
+        int w = 0, h = 0, n = 0;
+        stbi_set_flip_vertically_on_load_thread(specification.flip);
+        unsigned char* pixels = stbi_load_from_memory(bytes.data(), size, &w, &h, &n, 4);
+        if (!pixels)
+            return false;
+
+        bool hasAlpha = false;
+        if (n == 2 || n == 4)
+        {
+            const size_t count = static_cast<size_t>(w) * h;
+            for (size_t i = 0; i < count && !hasAlpha; ++i)
+                hasAlpha = pixels[i * 4 + 3] != 255;
+        }
+
+        TextureCompressionOptions options;
+        options.usage = GuessUsage(source);
+        options.format = ChooseFormat(options.usage, hasAlpha, specification.is_srgb());
+        options.flipped = specification.flip;
+
+        CompressedTexture texture;
+        const bool compressed = Compress(pixels, static_cast<uint32_t>(w), static_cast<uint32_t>(h), options, texture);
+        stbi_image_free(pixels);
+
+        // BC5 has no sRGB variant; record what was asked for so the bake is not redone every load.
+        texture.srgb = specification.is_srgb();
+
+        return compressed && SaveKtx2(destination, texture);
+    }
+
+    bool TextureCompression::IsUpToDate(const std::filesystem::path& source, const std::filesystem::path& compressed)
+    {
+        std::error_code ec;
+        const auto compressedTime = std::filesystem::last_write_time(compressed, ec);
+        if (ec)
+            return false;
+        const auto sourceTime = std::filesystem::last_write_time(source, ec);
+        return !ec && compressedTime >= sourceTime;
+    }
+
+    bool TextureCompression::MatchesSpecification(const CompressedTexture& texture, const std::filesystem::path& source, const TextureSpecification& specification)
+    {
+        if (!texture.described || texture.flipped != specification.flip || texture.srgb != specification.is_srgb())
+            return false;
+
+        const TextureCompressionUsage usage = GuessUsage(source);
+        if (texture.usage != usage)
+            return false;
+
+        if (usage == TextureCompressionUsage::Normal)
+            return texture.format == TextureFormat::BC5;
+        return texture.format != TextureFormat::BC5 && IsSrgbFormat(texture.format) == specification.is_srgb();
+    }
+}
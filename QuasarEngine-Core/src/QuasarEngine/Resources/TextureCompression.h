@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <QuasarEngine/Resources/Texture.h>
+
+namespace QuasarEngine
+{
+    enum class TextureCompressionUsage : uint8_t
+    {
+        Color,
+        Normal,
+    };
+
+    // A block-compressed mip chain. Level 0 is the full resolution image; every level is a tightly
+    // packed array of 4x4 blocks, row by row.
+    struct CompressedTexture
+    {
+        TextureFormat format = TextureFormat::BC1;
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        // Rows run bottom-up, the way stb hands them over when TextureSpecification::flip is set.
+        bool flipped = true;
+
+        // What the chain was baked for, kept in the container's QEbake entry. Containers without
+        // one (other writers, older bakes) leave described unset.
+        bool described = false;
+        TextureCompressionUsage usage = TextureCompressionUsage::Color;
+        bool srgb = false;
+
+        std::vector<std::vector<uint8_t>> levels;
+    };
+
+    struct TextureCompressionOptions
+    {
+        TextureFormat format = TextureFormat::BC7;
+        TextureCompressionUsage usage = TextureCompressionUsage::Color;
+        bool generateMips = true;
+        bool flipped = true;
+    };
+
+    class TextureCompression
+    {
+    public:
+        static uint32_t GetBlockBytes(TextureFormat format);
+        static size_t GetLevelBytes(TextureFormat format, uint32_t width, uint32_t height);
+
+        // Normal maps keep two channels in BC5; colour goes to BC1 when opaque, BC7 otherwise.
+        static TextureFormat ChooseFormat(TextureCompressionUsage usage, bool hasAlpha, bool srgb);
+        // Judged on the file name; a trailing ".qasset" is ignored.
+        static TextureCompressionUsage GuessUsage(const std::filesystem::path& source);
+
+        // Encodes tightly packed RGBA8 pixels, building the mip chain first when asked to.
+        static bool Compress(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureCompressionOptions& options, CompressedTexture& out);
+
+        // Expands one level back to RGBA8. Only the BC7 mode the encoder writes is understood.
+        static bool Decompress(const CompressedTexture& texture, uint32_t level, std::vector<uint8_t>& rgba);
+
+        static bool SaveKtx2(const std::filesystem::path& path, const CompressedTexture& texture);
+        static bool ParseKtx2(ByteView data, CompressedTexture& out);
+        static bool LoadKtx2(const std::filesystem::path& path, CompressedTexture& out);
+
+        // "albedo.png" and "albedo.png.qasset" both map to "albedo.png.ktx2".
+        static std::filesystem::path GetCompressedPath(const std::filesystem::path& source);
+
+        // The asset pipeline step: decodes the image, picks a format and writes the KTX2 container.
+        static bool CompressFile(const std::filesystem::path& source, const std::filesystem::path& destination, const TextureSpecification& specification);
+
+        // A container that exists and is not older than its source.
+        static bool IsUpToDate(const std::filesystem::path& source, const std::filesystem::path& compressed);
+
+        // Whether a loaded container was baked from this source for this specification: same sRGB
+        // request, usage and orientation, and a format consistent with them.
+        static bool MatchesSpecification(const CompressedTexture& texture, const std::filesystem::path& source, const TextureSpecification& specification);
+    };
+}
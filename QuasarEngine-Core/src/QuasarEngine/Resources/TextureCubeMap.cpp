@@ -6,6 +6,7 @@
 #include <Platform/Vulkan/VulkanTextureCubeMap.h>
 #include <Platform/OpenGL/OpenGLTextureCubeMap.h>
 #include <Platform/DirectX/DirectXTextureCubeMap.h>
+#include <Platform/Null/NullTextureCubeMap.h>
 
 namespace QuasarEngine
 {
@@ -14,7 +15,7 @@ namespace QuasarEngine
     std::shared_ptr<TextureCubeMap> TextureCubeMap::Create(const TextureSpecification& specification) {
         switch (RendererAPI::GetAPI())
         {
-        case RendererAPI::API::None:   return nullptr;
+        case RendererAPI::API::None:   return std::make_shared<NullTextureCubeMap>(specification);
         case RendererAPI::API::Vulkan: return std::make_shared<VulkanTextureCubeMap>(specification);
         case RendererAPI::API::OpenGL: return std::make_shared<OpenGLTextureCubeMap>(specification);
         case RendererAPI::API::DirectX:return std::make_shared<DirectXTextureCubeMap>(specification);
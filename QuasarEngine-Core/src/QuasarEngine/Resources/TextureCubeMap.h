@@ -27,6 +27,11 @@ namespace QuasarEngine
         virtual bool LoadFaceFromMemory(Face face, ByteView data) = 0;
         virtual bool LoadFaceFromData(Face face, ByteView data, uint32_t w, uint32_t h, uint32_t channels) = 0;
 
+        // Per-mip upload and float readback, used to persist baked maps. Backends that cannot
+        // do either return false and callers fall back to rebuilding.
+        virtual bool LoadFaceMipFromData(Face face, uint32_t mip, ByteView data, uint32_t w, uint32_t h) { return false; }
+        virtual bool ReadFaceMip(Face face, uint32_t mip, std::vector<float>& out) const { return false; }
+
         static std::shared_ptr<TextureCubeMap> Create(const TextureSpecification& specification);
     };
 }
\ No newline at end of file
@@ -33,8 +33,30 @@ namespace QuasarEngine
         DEPTH24,
         DEPTH32F,
         DEPTH24STENCIL8,
+
+        // 4x4 block formats, produced offline by TextureCompression.
+        BC1,
+        BC1_SRGB,
+        BC3,
+        BC3_SRGB,
+        BC5,
+        BC7,
+        BC7_SRGB,
     };
 
+    constexpr bool IsBlockCompressed(TextureFormat format) noexcept {
+        switch (format) {
+        case TextureFormat::BC1:
+        case TextureFormat::BC1_SRGB:
+        case TextureFormat::BC3:
+        case TextureFormat::BC3_SRGB:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
+        case TextureFormat::BC7_SRGB: return true;
+        default: return false;
+        }
+    }
+
     enum class TextureWrap : uint8_t {
         REPEAT = 0,
         MIRRORED_REPEAT,
@@ -108,10 +130,14 @@ namespace QuasarEngine
             case TextureFormat::SRGB:
             case TextureFormat::SRGB8:
             case TextureFormat::SRGBA:
-            case TextureFormat::SRGB8A8: return true;
+            case TextureFormat::SRGB8A8:
+            case TextureFormat::BC1_SRGB:
+            case TextureFormat::BC3_SRGB:
+            case TextureFormat::BC7_SRGB: return true;
             default: return false;
             }
         }
+        constexpr bool is_block_compressed() const noexcept { return IsBlockCompressed(internal_format); }
         constexpr bool is_depth() const noexcept {
             switch (internal_format) {
             case TextureFormat::DEPTH24:
@@ -120,6 +146,47 @@ namespace QuasarEngine
             default: return false;
             }
         }
+        constexpr bool is_float() const noexcept {
+            switch (internal_format) {
+            case TextureFormat::R16F:
+            case TextureFormat::RG16F:
+            case TextureFormat::RGB16F:
+            case TextureFormat::RGBA16F:
+            case TextureFormat::R32F:
+            case TextureFormat::RGB32F:
+            case TextureFormat::RGBA32F:
+            case TextureFormat::R11G11B10F: return true;
+            default: return false;
+            }
+        }
+        // Channels an image is decoded to for this internal format, 0 keeps the file's own count.
+        constexpr std::uint32_t decode_channels() const noexcept {
+            switch (internal_format) {
+            case TextureFormat::RED:
+            case TextureFormat::RED8:
+            case TextureFormat::R16F:
+            case TextureFormat::R32F:
+            case TextureFormat::R32I:
+            case TextureFormat::DEPTH24:
+            case TextureFormat::DEPTH32F:
+            case TextureFormat::DEPTH24STENCIL8: return 1;
+            case TextureFormat::RG16F: return 2;
+            case TextureFormat::RGB:
+            case TextureFormat::RGB8:
+            case TextureFormat::SRGB:
+            case TextureFormat::SRGB8:
+            case TextureFormat::RGB16F:
+            case TextureFormat::RGB32F:
+            case TextureFormat::R11G11B10F: return 3;
+            case TextureFormat::RGBA:
+            case TextureFormat::RGBA8:
+            case TextureFormat::SRGBA:
+            case TextureFormat::SRGB8A8:
+            case TextureFormat::RGBA16F:
+            case TextureFormat::RGBA32F: return 4;
+            default: return 0;
+            }
+        }
 
         static constexpr std::uint32_t bit_width32(std::uint32_t x) {
             return x ? 1u + bit_width32(x >> 1) : 0u;
@@ -181,6 +248,14 @@ namespace QuasarEngine
         case TextureFormat::DEPTH24:         return "DEPTH24";
         case TextureFormat::DEPTH32F:        return "DEPTH32F";
         case TextureFormat::DEPTH24STENCIL8: return "DEPTH24STENCIL8";
+
+        case TextureFormat::BC1:      return "BC1";
+        case TextureFormat::BC1_SRGB: return "BC1_SRGB";
+        case TextureFormat::BC3:      return "BC3";
+        case TextureFormat::BC3_SRGB: return "BC3_SRGB";
+        case TextureFormat::BC5:      return "BC5";
+        case TextureFormat::BC7:      return "BC7";
+        case TextureFormat::BC7_SRGB: return "BC7_SRGB";
         }
         return "Unknown";
     }
@@ -231,6 +306,14 @@ namespace QuasarEngine
         if (s == "DEPTH32F")        return TextureFormat::DEPTH32F;
         if (s == "DEPTH24STENCIL8") return TextureFormat::DEPTH24STENCIL8;
 
+        if (s == "BC1")      return TextureFormat::BC1;
+        if (s == "BC1_SRGB") return TextureFormat::BC1_SRGB;
+        if (s == "BC3")      return TextureFormat::BC3;
+        if (s == "BC3_SRGB") return TextureFormat::BC3_SRGB;
+        if (s == "BC5")      return TextureFormat::BC5;
+        if (s == "BC7")      return TextureFormat::BC7;
+        if (s == "BC7_SRGB") return TextureFormat::BC7_SRGB;
+
         return std::nullopt;
     }
 }
\ No newline at end of file
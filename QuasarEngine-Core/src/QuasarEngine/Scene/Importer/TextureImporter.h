@@ -4,7 +4,9 @@
 #include <fstream>
 
 #include <QuasarEngine/File/FileUtils.h>
+#include <QuasarEngine/Core/Logger.h>
 #include <QuasarEngine/Resources/Texture2D.h>
+#include <QuasarEngine/Resources/TextureCompression.h>
 #include <QuasarEngine/Asset/AssetHeader.h>
 #include <QuasarEngine/Asset/AssetManager.h>
 #include <QuasarEngine/Scene/Importer/TextureConfigImporter.h>
@@ -35,6 +37,11 @@ namespace QuasarEngine
 			file.write(reinterpret_cast<const char*>(data.get()), size);
 
 			file.close();
+
+			// Baked BC mips next to the .qasset; streaming picks them up for the matching source image.
+			const std::filesystem::path baked = TextureCompression::GetCompressedPath(out);
+			if (!TextureCompression::CompressFile(path, baked, spec))
+				Q_WARNING("TextureImporter: no compressed mips for " + path);
 		}
 
 		static void updateTexture(const std::string& path, const TextureSpecification& spec)
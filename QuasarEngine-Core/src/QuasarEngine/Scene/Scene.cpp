@@ -1,6 +1,7 @@
 #include "qepch.h"
 
 #include <QuasarEngine/Scene/Scene.h>
+#include <QuasarEngine/Scene/TransformSystem.h>
 #include <QuasarEngine/Entity/Entity.h>
 #include <QuasarEngine/Core/Application.h>
 #include <QuasarEngine/Core/Window.h>
@@ -11,6 +12,9 @@
 #include <QuasarEngine/Entity/Components/TagComponent.h>
 #include <QuasarEngine/Physic/PhysicEngine.h>
 #include <QuasarEngine/Core/Input.h>
+#include <QuasarEngine/Thread/JobSystem.h>
+#include <QuasarEngine/Asset/AssetManager.h>
+#include <QuasarEngine/Tools/Profiler.h>
 
 #include "QuasarEngine/Entity/Components/Physics/RigidBodyComponent.h"
 #include <QuasarEngine/Entity/Components/Animation/AnimationComponent.h>
@@ -23,10 +27,13 @@ namespace QuasarEngine
         m_PrimaryCameraUUID(0)
     {
         m_Registry = std::make_unique<Registry>();
+        m_TransformSystem = std::make_unique<TransformSystem>();
     }
 
     Scene::~Scene()
     {
+        AssetManager::Instance().CancelMeshBindings(m_Registry.get());
+
         ClearEntities();
         ProcessEntityDestructions();
     }
@@ -165,28 +172,39 @@ namespace QuasarEngine
 
     void Scene::Update(double deltaTime)
     {
-        ProcessEntityDestructions();
+        QE_PROFILE_FUNCTION();
 
-        auto view = m_Registry->GetRegistry().view<AnimationComponent>();
-        for (auto entity : view)
-        {
-            auto& anim = view.get<AnimationComponent>(entity);
-            anim.Update(deltaTime);
-        }
+        if (!m_DeferDestructions)
+            ProcessEntityDestructions();
+
+        auto& animations = m_Registry->GetRegistry().storage<AnimationComponent>();
+        JobSystem::Instance().ParallelFor(animations.size(), 0, [&animations, deltaTime](std::size_t i)
+            {
+                animations.get(animations.data()[i]).Update(deltaTime);
+            });
 
         for (auto [e, tr, pc] : m_Registry->GetRegistry().group<TransformComponent, ParticleComponent>().each())
         {
             //glm::vec3 emitterPos = tr.GetGlobalTransform() * glm::vec4(pc.m_EmitterOffset, 1.0f);
             //pc.Update(deltaTime, emitterPos);
-            pc.Update(deltaTime);
+            pc.Update(deltaTime, tr.Position);
         }
 
         if (m_OnRuntime)
             UpdateRuntime(deltaTime);
     }
 
+    void Scene::UpdateWorldTransforms()
+    {
+        QE_PROFILE_FUNCTION();
+
+        m_TransformSystem->Update(*this);
+    }
+
     void Scene::UpdateRuntime(double deltaTime)
     {
+        QE_PROFILE_FUNCTION();
+
         PhysicEngine::Instance().Step(deltaTime);
 
         auto view = m_Registry->GetRegistry().view<RigidBodyComponent>();
@@ -200,7 +218,10 @@ namespace QuasarEngine
 
         if (Input::IsKeyJustPressed(Key::Escape))
         {
-            Application::Get().GetWindow().SetInputMode(false, false);
+            // May run on the frame worker, window calls belong to the main thread.
+            Application::Get().SubmitToMainThread([]() {
+                Application::Get().GetWindow().SetInputMode(false, false);
+                });
 		}
     }
 
@@ -10,6 +10,7 @@
 namespace QuasarEngine
 {
     class Entity;
+    class TransformSystem;
 
     using EntityMap = std::unordered_map<UUID, entt::entity>;
     using NameMap = std::unordered_map<std::string, entt::entity>;
@@ -24,6 +25,11 @@ namespace QuasarEngine
         Entity CreateEntityWithUUID(UUID uuid, const std::string& name = std::string());
 
         void DestroyEntity(UUID uuid);
+        void ProcessEntityDestructions();
+
+        // Pipelined frames: Update leaves destructions to the owner, which processes them
+        // while nothing is drawn, so the frame being rendered keeps its meshes and materials.
+        void SetDeferDestructions(bool defer) { m_DeferDestructions = defer; }
 
         std::optional<Entity> GetEntityByUUID(UUID uuid) const;
 		std::optional<Entity> GetEntityByName(const std::string& name) const;
@@ -31,6 +37,10 @@ namespace QuasarEngine
         void Update(double deltaTime);
         void UpdateRuntime(double deltaTime);
 
+        // Brings WorldTransformComponent up to date with every transform edit so far. The renderer
+        // runs it before syncing; anything else reading world matrices mid-frame sees the last pass.
+        void UpdateWorldTransforms();
+
         void OnRuntimeStart();
         void OnRuntimeStop();
 
@@ -64,16 +74,16 @@ namespace QuasarEngine
         NameMap m_NameMap;
 
         std::unique_ptr<Registry> m_Registry;
+        std::unique_ptr<TransformSystem> m_TransformSystem;
 
         bool m_OnRuntime;
+        bool m_DeferDestructions = false;
         UUID m_PrimaryCameraUUID;
 
         std::unordered_set<UUID> m_PendingEntityDestructions;
 
         void DestroyEntityNow(Entity entity);
 
-        void ProcessEntityDestructions();
-
         void RegisterEntityName(const std::string& name, entt::entity entity);
         void UnregisterEntityName(const std::string& name);
         void UpdatePrimaryCameraCache();
@@ -422,13 +422,13 @@ namespace QuasarEngine
                                 AssetManager::Instance().loadAsset(modelAsset);
                             }
 
-                            auto& comp = entity.AddOrReplaceComponent<MeshComponent>(mname, nullptr, id);
+                            entity.AddOrReplaceComponent<MeshComponent>(mname, nullptr, id);
 
                             AssetToLoad meshAsset;
                             meshAsset.id = id;
                             meshAsset.path = fullPath.generic_string();
                             meshAsset.type = AssetType::MESH;
-                            meshAsset.handle = &comp;
+                            meshAsset.handle = entity;
 
                             AssetManager::Instance().loadAsset(meshAsset);
                         }
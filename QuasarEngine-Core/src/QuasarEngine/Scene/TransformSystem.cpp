@@ -0,0 +1,202 @@
+#include "qepch.h"
+
+#include <QuasarEngine/Scene/TransformSystem.h>
+#include <QuasarEngine/Scene/Scene.h>
+#include <QuasarEngine/Entity/Entity.h>
+#include <QuasarEngine/Entity/Components/TransformComponent.h>
+#include <QuasarEngine/Entity/Components/WorldTransformComponent.h>
+#include <QuasarEngine/Entity/Components/HierarchyComponent.h>
+#include <QuasarEngine/Thread/JobSystem.h>
+
+#include <atomic>
+#include <limits>
+
+namespace QuasarEngine
+{
+    namespace
+    {
+        constexpr uint32_t DepthUnknown = std::numeric_limits<uint32_t>::max();
+        constexpr uint32_t DepthVisiting = DepthUnknown - 1;
+    }
+
+    void TransformSystem::Update(Scene& scene)
+    {
+        ++m_Frame;
+
+        AttachMissing(scene);
+        RefreshLocals(scene);
+
+        auto& registry = scene.GetRegistry()->GetRegistry();
+
+        if (m_HierarchyDirty)
+        {
+            RebuildLevels(registry);
+            m_HierarchyDirty = false;
+        }
+
+        Propagate(registry);
+    }
+
+    void TransformSystem::AttachMissing(Scene& scene)
+    {
+        auto& registry = scene.GetRegistry()->GetRegistry();
+
+        m_Scratch.clear();
+        for (auto e : registry.view<TransformComponent>(entt::exclude<WorldTransformComponent>))
+            m_Scratch.push_back(e);
+
+        for (auto e : m_Scratch)
+        {
+            Entity entity{ e, scene.GetRegistry() };
+            entity.AddComponent<WorldTransformComponent>();
+        }
+
+        bool changed = !m_Scratch.empty();
+
+        m_Scratch.clear();
+        for (auto e : registry.view<WorldTransformComponent>(entt::exclude<TransformComponent>))
+            m_Scratch.push_back(e);
+
+        for (auto e : m_Scratch)
+            registry.remove<WorldTransformComponent>(e);
+
+        changed |= !m_Scratch.empty();
+
+        if (changed)
+            m_HierarchyDirty = true;
+    }
+
+    void TransformSystem::RefreshLocals(Scene& scene)
+    {
+        auto& registry = scene.GetRegistry()->GetRegistry();
+        auto& worlds = registry.storage<WorldTransformComponent>();
+        auto& transforms = registry.storage<TransformComponent>();
+        auto& hierarchies = registry.storage<HierarchyComponent>();
+
+        std::atomic<bool> hierarchyChanged{ false };
+
+        JobSystem::Instance().ParallelFor(worlds.size(), 0, [&](std::size_t i)
+            {
+                const entt::entity e = worlds.data()[i];
+                auto& world = worlds.get(e);
+                const auto& tr = transforms.get(e);
+
+                if (!world.Matches(tr.Position, tr.Rotation, tr.Scale))
+                {
+                    world.Local = tr.GetLocalTransform();
+                    world.CachedPosition = tr.Position;
+                    world.CachedRotation = tr.Rotation;
+                    world.CachedScale = tr.Scale;
+                    world.Valid = true;
+                    world.Dirty = true;
+                }
+
+                const UUID parent = hierarchies.contains(e) ? hierarchies.get(e).m_Parent : UUID::Null();
+                const bool parentLost = world.ParentHandle != entt::null && !worlds.contains(world.ParentHandle);
+
+                if (parent != world.CachedParent || parentLost)
+                {
+                    world.CachedParent = parent;
+                    world.ParentHandle = entt::null;
+
+                    if (parent != UUID::Null())
+                    {
+                        std::optional<Entity> parentEntity = scene.GetEntityByUUID(parent);
+                        if (parentEntity.has_value() && static_cast<entt::entity>(*parentEntity) != e)
+                            world.ParentHandle = *parentEntity;
+                    }
+
+                    world.Dirty = true;
+                    hierarchyChanged.store(true, std::memory_order_relaxed);
+                }
+            });
+
+        if (hierarchyChanged.load(std::memory_order_relaxed))
+            m_HierarchyDirty = true;
+    }
+
+    void TransformSystem::RebuildLevels(entt::registry& registry)
+    {
+        auto& worlds = registry.storage<WorldTransformComponent>();
+
+        for (auto& world : worlds)
+            world.Depth = DepthUnknown;
+
+        for (auto& level : m_Levels)
+            level.clear();
+
+        for (std::size_t i = 0; i < worlds.size(); ++i)
+        {
+            const entt::entity e = worlds.data()[i];
+            if (worlds.get(e).Depth != DepthUnknown)
+                continue;
+
+            m_Scratch.clear();
+
+            entt::entity current = e;
+            while (current != entt::null && worlds.contains(current) && worlds.get(current).Depth == DepthUnknown)
+            {
+                auto& world = worlds.get(current);
+                world.Depth = DepthVisiting;
+                m_Scratch.push_back(current);
+                current = world.ParentHandle;
+            }
+
+            // A cycle (or a missing parent) makes the top of the chain a root.
+            uint32_t depth = 0;
+            if (current != entt::null && worlds.contains(current) && worlds.get(current).Depth != DepthVisiting)
+                depth = worlds.get(current).Depth + 1;
+
+            for (auto it = m_Scratch.rbegin(); it != m_Scratch.rend(); ++it, ++depth)
+            {
+                auto& world = worlds.get(*it);
+                world.Depth = depth;
+                world.Dirty = true;
+
+                if (m_Levels.size() <= depth)
+                    m_Levels.resize(depth + 1);
+                m_Levels[depth].push_back(*it);
+            }
+        }
+    }
+
+    void TransformSystem::Propagate(entt::registry& registry)
+    {
+        auto& worlds = registry.storage<WorldTransformComponent>();
+        const uint64_t frame = m_Frame;
+        std::atomic<bool> stale{ false };
+
+        for (const auto& level : m_Levels)
+        {
+            JobSystem::Instance().ParallelFor(level.size(), 0, [&](std::size_t i)
+                {
+                    const entt::entity e = level[i];
+                    if (!worlds.contains(e))
+                    {
+                        stale.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    auto& world = worlds.get(e);
+
+                    const WorldTransformComponent* parent = nullptr;
+                    if (world.ParentHandle != entt::null && worlds.contains(world.ParentHandle))
+                    {
+                        const auto& candidate = worlds.get(world.ParentHandle);
+                        if (candidate.Depth < world.Depth)
+                            parent = &candidate;
+                    }
+
+                    if (world.Dirty || (parent && parent->ChangedFrame == frame))
+                    {
+                        world.World = parent ? parent->World * world.Local : world.Local;
+                        world.ChangedFrame = frame;
+                        world.Dirty = false;
+                    }
+                });
+        }
+
+        if (stale.load(std::memory_order_relaxed))
+            m_HierarchyDirty = true;
+    }
+}
\ No newline at end of file
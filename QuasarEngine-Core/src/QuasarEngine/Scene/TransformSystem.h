@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <entt.hpp>
+
+namespace QuasarEngine
+{
+    class Scene;
+
+    // Keeps WorldTransformComponent in sync with TransformComponent / HierarchyComponent.
+    // Locals are rebuilt only when the transform values changed, and world matrices are
+    // propagated level by level (parents first), each level being processed in parallel.
+    class TransformSystem
+    {
+    public:
+        void Update(Scene& scene);
+
+        void Invalidate() { m_HierarchyDirty = true; }
+
+        uint64_t GetFrame() const { return m_Frame; }
+
+    private:
+        void AttachMissing(Scene& scene);
+        void RefreshLocals(Scene& scene);
+        void RebuildLevels(entt::registry& registry);
+        void Propagate(entt::registry& registry);
+
+        std::vector<std::vector<entt::entity>> m_Levels;
+        std::vector<entt::entity> m_Scratch;
+
+        uint64_t m_Frame = 0;
+        bool m_HierarchyDirty = true;
+    };
+}
\ No newline at end of file
@@ -35,6 +35,7 @@
 #include <QuasarEngine/UI/UISlider.h>
 #include <QuasarEngine/UI/UIText.h>
 #include <QuasarEngine/UI/UISystem.h>
+#include <QuasarEngine/Tools/Profiler.h>
 
 namespace QuasarEngine
 {
@@ -245,6 +246,8 @@ namespace QuasarEngine
 
     void ScriptSystem::Update(double dt)
     {
+        QE_PROFILE_FUNCTION();
+
         auto reg = Renderer::Instance().m_SceneData.m_Scene->GetRegistry();
         auto view = reg->GetRegistry().view<ScriptComponent>();
 
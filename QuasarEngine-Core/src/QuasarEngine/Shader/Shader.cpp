@@ -6,6 +6,7 @@
 #include <Platform/Vulkan/VulkanShader.h>
 #include <Platform/OpenGL/OpenGLShader.h>
 #include <Platform/DirectX/DirectXShader.h>
+#include <Platform/Null/NullShader.h>
 
 namespace QuasarEngine
 {
@@ -13,7 +14,7 @@ namespace QuasarEngine
 	{
 		switch (RendererAPI::GetAPI())
 		{
-		case RendererAPI::API::None:    return nullptr;
+		case RendererAPI::API::None:    return std::make_shared<NullShader>(desc);
 		case RendererAPI::API::Vulkan:	return std::make_shared<VulkanShader>(desc);
 		case RendererAPI::API::OpenGL:	return std::make_shared<OpenGLShader>(desc);
 		case RendererAPI::API::DirectX:	return std::make_shared<DirectXShader>(desc);
@@ -21,4 +22,42 @@ namespace QuasarEngine
 
 		return nullptr;
 	}
+
+	Shader::UniformHandle Shader::GetUniformHandle(const std::string& name) const
+	{
+		const ShaderDescription& desc = GetDescription();
+
+		for (size_t i = 0; i < desc.globalUniforms.size(); ++i)
+			if (desc.globalUniforms[i].name == name)
+				return static_cast<UniformHandle>(i);
+
+		for (size_t i = 0; i < desc.objectUniforms.size(); ++i)
+			if (desc.objectUniforms[i].name == name)
+				return static_cast<UniformHandle>(i) | ObjectUniformBit;
+
+		return InvalidHandle;
+	}
+
+	Shader::SamplerHandle Shader::GetSamplerHandle(const std::string& name) const
+	{
+		const ShaderDescription& desc = GetDescription();
+
+		for (size_t i = 0; i < desc.samplers.size(); ++i)
+			if (desc.samplers[i].name == name)
+				return static_cast<SamplerHandle>(i);
+
+		return InvalidHandle;
+	}
+
+	const Shader::ShaderUniformDesc* Shader::ResolveUniform(UniformHandle handle) const
+	{
+		if (handle == InvalidHandle)
+			return nullptr;
+
+		const ShaderDescription& desc = GetDescription();
+		const size_t index = handle & ~ObjectUniformBit;
+
+		const auto& uniforms = (handle & ObjectUniformBit) ? desc.objectUniforms : desc.globalUniforms;
+		return index < uniforms.size() ? &uniforms[index] : nullptr;
+	}
 }
\ No newline at end of file
@@ -163,11 +163,33 @@ namespace QuasarEngine
 
         virtual bool SetTexture(const std::string& name, Texture* texture, SamplerType type = SamplerType::Sampler2D) = 0;
 
+        // Handles index the description (global / object uniforms, samplers) and are resolved
+        // once by the caller, so per-draw updates skip the name lookups.
+        using UniformHandle = uint32_t;
+        using SamplerHandle = uint32_t;
+
+        static constexpr uint32_t InvalidHandle = 0xFFFFFFFFu;
+        static constexpr uint32_t ObjectUniformBit = 0x80000000u;
+
+        UniformHandle GetUniformHandle(const std::string& name) const;
+        SamplerHandle GetSamplerHandle(const std::string& name) const;
+
+        virtual bool SetUniform(UniformHandle handle, const void* data, size_t size) = 0;
+        virtual bool SetTexture(SamplerHandle handle, Texture* texture, SamplerType type = SamplerType::Sampler2D) = 0;
+
+        // Copies a whole object block laid out like ShaderDescription::objectUniforms.
+        virtual bool SetObjectUniforms(const void* data, size_t size) = 0;
+
         virtual bool SetStorageBuffer(const std::string& name, const void* data, size_t size) = 0;
 
 		virtual void Use() = 0;
 		virtual void Unuse() = 0;
 
 		virtual void Reset() = 0;
+
+    protected:
+        virtual const ShaderDescription& GetDescription() const = 0;
+
+        const ShaderUniformDesc* ResolveUniform(UniformHandle handle) const;
 	};
 }
@@ -0,0 +1,207 @@
+#include "qepch.h"
+#include <QuasarEngine/Shader/ShaderCache.h>
+
+#include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Tools/Hash.h>
+#include <QuasarEngine/File/FileUtils.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace QuasarEngine
+{
+    namespace
+    {
+        constexpr uint32_t CacheMagic = 0x43534551; // "QESC"
+
+        struct CacheHeader
+        {
+            uint32_t magic = CacheMagic;
+            uint32_t version = ShaderCache::Version;
+            uint64_t key = 0;
+            uint32_t format = 0;
+            uint32_t size = 0;
+        };
+
+        void HashUniforms(Fnv1a& h, const std::vector<Shader::ShaderUniformDesc>& uniforms)
+        {
+            h.U64(uniforms.size());
+            for (const auto& u : uniforms)
+            {
+                h.String(u.name);
+                h.U64(static_cast<uint64_t>(u.type));
+                h.U64(u.size);
+                h.U64(u.offset);
+                h.U64(u.set);
+                h.U64(u.binding);
+                h.U64(u.stages);
+            }
+        }
+    }
+
+    uint64_t ShaderCache::ComputeKey(const Shader::ShaderDescription& desc, const std::vector<std::string>& sources, const std::string& driver)
+    {
+        Fnv1a h;
+        h.U64(Version);
+        h.String(driver);
+
+        h.U64(desc.modules.size());
+        for (const auto& module : desc.modules)
+            h.U64(static_cast<uint64_t>(module.stage));
+
+        h.U64(sources.size());
+        for (const std::string& source : sources)
+            h.String(source);
+
+        HashUniforms(h, desc.globalUniforms);
+        HashUniforms(h, desc.objectUniforms);
+
+        h.U64(desc.samplers.size());
+        for (const auto& s : desc.samplers)
+        {
+            h.String(s.name);
+            h.U64(s.set);
+            h.U64(s.binding);
+            h.U64(s.stages);
+        }
+
+        h.U64(desc.pushConstants.size());
+        for (const auto& p : desc.pushConstants)
+        {
+            h.String(p.name);
+            h.U64(p.stages);
+            h.U64(p.size);
+            h.U64(p.offset);
+        }
+
+        h.U64(desc.storageBuffers.size());
+        for (const auto& sb : desc.storageBuffers)
+        {
+            h.String(sb.name);
+            h.U64(sb.size);
+            h.U64(sb.binding);
+            h.U64(sb.stages);
+        }
+
+        // Depth, cull and blend state is applied per draw and never reaches the program.
+        h.U64(static_cast<uint64_t>(desc.topology));
+        h.U64(static_cast<uint64_t>(desc.patchControlPoints));
+
+        return h.hash;
+    }
+
+    void ShaderCache::SetDirectory(const std::filesystem::path& directory)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Directory = directory;
+    }
+
+    std::filesystem::path ShaderCache::GetDirectory() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Directory.empty() ? std::filesystem::current_path() / "ShaderCache" : m_Directory;
+    }
+
+    std::filesystem::path ShaderCache::GetEntryPath(uint64_t key) const
+    {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return GetDirectory() / name.str();
+    }
+
+    bool ShaderCache::Load(uint64_t key, uint32_t& format, std::vector<uint8_t>& binary) const
+    {
+        if (!m_Enabled)
+            return false;
+
+        std::ifstream in(GetEntryPath(key), std::ios::binary);
+        if (!in)
+            return false;
+
+        CacheHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+
+        if (header.magic != CacheMagic || header.version != Version || header.key != key || header.size == 0)
+            return false;
+
+        binary.resize(header.size);
+        if (!in.read(reinterpret_cast<char*>(binary.data()), header.size))
+            return false;
+
+        format = header.format;
+        return true;
+    }
+
+    bool ShaderCache::Store(uint64_t key, uint32_t format, const std::vector<uint8_t>& binary)
+    {
+        if (!m_Enabled || binary.empty())
+            return false;
+
+        const std::filesystem::path path = GetEntryPath(key);
+
+        CacheHeader header;
+        header.key = key;
+        header.format = format;
+        header.size = static_cast<uint32_t>(binary.size());
+
+        const bool written = FileUtils::WriteFileAtomic(path, [&](std::ofstream& out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+            });
+        if (!written)
+        {
+            Q_WARNING("ShaderCache: failed to write " + path.string());
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.stores;
+        return true;
+    }
+
+    void ShaderCache::Remove(uint64_t key)
+    {
+        std::error_code ec;
+        std::filesystem::remove(GetEntryPath(key), ec);
+    }
+
+    void ShaderCache::Clear()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(GetDirectory(), ec);
+    }
+
+    void ShaderCache::RecordHit(double ms)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.hits;
+        m_Stats.warmMs += ms;
+    }
+
+    void ShaderCache::RecordMiss(double ms)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.misses;
+        m_Stats.coldMs += ms;
+    }
+
+    void ShaderCache::RecordRejected()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.rejected;
+    }
+
+    ShaderCacheStats ShaderCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Stats;
+    }
+
+    void ShaderCache::ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats = {};
+    }
+}
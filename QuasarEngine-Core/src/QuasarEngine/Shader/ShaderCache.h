@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QuasarEngine/Core/Singleton.h>
+#include <QuasarEngine/Shader/Shader.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace QuasarEngine
+{
+    struct ShaderCacheStats
+    {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        // Entries the driver refused (driver update, corrupted file); they count as misses too.
+        uint32_t rejected = 0;
+        uint32_t stores = 0;
+
+        // Time spent creating programs from the cache (warm) and from source (cold).
+        double warmMs = 0.0;
+        double coldMs = 0.0;
+    };
+
+    // On-disk cache of linked program binaries. Entries are keyed by the stage sources, the
+    // shader description and the driver string, so any of them changing simply misses.
+    class ShaderCache : public Singleton<ShaderCache>
+    {
+    public:
+        static constexpr uint32_t Version = 1;
+
+        static uint64_t ComputeKey(const Shader::ShaderDescription& desc, const std::vector<std::string>& sources, const std::string& driver);
+
+        void SetEnabled(bool enabled) { m_Enabled = enabled; }
+        bool IsEnabled() const { return m_Enabled; }
+
+        void SetDirectory(const std::filesystem::path& directory);
+        std::filesystem::path GetDirectory() const;
+
+        bool Load(uint64_t key, uint32_t& format, std::vector<uint8_t>& binary) const;
+        bool Store(uint64_t key, uint32_t format, const std::vector<uint8_t>& binary);
+        void Remove(uint64_t key);
+        void Clear();
+
+        void RecordHit(double ms);
+        void RecordMiss(double ms);
+        void RecordRejected();
+
+        ShaderCacheStats GetStats() const;
+        void ResetStats();
+
+        friend class Singleton<ShaderCache>;
+    private:
+        ShaderCache() = default;
+
+        std::filesystem::path GetEntryPath(uint64_t key) const;
+
+        bool m_Enabled = true;
+        std::filesystem::path m_Directory;
+
+        mutable std::mutex m_Mutex;
+        ShaderCacheStats m_Stats;
+    };
+}
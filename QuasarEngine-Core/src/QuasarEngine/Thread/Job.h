@@ -1,8 +1,11 @@
 #pragma once
 
+#include <QuasarEngine/Tools/Profiler.h>
+
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -10,21 +13,34 @@ namespace QuasarEngine
 {
     enum class JobPriority { LOW = 0, NORMAL, HIGH };
     enum class JobPoolType { GENERAL, IO, RENDER, SIMULATION };
+    enum class JobSchedulerType { SHARED_QUEUE, WORK_STEALING };
 
     struct Job
     {
         using Ptr = std::shared_ptr<Job>;
 
         std::string        name;
+        // Zone name handed to the profiler: a literal or the interned copy of name, resolved
+        // once at creation so running the job never touches the profiler's name table.
+        const char*        profileName = "Job";
         JobPriority        priority{ JobPriority::NORMAL };
         JobPoolType        pool{ JobPoolType::GENERAL };
         std::function<void()> func;
 
-        std::vector<std::weak_ptr<Job>> dependencies;
-
         std::atomic<bool> started{ false };
         std::atomic<bool> finished{ false };
 
+        // Dependencies not finished yet; the job is dispatched when it drops to zero.
+        std::atomic<int> unfinishedDependencies{ 0 };
+
+        // Jobs waiting on this one. Once released, late dependents no longer register.
+        std::mutex       successorsMutex;
+        std::vector<Ptr> successors;
+        bool             successorsReleased = false;
+
+        // Self-reference held while the job sits in a WorkStealingJobPool deque.
+        Ptr keepAlive;
+
         Job() = default;
 
         template <typename F>
@@ -33,23 +49,25 @@ namespace QuasarEngine
             JobPoolType poolType = JobPoolType::GENERAL,
             std::string n = {})
             : name(std::move(n))
+            , profileName(ProfileName(name))
             , priority(p)
             , pool(poolType)
             , func(std::forward<F>(f))
         {
         }
 
+        static const char* ProfileName(const std::string& n)
+        {
+#if QE_PROFILE
+            if (!n.empty())
+                return Profiler::Instance().InternName(n);
+#endif
+            return "Job";
+        }
+
         bool DependenciesFinished() const
         {
-            for (auto& depWeak : dependencies)
-            {
-                if (auto dep = depWeak.lock())
-                {
-                    if (!dep->finished.load(std::memory_order_acquire))
-                        return false;
-                }
-            }
-            return true;
+            return unfinishedDependencies.load(std::memory_order_acquire) == 0;
         }
     };
 
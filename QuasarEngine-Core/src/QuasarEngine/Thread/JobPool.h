@@ -2,13 +2,12 @@
 
 #include "Job.h"
 
-#include <atomic>
-#include <condition_variable>
+#include <QuasarEngine/Tools/Profiler.h>
+
 #include <cstddef>
 #include <functional>
-#include <mutex>
-#include <queue>
-#include <thread>
+#include <string>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
@@ -23,12 +22,7 @@ namespace QuasarEngine
     public:
         using JobFinishedCallback = std::function<void(const Job::Ptr&)>;
 
-        JobPool(JobPoolType type,
-            std::size_t threadCount,
-            JobFinishedCallback onFinished = {},
-            std::vector<int> coreAffinity = {});
-
-        ~JobPool();
+        virtual ~JobPool() = default;
 
         JobPool(const JobPool&) = delete;
         JobPool& operator=(const JobPool&) = delete;
@@ -36,137 +30,90 @@ namespace QuasarEngine
         JobPool& operator=(JobPool&&) = delete;
 
         JobPoolType GetType() const noexcept { return m_type; }
+        virtual JobSchedulerType GetScheduler() const noexcept = 0;
 
-        void Enqueue(Job::Ptr job);
+        virtual std::size_t GetThreadCount() const noexcept = 0;
 
-        void Shutdown();
+        virtual void Enqueue(Job::Ptr job) = 0;
 
-    private:
-        void WorkerLoop(std::size_t workerIndex);
+        // Runs one queued job on the calling thread, if any is available.
+        virtual bool TryExecuteOne() = 0;
 
-        JobPoolType m_type;
-        std::vector<std::thread> m_workers;
+        virtual void Shutdown() = 0;
 
-        std::priority_queue<
-            Job::Ptr,
-            std::vector<Job::Ptr>,
-            JobPriorityComparator> m_jobs;
+    protected:
+        JobPool(JobPoolType type,
+            JobFinishedCallback onFinished,
+            std::vector<int> coreAffinity)
+            : m_type(type)
+            , m_affinity(std::move(coreAffinity))
+            , m_onFinished(std::move(onFinished))
+        {
+        }
 
-        std::mutex              m_queueMutex;
-        std::condition_variable m_condition;
-        std::atomic<bool>       m_stop{ false };
+        void ApplyAffinity(std::size_t workerIndex) const;
+        std::string WorkerName(std::size_t workerIndex) const;
+        void Execute(const Job::Ptr& job) const;
 
-        std::vector<int>        m_affinity;
-        JobFinishedCallback     m_onFinished;
+        JobPoolType         m_type;
+        std::vector<int>    m_affinity;
+        JobFinishedCallback m_onFinished;
     };
 
-    inline JobPool::JobPool(JobPoolType type,
-        std::size_t threadCount,
-        JobFinishedCallback onFinished,
-        std::vector<int> coreAffinity)
-        : m_type(type)
-        , m_affinity(std::move(coreAffinity))
-        , m_onFinished(std::move(onFinished))
+    inline void JobPool::ApplyAffinity(std::size_t workerIndex) const
     {
-        if (threadCount == 0)
-            threadCount = 1;
-
-        m_workers.reserve(threadCount);
-        for (std::size_t i = 0; i < threadCount; ++i)
+#ifdef _WIN32
+        if (!m_affinity.empty())
         {
-            m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+            DWORD_PTR mask = 1ull << m_affinity[workerIndex % m_affinity.size()];
+            SetThreadAffinityMask(GetCurrentThread(), mask);
         }
+#else
+        (void)workerIndex;
+#endif
     }
 
-    inline JobPool::~JobPool()
-    {
-        Shutdown();
-    }
-
-    inline void JobPool::Shutdown()
+    inline std::string JobPool::WorkerName(std::size_t workerIndex) const
     {
-        bool expected = false;
-        if (!m_stop.compare_exchange_strong(expected, true,
-            std::memory_order_acq_rel))
+        const char* pool = "General";
+        switch (m_type)
         {
-            return;
-        }
-
-        m_condition.notify_all();
-        for (auto& worker : m_workers)
-        {
-            if (worker.joinable())
-                worker.join();
+        case JobPoolType::IO:         pool = "IO"; break;
+        case JobPoolType::RENDER:     pool = "Render"; break;
+        case JobPoolType::SIMULATION: pool = "Simulation"; break;
+        default: break;
         }
+        return std::string(pool) + " Worker " + std::to_string(workerIndex);
     }
 
-    inline void JobPool::Enqueue(Job::Ptr job)
+    inline void JobPool::Execute(const Job::Ptr& job) const
     {
-        if (!job)
-            return;
+        job->started.store(true, std::memory_order_release);
 
+        try
         {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            if (m_stop.load(std::memory_order_acquire))
+#if QE_PROFILE
+            if (Profiler::Instance().IsEnabled())
             {
-                return;
+                ProfileScope zone(job->profileName);
+                job->func();
             }
-
-            m_jobs.push(std::move(job));
-        }
-        m_condition.notify_one();
-    }
-
-    inline void JobPool::WorkerLoop(std::size_t workerIndex)
-    {
-#ifdef _WIN32
-        if (!m_affinity.empty())
-        {
-            DWORD_PTR mask = 1ull << m_affinity[workerIndex % m_affinity.size()];
-            SetThreadAffinityMask(GetCurrentThread(), mask);
-        }
-#else
-        (void)workerIndex;
+            else
 #endif
-
-        for (;;)
-        {
-            Job::Ptr job;
-
             {
-                std::unique_lock<std::mutex> lock(m_queueMutex);
-                m_condition.wait(lock, [this]() {
-                    return m_stop.load(std::memory_order_acquire)
-                        || !m_jobs.empty();
-                    });
+                job->func();
+            }
+        }
+        catch (...)
+        {
 
-                if (m_stop.load(std::memory_order_acquire) && m_jobs.empty())
-                    return;
+        }
 
-                job = m_jobs.top();
-                m_jobs.pop();
-            }
+        job->finished.store(true, std::memory_order_release);
 
-            if (job)
-            {
-                job->started.store(true, std::memory_order_release);
-
-                try
-                {
-                    job->func();
-                }
-                catch (...)
-                {
-                    
-                }
-
-                job->finished.store(true, std::memory_order_release);
-
-                if (m_onFinished)
-                {
-                    m_onFinished(job);
-                }
-            }
+        if (m_onFinished)
+        {
+            m_onFinished(job);
         }
     }
 }
\ No newline at end of file
@@ -1,18 +1,25 @@
 #pragma once
 
-#include "JobPool.h"
+#include "SharedQueueJobPool.h"
+#include "WorkStealingJobPool.h"
+#include "TaskGraph.h"
 
 #include <QuasarEngine/Core/Singleton.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <future>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace QuasarEngine
@@ -20,7 +27,10 @@ namespace QuasarEngine
     class JobSystem : public Singleton<JobSystem>
     {
     public:
+        using SchedulerMap = std::map<JobPoolType, JobSchedulerType>;
+
         JobSystem();
+        explicit JobSystem(SchedulerMap schedulers);
         ~JobSystem();
 
         JobSystem(const JobSystem&) = delete;
@@ -91,34 +101,94 @@ namespace QuasarEngine
 
         void WaitAll();
 
+        void Wait(const Job::Ptr& job);
+
+        template<typename T>
+        void Wait(const std::future<T>& future);
+
+        template<typename Func>
+        void ParallelForRange(std::size_t count, std::size_t grain, Func&& func);
+
+        template<typename Func>
+        void ParallelFor(std::size_t count, std::size_t grain, Func&& func);
+
+        template<typename T, typename MapFunc, typename ReduceFunc>
+        T ParallelReduce(std::size_t count, std::size_t grain, T identity, MapFunc&& map, ReduceFunc&& reduce);
+
+        void Run(TaskGraph& graph);
+        void Wait(TaskGraph& graph);
+        void RunAndWait(TaskGraph& graph);
+
+        JobSchedulerType GetScheduler(JobPoolType pool) const;
+        std::size_t GetThreadCount(JobPoolType pool) const;
+
+        static SchedulerMap DefaultSchedulers();
+
     private:
         friend class Singleton<JobSystem>;
 
         void InitDefaultPools();
+        void Schedule(const Job::Ptr& job, const std::vector<Job::Ptr>& dependencies);
+        void Dispatch(const Job::Ptr& job);
         void OnJobFinished(const Job::Ptr& job);
 
+        bool HelpOnce();
+        std::size_t ResolveGrain(std::size_t count, std::size_t grain) const;
+
+        void DispatchGraphNode(TaskGraph& graph, TaskGraph::TaskHandle task);
+        void RunGraphNode(TaskGraph& graph, TaskGraph::TaskHandle task);
+
         void StartDeadlockDetection();
         void StopDeadlockDetection();
 
         using JobSet = std::set<Job::Ptr>;
 
+        SchedulerMap m_schedulers;
         std::map<JobPoolType, std::unique_ptr<JobPool>> m_pools;
 
-        std::mutex m_jobsMutex;
-        JobSet     m_allJobs;
-        JobSet     m_pendingJobs;
-        JobSet     m_activeJobs;
+        std::mutex              m_jobsMutex;
+        std::condition_variable m_idleCondition;
+        JobSet                  m_activeJobs;
 
         std::atomic<bool> m_stop{ false };
         std::thread       m_deadlockDetector;
     };
 
     inline JobSystem::JobSystem()
+        : JobSystem(DefaultSchedulers())
     {
+    }
+
+    inline JobSystem::JobSystem(SchedulerMap schedulers)
+        : m_schedulers(std::move(schedulers))
+    {
+#if QE_PROFILE
+        // Workers record zones until they are joined, the profiler has to outlive them.
+        Profiler::Instance();
+#endif
         InitDefaultPools();
         StartDeadlockDetection();
     }
 
+    inline JobSystem::SchedulerMap JobSystem::DefaultSchedulers()
+    {
+        return {
+            { JobPoolType::GENERAL,    JobSchedulerType::WORK_STEALING },
+            { JobPoolType::IO,         JobSchedulerType::SHARED_QUEUE },
+            { JobPoolType::RENDER,     JobSchedulerType::SHARED_QUEUE },
+            { JobPoolType::SIMULATION, JobSchedulerType::SHARED_QUEUE }
+        };
+    }
+
+    inline JobSchedulerType JobSystem::GetScheduler(JobPoolType pool) const
+    {
+        auto it = m_pools.find(pool);
+        if (it == m_pools.end())
+            throw std::runtime_error("JobSystem::GetScheduler : pool inconnu");
+
+        return it->second->GetScheduler();
+    }
+
     inline JobSystem::~JobSystem()
     {
         WaitAll();
@@ -132,6 +202,15 @@ namespace QuasarEngine
         }
     }
 
+    inline std::size_t JobSystem::GetThreadCount(JobPoolType pool) const
+    {
+        auto it = m_pools.find(pool);
+        if (it == m_pools.end())
+            throw std::runtime_error("JobSystem::GetThreadCount : pool inconnu");
+
+        return it->second->GetThreadCount();
+    }
+
     inline void JobSystem::InitDefaultPools()
     {
         const unsigned hw = std::thread::hardware_concurrency();
@@ -143,12 +222,19 @@ namespace QuasarEngine
         auto makePool = [this](JobPoolType type,
             std::size_t threadCount)
             {
-                m_pools[type] = std::make_unique<JobPool>(
-                    type,
-                    threadCount,
-                    [this](const Job::Ptr& job) { OnJobFinished(job); },
-                    std::vector<int>{}
-                );
+                auto onFinished = [this](const Job::Ptr& job) { OnJobFinished(job); };
+
+                auto scheduler = m_schedulers.find(type);
+                if (scheduler != m_schedulers.end() && scheduler->second == JobSchedulerType::WORK_STEALING)
+                {
+                    m_pools[type] = std::make_unique<WorkStealingJobPool>(
+                        type, threadCount, std::move(onFinished), std::vector<int>{});
+                }
+                else
+                {
+                    m_pools[type] = std::make_unique<SharedQueueJobPool>(
+                        type, threadCount, std::move(onFinished), std::vector<int>{});
+                }
             };
 
         makePool(JobPoolType::GENERAL, generalThreads);
@@ -157,37 +243,66 @@ namespace QuasarEngine
         makePool(JobPoolType::SIMULATION, simThreads);
     }
 
-    inline void JobSystem::OnJobFinished(const Job::Ptr& job)
+    inline void JobSystem::Dispatch(const Job::Ptr& job)
     {
-        std::vector<Job::Ptr> nowReady;
+        auto poolIt = m_pools.find(job->pool);
+        if (poolIt != m_pools.end())
+        {
+            poolIt->second->Enqueue(job);
+        }
+    }
+
+    inline void JobSystem::Schedule(const Job::Ptr& job, const std::vector<Job::Ptr>& dependencies)
+    {
+        if (m_pools.find(job->pool) == m_pools.end())
+            throw std::runtime_error("JobSystem::Submit : pool inconnu");
 
         {
             std::lock_guard<std::mutex> lock(m_jobsMutex);
+            m_activeJobs.insert(job);
+        }
 
-            m_activeJobs.erase(job);
+        // Guard count held while dependencies register, so a dependency finishing
+        // concurrently cannot dispatch the job before registration is complete.
+        job->unfinishedDependencies.store(1, std::memory_order_relaxed);
 
-            for (auto it = m_pendingJobs.begin(); it != m_pendingJobs.end(); )
-            {
-                const auto& pendingJob = *it;
-                if (pendingJob->DependenciesFinished())
-                {
-                    nowReady.push_back(pendingJob);
-                    it = m_pendingJobs.erase(it);
-                }
-                else
-                {
-                    ++it;
-                }
-            }
+        for (const auto& dep : dependencies)
+        {
+            if (!dep || dep == job)
+                continue;
+
+            std::lock_guard<std::mutex> lock(dep->successorsMutex);
+            if (dep->successorsReleased)
+                continue;
+
+            job->unfinishedDependencies.fetch_add(1, std::memory_order_relaxed);
+            dep->successors.push_back(job);
         }
 
-        for (auto& ready : nowReady)
+        if (job->unfinishedDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Dispatch(job);
+    }
+
+    inline void JobSystem::OnJobFinished(const Job::Ptr& job)
+    {
+        std::vector<Job::Ptr> successors;
+
         {
-            auto poolIt = m_pools.find(ready->pool);
-            if (poolIt != m_pools.end())
-            {
-                poolIt->second->Enqueue(ready);
-            }
+            std::lock_guard<std::mutex> lock(job->successorsMutex);
+            job->successorsReleased = true;
+            successors.swap(job->successors);
+        }
+
+        for (const auto& successor : successors)
+        {
+            if (successor->unfinishedDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Dispatch(successor);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_jobsMutex);
+            if (m_activeJobs.erase(job) > 0 && m_activeJobs.empty())
+                m_idleCondition.notify_all();
         }
     }
 
@@ -232,27 +347,242 @@ namespace QuasarEngine
 
     inline void JobSystem::WaitAll()
     {
-        for (;;)
+        std::unique_lock<std::mutex> lock(m_jobsMutex);
+        m_idleCondition.wait(lock, [this]() { return m_activeJobs.empty(); });
+    }
+
+    inline bool JobSystem::HelpOnce()
+    {
+        auto it = m_pools.find(JobPoolType::GENERAL);
+        if (it == m_pools.end())
+            return false;
+
+        return it->second->TryExecuteOne();
+    }
+
+    inline void JobSystem::Wait(const Job::Ptr& job)
+    {
+        if (!job)
+            return;
+
+        while (!job->finished.load(std::memory_order_acquire))
         {
-            bool anyActive = false;
+            if (!HelpOnce())
+                std::this_thread::yield();
+        }
+    }
+
+    template<typename T>
+    void JobSystem::Wait(const std::future<T>& future)
+    {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!HelpOnce())
+                std::this_thread::yield();
+        }
+    }
+
+    inline std::size_t JobSystem::ResolveGrain(std::size_t count, std::size_t grain) const
+    {
+        if (grain > 0)
+            return grain;
+
+        // Around four chunks per participant (workers + caller) so faster threads
+        // can pick up the slack left by slower ones.
+        const std::size_t participants = GetThreadCount(JobPoolType::GENERAL) + 1;
+        return std::max<std::size_t>(1, count / (participants * 4));
+    }
+
+    template<typename Func>
+    void JobSystem::ParallelForRange(std::size_t count, std::size_t grain, Func&& func)
+    {
+        if (count == 0)
+            return;
+
+        grain = ResolveGrain(count, grain);
+        const std::size_t chunkCount = (count + grain - 1) / grain;
+
+        if (chunkCount == 1)
+        {
+            func(std::size_t{ 0 }, count);
+            return;
+        }
 
+        using FuncType = std::remove_reference_t<Func>;
+
+        struct State
+        {
+            FuncType*                funcPtr = nullptr;
+            std::size_t              count = 0;
+            std::size_t              grain = 0;
+            std::size_t              chunkCount = 0;
+            std::atomic<std::size_t> next{ 0 };
+            std::atomic<std::size_t> done{ 0 };
+            std::mutex               errorMutex;
+            std::exception_ptr       error;
+        };
+
+        auto state = std::make_shared<State>();
+        state->funcPtr = &func;
+        state->count = count;
+        state->grain = grain;
+        state->chunkCount = chunkCount;
+
+        auto drain = [](State& st)
             {
-                std::lock_guard<std::mutex> lock(m_jobsMutex);
-                for (const auto& job : m_allJobs)
+                for (;;)
                 {
-                    if (!job->finished.load(std::memory_order_acquire))
+                    const std::size_t chunk = st.next.fetch_add(1, std::memory_order_relaxed);
+                    if (chunk >= st.chunkCount)
+                        return;
+
+                    const std::size_t begin = chunk * st.grain;
+                    const std::size_t end = std::min(st.count, begin + st.grain);
+
+                    try
+                    {
+                        (*st.funcPtr)(begin, end);
+                    }
+                    catch (...)
                     {
-                        anyActive = true;
-                        break;
+                        std::lock_guard<std::mutex> lock(st.errorMutex);
+                        if (!st.error)
+                            st.error = std::current_exception();
                     }
+
+                    st.done.fetch_add(1, std::memory_order_acq_rel);
                 }
-            }
+            };
+
+        const std::size_t helpers = std::min(GetThreadCount(JobPoolType::GENERAL), chunkCount - 1);
+        for (std::size_t i = 0; i < helpers; ++i)
+        {
+            auto job = std::make_shared<Job>([state, drain]() { drain(*state); },
+                JobPriority::HIGH, JobPoolType::GENERAL);
+            job->name = "ParallelFor";
+            job->profileName = "ParallelFor";
+            Dispatch(job);
+        }
 
-            if (!anyActive)
-                return;
+        drain(*state);
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        while (state->done.load(std::memory_order_acquire) < chunkCount)
+        {
+            if (!HelpOnce())
+                std::this_thread::yield();
         }
+
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+
+    template<typename Func>
+    void JobSystem::ParallelFor(std::size_t count, std::size_t grain, Func&& func)
+    {
+        ParallelForRange(count, grain, [&func](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    func(i);
+            });
+    }
+
+    template<typename T, typename MapFunc, typename ReduceFunc>
+    T JobSystem::ParallelReduce(std::size_t count, std::size_t grain, T identity, MapFunc&& map, ReduceFunc&& reduce)
+    {
+        if (count == 0)
+            return identity;
+
+        grain = ResolveGrain(count, grain);
+        const std::size_t chunkCount = (count + grain - 1) / grain;
+
+        std::vector<T> partials(chunkCount, identity);
+
+        ParallelForRange(count, grain, [&](std::size_t begin, std::size_t end)
+            {
+                partials[begin / grain] = map(begin, end);
+            });
+
+        T result = std::move(identity);
+        for (auto& partial : partials)
+            result = reduce(std::move(result), std::move(partial));
+
+        return result;
+    }
+
+    inline void JobSystem::Run(TaskGraph& graph)
+    {
+        if (graph.IsRunning())
+            throw std::runtime_error("JobSystem::Run : TaskGraph deja en cours d'execution");
+
+        graph.Compile();
+
+        if (graph.m_nodes.empty())
+            return;
+
+        for (const auto& node : graph.m_nodes)
+        {
+            if (m_pools.find(node.pool) == m_pools.end())
+                throw std::runtime_error("JobSystem::Run : pool inconnu");
+        }
+
+        graph.Reset();
+
+        for (TaskGraph::TaskHandle i = 0; i < graph.m_nodes.size(); ++i)
+        {
+            if (graph.m_nodes[i].dependencyCount == 0)
+                DispatchGraphNode(graph, i);
+        }
+    }
+
+    inline void JobSystem::Wait(TaskGraph& graph)
+    {
+        while (graph.IsRunning())
+        {
+            if (!HelpOnce())
+                std::this_thread::yield();
+        }
+
+        graph.RethrowError();
+    }
+
+    inline void JobSystem::RunAndWait(TaskGraph& graph)
+    {
+        Run(graph);
+        Wait(graph);
+    }
+
+    inline void JobSystem::DispatchGraphNode(TaskGraph& graph, TaskGraph::TaskHandle task)
+    {
+        const auto& node = graph.m_nodes[task];
+
+        auto job = std::make_shared<Job>([this, &graph, task]() { RunGraphNode(graph, task); },
+            node.priority, node.pool);
+        job->name = node.name;
+        job->profileName = node.profileName;
+        Dispatch(job);
+    }
+
+    inline void JobSystem::RunGraphNode(TaskGraph& graph, TaskGraph::TaskHandle task)
+    {
+        const auto& node = graph.m_nodes[task];
+
+        try
+        {
+            if (node.func)
+                node.func();
+        }
+        catch (...)
+        {
+            graph.RecordError(std::current_exception());
+        }
+
+        for (TaskGraph::TaskHandle successor : node.successors)
+        {
+            if (graph.m_pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                DispatchGraphNode(graph, successor);
+        }
+
+        graph.m_remaining.fetch_sub(1, std::memory_order_acq_rel);
     }
 
     template<typename Func, typename... Args>
@@ -275,34 +605,12 @@ namespace QuasarEngine
 
         auto job = std::make_shared<Job>();
         job->name = std::move(name);
+        job->profileName = Job::ProfileName(job->name);
         job->priority = priority;
         job->pool = pool;
         job->func = [task]() { (*task)(); };
 
-        job->dependencies.clear();
-        job->dependencies.reserve(dependencies.size());
-        for (auto& dep : dependencies)
-            job->dependencies.emplace_back(dep);
-
-        {
-            std::lock_guard<std::mutex> lock(m_jobsMutex);
-
-            m_allJobs.insert(job);
-            m_activeJobs.insert(job);
-
-            if (job->DependenciesFinished())
-            {
-                auto it = m_pools.find(pool);
-                if (it == m_pools.end())
-                    throw std::runtime_error("JobSystem::Submit : pool inconnu");
-
-                it->second->Enqueue(job);
-            }
-            else
-            {
-                m_pendingJobs.insert(job);
-            }
-        }
+        Schedule(job, dependencies);
 
         return future;
     }
@@ -329,34 +637,12 @@ namespace QuasarEngine
 
         auto job = std::make_shared<Job>();
         job->name = std::move(name);
+        job->profileName = Job::ProfileName(job->name);
         job->priority = priority;
         job->pool = pool;
         job->func = [task]() { (*task)(); };
 
-        job->dependencies.clear();
-        job->dependencies.reserve(dependencies.size());
-        for (auto& dep : dependencies)
-            job->dependencies.emplace_back(dep);
-
-        {
-            std::lock_guard<std::mutex> lock(m_jobsMutex);
-
-            m_allJobs.insert(job);
-            m_activeJobs.insert(job);
-
-            if (job->DependenciesFinished())
-            {
-                auto it = m_pools.find(pool);
-                if (it == m_pools.end())
-                    throw std::runtime_error("JobSystem::SubmitWithHandle : pool inconnu");
-
-                it->second->Enqueue(job);
-            }
-            else
-            {
-                m_pendingJobs.insert(job);
-            }
-        }
+        Schedule(job, dependencies);
 
         return { std::move(future), job };
     }
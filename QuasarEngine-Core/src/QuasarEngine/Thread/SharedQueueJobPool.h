@@ -0,0 +1,151 @@
+#pragma once
+
+#include "JobPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace QuasarEngine
+{
+    class SharedQueueJobPool final : public JobPool
+    {
+    public:
+        SharedQueueJobPool(JobPoolType type,
+            std::size_t threadCount,
+            JobFinishedCallback onFinished = {},
+            std::vector<int> coreAffinity = {});
+
+        ~SharedQueueJobPool() override;
+
+        JobSchedulerType GetScheduler() const noexcept override { return JobSchedulerType::SHARED_QUEUE; }
+
+        std::size_t GetThreadCount() const noexcept override { return m_workers.size(); }
+
+        void Enqueue(Job::Ptr job) override;
+
+        bool TryExecuteOne() override;
+
+        void Shutdown() override;
+
+    private:
+        void WorkerLoop(std::size_t workerIndex);
+
+        std::vector<std::thread> m_workers;
+
+        std::priority_queue<
+            Job::Ptr,
+            std::vector<Job::Ptr>,
+            JobPriorityComparator> m_jobs;
+
+        std::mutex              m_queueMutex;
+        std::condition_variable m_condition;
+        std::atomic<bool>       m_stop{ false };
+    };
+
+    inline SharedQueueJobPool::SharedQueueJobPool(JobPoolType type,
+        std::size_t threadCount,
+        JobFinishedCallback onFinished,
+        std::vector<int> coreAffinity)
+        : JobPool(type, std::move(onFinished), std::move(coreAffinity))
+    {
+        if (threadCount == 0)
+            threadCount = 1;
+
+        m_workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+        }
+    }
+
+    inline SharedQueueJobPool::~SharedQueueJobPool()
+    {
+        Shutdown();
+    }
+
+    inline void SharedQueueJobPool::Shutdown()
+    {
+        bool expected = false;
+        if (!m_stop.compare_exchange_strong(expected, true,
+            std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        m_condition.notify_all();
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    inline void SharedQueueJobPool::Enqueue(Job::Ptr job)
+    {
+        if (!job)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_stop.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            m_jobs.push(std::move(job));
+        }
+        m_condition.notify_one();
+    }
+
+    inline bool SharedQueueJobPool::TryExecuteOne()
+    {
+        Job::Ptr job;
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_jobs.empty())
+                return false;
+
+            job = m_jobs.top();
+            m_jobs.pop();
+        }
+
+        Execute(job);
+        return true;
+    }
+
+    inline void SharedQueueJobPool::WorkerLoop(std::size_t workerIndex)
+    {
+        ApplyAffinity(workerIndex);
+        QE_PROFILE_THREAD(WorkerName(workerIndex));
+
+        for (;;)
+        {
+            Job::Ptr job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_condition.wait(lock, [this]() {
+                    return m_stop.load(std::memory_order_acquire)
+                        || !m_jobs.empty();
+                    });
+
+                if (m_stop.load(std::memory_order_acquire) && m_jobs.empty())
+                    return;
+
+                job = m_jobs.top();
+                m_jobs.pop();
+            }
+
+            if (job)
+            {
+                Execute(job);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Job.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace QuasarEngine
+{
+    class JobSystem;
+
+    // Graph of tasks declared once and executed as many times as needed through
+    // JobSystem::Run / JobSystem::Wait. The topology is only re-validated after an edit.
+    class TaskGraph
+    {
+    public:
+        using TaskHandle = std::size_t;
+
+        TaskGraph() = default;
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        TaskHandle AddTask(std::string name,
+            std::function<void()> func,
+            JobPoolType pool = JobPoolType::GENERAL,
+            JobPriority priority = JobPriority::NORMAL);
+
+        void AddDependency(TaskHandle task, TaskHandle dependsOn);
+
+        void Clear();
+
+        std::size_t GetTaskCount() const noexcept { return m_nodes.size(); }
+        bool IsRunning() const noexcept { return m_remaining.load(std::memory_order_acquire) > 0; }
+
+    private:
+        friend class JobSystem;
+
+        struct Node
+        {
+            std::string              name;
+            const char*              profileName = "Job";
+            std::function<void()>    func;
+            JobPoolType              pool{ JobPoolType::GENERAL };
+            JobPriority              priority{ JobPriority::NORMAL };
+            std::vector<TaskHandle>  successors;
+            int                      dependencyCount = 0;
+        };
+
+        void Compile();
+        void Reset();
+
+        void RecordError(std::exception_ptr error);
+        void RethrowError();
+
+        std::vector<Node> m_nodes;
+        bool              m_dirty = true;
+
+        std::unique_ptr<std::atomic<int>[]> m_pending;
+        std::atomic<std::size_t>           m_remaining{ 0 };
+
+        std::mutex         m_errorMutex;
+        std::exception_ptr m_error;
+    };
+
+    inline TaskGraph::TaskHandle TaskGraph::AddTask(std::string name,
+        std::function<void()> func,
+        JobPoolType pool,
+        JobPriority priority)
+    {
+        if (IsRunning())
+            throw std::runtime_error("TaskGraph::AddTask : graphe en cours d'execution");
+
+        Node node;
+        node.name = std::move(name);
+        node.profileName = Job::ProfileName(node.name);
+        node.func = std::move(func);
+        node.pool = pool;
+        node.priority = priority;
+
+        m_nodes.push_back(std::move(node));
+        m_dirty = true;
+
+        return m_nodes.size() - 1;
+    }
+
+    inline void TaskGraph::AddDependency(TaskHandle task, TaskHandle dependsOn)
+    {
+        if (IsRunning())
+            throw std::runtime_error("TaskGraph::AddDependency : graphe en cours d'execution");
+
+        if (task >= m_nodes.size() || dependsOn >= m_nodes.size() || task == dependsOn)
+            throw std::runtime_error("TaskGraph::AddDependency : tache invalide");
+
+        m_nodes[dependsOn].successors.push_back(task);
+        m_dirty = true;
+    }
+
+    inline void TaskGraph::Clear()
+    {
+        if (IsRunning())
+            throw std::runtime_error("TaskGraph::Clear : graphe en cours d'execution");
+
+        m_nodes.clear();
+        m_pending.reset();
+        m_dirty = true;
+    }
+
+    inline void TaskGraph::Compile()
+    {
+        if (!m_dirty)
+            return;
+
+        const std::size_t count = m_nodes.size();
+
+        for (auto& node : m_nodes)
+            node.dependencyCount = 0;
+
+        for (const auto& node : m_nodes)
+            for (TaskHandle successor : node.successors)
+                ++m_nodes[successor].dependencyCount;
+
+        std::vector<int> inDegree(count);
+        std::vector<TaskHandle> ready;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            inDegree[i] = m_nodes[i].dependencyCount;
+            if (inDegree[i] == 0)
+                ready.push_back(i);
+        }
+
+        std::size_t visited = 0;
+        while (!ready.empty())
+        {
+            TaskHandle current = ready.back();
+            ready.pop_back();
+            ++visited;
+
+            for (TaskHandle successor : m_nodes[current].successors)
+                if (--inDegree[successor] == 0)
+                    ready.push_back(successor);
+        }
+
+        if (visited != count)
+            throw std::runtime_error("TaskGraph::Compile : cycle detecte");
+
+        m_pending = std::make_unique<std::atomic<int>[]>(count);
+        m_dirty = false;
+    }
+
+    inline void TaskGraph::Reset()
+    {
+        for (std::size_t i = 0; i < m_nodes.size(); ++i)
+            m_pending[i].store(m_nodes[i].dependencyCount, std::memory_order_relaxed);
+
+        m_error = nullptr;
+        m_remaining.store(m_nodes.size(), std::memory_order_release);
+    }
+
+    inline void TaskGraph::RecordError(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        if (!m_error)
+            m_error = std::move(error);
+    }
+
+    inline void TaskGraph::RethrowError()
+    {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_errorMutex);
+            error = std::exchange(m_error, nullptr);
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace QuasarEngine
+{
+    // Chase-Lev deque : Push/Pop are reserved to the owning thread (LIFO end),
+    // Steal can be called concurrently from any other thread (FIFO end).
+    template <typename T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_pointer_v<T>, "WorkStealingDeque stores raw pointers");
+
+    public:
+        explicit WorkStealingDeque(std::int64_t capacity = 1024);
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        void Push(T item);
+        T Pop();
+        T Steal();
+
+        bool Empty() const noexcept
+        {
+            const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+            const std::int64_t t = m_top.load(std::memory_order_relaxed);
+            return b <= t;
+        }
+
+    private:
+        struct Buffer
+        {
+            std::int64_t capacity;
+            std::int64_t mask;
+            std::unique_ptr<std::atomic<T>[]> data;
+
+            explicit Buffer(std::int64_t cap)
+                : capacity(cap)
+                , mask(cap - 1)
+                , data(std::make_unique<std::atomic<T>[]>(static_cast<std::size_t>(cap)))
+            {
+            }
+
+            void Put(std::int64_t i, T item) noexcept { data[i & mask].store(item, std::memory_order_relaxed); }
+            T Get(std::int64_t i) const noexcept { return data[i & mask].load(std::memory_order_relaxed); }
+        };
+
+        Buffer* Grow(Buffer* old, std::int64_t bottom, std::int64_t top);
+
+        alignas(64) std::atomic<std::int64_t> m_top{ 0 };
+        alignas(64) std::atomic<std::int64_t> m_bottom{ 0 };
+        alignas(64) std::atomic<Buffer*>      m_buffer{ nullptr };
+
+        // Retired buffers stay alive until destruction: a thief may still be reading them.
+        std::vector<std::unique_ptr<Buffer>> m_buffers;
+    };
+
+    template <typename T>
+    WorkStealingDeque<T>::WorkStealingDeque(std::int64_t capacity)
+    {
+        std::int64_t cap = 1;
+        while (cap < capacity)
+            cap <<= 1;
+
+        m_buffers.push_back(std::make_unique<Buffer>(cap));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::Grow(Buffer* old, std::int64_t bottom, std::int64_t top)
+    {
+        auto grown = std::make_unique<Buffer>(old->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i)
+            grown->Put(i, old->Get(i));
+
+        Buffer* raw = grown.get();
+        m_buffers.push_back(std::move(grown));
+        m_buffer.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    template <typename T>
+    void WorkStealingDeque<T>::Push(T item)
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+        if (b - t > buffer->capacity - 1)
+            buffer = Grow(buffer, b, t);
+
+        buffer->Put(b, item);
+        m_bottom.store(b + 1, std::memory_order_release);
+    }
+
+    template <typename T>
+    T WorkStealingDeque<T>::Pop()
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = m_top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T item = buffer->Get(b);
+        if (t == b)
+        {
+            if (!m_top.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    template <typename T>
+    T WorkStealingDeque<T>::Steal()
+    {
+        std::int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = m_bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        T item = buffer->Get(t);
+
+        if (!m_top.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return item;
+    }
+}
\ No newline at end of file
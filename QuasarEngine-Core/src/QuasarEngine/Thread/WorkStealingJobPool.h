@@ -0,0 +1,307 @@
+#pragma once
+
+#include "JobPool.h"
+#include "WorkStealingDeque.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace QuasarEngine
+{
+    class WorkStealingJobPool final : public JobPool
+    {
+    public:
+        WorkStealingJobPool(JobPoolType type,
+            std::size_t threadCount,
+            JobFinishedCallback onFinished = {},
+            std::vector<int> coreAffinity = {});
+
+        ~WorkStealingJobPool() override;
+
+        JobSchedulerType GetScheduler() const noexcept override { return JobSchedulerType::WORK_STEALING; }
+
+        std::size_t GetThreadCount() const noexcept override { return m_workers.size(); }
+
+        void Enqueue(Job::Ptr job) override;
+
+        bool TryExecuteOne() override;
+
+        void Shutdown() override;
+
+    private:
+        static constexpr std::size_t LaneCount = 3;
+        static constexpr int SpinCount = 64;
+
+        struct Worker
+        {
+            std::array<WorkStealingDeque<Job*>, LaneCount> lanes;
+            std::uint32_t rng = 0;
+            std::thread thread;
+        };
+
+        void WorkerLoop(std::size_t workerIndex);
+
+        Job* FindJob(std::size_t workerIndex);
+        Job* FindJobExternal();
+        Job* PopInjected(std::size_t lane);
+        Job* StealFrom(std::size_t start, std::size_t thiefIndex, std::size_t lane);
+        void Run(Job* raw);
+
+        static std::size_t LaneOf(JobPriority priority) noexcept
+        {
+            return LaneCount - 1 - static_cast<std::size_t>(priority);
+        }
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        std::mutex                             m_injectMutex;
+        std::array<std::deque<Job*>, LaneCount> m_injected;
+        std::atomic<std::size_t>               m_injectedCount{ 0 };
+
+        std::mutex                m_sleepMutex;
+        std::condition_variable   m_wake;
+        std::atomic<int>          m_sleepers{ 0 };
+        std::atomic<std::int64_t> m_pending{ 0 };
+        std::atomic<bool>         m_stop{ false };
+
+        static inline thread_local WorkStealingJobPool* t_pool = nullptr;
+        static inline thread_local std::size_t t_workerIndex = 0;
+        static inline thread_local std::size_t t_externalVictim = 0;
+    };
+
+    inline WorkStealingJobPool::WorkStealingJobPool(JobPoolType type,
+        std::size_t threadCount,
+        JobFinishedCallback onFinished,
+        std::vector<int> coreAffinity)
+        : JobPool(type, std::move(onFinished), std::move(coreAffinity))
+    {
+        if (threadCount == 0)
+            threadCount = 1;
+
+        m_workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            auto worker = std::make_unique<Worker>();
+            worker->rng = static_cast<std::uint32_t>(i * 2654435761u + 1u);
+            m_workers.push_back(std::move(worker));
+        }
+
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            m_workers[i]->thread = std::thread([this, i]() { WorkerLoop(i); });
+        }
+    }
+
+    inline WorkStealingJobPool::~WorkStealingJobPool()
+    {
+        Shutdown();
+    }
+
+    inline void WorkStealingJobPool::Shutdown()
+    {
+        bool expected = false;
+        if (!m_stop.compare_exchange_strong(expected, true,
+            std::memory_order_seq_cst))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_all();
+
+        // Workers only exit once m_pending reaches zero, so every queued job has run by the time
+        // they are joined, like SharedQueueJobPool.
+        for (auto& worker : m_workers)
+        {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+    }
+
+    inline void WorkStealingJobPool::Enqueue(Job::Ptr job)
+    {
+        if (!job)
+            return;
+
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        if (m_stop.load(std::memory_order_seq_cst))
+        {
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const std::size_t lane = LaneOf(job->priority);
+        Job* raw = job.get();
+        raw->keepAlive = std::move(job);
+
+        if (t_pool == this)
+        {
+            m_workers[t_workerIndex]->lanes[lane].Push(raw);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_injectMutex);
+            m_injected[lane].push_back(raw);
+            m_injectedCount.fetch_add(1, std::memory_order_release);
+        }
+
+        if (m_sleepers.load(std::memory_order_seq_cst) > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_wake.notify_one();
+        }
+    }
+
+    inline Job* WorkStealingJobPool::PopInjected(std::size_t lane)
+    {
+        if (m_injectedCount.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        auto& queue = m_injected[lane];
+        if (queue.empty())
+            return nullptr;
+
+        Job* job = queue.front();
+        queue.pop_front();
+        m_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    inline Job* WorkStealingJobPool::StealFrom(std::size_t start, std::size_t thiefIndex, std::size_t lane)
+    {
+        const std::size_t count = m_workers.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t victim = (start + i) % count;
+            if (victim == thiefIndex)
+                continue;
+
+            if (Job* job = m_workers[victim]->lanes[lane].Steal())
+                return job;
+        }
+
+        return nullptr;
+    }
+
+    inline Job* WorkStealingJobPool::FindJob(std::size_t workerIndex)
+    {
+        Worker& self = *m_workers[workerIndex];
+
+        std::uint32_t& rng = self.rng;
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+
+        for (std::size_t lane = 0; lane < LaneCount; ++lane)
+        {
+            if (Job* job = self.lanes[lane].Pop())
+                return job;
+
+            if (Job* job = PopInjected(lane))
+                return job;
+
+            if (m_workers.size() > 1)
+            {
+                if (Job* job = StealFrom(rng, workerIndex, lane))
+                    return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline Job* WorkStealingJobPool::FindJobExternal()
+    {
+        const std::size_t start = t_externalVictim++;
+
+        for (std::size_t lane = 0; lane < LaneCount; ++lane)
+        {
+            if (Job* job = PopInjected(lane))
+                return job;
+
+            if (Job* job = StealFrom(start, m_workers.size(), lane))
+                return job;
+        }
+
+        return nullptr;
+    }
+
+    inline void WorkStealingJobPool::Run(Job* raw)
+    {
+        m_pending.fetch_sub(1, std::memory_order_acq_rel);
+
+        Job::Ptr job = std::move(raw->keepAlive);
+        Execute(job);
+    }
+
+    inline bool WorkStealingJobPool::TryExecuteOne()
+    {
+        Job* raw = (t_pool == this) ? FindJob(t_workerIndex) : FindJobExternal();
+        if (!raw)
+            return false;
+
+        Run(raw);
+        return true;
+    }
+
+    inline void WorkStealingJobPool::WorkerLoop(std::size_t workerIndex)
+    {
+        ApplyAffinity(workerIndex);
+        QE_PROFILE_THREAD(WorkerName(workerIndex));
+
+        t_pool = this;
+        t_workerIndex = workerIndex;
+
+        int spins = 0;
+
+        for (;;)
+        {
+            if (Job* raw = FindJob(workerIndex))
+            {
+                Run(raw);
+
+                spins = 0;
+                continue;
+            }
+
+            if (m_stop.load(std::memory_order_seq_cst)
+                && m_pending.load(std::memory_order_seq_cst) <= 0)
+            {
+                break;
+            }
+
+            if (++spins < SpinCount)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(m_sleepMutex);
+                m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+                m_wake.wait(lock, [this]() {
+                    return m_stop.load(std::memory_order_acquire)
+                        || m_pending.load(std::memory_order_seq_cst) > 0;
+                    });
+                m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            spins = 0;
+        }
+
+        t_pool = nullptr;
+    }
+}
\ No newline at end of file
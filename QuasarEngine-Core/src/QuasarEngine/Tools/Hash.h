@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace QuasarEngine
+{
+    // 64-bit FNV-1a, shared by the on-disk caches. Their keys depend on it, so the mixing must not change.
+    struct Fnv1a
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        void Bytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+
+        // Same mixing a word at a time, for large blobs. Not interchangeable with Bytes().
+        void Words(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            const size_t words = size / sizeof(uint64_t);
+            for (size_t i = 0; i < words; ++i)
+            {
+                uint64_t w;
+                std::memcpy(&w, bytes + i * sizeof(uint64_t), sizeof(w));
+                hash ^= w;
+                hash *= 1099511628211ull;
+            }
+            Bytes(bytes + words * sizeof(uint64_t), size % sizeof(uint64_t));
+        }
+
+        void String(std::string_view text)
+        {
+            U64(text.size());
+            Bytes(text.data(), text.size());
+        }
+
+        void U32(uint32_t value) { Bytes(&value, sizeof(value)); }
+        void U64(uint64_t value) { Bytes(&value, sizeof(value)); }
+    };
+}
@@ -0,0 +1,351 @@
+#include "qepch.h"
+#include <QuasarEngine/Tools/PerlinNoiseBatch.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QE_NOISE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define QE_NOISE_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define QE_TARGET_AVX2
+#else
+#define QE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define QE_TARGET_AVX2
+#endif
+
+namespace QuasarEngine
+{
+	namespace
+	{
+		// noise2D samples the 3D noise on this plane.
+		const double kPlaneZ = static_cast<double>(SIVPERLIN_DEFAULT_Z);
+		const double kPlaneFloorZ = std::floor(kPlaneZ);
+		const std::int32_t kPlaneIZ = static_cast<std::int32_t>(kPlaneFloorZ) & 255;
+		const double kPlaneFZ = kPlaneZ - kPlaneFloorZ;
+		const double kPlaneW = siv::perlin_detail::Fade(kPlaneFZ);
+
+		bool CpuSupportsAVX2()
+		{
+#if defined(QE_NOISE_AVX2) && defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+
+			// AVX2 also needs the OS to save the YMM registers.
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+				return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#elif defined(QE_NOISE_AVX2)
+			return __builtin_cpu_supports("avx2");
+#else
+			return false;
+#endif
+		}
+
+#ifdef QE_NOISE_SSE2
+		// Matches std::floor for |x| < 2^31, the range the library's int cast supports anyway.
+		inline __m128d Floor(__m128d x)
+		{
+			const __m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+			return _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, x), _mm_set1_pd(1.0)));
+		}
+
+		inline __m128d Fade(__m128d t)
+		{
+			const __m128d inner = _mm_add_pd(_mm_mul_pd(t, _mm_sub_pd(_mm_mul_pd(t, _mm_set1_pd(6.0)), _mm_set1_pd(15.0))), _mm_set1_pd(10.0));
+			return _mm_mul_pd(_mm_mul_pd(_mm_mul_pd(t, t), t), inner);
+		}
+
+		inline __m128d Lerp(__m128d a, __m128d b, __m128d t)
+		{
+			return _mm_add_pd(a, _mm_mul_pd(_mm_sub_pd(b, a), t));
+		}
+
+		inline __m128d Select(__m128d mask, __m128d a, __m128d b)
+		{
+			return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+		}
+
+		// perlin_detail::Grad for two hashes.
+		inline __m128d Grad(std::int32_t hash0, std::int32_t hash1, __m128d x, __m128d y, __m128d z)
+		{
+			const __m128i h = _mm_and_si128(_mm_set_epi32(hash1, hash1, hash0, hash0), _mm_set1_epi32(15));
+
+			const __m128d useX = _mm_castsi128_pd(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+			const __m128d vUseY = _mm_castsi128_pd(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+			const __m128d vUseX = _mm_castsi128_pd(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+
+			const __m128d u = Select(useX, x, y);
+			const __m128d v = Select(vUseY, y, Select(vUseX, x, z));
+
+			const __m128d signU = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(h, _mm_set1_epi64x(1)), 63));
+			const __m128d signV = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(h, _mm_set1_epi64x(2)), 62));
+
+			return _mm_add_pd(_mm_xor_pd(u, signU), _mm_xor_pd(v, signV));
+		}
+#endif
+
+#ifdef QE_NOISE_AVX2
+		QE_TARGET_AVX2 inline __m256d Fade(__m256d t)
+		{
+			const __m256d inner = _mm256_add_pd(_mm256_mul_pd(t, _mm256_sub_pd(_mm256_mul_pd(t, _mm256_set1_pd(6.0)), _mm256_set1_pd(15.0))), _mm256_set1_pd(10.0));
+			return _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(t, t), t), inner);
+		}
+
+		QE_TARGET_AVX2 inline __m256d Lerp(__m256d a, __m256d b, __m256d t)
+		{
+			return _mm256_add_pd(a, _mm256_mul_pd(_mm256_sub_pd(b, a), t));
+		}
+
+		// Loads p[i] and p[i + 1] of four indices at once: p[i] in the low half of each 64-bit lane.
+		QE_TARGET_AVX2 inline __m256i GatherPairs(const std::int32_t* p, __m128i index)
+		{
+			return _mm256_i32gather_epi64(reinterpret_cast<const long long*>(p), index, 4);
+		}
+
+		QE_TARGET_AVX2 inline __m128i LowHalves(__m256i pairs)
+		{
+			return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(pairs, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+		}
+
+		QE_TARGET_AVX2 inline __m128i HighHalves(__m256i pairs)
+		{
+			return _mm256_extracti128_si256(_mm256_permutevar8x32_epi32(pairs, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)), 1);
+		}
+
+		// perlin_detail::Grad for four hashes held in the low 32 bits of each 64-bit lane.
+		QE_TARGET_AVX2 inline __m256d Grad(__m256i hash, __m256d x, __m256d y, __m256d z)
+		{
+			const __m256i h = _mm256_and_si256(hash, _mm256_set1_epi64x(15));
+
+			const __m256d useX = _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_set1_epi64x(8), h));
+			const __m256d vUseY = _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_set1_epi64x(4), h));
+			const __m256d vUseX = _mm256_castsi256_pd(_mm256_or_si256(_mm256_cmpeq_epi64(h, _mm256_set1_epi64x(12)), _mm256_cmpeq_epi64(h, _mm256_set1_epi64x(14))));
+
+			const __m256d u = _mm256_blendv_pd(y, x, useX);
+			const __m256d v = _mm256_blendv_pd(_mm256_blendv_pd(z, x, vUseX), y, vUseY);
+
+			const __m256d signU = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(h, _mm256_set1_epi64x(1)), 63));
+			const __m256d signV = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(h, _mm256_set1_epi64x(2)), 62));
+
+			return _mm256_add_pd(_mm256_xor_pd(u, signU), _mm256_xor_pd(v, signV));
+		}
+#endif
+	}
+
+	PerlinNoiseBatch::PerlinNoiseBatch(const siv::PerlinNoise& noise) : m_Noise(noise), m_Level(GetSupportedSimdLevel())
+	{
+		const auto& state = noise.serialize();
+		for (std::size_t i = 0; i < m_Permutation.size(); ++i)
+			m_Permutation[i] = state[i & 255];
+	}
+
+	void PerlinNoiseBatch::Octave2D(const double* x, const double* y, std::size_t count, std::int32_t octaves, double persistence, double* out) const
+	{
+		std::fill(out, out + count, 0.0);
+
+		// Same accumulation as perlin_detail::Octave2D, scaling by a power of two is exact.
+		double amplitude = 1.0;
+		double scale = 1.0;
+		for (std::int32_t i = 0; i < octaves; ++i)
+		{
+			switch (m_Level)
+			{
+			case SimdLevel::AVX2: Noise2DAVX2(x, y, count, scale, amplitude, out); break;
+			case SimdLevel::SSE2: Noise2DSSE2(x, y, count, scale, amplitude, out); break;
+			default: Noise2DScalar(x, y, count, scale, amplitude, out); break;
+			}
+
+			scale *= 2.0;
+			amplitude *= persistence;
+		}
+	}
+
+	void PerlinNoiseBatch::SetSimdLevel(SimdLevel level)
+	{
+		m_Level = std::min(level, GetSupportedSimdLevel());
+	}
+
+	PerlinNoiseBatch::SimdLevel PerlinNoiseBatch::GetSupportedSimdLevel()
+	{
+		static const SimdLevel level = []() {
+			if (CpuSupportsAVX2())
+				return SimdLevel::AVX2;
+#ifdef QE_NOISE_SSE2
+			return SimdLevel::SSE2;
+#else
+			return SimdLevel::Scalar;
+#endif
+			}();
+		return level;
+	}
+
+	const char* PerlinNoiseBatch::GetSimdLevelName(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::AVX2: return "AVX2";
+		case SimdLevel::SSE2: return "SSE2";
+		default: return "Scalar";
+		}
+	}
+
+	void PerlinNoiseBatch::Noise2DScalar(const double* x, const double* y, std::size_t count, double scale, double amplitude, double* out) const
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			out[i] += m_Noise.noise2D(x[i] * scale, y[i] * scale) * amplitude;
+	}
+
+	void PerlinNoiseBatch::Noise2DSSE2(const double* x, const double* y, std::size_t count, double scale, double amplitude, double* out) const
+	{
+		std::size_t i = 0;
+
+#ifdef QE_NOISE_SSE2
+		const std::int32_t* p = m_Permutation.data();
+
+		const __m128d scaleV = _mm_set1_pd(scale);
+		const __m128d amplitudeV = _mm_set1_pd(amplitude);
+		const __m128d one = _mm_set1_pd(1.0);
+		const __m128d fz = _mm_set1_pd(kPlaneFZ);
+		const __m128d fz1 = _mm_set1_pd(kPlaneFZ - 1);
+		const __m128d w = _mm_set1_pd(kPlaneW);
+
+		for (; i + 2 <= count; i += 2)
+		{
+			const __m128d px = _mm_mul_pd(_mm_loadu_pd(x + i), scaleV);
+			const __m128d py = _mm_mul_pd(_mm_loadu_pd(y + i), scaleV);
+
+			const __m128d floorX = Floor(px);
+			const __m128d floorY = Floor(py);
+
+			alignas(16) std::int32_t ix[4];
+			alignas(16) std::int32_t iy[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(ix), _mm_and_si128(_mm_cvttpd_epi32(floorX), _mm_set1_epi32(255)));
+			_mm_store_si128(reinterpret_cast<__m128i*>(iy), _mm_and_si128(_mm_cvttpd_epi32(floorY), _mm_set1_epi32(255)));
+
+			std::int32_t AA[2], AB[2], BA[2], BB[2];
+			for (int l = 0; l < 2; ++l)
+			{
+				const std::int32_t A = p[ix[l]] + iy[l];
+				const std::int32_t B = p[ix[l] + 1] + iy[l];
+				AA[l] = p[A] + kPlaneIZ;
+				AB[l] = p[A + 1] + kPlaneIZ;
+				BA[l] = p[B] + kPlaneIZ;
+				BB[l] = p[B + 1] + kPlaneIZ;
+			}
+
+			const __m128d fx = _mm_sub_pd(px, floorX);
+			const __m128d fy = _mm_sub_pd(py, floorY);
+			const __m128d fx1 = _mm_sub_pd(fx, one);
+			const __m128d fy1 = _mm_sub_pd(fy, one);
+
+			const __m128d u = Fade(fx);
+			const __m128d v = Fade(fy);
+
+			const __m128d p0 = Grad(p[AA[0]], p[AA[1]], fx, fy, fz);
+			const __m128d p1 = Grad(p[BA[0]], p[BA[1]], fx1, fy, fz);
+			const __m128d p2 = Grad(p[AB[0]], p[AB[1]], fx, fy1, fz);
+			const __m128d p3 = Grad(p[BB[0]], p[BB[1]], fx1, fy1, fz);
+			const __m128d p4 = Grad(p[AA[0] + 1], p[AA[1] + 1], fx, fy, fz1);
+			const __m128d p5 = Grad(p[BA[0] + 1], p[BA[1] + 1], fx1, fy, fz1);
+			const __m128d p6 = Grad(p[AB[0] + 1], p[AB[1] + 1], fx, fy1, fz1);
+			const __m128d p7 = Grad(p[BB[0] + 1], p[BB[1] + 1], fx1, fy1, fz1);
+
+			const __m128d r0 = Lerp(Lerp(p0, p1, u), Lerp(p2, p3, u), v);
+			const __m128d r1 = Lerp(Lerp(p4, p5, u), Lerp(p6, p7, u), v);
+			const __m128d n = Lerp(r0, r1, w);
+
+			_mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(out + i), _mm_mul_pd(n, amplitudeV)));
+		}
+#endif
+
+		Noise2DScalar(x + i, y + i, count - i, scale, amplitude, out + i);
+	}
+
+	QE_TARGET_AVX2 void PerlinNoiseBatch::Noise2DAVX2(const double* x, const double* y, std::size_t count, double scale, double amplitude, double* out) const
+	{
+		std::size_t i = 0;
+
+#ifdef QE_NOISE_AVX2
+		const std::int32_t* p = m_Permutation.data();
+
+		const __m256d scaleV = _mm256_set1_pd(scale);
+		const __m256d amplitudeV = _mm256_set1_pd(amplitude);
+		const __m256d one = _mm256_set1_pd(1.0);
+		const __m256d fz = _mm256_set1_pd(kPlaneFZ);
+		const __m256d fz1 = _mm256_set1_pd(kPlaneFZ - 1);
+		const __m256d w = _mm256_set1_pd(kPlaneW);
+		const __m128i mask = _mm_set1_epi32(255);
+		const __m128i iz = _mm_set1_epi32(kPlaneIZ);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m256d px = _mm256_mul_pd(_mm256_loadu_pd(x + i), scaleV);
+			const __m256d py = _mm256_mul_pd(_mm256_loadu_pd(y + i), scaleV);
+
+			const __m256d floorX = _mm256_floor_pd(px);
+			const __m256d floorY = _mm256_floor_pd(py);
+
+			const __m128i ix = _mm_and_si128(_mm256_cvttpd_epi32(floorX), mask);
+			const __m128i iy = _mm_and_si128(_mm256_cvttpd_epi32(floorY), mask);
+
+			// Every lookup needs p[i] and p[i + 1], one 64-bit gather fetches both.
+			const __m256i pX = GatherPairs(p, ix);
+			const __m128i A = _mm_add_epi32(LowHalves(pX), iy);
+			const __m128i B = _mm_add_epi32(HighHalves(pX), iy);
+
+			const __m256i pA = GatherPairs(p, A);
+			const __m256i pB = GatherPairs(p, B);
+			const __m128i AA = _mm_add_epi32(LowHalves(pA), iz);
+			const __m128i AB = _mm_add_epi32(HighHalves(pA), iz);
+			const __m128i BA = _mm_add_epi32(LowHalves(pB), iz);
+			const __m128i BB = _mm_add_epi32(HighHalves(pB), iz);
+
+			const __m256i hAA = GatherPairs(p, AA);
+			const __m256i hBA = GatherPairs(p, BA);
+			const __m256i hAB = GatherPairs(p, AB);
+			const __m256i hBB = GatherPairs(p, BB);
+
+			const __m256d fx = _mm256_sub_pd(px, floorX);
+			const __m256d fy = _mm256_sub_pd(py, floorY);
+			const __m256d fx1 = _mm256_sub_pd(fx, one);
+			const __m256d fy1 = _mm256_sub_pd(fy, one);
+
+			const __m256d u = Fade(fx);
+			const __m256d v = Fade(fy);
+
+			const __m256d p0 = Grad(hAA, fx, fy, fz);
+			const __m256d p1 = Grad(hBA, fx1, fy, fz);
+			const __m256d p2 = Grad(hAB, fx, fy1, fz);
+			const __m256d p3 = Grad(hBB, fx1, fy1, fz);
+			const __m256d p4 = Grad(_mm256_srli_epi64(hAA, 32), fx, fy, fz1);
+			const __m256d p5 = Grad(_mm256_srli_epi64(hBA, 32), fx1, fy, fz1);
+			const __m256d p6 = Grad(_mm256_srli_epi64(hAB, 32), fx, fy1, fz1);
+			const __m256d p7 = Grad(_mm256_srli_epi64(hBB, 32), fx1, fy1, fz1);
+
+			const __m256d r0 = Lerp(Lerp(p0, p1, u), Lerp(p2, p3, u), v);
+			const __m256d r1 = Lerp(Lerp(p4, p5, u), Lerp(p6, p7, u), v);
+			const __m256d n = Lerp(r0, r1, w);
+
+			_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(out + i), _mm256_mul_pd(n, amplitudeV)));
+		}
+#endif
+
+		Noise2DSSE2(x + i, y + i, count - i, scale, amplitude, out + i);
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <QuasarEngine/Tools/PerlinNoise.h>
+
+namespace QuasarEngine
+{
+	// Evaluates siv::PerlinNoise::octave2D for many points at once, 4 lanes with AVX2
+	// (chosen at runtime), 2 with SSE2, one at a time otherwise. Every path performs the
+	// same double operations in the same order as the scalar library, so results are
+	// bit-identical as long as the compiler does not contract them into FMAs.
+	class PerlinNoiseBatch
+	{
+	public:
+		enum class SimdLevel : uint8_t
+		{
+			Scalar,
+			SSE2,
+			AVX2
+		};
+
+		explicit PerlinNoiseBatch(const siv::PerlinNoise& noise);
+
+		void Octave2D(const double* x, const double* y, std::size_t count, std::int32_t octaves, double persistence, double* out) const;
+
+		// Forces a path (clamped to what the CPU supports), used to compare them.
+		void SetSimdLevel(SimdLevel level);
+		SimdLevel GetSimdLevel() const { return m_Level; }
+
+		static SimdLevel GetSupportedSimdLevel();
+		static const char* GetSimdLevelName(SimdLevel level);
+
+	private:
+		// out[i] += noise2D(x[i] * scale, y[i] * scale) * amplitude
+		void Noise2DScalar(const double* x, const double* y, std::size_t count, double scale, double amplitude, double* out) const;
+		void Noise2DSSE2(const double* x, const double* y, std::size_t count, double scale, double amplitude, double* out) const;
+		void Noise2DAVX2(const double* x, const double* y, std::size_t count, double scale, double amplitude, double* out) const;
+
+		const siv::PerlinNoise& m_Noise;
+
+		// Permutation repeated twice so hash + 1 never needs wrapping.
+		std::array<std::int32_t, 512> m_Permutation;
+
+		SimdLevel m_Level;
+	};
+}
@@ -0,0 +1,272 @@
+#include "qepch.h"
+#include <QuasarEngine/Tools/Profiler.h>
+
+#include <QuasarEngine/Core/Logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace QuasarEngine
+{
+	namespace
+	{
+		thread_local ProfileThreadBuffer* t_Buffer = nullptr;
+
+		uint64_t ClockNow()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		void WriteEscaped(std::ofstream& out, const char* text)
+		{
+			for (const char* c = text ? text : "?"; *c; ++c)
+			{
+				switch (*c)
+				{
+				case '"': out << "\\\""; break;
+				case '\\': out << "\\\\"; break;
+				case '\n': out << "\\n"; break;
+				default:
+					if (static_cast<unsigned char>(*c) >= 0x20)
+						out << *c;
+					break;
+				}
+			}
+		}
+	}
+
+	// Returns the calling thread's buffer to the profiler when the thread exits.
+	struct Profiler::ThreadBufferOwner
+	{
+		~ThreadBufferOwner()
+		{
+			if (t_Buffer)
+				Profiler::Instance().ReleaseThreadBuffer(*t_Buffer);
+			t_Buffer = nullptr;
+		}
+	};
+
+	ProfileThreadBuffer::ProfileThreadBuffer(uint32_t id, std::string name)
+		: m_Slots(std::make_unique<Slot[]>(Capacity)), m_Id(id), m_Name(std::move(name))
+	{
+	}
+
+	void ProfileThreadBuffer::Push(const ProfileEvent& event)
+	{
+		const uint64_t written = m_Written.load(std::memory_order_relaxed);
+		Slot& slot = m_Slots[written & (Capacity - 1)];
+
+		slot.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.name.store(event.name, std::memory_order_relaxed);
+		slot.start.store(event.start, std::memory_order_relaxed);
+		slot.end.store(event.end, std::memory_order_relaxed);
+		slot.depth.store(event.depth, std::memory_order_relaxed);
+
+		slot.sequence.store(written + 1, std::memory_order_release);
+		m_Written.store(written + 1, std::memory_order_release);
+	}
+
+	void ProfileThreadBuffer::Read(uint64_t minEnd, std::vector<ProfileEvent>& out) const
+	{
+		const uint64_t written = m_Written.load(std::memory_order_acquire);
+		const uint64_t oldest = std::max(written > Capacity ? written - Capacity : 0, m_First);
+
+		// Events are pushed when their zone closes, so end times only grow along the buffer.
+		// Walking back from the newest, stop at the first slot that no longer holds the
+		// expected event: the writer has lapped everything older than it.
+		const size_t base = out.size();
+		for (uint64_t index = written; index > oldest; --index)
+		{
+			const Slot& slot = m_Slots[(index - 1) & (Capacity - 1)];
+
+			const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence != index)
+				break;
+
+			ProfileEvent event;
+			event.name = slot.name.load(std::memory_order_relaxed);
+			event.start = slot.start.load(std::memory_order_relaxed);
+			event.end = slot.end.load(std::memory_order_relaxed);
+			event.depth = slot.depth.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+				break;
+
+			if (event.end < minEnd)
+				break;
+
+			out.push_back(event);
+		}
+
+		std::reverse(out.begin() + base, out.end());
+	}
+
+	Profiler::Profiler()
+		: m_Epoch(ClockNow())
+	{
+	}
+
+	uint64_t Profiler::Now() const
+	{
+		return ClockNow() - m_Epoch;
+	}
+
+	ProfileThreadBuffer& Profiler::GetThreadBuffer()
+	{
+		if (!t_Buffer)
+		{
+			thread_local ThreadBufferOwner owner;
+
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+
+			auto free = std::find_if(m_Buffers.begin(), m_Buffers.end(),
+				[](const auto& buffer) { return buffer->m_Free; });
+			if (free != m_Buffers.end())
+			{
+				ProfileThreadBuffer& buffer = **free;
+				buffer.m_Free = false;
+				buffer.m_First = buffer.m_Written.load(std::memory_order_relaxed);
+				buffer.m_Name = "Thread " + std::to_string(buffer.m_Id);
+				buffer.m_Depth = 0;
+				t_Buffer = &buffer;
+			}
+			else
+			{
+				const uint32_t id = static_cast<uint32_t>(m_Buffers.size());
+				m_Buffers.push_back(std::make_unique<ProfileThreadBuffer>(id, "Thread " + std::to_string(id)));
+				t_Buffer = m_Buffers.back().get();
+			}
+		}
+		return *t_Buffer;
+	}
+
+	void Profiler::ReleaseThreadBuffer(ProfileThreadBuffer& buffer)
+	{
+		// Its events stay readable under the old name until another thread picks it up.
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		buffer.m_Free = true;
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ProfileThreadBuffer& buffer = GetThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		buffer.m_Name = name;
+	}
+
+	const char* Profiler::InternName(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_NamesMutex);
+		return m_Names.insert(name).first->c_str();
+	}
+
+	void Profiler::BeginFrame()
+	{
+		const uint64_t index = m_FrameIndex.load(std::memory_order_relaxed) + 1;
+		m_FrameStarts[index % FrameHistory].store(Now(), std::memory_order_relaxed);
+		m_FrameIndex.store(index, std::memory_order_release);
+	}
+
+	uint32_t Profiler::BeginZone()
+	{
+		return GetThreadBuffer().m_Depth++;
+	}
+
+	void Profiler::EndZone(const char* name, uint64_t start, uint32_t depth)
+	{
+		ProfileThreadBuffer& buffer = GetThreadBuffer();
+		buffer.m_Depth = depth;
+		buffer.Push(ProfileEvent{ name, start, Now(), depth });
+	}
+
+	size_t Profiler::GetThreadBufferCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		return m_Buffers.size();
+	}
+
+	ProfileFrame Profiler::CollectLastFrame() const
+	{
+		ProfileFrame frame;
+
+		const uint64_t index = m_FrameIndex.load(std::memory_order_acquire);
+		if (index < 2)
+			return frame;
+
+		frame.index = index - 1;
+		frame.start = m_FrameStarts[(index - 1) % FrameHistory].load(std::memory_order_relaxed);
+		frame.end = m_FrameStarts[index % FrameHistory].load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		for (const auto& buffer : m_Buffers)
+		{
+			ProfileThreadFrame thread;
+			thread.id = buffer->GetId();
+			thread.name = buffer->GetName();
+
+			buffer->Read(frame.start, thread.events);
+			thread.events.erase(std::remove_if(thread.events.begin(), thread.events.end(),
+				[&](const ProfileEvent& e) { return e.start >= frame.end; }), thread.events.end());
+
+			if (!thread.events.empty())
+				frame.threads.push_back(std::move(thread));
+		}
+
+		return frame;
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& path) const
+	{
+		std::ofstream out(path, std::ios::trunc);
+		if (!out)
+		{
+			Q_ERROR("Profiler: failed to open " + path);
+			return false;
+		}
+
+		out << std::fixed << std::setprecision(3);
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool first = true;
+		auto separator = [&]() {
+			if (!first)
+				out << ",";
+			first = false;
+			out << "\n";
+			};
+
+		std::vector<ProfileEvent> events;
+
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		for (const auto& buffer : m_Buffers)
+		{
+			separator();
+			out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->GetId() << ",\"args\":{\"name\":\"";
+			WriteEscaped(out, buffer->GetName().c_str());
+			out << "\"}}";
+
+			events.clear();
+			buffer->Read(0, events);
+
+			for (const ProfileEvent& event : events)
+			{
+				separator();
+				out << "{\"name\":\"";
+				WriteEscaped(out, event.name);
+				out << "\",\"cat\":\"QuasarEngine\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->GetId()
+					<< ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+					<< ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << "}";
+			}
+		}
+
+		out << "\n]}\n";
+		return static_cast<bool>(out);
+	}
+}
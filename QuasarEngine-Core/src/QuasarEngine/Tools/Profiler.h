@@ -0,0 +1,186 @@
+#pragma once
+
+#include <QuasarEngine/Core/Singleton.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifndef QE_PROFILE
+#define QE_PROFILE 1
+#endif
+
+namespace QuasarEngine
+{
+	struct ProfileEvent
+	{
+		const char* name = nullptr;
+		uint64_t start = 0;
+		uint64_t end = 0;
+		uint32_t depth = 0;
+	};
+
+	// One per live thread; handed to the next new thread once its owner exits. Only the owner
+	// writes. Each slot carries the index of the event it holds, so readers can tell a finished
+	// event from one the writer is overwriting or has already lapped.
+	class ProfileThreadBuffer
+	{
+	public:
+		static constexpr uint64_t Capacity = 1u << 15;
+
+		ProfileThreadBuffer(uint32_t id, std::string name);
+
+		void Push(const ProfileEvent& event);
+		void Read(uint64_t minEnd, std::vector<ProfileEvent>& out) const;
+
+		uint64_t GetWritten() const { return m_Written.load(std::memory_order_acquire); }
+
+		uint32_t GetId() const { return m_Id; }
+		const std::string& GetName() const { return m_Name; }
+
+	private:
+		friend class Profiler;
+
+		struct Slot
+		{
+			// Index + 1 of the event held, 0 while it is being written.
+			std::atomic<uint64_t> sequence{ 0 };
+			std::atomic<const char*> name{ nullptr };
+			std::atomic<uint64_t> start{ 0 };
+			std::atomic<uint64_t> end{ 0 };
+			std::atomic<uint32_t> depth{ 0 };
+		};
+
+		std::unique_ptr<Slot[]> m_Slots;
+		std::atomic<uint64_t> m_Written{ 0 };
+
+		// First event of the current owner; older ones belonged to a thread that has exited.
+		uint64_t m_First = 0;
+		bool m_Free = false;
+
+		uint32_t m_Id = 0;
+		std::string m_Name;
+		uint32_t m_Depth = 0;
+	};
+
+	struct ProfileThreadFrame
+	{
+		uint32_t id = 0;
+		std::string name;
+		std::vector<ProfileEvent> events;
+	};
+
+	struct ProfileFrame
+	{
+		uint64_t index = 0;
+		uint64_t start = 0;
+		uint64_t end = 0;
+		std::vector<ProfileThreadFrame> threads;
+	};
+
+	class Profiler : public Singleton<Profiler>
+	{
+	public:
+		static constexpr size_t FrameHistory = 256;
+
+		void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+		bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+		void SetThreadName(const std::string& name);
+
+		// Marks the start of a new frame; call once per frame from the main thread.
+		void BeginFrame();
+
+		// Returns a stable pointer for names that do not outlive the zone (job names, etc.).
+		const char* InternName(const std::string& name);
+
+		uint64_t Now() const;
+
+		uint32_t BeginZone();
+		void EndZone(const char* name, uint64_t start, uint32_t depth);
+
+		// Buffers allocated so far; bounded by the peak number of live profiled threads.
+		size_t GetThreadBufferCount() const;
+
+		// Events of the last completed frame, grouped per thread.
+		ProfileFrame CollectLastFrame() const;
+
+		// Writes every event still held by the thread buffers in Chrome trace format
+		// (chrome://tracing, Perfetto).
+		bool ExportChromeTrace(const std::string& path) const;
+
+		friend class Singleton<Profiler>;
+	private:
+		Profiler();
+
+		struct ThreadBufferOwner;
+
+		ProfileThreadBuffer& GetThreadBuffer();
+		void ReleaseThreadBuffer(ProfileThreadBuffer& buffer);
+
+		// Off until something asks for it (the editor's profiler panel), so shipping builds do not
+		// record every zone into buffers nobody reads.
+		std::atomic<bool> m_Enabled{ false };
+		uint64_t m_Epoch = 0;
+
+		mutable std::mutex m_BuffersMutex;
+		std::vector<std::unique_ptr<ProfileThreadBuffer>> m_Buffers;
+
+		std::mutex m_NamesMutex;
+		std::unordered_set<std::string> m_Names;
+
+		std::array<std::atomic<uint64_t>, FrameHistory> m_FrameStarts{};
+		std::atomic<uint64_t> m_FrameIndex{ 0 };
+	};
+
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: m_Name(name)
+		{
+			Profiler& profiler = Profiler::Instance();
+			m_Active = profiler.IsEnabled();
+			if (m_Active)
+			{
+				m_Depth = profiler.BeginZone();
+				m_Start = profiler.Now();
+			}
+		}
+
+		~ProfileScope()
+		{
+			if (m_Active)
+				Profiler::Instance().EndZone(m_Name, m_Start, m_Depth);
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_Name;
+		uint64_t m_Start = 0;
+		uint32_t m_Depth = 0;
+		bool m_Active = false;
+	};
+}
+
+#define QE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define QE_PROFILE_CONCAT(a, b) QE_PROFILE_CONCAT_IMPL(a, b)
+
+#if QE_PROFILE
+#define QE_PROFILE_SCOPE(name) ::QuasarEngine::ProfileScope QE_PROFILE_CONCAT(qeProfileScope, __LINE__)(name)
+#define QE_PROFILE_FUNCTION() QE_PROFILE_SCOPE(__FUNCTION__)
+#define QE_PROFILE_FRAME() ::QuasarEngine::Profiler::Instance().BeginFrame()
+#define QE_PROFILE_THREAD(name) ::QuasarEngine::Profiler::Instance().SetThreadName(name)
+#else
+#define QE_PROFILE_SCOPE(name)
+#define QE_PROFILE_FUNCTION()
+#define QE_PROFILE_FRAME()
+#define QE_PROFILE_THREAD(name)
+#endif
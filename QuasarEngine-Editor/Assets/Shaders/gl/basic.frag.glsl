@@ -95,7 +95,10 @@ float getAO()
 
 vec3 getNormalFromMap(vec3 N)
 {
-    vec3 tangentNormal = texture(normal_texture, inTexCoord).xyz * 2.0 - 1.0;
+    // Z is rebuilt so two channel (BC5) normal maps work; a no-op for unit RGB normals.
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(normal_texture, inTexCoord).xy * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
 
     vec3 T = normalize(inTangent);
     T = normalize(T - dot(T, N) * N);
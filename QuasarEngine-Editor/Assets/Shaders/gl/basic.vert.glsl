@@ -55,19 +55,27 @@ layout(std140, binding = 1) uniform local_uniform_object  {
     int has_roughness_texture;
     int has_metallic_texture;
     int has_ao_texture;
+
+    int use_instancing;
 } object_ubo;
 
+layout(std430, binding = 3) readonly buffer InstanceBuffer {
+    mat4 instance_models[];
+};
+
 void main()
 {
     outTexCoord = inTexCoord;
 
-    vec4 worldPos = object_ubo.model * vec4(inPosition, 1.0);
+    mat4 model = object_ubo.use_instancing != 0 ? instance_models[gl_InstanceID] : object_ubo.model;
+
+    vec4 worldPos = model * vec4(inPosition, 1.0);
     outWorldPos = worldPos.xyz;
 
-    mat3 normalMatrix = transpose(inverse(mat3(object_ubo.model)));
+    mat3 normalMatrix = transpose(inverse(mat3(model)));
     outNormal = normalize(normalMatrix * inNormal);
 
-    mat3 model3 = mat3(object_ubo.model);
+    mat3 model3 = mat3(model);
     outTangent = normalize(model3 * inTangent);
 
     gl_Position = global_ubo.projection * global_ubo.view * worldPos;
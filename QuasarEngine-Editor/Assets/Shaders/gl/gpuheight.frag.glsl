@@ -113,7 +113,10 @@ vec3 getNormal()
     if (object_ubo.has_normal_texture == 0)
         return Ng;
 
-    vec3 tangentNormal = texture(normal_texture, uvScaled()).xyz * 2.0 - 1.0;
+    // Z is rebuilt so two channel (BC5) normal maps work; a no-op for unit RGB normals.
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(normal_texture, uvScaled()).xy * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
 
     vec3 Q1  = dFdx(inWorldPos);
     vec3 Q2  = dFdy(inWorldPos);
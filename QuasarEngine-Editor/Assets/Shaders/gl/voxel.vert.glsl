@@ -0,0 +1,84 @@
+#version 450 core
+
+// Packed chunk vertex, see ChunkVertex:
+//   x: x (6) | y (9) | z (6) | face (3) | corner (2), block corner coordinates inside the chunk
+//   y: width (6) | height (6) | texture layer (8)
+layout(location = 0) in ivec2 inPacked;
+
+layout(location = 0) out vec2 outTexCoord;
+layout(location = 1) out vec3 outWorldPos;
+layout(location = 2) out vec3 outNormal;
+
+struct PointLight {    
+    vec3 position;
+    vec3 color;
+	
+    float attenuation;
+    float power;
+};
+#define NR_POINT_LIGHTS 4
+
+struct DirLight {    
+    vec3 direction;
+	vec3 color;
+	
+    float power;
+};
+#define NR_DIR_LIGHTS 4
+
+layout(std140, binding = 0) uniform global_uniform_object  {
+    mat4 view;
+	mat4 projection;
+	vec3 camera_position;
+	
+	int usePointLight;
+	int useDirLight;
+	
+	PointLight pointLights[NR_POINT_LIGHTS];
+	DirLight dirLights[NR_DIR_LIGHTS];
+} global_ubo;
+
+layout(std140, binding = 1) uniform local_uniform_object  {
+    mat4 model;
+	
+    vec4 albedo;
+    float roughness;
+    float metallic;
+    float ao;
+	
+    int has_albedo_texture;
+    int has_normal_texture;
+    int has_roughness_texture;
+    int has_metallic_texture;
+    int has_ao_texture;
+	
+    int use_instancing;
+} object_ubo;
+
+// +X, -X, +Y, -Y, +Z, -Z
+const vec3 faceNormals[6] = vec3[6](
+    vec3( 1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3( 0.0, 1.0, 0.0), vec3( 0.0,-1.0, 0.0),
+    vec3( 0.0, 0.0, 1.0), vec3( 0.0, 0.0,-1.0)
+);
+
+const vec2 cornerUVs[4] = vec2[4](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+void main()
+{
+    uint position = uint(inPacked.x);
+    uint face = uint(inPacked.y);
+
+    // Blocks are centered on integer coordinates, corners sit half a block away.
+    vec3 local = vec3(position & 63u, (position >> 6) & 511u, (position >> 15) & 63u) - 0.5;
+    vec3 normal = faceNormals[(position >> 21) & 7u];
+    vec2 extent = vec2(face & 63u, (face >> 6) & 63u);
+
+    // Repeat the texture once per block over merged faces.
+    outTexCoord = cornerUVs[(position >> 24) & 3u] * extent;
+    outNormal = mat3(object_ubo.model) * normal;
+    outWorldPos = vec3(object_ubo.model * vec4(local, 1.0));
+    gl_Position = global_ubo.projection * global_ubo.view * vec4(outWorldPos, 1.0);
+}
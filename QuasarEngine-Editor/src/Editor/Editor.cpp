@@ -19,6 +19,7 @@
 #include "QuasarEngine/Asset/AssetManager.h"
 #include "QuasarEngine/Renderer/RenderCommand.h"
 #include "QuasarEngine/Renderer/Renderer2D.h"
+#include "QuasarEngine/Shader/ShaderCache.h"
 
 #include <QuasarEngine/Memory/MemoryTracker.h>
 
@@ -40,6 +41,7 @@
 #include <Editor/Modules/UIEditor/UserInterfaceEditor.h>
 #include <Editor/Modules/SpriteEditor/SpriteEditor.h>
 #include <Editor/Modules/Particles/ParticleEffectEditor.h>
+#include <Editor/Modules/Profiler/ProfilerPanel.h>
 
 #include <Editor/EditorCamera.h>
 
@@ -195,6 +197,7 @@ namespace QuasarEngine
 		m_EditorModuleMap["HeightMapEditor"] = std::make_unique<HeightMapEditor>(m_Context);
 		m_EditorModuleMap["UserInterfaceEditor"] = std::make_unique<UserInterfaceEditor>(m_Context);
 		m_EditorModuleMap["SpriteEditor"] = std::make_unique<SpriteEditor>(m_Context);
+		m_EditorModuleMap["Profiler"] = std::make_unique<ProfilerPanel>(m_Context);
 		//m_EditorModuleMap["ParticleEditor"] = std::make_unique<ParticleEffectEditor>(m_Context);
 
 		/*m_EntityPropertie = std::make_unique<EntityPropertie>(m_Specification.ProjectPath);
@@ -481,8 +484,6 @@ namespace QuasarEngine
 
 	void Editor::OnUpdate(double dt)
 	{
-		Input::Update();
-
 		m_Context.editorCamera->Update();
 		m_Context.sceneManager->Update(dt);
 
@@ -541,6 +542,14 @@ namespace QuasarEngine
 
 		DrawFrameStats(infos, frame_history);
 
+		const auto& renderStats = Renderer::Instance().GetStats();
+		ImGui::Text("Objects: %u visible | %u culled", renderStats.visibleObjects, renderStats.culledObjects);
+		ImGui::Text("Draw calls: %u (%u saved by instancing)", renderStats.drawCalls, renderStats.drawsSaved);
+		const ShaderCacheStats shaderStats = ShaderCache::Instance().GetStats();
+		ImGui::Text("Shader cache: %u hits (%.1f ms) | %u misses (%.1f ms) | %u rejected",
+			shaderStats.hits, shaderStats.warmMs, shaderStats.misses, shaderStats.coldMs, shaderStats.rejected);
+		ImGui::Separator();
+
 		if (ImGui::BeginTable("##memtbl", 3, ImGuiTableFlags_SizingStretchProp))
 		{
 			ImGui::TableNextRow();
@@ -581,6 +590,8 @@ namespace QuasarEngine
 
 		const double fps = infos.app_fps;
 		ImGui::Text("FPS: %.1f | Frame Time: %.2f ms", fps, 1000.0 / ImMax(1.0, fps));
+		if (infos.pipelined)
+			ImGui::Text("Pipelined: update and render overlapped %.2f ms, main thread waited %.2f ms", infos.overlap_latency, infos.wait_latency);
 		ImGui::Separator();
 
 		const int size = history.Size();
@@ -598,14 +609,16 @@ namespace QuasarEngine
 			IM_COL32(255,210,120,255), // end
 			IM_COL32(255,100,100,255), // event
 			IM_COL32(100,210,180,255), // asset
-			IM_COL32(255,110,220,255)  // imgui
+			IM_COL32(255,110,220,255), // imgui
+			IM_COL32(230,230,110,255), // extract
+			IM_COL32(170,170,170,255)  // wait
 		};
-		static const char* kLabels[] = { "Begin","Update","Render","End","Event","Asset","ImGui" };
-		static bool visible[IM_ARRAYSIZE(kLabels)] = { true,true,true,true,true,true,true };
+		static const char* kLabels[] = { "Begin","Update","Render","End","Event","Asset","ImGui","Extract","Wait" };
+		static bool visible[IM_ARRAYSIZE(kLabels)] = { true,true,true,true,true,true,true,true,true };
 
 		float* curves[] = {
 			history.begin, history.update, history.render, history.end,
-			history.event, history.asset, history.imgui
+			history.event, history.asset, history.imgui, history.extract, history.wait
 		};
 		const int n_curves = IM_ARRAYSIZE(kLabels);
 
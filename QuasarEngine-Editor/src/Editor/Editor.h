@@ -24,6 +24,8 @@ namespace QuasarEngine
 		float event[FRAME_HISTORY_SIZE] = {};
 		float asset[FRAME_HISTORY_SIZE] = {};
 		float imgui[FRAME_HISTORY_SIZE] = {};
+		float extract[FRAME_HISTORY_SIZE] = {};
+		float wait[FRAME_HISTORY_SIZE] = {};
 		int index = 0;
 		bool filled = false;
 
@@ -35,6 +37,8 @@ namespace QuasarEngine
 			event[index] = (float)infos.event_latency;
 			asset[index] = (float)infos.asset_latency;
 			imgui[index] = (float)infos.imgui_latency;
+			extract[index] = (float)infos.extract_latency;
+			wait[index] = (float)infos.wait_latency;
 			index = (index + 1) % FRAME_HISTORY_SIZE;
 			if (index == 0) filled = true;
 		}
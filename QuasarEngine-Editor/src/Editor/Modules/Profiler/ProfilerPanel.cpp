@@ -0,0 +1,209 @@
+#include "ProfilerPanel.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui/imgui.h>
+
+namespace QuasarEngine
+{
+	namespace
+	{
+		constexpr float RowHeight = 18.0f;
+
+		ImU32 ZoneColor(const char* name)
+		{
+			const size_t hash = std::hash<std::string>{}(name ? name : "");
+			const float hue = static_cast<float>(hash % 360) / 360.0f;
+
+			float r, g, b;
+			ImGui::ColorConvertHSVtoRGB(hue, 0.45f, 0.85f, r, g, b);
+			return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+		}
+
+		double ToMs(uint64_t ns)
+		{
+			return static_cast<double>(ns) / 1000000.0;
+		}
+	}
+
+	ProfilerPanel::ProfilerPanel(EditorContext& context) : IEditorModule(context)
+	{
+		// The profiler is off by default; the editor records from the start, the checkbox stops it.
+		Profiler::Instance().SetEnabled(true);
+	}
+
+	ProfilerPanel::~ProfilerPanel()
+	{
+
+	}
+
+	void ProfilerPanel::Update(double dt)
+	{
+		if (!m_Paused && Profiler::Instance().IsEnabled())
+			m_Frame = Profiler::Instance().CollectLastFrame();
+	}
+
+	void ProfilerPanel::RenderUI()
+	{
+		ImGui::Begin("Profiler");
+
+		bool enabled = Profiler::Instance().IsEnabled();
+		if (ImGui::Checkbox("Enabled", &enabled))
+			Profiler::Instance().SetEnabled(enabled);
+
+		ImGui::SameLine();
+		ImGui::Checkbox("Pause", &m_Paused);
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(120.0f);
+		ImGui::SliderFloat("Zoom", &m_Zoom, 1.0f, 20.0f, "%.1fx");
+
+		ImGui::SameLine();
+		if (ImGui::Button("Export Chrome Trace"))
+		{
+			const std::filesystem::path dir = m_Context.projectPath.empty()
+				? std::filesystem::current_path()
+				: std::filesystem::path(m_Context.projectPath);
+			const std::string path = (dir / ("trace_" + std::to_string(m_Frame.index) + ".json")).generic_string();
+
+			m_LastExport = Profiler::Instance().ExportChromeTrace(path) ? path : std::string("Export failed");
+		}
+
+		if (!m_LastExport.empty())
+			ImGui::TextDisabled("%s", m_LastExport.c_str());
+
+		if (m_Frame.threads.empty())
+		{
+			ImGui::TextDisabled("No frame captured yet.");
+			ImGui::End();
+			return;
+		}
+
+		ImGui::Text("Frame %llu : %.3f ms", static_cast<unsigned long long>(m_Frame.index), ToMs(m_Frame.end - m_Frame.start));
+
+		if (ImGui::BeginTabBar("##ProfilerTabs"))
+		{
+			if (ImGui::BeginTabItem("Flame Graph"))
+			{
+				DrawFlameGraph();
+				ImGui::EndTabItem();
+			}
+			if (ImGui::BeginTabItem("Zones"))
+			{
+				DrawZoneTable();
+				ImGui::EndTabItem();
+			}
+			ImGui::EndTabBar();
+		}
+
+		ImGui::End();
+	}
+
+	void ProfilerPanel::DrawFlameGraph()
+	{
+		ImGui::BeginChild("##FlameGraph", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+		const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f) * m_Zoom;
+		const double frameNs = static_cast<double>(std::max<uint64_t>(m_Frame.end - m_Frame.start, 1));
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		for (const ProfileThreadFrame& thread : m_Frame.threads)
+		{
+			uint32_t maxDepth = 0;
+			for (const ProfileEvent& event : thread.events)
+				maxDepth = std::max(maxDepth, event.depth);
+
+			ImGui::TextUnformatted(thread.name.c_str());
+
+			const ImVec2 origin = ImGui::GetCursorScreenPos();
+			const float height = (maxDepth + 1) * RowHeight;
+
+			ImGui::InvisibleButton(("##lane" + std::to_string(thread.id)).c_str(), ImVec2(width, height));
+			const bool laneHovered = ImGui::IsItemHovered();
+			const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+			for (const ProfileEvent& event : thread.events)
+			{
+				// Zones straddling the frame edges are clipped to it.
+				const uint64_t start = std::max(event.start, m_Frame.start);
+				const uint64_t end = std::min(event.end, m_Frame.end);
+				if (end <= start)
+					continue;
+
+				const float x0 = origin.x + static_cast<float>((start - m_Frame.start) / frameNs) * width;
+				const float x1 = std::max(x0 + 1.0f, origin.x + static_cast<float>((end - m_Frame.start) / frameNs) * width);
+				const float y0 = origin.y + event.depth * RowHeight;
+				const float y1 = y0 + RowHeight - 1.0f;
+
+				drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ZoneColor(event.name));
+
+				const char* name = event.name ? event.name : "?";
+				if (x1 - x0 > ImGui::CalcTextSize(name).x + 4.0f)
+					drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(20, 20, 20, 255), name);
+
+				if (laneHovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+				{
+					ImGui::BeginTooltip();
+					ImGui::TextUnformatted(name);
+					ImGui::Text("%.3f ms", ToMs(event.end - event.start));
+					ImGui::EndTooltip();
+				}
+			}
+
+			ImGui::Spacing();
+		}
+
+		ImGui::EndChild();
+	}
+
+	void ProfilerPanel::DrawZoneTable()
+	{
+		struct ZoneStats
+		{
+			uint64_t total = 0;
+			uint64_t max = 0;
+			uint32_t count = 0;
+		};
+
+		std::unordered_map<std::string, ZoneStats> stats;
+		for (const ProfileThreadFrame& thread : m_Frame.threads)
+		{
+			for (const ProfileEvent& event : thread.events)
+			{
+				ZoneStats& zone = stats[event.name ? event.name : "?"];
+				const uint64_t duration = event.end - event.start;
+				zone.total += duration;
+				zone.max = std::max(zone.max, duration);
+				++zone.count;
+			}
+		}
+
+		std::vector<std::pair<std::string, ZoneStats>> sorted(stats.begin(), stats.end());
+		std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.total > b.second.total; });
+
+		if (ImGui::BeginTable("##ZoneTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY))
+		{
+			ImGui::TableSetupColumn("Zone");
+			ImGui::TableSetupColumn("Total (ms)");
+			ImGui::TableSetupColumn("Max (ms)");
+			ImGui::TableSetupColumn("Calls");
+			ImGui::TableHeadersRow();
+
+			for (const auto& [name, zone] : sorted)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted(name.c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f", ToMs(zone.total));
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f", ToMs(zone.max));
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%u", zone.count);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+}
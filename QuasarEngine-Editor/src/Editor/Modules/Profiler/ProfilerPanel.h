@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+#include <QuasarEngine/Tools/Profiler.h>
+
+#include <Editor/Modules/IEditorModule.h>
+
+namespace QuasarEngine
+{
+	class ProfilerPanel : public IEditorModule
+	{
+	public:
+		ProfilerPanel(EditorContext& context);
+		~ProfilerPanel() override;
+
+		void Update(double dt) override;
+		void RenderUI() override;
+
+	private:
+		void DrawFlameGraph();
+		void DrawZoneTable();
+
+	private:
+		ProfileFrame m_Frame;
+
+		bool m_Paused = false;
+		float m_Zoom = 1.0f;
+
+		std::string m_LastExport;
+	};
+}
@@ -605,7 +605,7 @@ namespace QuasarEngine
 		if (m_Context.selectedEntity.IsValid() && m_GizmoOperation != -1)
 		{
 			auto& tc = m_Context.selectedEntity.GetComponent<TransformComponent>();
-			glm::mat4 transform = tc.GetGlobalTransform();
+			glm::mat4 transform = tc.GetGlobalTransform(m_Context.selectedEntity);
 
 			float snap[3] = { m_SnapT, m_SnapT, m_SnapT };
 			if (m_GizmoOperation == ImGuizmo::ROTATE) snap[0] = snap[1] = snap[2] = m_SnapR;
@@ -119,7 +119,7 @@ namespace QuasarEngine
 
 						auto& cam = entity.GetComponent<CameraComponent>();
 
-						glm::mat4 camWorld = tr.GetGlobalTransform();
+						glm::mat4 camWorld = tr.GetGlobalTransform(entity);
 
 						float fov = cam.FovDeg;
 						float nearZ = cam.NearZ;
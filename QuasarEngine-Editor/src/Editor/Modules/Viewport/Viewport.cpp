@@ -65,10 +65,10 @@ namespace QuasarEngine
 			RenderCommand::Instance().ClearColor(m_ClearColor);
 			RenderCommand::Instance().Clear();
 
-			glm::mat4 view = tc.GetGlobalViewMatrix();
+			glm::mat4 view = tc.GetGlobalViewMatrix(entity);
 			glm::mat4 skyboxView = glm::mat4(glm::mat3(view));
 			Renderer::Instance().RenderSkybox(skyboxView, cc.Projection());
-			Renderer::Instance().Render(tc.GetGlobalViewMatrix(), cc.Projection(), tc.Position);
+			Renderer::Instance().Render(tc.GetGlobalViewMatrix(entity), cc.Projection(), tc.Position);
 			//Renderer::Instance().RenderUI(camera, fbW, fbH, dpiScale);
 			Renderer::Instance().EndScene();
 
@@ -50,13 +50,20 @@ layout(std140, binding = 1) uniform local_uniform_object  {
     int has_roughness_texture;
     int has_metallic_texture;
     int has_ao_texture;
+	
+    int use_instancing;
 } object_ubo;
 
+layout(std430, binding = 3) readonly buffer InstanceBuffer {
+    mat4 instance_models[];
+};
+
 void main()
 {
     outTexCoord = inTexCoord;
-    mat3 normalMatrix = transpose(inverse(mat3(object_ubo.model)));
+    mat4 model = object_ubo.use_instancing != 0 ? instance_models[gl_InstanceID] : object_ubo.model;
+    mat3 normalMatrix = transpose(inverse(mat3(model)));
     outNormal = normalMatrix * inNormal;
-    outWorldPos = vec3(object_ubo.model * vec4(inPosition, 1.0));
+    outWorldPos = vec3(model * vec4(inPosition, 1.0));
     gl_Position = global_ubo.projection * global_ubo.view * vec4(outWorldPos, 1.0);
 }
\ No newline at end of file
@@ -45,6 +45,7 @@ namespace QuasarEngine
 		m_ScreenQuad = std::make_unique<ScreenQuad>();
 
 		m_Scene = std::make_unique<Scene>();
+		m_Scene->SetDeferDestructions(true);
 		Renderer::Instance().BeginScene(*m_Scene);
 		
 		//m_SceneManager = std::make_unique<SceneManager>("");
@@ -172,6 +173,9 @@ namespace QuasarEngine
 
 	void Runtime::OnDetach()
 	{
+		// Saves the loaded chunks while their entities still exist.
+		m_ChunkManager.reset();
+
 		PhysicEngine::Instance().Shutdown();
 		AssetManager::Instance().Shutdown();
 		Renderer2D::Instance().Shutdown();
@@ -181,15 +185,13 @@ namespace QuasarEngine
 
 	void Runtime::OnUpdate(double dt)
 	{
-		Input::Update();
-
 		m_Scene->Update(dt);
 
 		m_Player->Update(dt);
 
 		m_Player->GetCamera().Update();
 
-		m_ChunkManager->UpdateChunks(glm::floor(m_Player->GetPosition()), dt);
+		m_ChunkManager->UpdateChunks(glm::floor(m_Player->GetPosition()), m_Player->GetCamera().GetFront(), dt);
 
 		//m_SceneManager->Update(dt);
 
@@ -200,6 +202,20 @@ namespace QuasarEngine
 		}*/
 	}
 
+	void Runtime::OnExtract()
+	{
+		// Both replace meshes, so they wait for a point where nothing is drawn.
+		m_Scene->ProcessEntityDestructions();
+		m_ChunkManager->UploadMeshes();
+
+		const GameCamera& camera = m_Player->GetCamera();
+		m_RenderView = camera.getViewMatrix();
+		m_RenderProjection = camera.getProjectionMatrix();
+		m_RenderCameraPosition = camera.GetPosition();
+
+		Renderer::Instance().ExtractScene(*m_Scene);
+	}
+
 	void Runtime::OnRender()
 	{
 		m_FrameBuffer->Bind();
@@ -211,27 +227,11 @@ namespace QuasarEngine
 		RenderCommand::Instance().SetViewport(0, 0, spec.Width, spec.Height);
 		RenderCommand::Instance().SetScissor(0, 0, spec.Width, spec.Height);
 
-		//Renderer::Instance().BeginScene(m_SceneManager->GetActiveScene());
-		Renderer::Instance().BeginScene(*m_Scene.get());
+		// Scene, lights and camera come from OnExtract, the update of the next frame may be running.
+		Renderer::Instance().RenderSkybox(m_RenderView, m_RenderProjection);
+		Renderer::Instance().Render(m_RenderView, m_RenderProjection, m_RenderCameraPosition);
 
-		Renderer::Instance().BuildLight(m_Player->GetCamera());
-
-		//if (m_SceneManager->GetActiveScene().HasPrimaryCamera()) {
-		//if (m_Scene->HasPrimaryCamera()) {
-
-			//Camera& camera = m_SceneManager->GetActiveScene().GetPrimaryCamera();
-			BaseCamera& camera = m_Player->GetCamera();
-
-			Renderer::Instance().BuildLight(camera);
-
-			Renderer::Instance().RenderSkybox(camera);
-			Renderer::Instance().Render(camera);
-
-			//Renderer::Instance().RenderSkybox(m_Player->GetCamera());
-			//Renderer::Instance().Render(m_Player->GetCamera());
-
-			Renderer::Instance().EndScene();
-		//}
+		Renderer::Instance().EndScene();
 
 		m_FrameBuffer->Unbind();
 
@@ -255,6 +255,21 @@ namespace QuasarEngine
 
 	void Runtime::OnGuiRender()
 	{
+		const ChunkManager::Stats worldStats = m_ChunkManager->GetStats();
+
+		ImGui::Begin("World");
+		ImGui::Text("Chunks: %u", worldStats.loadedChunks);
+		ImGui::Text("Block memory: %.2f MB", worldStats.blockMemory / (1024.0 * 1024.0));
+		if (worldStats.loadedChunks > 0)
+			ImGui::Text("Per chunk: %.1f KB", worldStats.blockMemory / 1024.0 / worldStats.loadedChunks);
+		ImGui::Text("Mesh memory: %.2f MB", worldStats.meshMemory / (1024.0 * 1024.0));
+		ImGui::Text("Triangles: %zu, mesh builds: %u", worldStats.triangles, worldStats.meshBuilds);
+		ImGui::Text("Pending chunks: %u", worldStats.pendingChunks);
+		ImGui::Text("Pending uploads: %u (%.1f KB this frame)", worldStats.pendingUploads, worldStats.uploadedBytes / 1024.0);
+		ImGui::Text("Loaded from disk: %u, generated: %u", worldStats.loadedFromDisk, worldStats.generatedChunks);
+		ImGui::Text("Pending saves: %u", worldStats.pendingSaves);
+		ImGui::End();
+
 		/*ImGui::Begin("Runtime");
 
 		ImGui::Image((ImTextureID)(uintptr_t)m_FrameBuffer->GetColorAttachmentTexture(0)->GetHandle(), ImVec2(512, 512), ImVec2(0, 1), ImVec2(1, 0));
@@ -27,10 +27,13 @@ namespace QuasarEngine
 		void OnAttach() override;
 		void OnDetach() override;
 		void OnUpdate(double dt) override;
+		void OnExtract() override;
 		void OnRender() override;
 		void OnGuiRender() override;
 		void OnEvent(Event& e) override;
 
+		bool IsPipelined() const override { return true; }
+
 		bool OnWindowResize(WindowResizeEvent& e);
 
 	private:
@@ -40,6 +43,11 @@ namespace QuasarEngine
 		std::shared_ptr<Shader> m_ScreenQuadShader;
 		glm::vec2 m_ApplicationSize = { 0.0f, 0.0f };
 
+		// Camera of the extracted frame, the player's one may already be a frame ahead.
+		glm::mat4 m_RenderView{ 1.0f };
+		glm::mat4 m_RenderProjection{ 1.0f };
+		glm::vec3 m_RenderCameraPosition{ 0.0f };
+
 	private:
 		std::unique_ptr<Player> m_Player;
 		std::unique_ptr<ChunkManager> m_ChunkManager;
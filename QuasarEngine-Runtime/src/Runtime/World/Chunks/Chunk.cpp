@@ -6,21 +6,29 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "glm/gtx/compatibility.hpp"
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <random>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include <QuasarEngine/Renderer/Renderer.h>
 #include <QuasarEngine/Entity/Entity.h>
 #include <QuasarEngine/Entity/Components/MeshComponent.h>
+#include <QuasarEngine/Renderer/VoxelTechnique.h>
 
-Chunk::Chunk(const glm::ivec3& position) : m_Position(position), m_MaxHeight(0), m_Blocks(), m_HeightTimer(0.0f), m_HeightTimerIncreasing(true)
+Chunk::Chunk(const glm::ivec3& position) : m_Blocks(), m_BlocksMutex(std::make_unique<std::shared_mutex>()), m_MeshMutex(std::make_unique<std::mutex>()), m_Position(position), m_MaxHeight(0), m_HeightTimer(0.0f), m_HeightTimerIncreasing(true)
 {
-
+	m_SectionDirty.fill(true);
 }
 
-Chunk::Chunk(const glm::ivec3& position, BlockType voxel) : m_Position(position), m_MaxHeight(0), m_Blocks(), m_HeightTimer(0.0f), m_HeightTimerIncreasing(true)
+Chunk::Chunk(const glm::ivec3& position, BlockType voxel) : m_Blocks(), m_BlocksMutex(std::make_unique<std::shared_mutex>()), m_MeshMutex(std::make_unique<std::mutex>()), m_Position(position), m_MaxHeight(0), m_HeightTimer(0.0f), m_HeightTimerIncreasing(true)
 {
-	m_Blocks.fill(Block(voxel));
+	m_Blocks.Fill(voxel);
+	m_SectionDirty.fill(true);
 }
 
 Chunk::~Chunk()
@@ -30,34 +38,47 @@ Chunk::~Chunk()
 
 void Chunk::SetBlock(const glm::ivec3& pos, Block voxel)
 {
-	if (ToIndex(pos) < 0 || ToIndex(pos) >= m_Blocks.size())
+	if (!InBounds(pos))
 	{
 		//ChunkManager::GetInstance()->SetBlock(pos + m_Position, voxel.GetType());
 		return;
 	}
 	else
 	{
-		m_Blocks.at(ToIndex(pos)) = voxel;
+		std::unique_lock<std::shared_mutex> lock(*m_BlocksMutex);
+		m_Blocks.Set(pos.x, pos.y, pos.z, voxel.GetType());
+		m_Unsaved = true;
+
+		// Faces on a section border depend on the block across it.
+		const int section = pos.y / CHUNK_SECTION_HEIGHT;
+		const int local = pos.y % CHUNK_SECTION_HEIGHT;
+		m_SectionDirty[section] = true;
+		if (local == 0 && section > 0)
+			m_SectionDirty[section - 1] = true;
+		if (local == CHUNK_SECTION_HEIGHT - 1 && section + 1 < CHUNK_SECTION_COUNT)
+			m_SectionDirty[section + 1] = true;
 	}
 
 	if (pos.y > m_MaxHeight)
 		m_MaxHeight = pos.y;
 }
 
-const Block* Chunk::GetBlock(const glm::ivec3& position) const
+std::optional<Block> Chunk::GetBlock(const glm::ivec3& position) const
 {
-	if (ToIndex(position) < 0 || ToIndex(position) >= m_Blocks.size())
-		return nullptr;
+	if (!InBounds(position))
+		return std::nullopt;
 
-	return &m_Blocks.at(ToIndex(position));
+	std::shared_lock<std::shared_mutex> lock(*m_BlocksMutex);
+	return Block(m_Blocks.Get(position.x, position.y, position.z));
 }
 
 const BlockType Chunk::GetBlockType(const glm::ivec3& position) const
 {
-	if (ToIndex(position) < 0 || ToIndex(position) >= m_Blocks.size())
+	if (!InBounds(position))
 		return BlockType::BLOCK_ERROR;
 
-	return m_Blocks.at(ToIndex(position)).GetType();
+	std::shared_lock<std::shared_mutex> lock(*m_BlocksMutex);
+	return m_Blocks.Get(position.x, position.y, position.z);
 }
 
 void Chunk::Generate(TerrainGenerator& generator)
@@ -113,14 +134,16 @@ void Chunk::Generate(TerrainGenerator& generator)
 		int height = generator.GetHeight(hpos);
 		generator.GenerateTree(*this, pos.x, height, pos.y);
 	}
+
+	m_HasBlocks = true;
 }
 
 void Chunk::GenerateMesh()
 {
-	std::vector<float> vertices;
+	std::vector<ChunkVertex> vertices;
 	std::vector<unsigned int> indices;
 
-	BuildGreedyMeshData(vertices, indices);
+	m_UploadedRevision = BuildMeshData(ChunkManager::GetInstance()->GetBorder(m_Position), vertices, indices);
 
 	if (vertices.empty() || indices.empty())
 	{
@@ -129,15 +152,7 @@ void Chunk::GenerateMesh()
 	}
 
 	QuasarEngine::Entity entity{ entt_entity, registry };
-	auto& meshComp = entity.GetComponent<QuasarEngine::MeshComponent>();
-
-	QuasarEngine::BufferLayout layout = {
-		{ QuasarEngine::ShaderDataType::Vec3,  "vPosition" },
-		{ QuasarEngine::ShaderDataType::Vec3,  "vNormal"   },
-		{ QuasarEngine::ShaderDataType::Vec2,  "vTextureCoordinates" }
-	};
-
-	meshComp.GenerateMesh(vertices, indices, layout);
+	UploadMesh(entity.GetComponent<QuasarEngine::MeshComponent>(), vertices, indices);
 }
 
 const glm::vec3& Chunk::GetRenderPos() const
@@ -170,286 +185,209 @@ bool Chunk::HeightTimerHitZero() const
 	return m_HeightTimer == 0.0f && !m_HeightTimerIncreasing;
 }
 
-void Chunk::SetBlocksFromExternal(const std::array<Block, CHUNK_VOLUME>& blocks, int maxHeight)
+void Chunk::SetBlocksFromExternal(ChunkStorage&& blocks, int maxHeight)
 {
-	m_Blocks = blocks;
+	std::unique_lock<std::shared_mutex> lock(*m_BlocksMutex);
+	m_Blocks = std::move(blocks);
 	m_MaxHeight = maxHeight;
+	m_SectionDirty.fill(true);
+	m_HasBlocks = true;
 }
 
-void Chunk::BuildGreedyMeshData(std::vector<float>& vertices, std::vector<unsigned int>& indices) const
+ChunkStorage Chunk::CopyBlocks() const
 {
-    vertices.clear();
-    indices.clear();
-
-    unsigned int indexOffset = 0;
-
-    auto pushQuad = [&](const glm::vec3& v0,
-        const glm::vec3& v1,
-        const glm::vec3& v2,
-        const glm::vec3& v3,
-        const glm::vec3& normal)
-        {
-            vertices.push_back(v0.x); vertices.push_back(v0.y); vertices.push_back(v0.z);
-            vertices.push_back(normal.x); vertices.push_back(normal.y); vertices.push_back(normal.z);
-            vertices.push_back(0.0f); vertices.push_back(0.0f);
-
-            vertices.push_back(v1.x); vertices.push_back(v1.y); vertices.push_back(v1.z);
-            vertices.push_back(normal.x); vertices.push_back(normal.y); vertices.push_back(normal.z);
-            vertices.push_back(1.0f); vertices.push_back(0.0f);
-
-            vertices.push_back(v2.x); vertices.push_back(v2.y); vertices.push_back(v2.z);
-            vertices.push_back(normal.x); vertices.push_back(normal.y); vertices.push_back(normal.z);
-            vertices.push_back(1.0f); vertices.push_back(1.0f);
-
-            vertices.push_back(v3.x); vertices.push_back(v3.y); vertices.push_back(v3.z);
-            vertices.push_back(normal.x); vertices.push_back(normal.y); vertices.push_back(normal.z);
-            vertices.push_back(0.0f); vertices.push_back(1.0f);
-
-            indices.push_back(indexOffset + 0);
-            indices.push_back(indexOffset + 1);
-            indices.push_back(indexOffset + 2);
-            indices.push_back(indexOffset + 0);
-            indices.push_back(indexOffset + 2);
-            indices.push_back(indexOffset + 3);
-
-            indexOffset += 4;
-        };
+	std::shared_lock<std::shared_mutex> lock(*m_BlocksMutex);
+	return m_Blocks;
+}
 
-    const int S = CHUNK_SIZE;
-    const int H = CHUNK_HEIGHT;
+std::size_t Chunk::GetMemoryUsage() const
+{
+	std::shared_lock<std::shared_mutex> lock(*m_BlocksMutex);
+	return sizeof(Chunk) + m_Blocks.GetMemoryUsage();
+}
 
-    std::vector<BlockType> mask(S * S);
+uint32_t Chunk::BuildMeshData(const ChunkBorder& border, std::vector<ChunkVertex>& vertices, std::vector<unsigned int>& indices) const
+{
+    std::shared_lock<std::shared_mutex> lock(*m_BlocksMutex);
+    std::lock_guard<std::mutex> meshLock(*m_MeshMutex);
 
-    for (int y = 0; y < H; ++y)
+    std::size_t vertexCount = 0;
+    for (int s = 0; s < CHUNK_SECTION_COUNT; ++s)
     {
-        for (int z = 0; z < S; ++z)
+        if (m_SectionDirty[s])
         {
-            for (int x = 0; x < S; ++x)
-            {
-                BlockType t = GetBlockFast(x, y, z).GetType();
-                bool solid = (t != BlockType::AIR);
-                bool neighborSolid = IsSolid(x, y + 1, z);
-
-                mask[z * S + x] = (solid && !neighborSolid) ? t : BlockType::AIR;
-            }
+            BuildSectionMesh(s, border, m_SectionVertices[s]);
+            m_SectionDirty[s] = false;
         }
+        vertexCount += m_SectionVertices[s].size();
+    }
 
-        int z = 0;
-        while (z < S)
-        {
-            int x = 0;
-            while (x < S)
-            {
-                BlockType t = mask[z * S + x];
-                if (t == BlockType::AIR) { x++; continue; }
-
-                int w = 1;
-                while (x + w < S && mask[z * S + (x + w)] == t) w++;
+    // Sized once and written in place, so recycled buffers keep their capacity between builds.
+    vertices.resize(vertexCount);
+    indices.resize(vertexCount / 4 * 6);
 
-                int h = 1;
-                bool stop = false;
-                while (z + h < S && !stop)
-                {
-                    for (int k = 0; k < w; ++k)
-                    {
-                        if (mask[(z + h) * S + (x + k)] != t)
-                        {
-                            stop = true; break;
-                        }
-                    }
-                    if (!stop) h++;
-                }
+    ChunkVertex* out = vertices.data();
+    for (const auto& sectionVertices : m_SectionVertices)
+    {
+        if (!sectionVertices.empty())
+            std::memcpy(out, sectionVertices.data(), sectionVertices.size() * sizeof(ChunkVertex));
+        out += sectionVertices.size();
+    }
 
-                for (int dz = 0; dz < h; ++dz)
-                    for (int dx = 0; dx < w; ++dx)
-                        mask[(z + dz) * S + (x + dx)] = BlockType::AIR;
+    unsigned int* index = indices.data();
+    for (unsigned int base = 0; base < vertexCount; base += 4)
+    {
+        *index++ = base + 0;
+        *index++ = base + 1;
+        *index++ = base + 2;
+        *index++ = base + 0;
+        *index++ = base + 2;
+        *index++ = base + 3;
+    }
 
-                float x0 = m_Position.x + x - 0.5f;
-                float x1 = m_Position.x + x + w - 0.5f;
-                float z0 = m_Position.z + z - 0.5f;
-                float z1 = m_Position.z + z + h - 0.5f;
-                float yy = m_Position.y + y + 0.5f;
+    return ++m_MeshRevision;
+}
 
-                glm::vec3 n(0.0f, 1.0f, 0.0f);
+void Chunk::BuildGreedyMeshData(const ChunkBorder& border, std::vector<float>& vertices, std::vector<unsigned int>& indices) const
+{
+    std::vector<ChunkVertex> packed;
+    BuildMeshData(border, packed, indices);
+    UnpackVertices(packed, vertices);
+}
 
-                glm::vec3 v0(x0, yy, z1);
-                glm::vec3 v1(x1, yy, z1);
-                glm::vec3 v2(x1, yy, z0);
-                glm::vec3 v3(x0, yy, z0);
+void Chunk::UnpackVertices(const std::vector<ChunkVertex>& vertices, std::vector<float>& outVertices)
+{
+    static const glm::vec3 normals[6] = {
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+    };
+    static const glm::vec2 cornerUVs[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
 
-                pushQuad(v0, v1, v2, v3, n);
+    outVertices.resize(vertices.size() * 8);
 
-                x += w;
-            }
-            z++;
-        }
+    float* out = outVertices.data();
+    for (const ChunkVertex& v : vertices)
+    {
+        const glm::vec3& normal = normals[(v.position >> 21) & 7u];
+        const glm::vec2 uv = cornerUVs[(v.position >> 24) & 3u] * glm::vec2(float(v.face & 63u), float((v.face >> 6) & 63u));
+
+        *out++ = float(v.position & 63u) - 0.5f;
+        *out++ = float((v.position >> 6) & 511u) - 0.5f;
+        *out++ = float((v.position >> 15) & 63u) - 0.5f;
+        *out++ = normal.x; *out++ = normal.y; *out++ = normal.z;
+        *out++ = uv.x; *out++ = uv.y;
     }
+}
 
-    for (int y = 0; y < H; ++y)
+void Chunk::UploadMesh(QuasarEngine::MeshComponent& meshComp, const std::vector<ChunkVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    if (!QuasarEngine::VoxelTechnique::IsSupported())
     {
-        for (int z = 0; z < S; ++z)
-        {
-            for (int x = 0; x < S; ++x)
-            {
-                BlockType t = GetBlockFast(x, y, z).GetType();
-                bool solid = (t != BlockType::AIR);
-                bool neighborSolid = IsSolid(x, y - 1, z);
-
-                mask[z * S + x] = (solid && !neighborSolid) ? t : BlockType::AIR;
-            }
-        }
-
-        int z = 0;
-        while (z < S)
-        {
-            int x = 0;
-            while (x < S)
-            {
-                BlockType t = mask[z * S + x];
-                if (t == BlockType::AIR) { x++; continue; }
-
-                int w = 1;
-                while (x + w < S && mask[z * S + (x + w)] == t) w++;
-
-                int h = 1;
-                bool stop = false;
-                while (z + h < S && !stop)
-                {
-                    for (int k = 0; k < w; ++k)
-                    {
-                        if (mask[(z + h) * S + (x + k)] != t)
-                        {
-                            stop = true; break;
-                        }
-                    }
-                    if (!stop) h++;
-                }
-
-                for (int dz = 0; dz < h; ++dz)
-                    for (int dx = 0; dx < w; ++dx)
-                        mask[(z + dz) * S + (x + dx)] = BlockType::AIR;
+        std::vector<float> unpacked;
+        UnpackVertices(vertices, unpacked);
+        std::vector<unsigned int> unpackedIndices = indices;
+
+        QuasarEngine::BufferLayout layout = {
+            { QuasarEngine::ShaderDataType::Vec3,  "vPosition" },
+            { QuasarEngine::ShaderDataType::Vec3,  "vNormal"   },
+            { QuasarEngine::ShaderDataType::Vec2,  "vTextureCoordinates" }
+        };
+        meshComp.GenerateMesh(unpacked, unpackedIndices, layout);
+        return;
+    }
 
-                float x0 = m_Position.x + x - 0.5f;
-                float x1 = m_Position.x + x + w - 0.5f;
-                float z0 = m_Position.z + z - 0.5f;
-                float z1 = m_Position.z + z + h - 0.5f;
-                float yy = m_Position.y + y - 0.5f;
+    glm::uvec3 minCorner(~0u);
+    glm::uvec3 maxCorner(0u);
+    for (const ChunkVertex& v : vertices)
+    {
+        const glm::uvec3 corner(v.position & 63u, (v.position >> 6) & 511u, (v.position >> 15) & 63u);
+        minCorner = glm::min(minCorner, corner);
+        maxCorner = glm::max(maxCorner, corner);
+    }
 
-                glm::vec3 n(0.0f, -1.0f, 0.0f);
+    QuasarEngine::BufferLayout layout = {
+        { QuasarEngine::ShaderDataType::IVec2, "inPacked" }
+    };
+    meshComp.GenerateMesh(vertices.data(), static_cast<uint32_t>(vertices.size()), layout, indices,
+        QuasarEngine::MeshVertexFormat::PackedVoxel, glm::vec3(minCorner) - 0.5f, glm::vec3(maxCorner - minCorner));
+}
 
-                glm::vec3 v0(x0, yy, z0);
-                glm::vec3 v1(x1, yy, z0);
-                glm::vec3 v2(x1, yy, z1);
-                glm::vec3 v3(x0, yy, z1);
+void Chunk::InvalidateSection(int y)
+{
+    if (y < 0 || y >= CHUNK_HEIGHT)
+        return;
 
-                pushQuad(v0, v1, v2, v3, n);
+    std::unique_lock<std::shared_mutex> lock(*m_BlocksMutex);
+    m_SectionDirty[y / CHUNK_SECTION_HEIGHT] = true;
+}
 
-                x += w;
-            }
-            z++;
-        }
-    }
+void Chunk::InvalidateMesh()
+{
+    std::unique_lock<std::shared_mutex> lock(*m_BlocksMutex);
+    m_SectionDirty.fill(true);
+}
 
-    mask.resize(H * S);
+bool Chunk::CopySide(int face, std::array<uint32_t, CHUNK_HEIGHT>& rows) const
+{
+    std::shared_lock<std::shared_mutex> lock(*m_BlocksMutex);
+    if (!m_HasBlocks)
+        return false;
 
-    for (int x = 0; x < S; ++x)
+    for (int y = 0; y < CHUNK_HEIGHT; ++y)
     {
-        for (int y = 0; y < H; ++y)
+        if (face == 4 || face == 5)
         {
-            for (int z = 0; z < S; ++z)
-            {
-                BlockType t = GetBlockFast(x, y, z).GetType();
-                bool solid = (t != BlockType::AIR);
-                bool neighborSolid = IsSolid(x + 1, y, z);
-
-                mask[y * S + z] = (solid && !neighborSolid) ? t : BlockType::AIR;
-            }
+            rows[y] = m_Blocks.GetRow(y, face == 4 ? CHUNK_SIZE - 1 : 0);
+            continue;
         }
 
-        int y = 0;
-        while (y < H)
-        {
-            int z = 0;
-            while (z < S)
-            {
-                BlockType t = mask[y * S + z];
-                if (t == BlockType::AIR) { z++; continue; }
-
-                int w = 1;
-                while (z + w < S && mask[y * S + (z + w)] == t) w++;
-
-                int h = 1;
-                bool stop = false;
-                while (y + h < H && !stop)
-                {
-                    for (int k = 0; k < w; ++k)
-                    {
-                        if (mask[(y + h) * S + (z + k)] != t)
-                        {
-                            stop = true; break;
-                        }
-                    }
-                    if (!stop) h++;
-                }
-
-                for (int dy = 0; dy < h; ++dy)
-                    for (int dz = 0; dz < w; ++dz)
-                        mask[(y + dy) * S + (z + dz)] = BlockType::AIR;
-
-                float xx = m_Position.x + x + 0.5f;
-                float y0 = m_Position.y + y - 0.5f;
-                float y1 = m_Position.y + y + h - 0.5f;
-                float z0 = m_Position.z + z - 0.5f;
-                float z1 = m_Position.z + z + w - 0.5f;
-
-                glm::vec3 n(1.0f, 0.0f, 0.0f);
-
-                glm::vec3 v0(xx, y0, z1);
-                glm::vec3 v1(xx, y0, z0);
-                glm::vec3 v2(xx, y1, z0);
-                glm::vec3 v3(xx, y1, z1);
+        const int shift = face == 0 ? CHUNK_SIZE - 1 : 0;
+        uint32_t column = 0;
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            column |= ((m_Blocks.GetRow(y, z) >> shift) & 1u) << z;
+        rows[y] = column;
+    }
 
-                pushQuad(v0, v1, v2, v3, n);
+    return true;
+}
 
-                z += w;
-            }
-            y++;
-        }
+namespace
+{
+    inline int CountTrailingZeros(uint32_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(bits);
+#endif
     }
 
-    for (int x = 0; x < S; ++x)
+    // Merges equal neighbours of a width x height mask into rectangles, emit(u, v, w, h, type)
+    // is called for each of them. The mask is consumed.
+    template<typename Emit>
+    void GreedyMerge(BlockType* mask, int width, int height, Emit&& emit)
     {
-        for (int y = 0; y < H; ++y)
-        {
-            for (int z = 0; z < S; ++z)
-            {
-                BlockType t = GetBlockFast(x, y, z).GetType();
-                bool solid = (t != BlockType::AIR);
-                bool neighborSolid = IsSolid(x - 1, y, z);
-
-                mask[y * S + z] = (solid && !neighborSolid) ? t : BlockType::AIR;
-            }
-        }
-
-        int y = 0;
-        while (y < H)
+        for (int v = 0; v < height; ++v)
         {
-            int z = 0;
-            while (z < S)
+            int u = 0;
+            while (u < width)
             {
-                BlockType t = mask[y * S + z];
-                if (t == BlockType::AIR) { z++; continue; }
+                BlockType t = mask[v * width + u];
+                if (t == BlockType::AIR) { u++; continue; }
 
                 int w = 1;
-                while (z + w < S && mask[y * S + (z + w)] == t) w++;
+                while (u + w < width && mask[v * width + (u + w)] == t) w++;
 
                 int h = 1;
                 bool stop = false;
-                while (y + h < H && !stop)
+                while (v + h < height && !stop)
                 {
                     for (int k = 0; k < w; ++k)
                     {
-                        if (mask[(y + h) * S + (z + k)] != t)
+                        if (mask[(v + h) * width + (u + k)] != t)
                         {
                             stop = true; break;
                         }
@@ -457,160 +395,167 @@ void Chunk::BuildGreedyMeshData(std::vector<float>& vertices, std::vector<unsign
                     if (!stop) h++;
                 }
 
-                for (int dy = 0; dy < h; ++dy)
-                    for (int dz = 0; dz < w; ++dz)
-                        mask[(y + dy) * S + (z + dz)] = BlockType::AIR;
+                for (int dv = 0; dv < h; ++dv)
+                    for (int du = 0; du < w; ++du)
+                        mask[(v + dv) * width + (u + du)] = BlockType::AIR;
 
-                float xx = m_Position.x + x - 0.5f;
-                float y0 = m_Position.y + y - 0.5f;
-                float y1 = m_Position.y + y + h - 0.5f;
-                float z0 = m_Position.z + z + w - 0.5f;
-                float z1 = m_Position.z + z - 0.5f;
+                emit(u, v, w, h, t);
 
-                glm::vec3 n(-1.0f, 0.0f, 0.0f);
-
-                glm::vec3 v0(xx, y0, z0);
-                glm::vec3 v1(xx, y1, z0);
-                glm::vec3 v2(xx, y1, z1);
-                glm::vec3 v3(xx, y0, z1);
-
-                pushQuad(v0, v1, v2, v3, n);
-
-                z += w;
+                u += w;
             }
-            y++;
         }
     }
+}
 
-    mask.resize(H * S);
+void Chunk::BuildSectionMesh(int section, const ChunkBorder& border, std::vector<ChunkVertex>& vertices) const
+{
+    vertices.clear();
 
-    for (int z = 0; z < S; ++z)
-    {
-        for (int y = 0; y < H; ++y)
-        {
-            for (int x = 0; x < S; ++x)
-            {
-                BlockType t = GetBlockFast(x, y, z).GetType();
-                bool solid = (t != BlockType::AIR);
-                bool neighborSolid = IsSolid(x, y, z + 1);
+    const ChunkSection& blocks = m_Blocks.GetSection(section);
+    if (blocks.IsEmpty())
+        return;
 
-                mask[y * S + x] = (solid && !neighborSolid) ? t : BlockType::AIR;
-            }
-        }
+    const ChunkManager* manager = ChunkManager::GetInstance();
 
-        int y = 0;
-        while (y < H)
+    // Corners in texture order (0,0) (1,0) (1,1) (0,1), width and height are the extents along u and v.
+    auto pushQuad = [&](int face, BlockType type, const glm::ivec3& c0, const glm::ivec3& c1, const glm::ivec3& c2, const glm::ivec3& c3, int width, int height)
         {
-            int x = 0;
-            while (x < S)
-            {
-                BlockType t = mask[y * S + x];
-                if (t == BlockType::AIR) { x++; continue; }
-
-                int w = 1;
-                while (x + w < S && mask[y * S + (x + w)] == t) w++;
+            const int layer = manager->GetFaceLayer(type, face);
+            const glm::ivec3* corners[4] = { &c0, &c1, &c2, &c3 };
+            for (int i = 0; i < 4; ++i)
+                vertices.push_back(ChunkVertex::Pack(corners[i]->x, corners[i]->y, corners[i]->z, face, i, width, height, layer));
+        };
 
-                int h = 1;
-                bool stop = false;
-                while (y + h < H && !stop)
-                {
-                    for (int k = 0; k < w; ++k)
-                    {
-                        if (mask[(y + h) * S + (x + k)] != t)
-                        {
-                            stop = true; break;
-                        }
-                    }
-                    if (!stop) h++;
-                }
+    const int S = CHUNK_SIZE;
+    const int SH = CHUNK_SECTION_HEIGHT;
+    const int baseY = section * SH;
 
-                for (int dy = 0; dy < h; ++dy)
-                    for (int dx = 0; dx < w; ++dx)
-                        mask[(y + dy) * S + (x + dx)] = BlockType::AIR;
+    // Occupancy rows of the section and the face rows derived from them, indexed [ly * S + z].
+    std::array<uint32_t, CHUNK_SECTION_HEIGHT * CHUNK_SIZE> rows;
+    std::array<uint32_t, CHUNK_SECTION_HEIGHT * CHUNK_SIZE> faces;
+    std::array<BlockType, CHUNK_SIZE * CHUNK_SIZE> mask;
 
-                float zz = m_Position.z + z + 0.5f;
-                float x0 = m_Position.x + x - 0.5f;
-                float x1 = m_Position.x + x + w - 0.5f;
-                float y0 = m_Position.y + y - 0.5f;
-                float y1 = m_Position.y + y + h - 0.5f;
+    for (int ly = 0; ly < SH; ++ly)
+        for (int z = 0; z < S; ++z)
+            rows[ly * S + z] = blocks.GetRow(ly, z);
 
-                glm::vec3 n(0.0f, 0.0f, 1.0f);
+    auto fillMask = [&](uint32_t bits, int maskRow, int y, int z) {
+        for (; bits; bits &= bits - 1)
+        {
+            const int x = CountTrailingZeros(bits);
+            mask[maskRow * S + x] = GetBlockFast(x, y, z);
+        }
+        };
 
-                glm::vec3 v0(x0, y0, zz);
-                glm::vec3 v1(x1, y0, zz);
-                glm::vec3 v2(x1, y1, zz);
-                glm::vec3 v3(x0, y1, zz);
+    // +Y / -Y: one layer at a time, rows are compared with the layer above / below.
+    for (int dir = 0; dir < 2; ++dir)
+    {
+        const int dy = dir == 0 ? 1 : -1;
 
-                pushQuad(v0, v1, v2, v3, n);
+        for (int ly = 0; ly < SH; ++ly)
+        {
+            const int y = baseY + ly;
 
-                x += w;
+            bool any = false;
+            mask.fill(BlockType::AIR);
+            for (int z = 0; z < S; ++z)
+            {
+                const uint32_t bits = rows[ly * S + z] & ~m_Blocks.GetRow(y + dy, z);
+                if (!bits) continue;
+                fillMask(bits, z, y, z);
+                any = true;
             }
-            y++;
+            if (!any) continue;
+
+            GreedyMerge(mask.data(), S, S, [&](int x, int z, int w, int h, BlockType type) {
+                if (dy > 0)
+                    pushQuad(2, type, { x, y + 1, z + h }, { x + w, y + 1, z + h }, { x + w, y + 1, z }, { x, y + 1, z }, w, h);
+                else
+                    pushQuad(3, type, { x, y, z }, { x + w, y, z }, { x + w, y, z + h }, { x, y, z + h }, w, h);
+                });
         }
     }
 
-    for (int z = 0; z < S; ++z)
+    // +X / -X: face rows within each (y, z) row, the border supplies the column across the chunk side.
+    for (int dir = 0; dir < 2; ++dir)
     {
-        for (int y = 0; y < H; ++y)
+        uint32_t anyFaces = 0;
+        for (int ly = 0; ly < SH; ++ly)
         {
-            for (int x = 0; x < S; ++x)
+            const int y = baseY + ly;
+            for (int z = 0; z < S; ++z)
             {
-                BlockType t = GetBlockFast(x, y, z).GetType();
-                bool solid = (t != BlockType::AIR);
-                bool neighborSolid = IsSolid(x, y, z - 1);
-
-                mask[y * S + x] = (solid && !neighborSolid) ? t : BlockType::AIR;
+                const uint32_t row = rows[ly * S + z];
+                uint32_t covered;
+                if (dir == 0)
+                    covered = (row >> 1) | (((border.posX[y] >> z) & 1u) << (S - 1));
+                else
+                    covered = (row << 1) | ((border.negX[y] >> z) & 1u);
+
+                faces[ly * S + z] = row & ~covered;
+                anyFaces |= faces[ly * S + z];
             }
         }
 
-        int y = 0;
-        while (y < H)
+        for (; anyFaces; anyFaces &= anyFaces - 1)
         {
-            int x = 0;
-            while (x < S)
-            {
-                BlockType t = mask[y * S + x];
-                if (t == BlockType::AIR) { x++; continue; }
-
-                int w = 1;
-                while (x + w < S && mask[y * S + (x + w)] == t) w++;
-
-                int h = 1;
-                bool stop = false;
-                while (y + h < H && !stop)
-                {
-                    for (int k = 0; k < w; ++k)
-                    {
-                        if (mask[(y + h) * S + (x + k)] != t)
-                        {
-                            stop = true; break;
-                        }
-                    }
-                    if (!stop) h++;
-                }
-
-                for (int dy = 0; dy < h; ++dy)
-                    for (int dx = 0; dx < w; ++dx)
-                        mask[(y + dy) * S + (x + dx)] = BlockType::AIR;
+            const int x = CountTrailingZeros(anyFaces);
+
+            mask.fill(BlockType::AIR);
+            for (int ly = 0; ly < SH; ++ly)
+                for (int z = 0; z < S; ++z)
+                    if ((faces[ly * S + z] >> x) & 1u)
+                        mask[ly * S + z] = GetBlockFast(x, baseY + ly, z);
+
+            GreedyMerge(mask.data(), S, SH, [&](int z, int ly, int w, int h, BlockType type) {
+                const int y = baseY + ly;
+
+                if (dir == 0)
+                    pushQuad(0, type, { x + 1, y, z + w }, { x + 1, y, z }, { x + 1, y + h, z }, { x + 1, y + h, z + w }, w, h);
+                else
+                    pushQuad(1, type, { x, y, z + w }, { x, y + h, z + w }, { x, y + h, z }, { x, y, z }, h, w);
+                });
+        }
+    }
 
-                float zz = m_Position.z + z - 0.5f;
-                float x0 = m_Position.x + x + w - 0.5f;
-                float x1 = m_Position.x + x - 0.5f;
-                float y0 = m_Position.y + y - 0.5f;
-                float y1 = m_Position.y + y + h - 0.5f;
+    // +Z / -Z: rows are compared with the next / previous row, or the border row on the chunk sides.
+    for (int dir = 0; dir < 2; ++dir)
+    {
+        const int dz = dir == 0 ? 1 : -1;
 
-                glm::vec3 n(0.0f, 0.0f, -1.0f);
+        for (int z = 0; z < S; ++z)
+        {
+            const int nz = z + dz;
 
-                glm::vec3 v0(x0, y0, zz);
-                glm::vec3 v1(x1, y0, zz);
-                glm::vec3 v2(x1, y1, zz);
-                glm::vec3 v3(x0, y1, zz);
+            bool any = false;
+            mask.fill(BlockType::AIR);
+            for (int ly = 0; ly < SH; ++ly)
+            {
+                const int y = baseY + ly;
+                const uint32_t row = rows[ly * S + z];
+                if (!row) continue;
+
+                uint32_t covered;
+                if (nz >= 0 && nz < S)
+                    covered = rows[ly * S + nz];
+                else
+                    covered = dz > 0 ? border.posZ[y] : border.negZ[y];
+
+                const uint32_t bits = row & ~covered;
+                if (!bits) continue;
+                fillMask(bits, ly, y, z);
+                any = true;
+            }
+            if (!any) continue;
 
-                pushQuad(v0, v1, v2, v3, n);
+            GreedyMerge(mask.data(), S, SH, [&](int x, int ly, int w, int h, BlockType type) {
+                const int y = baseY + ly;
 
-                x += w;
-            }
-            y++;
+                if (dz > 0)
+                    pushQuad(4, type, { x, y, z + 1 }, { x + w, y, z + 1 }, { x + w, y + h, z + 1 }, { x, y + h, z + 1 }, w, h);
+                else
+                    pushQuad(5, type, { x + w, y, z }, { x, y, z }, { x, y + h, z }, { x + w, y + h, z }, w, h);
+                });
         }
     }
 }
@@ -631,37 +576,12 @@ bool Chunk::IsMeshGenerated() const
 		return false;
 }
 
-inline int Chunk::ToIndex(int x, int y, int z) const
+inline bool Chunk::InBounds(const glm::ivec3& p) const
 {
-	return y * CHUNK_AREA + z * CHUNK_SIZE + x;
+	return p.x >= 0 && p.x < CHUNK_SIZE && p.y >= 0 && p.y < CHUNK_HEIGHT && p.z >= 0 && p.z < CHUNK_SIZE;
 }
 
-inline int Chunk::ToIndex(const glm::ivec3& p) const
+inline BlockType Chunk::GetBlockFast(int x, int y, int z) const
 {
-	return ToIndex(p.x, p.y, p.z);
+	return m_Blocks.Get(x, y, z);
 }
-
-inline const Block& Chunk::GetBlockFast(int x, int y, int z) const
-{
-	return m_Blocks[ToIndex(x, y, z)];
-}
-
-inline bool Chunk::IsSolid(int x, int y, int z) const
-{
-    if (x >= 0 && x < CHUNK_SIZE &&
-        y >= 0 && y < CHUNK_HEIGHT &&
-        z >= 0 && z < CHUNK_SIZE)
-    {
-        return GetBlockFast(x, y, z).GetType() != BlockType::AIR;
-    }
-
-    glm::ivec3 worldPos = m_Position + glm::ivec3(x, y, z);
-
-    ChunkManager* cm = ChunkManager::GetInstance();
-    if (!cm)
-        return false;
-
-    BlockType t = cm->GetBlockType(worldPos);
-
-    return t != BlockType::AIR && t != BlockType::BLOCK_ERROR;
-}
\ No newline at end of file
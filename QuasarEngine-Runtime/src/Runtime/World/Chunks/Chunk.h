@@ -4,18 +4,57 @@
 #include "../../World/Blocks/Block.h"
 #include "../../World/Blocks/BlockType.h"
 #include "../../Utils/Math.h"
+#include "ChunkStorage.h"
 
 #include <array>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include <QuasarEngine/Entity/Component.h>
 
+namespace QuasarEngine
+{
+    class MeshComponent;
+}
+
 class ChunkManager;
 class TerrainGenerator;
 
-class Chunk : public QuasarEngine::Component
+// One corner of a greedy meshed face, 8 bytes:
+//   position: x (6) | y (9) | z (6) | face (3) | corner (2), block corner coordinates inside the chunk
+//   face:     width (6) | height (6) | texture layer (8), extent along the texture u and v axes
+// Faces are +X, -X, +Y, -Y, +Z, -Z. Decoded by the voxel vertex shader or Chunk::UnpackVertices.
+struct ChunkVertex
+{
+    uint32_t position;
+    uint32_t face;
+
+    static ChunkVertex Pack(int x, int y, int z, int face, int corner, int width, int height, int layer)
+    {
+        return {
+            uint32_t(x) | uint32_t(y) << 6 | uint32_t(z) << 15 | uint32_t(face) << 21 | uint32_t(corner) << 24,
+            uint32_t(width) | uint32_t(height) << 6 | uint32_t(layer) << 12
+        };
+    }
+};
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+// Solid blocks just outside a chunk, copied from its four neighbours before meshing so the
+// mesher never reads another chunk. One row per layer: bit z on the X sides, bit x on the Z sides.
+struct ChunkBorder
+{
+    std::array<uint32_t, CHUNK_HEIGHT> posX;
+    std::array<uint32_t, CHUNK_HEIGHT> negX;
+    std::array<uint32_t, CHUNK_HEIGHT> posZ;
+    std::array<uint32_t, CHUNK_HEIGHT> negZ;
+};
+
+class Chunk : public QuasarEngine::EntityBoundComponent
 {
 public:
     Chunk(const glm::ivec3& position);
@@ -23,7 +62,7 @@ public:
     ~Chunk();
 
     void SetBlock(const glm::ivec3& pos, Block voxel);
-    const Block* GetBlock(const glm::ivec3& position) const;
+    std::optional<Block> GetBlock(const glm::ivec3& position) const;
     const BlockType GetBlockType(const glm::ivec3& position) const;
 
     void Generate(TerrainGenerator& generator);
@@ -40,20 +79,60 @@ public:
     void SetHeightTimerIncreasing(bool increasing);
     bool HeightTimerHitZero() const;
 
-    void SetBlocksFromExternal(const std::array<Block, CHUNK_VOLUME>& blocks, int maxHeight);
-    void BuildGreedyMeshData(std::vector<float>& outVertices, std::vector<unsigned int>& outIndices) const;
+    void SetBlocksFromExternal(ChunkStorage&& blocks, int maxHeight);
+    // False until the generated or loaded blocks arrived, edits made before would be overwritten.
+    bool HasBlocks() const { return m_HasBlocks; }
+    ChunkStorage CopyBlocks() const;
+
+    // Set when the blocks differ from the region file: freshly generated or edited since loaded.
+    bool IsUnsaved() const { return m_Unsaved; }
+    void SetUnsaved(bool unsaved) { m_Unsaved = unsaved; }
+
+    // Returns the revision of the built mesh, every build gets a higher one than the previous.
+    uint32_t BuildMeshData(const ChunkBorder& border, std::vector<ChunkVertex>& outVertices, std::vector<unsigned int>& outIndices) const;
+    void BuildGreedyMeshData(const ChunkBorder& border, std::vector<float>& outVertices, std::vector<unsigned int>& outIndices) const;
+
+    // Occupancy of the blocks on one side (face 0, 1, 4 or 5 as in ChunkVertex), in ChunkBorder row layout.
+    // Returns false, leaving rows untouched, while the chunk has no blocks yet.
+    bool CopySide(int face, std::array<uint32_t, CHUNK_HEIGHT>& rows) const;
+
+    // Uploads packed vertices, unpacked to position / normal / uv floats when the backend cannot draw them.
+    static void UploadMesh(QuasarEngine::MeshComponent& meshComp, const std::vector<ChunkVertex>& vertices, const std::vector<unsigned int>& indices);
+    static void UnpackVertices(const std::vector<ChunkVertex>& vertices, std::vector<float>& outVertices);
+
+    // Forces the section holding layer y (or every section) to be remeshed on the next build,
+    // used when a neighbouring chunk changed.
+    void InvalidateSection(int y);
+    void InvalidateMesh();
+
+    // Revision of the mesh on the GPU, main thread only. Results built before it are stale.
+    uint32_t GetUploadedRevision() const { return m_UploadedRevision; }
+    void SetUploadedRevision(uint32_t revision) { m_UploadedRevision = revision; }
+
+    std::size_t GetMemoryUsage() const;
 
 private:
-    std::array<Block, CHUNK_VOLUME> m_Blocks;
+    ChunkStorage m_Blocks;
+    // Meshing workers read the blocks while the main thread edits them.
+    std::unique_ptr<std::shared_mutex> m_BlocksMutex;
+
+    // Geometry is cached per section, a build only remeshes the sections touched since the last one.
+    mutable std::array<std::vector<ChunkVertex>, CHUNK_SECTION_COUNT> m_SectionVertices;
+    mutable std::array<bool, CHUNK_SECTION_COUNT> m_SectionDirty;
+    std::unique_ptr<std::mutex> m_MeshMutex;
+    mutable uint32_t m_MeshRevision = 0;
+    uint32_t m_UploadedRevision = 0;
 
     const glm::ivec3 m_Position;
     int m_MaxHeight;
     float m_HeightTimer;
     bool m_HeightTimerIncreasing;
+    bool m_Unsaved = false;
+    bool m_HasBlocks = false;
+
+    inline bool InBounds(const glm::ivec3& position) const;
 
-    inline int ToIndex(int x, int y, int z) const;
-    inline int ToIndex(const glm::ivec3& position) const;
+    void BuildSectionMesh(int section, const ChunkBorder& border, std::vector<ChunkVertex>& vertices) const;
 
-    inline const Block& GetBlockFast(int x, int y, int z) const;
-    inline bool IsSolid(int x, int y, int z) const;
+    inline BlockType GetBlockFast(int x, int y, int z) const;
 };
\ No newline at end of file
@@ -2,16 +2,55 @@
 
 #include <QuasarEngine/Renderer/Renderer.h>
 #include <QuasarEngine/Entity/Entity.h>
+#include <QuasarEngine/Entity/Components/TransformComponent.h>
 #include <QuasarEngine/Entity/Components/MeshComponent.h>
 #include <QuasarEngine/Entity/Components/MaterialComponent.h>
 #include <QuasarEngine/Entity/Components/MeshRendererComponent.h>
 #include <QuasarEngine/Resources/TextureArray.h>
+#include <QuasarEngine/Tools/Profiler.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	// Mesh uploads allowed per frame, the nearest finished mesh is always uploaded.
+	constexpr std::size_t kUploadBudgetBytes = 4 * 1024 * 1024;
+	constexpr double kUploadBudgetMs = 2.0;
+
+	// Generation jobs queued per worker, keeps the queue short enough to follow the player.
+	constexpr unsigned int kGenerationJobsPerThread = 2;
+
+	// Pending chunks are resorted when the camera turned by more than ~25 degrees.
+	constexpr float kResortDirectionCos = 0.9f;
+
+	// Mesh buffers kept for reuse once uploaded.
+	constexpr std::size_t kMaxFreeMeshResults = 16;
+
+	constexpr const char* kRegionDirectory = "Saves/World/Regions";
+
+	// Side neighbours with the ChunkVertex face pointing at them.
+	struct NeighborSide
+	{
+		glm::ivec3 offset;
+		int face;
+	};
+	constexpr NeighborSide kNeighborSides[4] = {
+		{ { CHUNK_SIZE, 0, 0 }, 0 },
+		{ { -CHUNK_SIZE, 0, 0 }, 1 },
+		{ { 0, 0, CHUNK_SIZE }, 4 },
+		{ { 0, 0, -CHUNK_SIZE }, 5 }
+	};
+}
 
 ChunkManager* ChunkManager::s_Instance = nullptr;
 
 ChunkManager::ChunkManager()
 	: m_GenerationPool(std::max(1u, std::thread::hardware_concurrency() / 2))
 	, m_MeshPool(std::max(1u, std::thread::hardware_concurrency() / 2))
+	, m_MaxGenerationInFlight(std::max(1u, std::thread::hardware_concurrency() / 2) * kGenerationJobsPerThread)
+	, m_Regions(kRegionDirectory)
+	, m_IOPool(1)
 {
 	s_Instance = this;
 
@@ -56,6 +95,11 @@ ChunkManager::ChunkManager()
 	m_BlockInfos[BlockType::LIBRARY_1] = BlockInfos({ 6, 6, 6, 6, 9, 9 }, true);
 	m_BlockInfos[BlockType::LIBRARY_2] = BlockInfos({ 6, 6, 6, 6, 10, 10 }, true);
 
+	// ChunkVertex faces are +X, -X, +Y, -Y, +Z, -Z.
+	static const int faceSlots[6] = { 3, 2, 0, 1, 4, 5 };
+	for (const auto& [type, infos] : m_BlockInfos)
+		for (int face = 0; face < 6; ++face)
+			m_FaceLayers[type][face] = static_cast<uint8_t>(infos.GetTexCoords()[faceSlots[face]]);
 
 	m_BiomeInfos[BiomeType::MONTAINS] = BiomeInfos(0.8f, 32.0f, 1.0f, 100, -0.2f);
 	m_BiomeInfos[BiomeType::PLAINS] = BiomeInfos(0.8f, 32.0f, 1.0f, 100, -0.6f);
@@ -80,62 +124,69 @@ ChunkManager::ChunkManager()
 	QuasarEngine::AssetManager::Instance().instLoadAsset("normal_textures", normalTextureArray);
 }
 
-void ChunkManager::SetBlock(const glm::ivec3& position, BlockType voxel)
+ChunkManager::~ChunkManager()
 {
-	auto chunkPos = Math::ToChunkPosition(position);
-	auto it = m_EntityMap.find(chunkPos);
-	if (it == m_EntityMap.end())
-		return;
+	if (auto* scene = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene)
+	{
+		auto& registry = scene->GetRegistry()->GetRegistry();
+		for (auto [e, chunk] : registry.view<Chunk>().each())
+		{
+			if (chunk.IsUnsaved())
+				SaveChunk(chunk, chunk.GetPosition());
+		}
+	}
 
-	auto entityOpt = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetEntityByUUID(it->second);
-	if (!entityOpt.has_value())
-		return;
+	// Loads still queued hand their misses to the generation pool, so it stops after.
+	m_IOPool.Shutdown();
+	m_GenerationPool.Shutdown();
+	m_MeshPool.Shutdown();
 
-	auto& entity = entityOpt.value();
-	auto& chunk = entity.GetComponent<Chunk>();
-	if (!chunk.IsMeshGenerated())
+	if (s_Instance == this)
+		s_Instance = nullptr;
+}
+
+void ChunkManager::SetBlock(const glm::ivec3& position, BlockType voxel)
+{
+	const glm::ivec3 chunkPos = Math::ToChunkPosition(position);
+	Chunk* chunk = GetChunk(chunkPos);
+	if (!chunk || !chunk->HasBlocks())
 		return;
 
-	chunk.SetBlock(glm::u8vec3(Math::ToBlockPosition(position)), Block(voxel));
-	chunk.GenerateMesh();
-	chunk.ClearMesh();
+	const glm::ivec3 blockPos = Math::ToBlockPosition(position);
+	chunk->SetBlock(blockPos, Block(voxel));
+	m_EditedChunks.insert(chunkPos);
 
-	auto updateNeighborChunk = [&](const glm::ivec3& neighborPos) {
-		auto neighborIt = m_EntityMap.find(Math::ToChunkPosition(neighborPos));
-		if (neighborIt == m_EntityMap.end())
-			return;
-		auto neighborOpt = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetEntityByUUID(neighborIt->second);
-		if (!neighborOpt.has_value())
+	// Only the section holding the block changes on the other side of a chunk border.
+	auto invalidateNeighbor = [&](const glm::ivec3& offset) {
+		Chunk* neighbor = GetChunk(chunkPos + offset);
+		if (!neighbor)
 			return;
-		auto& neighborEntity = neighborOpt.value();
-		auto& neighborChunk = neighborEntity.GetComponent<Chunk>();
-		neighborChunk.GenerateMesh();
-		neighborChunk.ClearMesh();
-		};
 
-	auto blockPos = Math::ToBlockPosition(position);
+		neighbor->InvalidateSection(position.y);
+		m_EditedChunks.insert(chunkPos + offset);
+		};
 
 	if (blockPos.z == 0)
-		updateNeighborChunk(position + glm::ivec3(0, 0, -CHUNK_SIZE));
+		invalidateNeighbor(glm::ivec3(0, 0, -CHUNK_SIZE));
 	else if (blockPos.z == CHUNK_SIZE - 1)
-		updateNeighborChunk(position + glm::ivec3(0, 0, CHUNK_SIZE));
+		invalidateNeighbor(glm::ivec3(0, 0, CHUNK_SIZE));
 
 	if (blockPos.x == 0)
-		updateNeighborChunk(position + glm::ivec3(-CHUNK_SIZE, 0, 0));
+		invalidateNeighbor(glm::ivec3(-CHUNK_SIZE, 0, 0));
 	else if (blockPos.x == CHUNK_SIZE - 1)
-		updateNeighborChunk(position + glm::ivec3(CHUNK_SIZE, 0, 0));
+		invalidateNeighbor(glm::ivec3(CHUNK_SIZE, 0, 0));
 }
 
-const Block* ChunkManager::GetBlock(const glm::ivec3& position)
+std::optional<Block> ChunkManager::GetBlock(const glm::ivec3& position)
 {
 	auto chunkPos = Math::ToChunkPosition(position);
 	auto it = m_EntityMap.find(chunkPos);
 	if (it == m_EntityMap.end())
-		return nullptr;
+		return std::nullopt;
 
 	auto entityOpt = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetEntityByUUID(it->second);
 	if (!entityOpt.has_value())
-		return nullptr;
+		return std::nullopt;
 
 	auto& entity = entityOpt.value();
 	auto& chunk = entity.GetComponent<Chunk>();
@@ -176,27 +227,105 @@ const Chunk* ChunkManager::GetChunk(const glm::ivec3& position) const
 	return &entityOpt.value().GetComponent<Chunk>();
 }
 
-void ChunkManager::UpdateChunks(const glm::ivec3& playerPos, float dt)
+void ChunkManager::UpdateChunks(const glm::ivec3& playerPos, const glm::vec3& viewDirection, float dt)
 {
-	ProcessGenerationResults();
-	ProcessMeshResults();
+	QE_PROFILE_FUNCTION();
 
 	glm::ivec3 playerChunkPos = Math::ToChunkPosition(playerPos);
+	if (!m_HasStreamCenter || playerChunkPos != m_StreamCenter)
+		UpdateStreamCenter(playerChunkPos);
+
+	ProcessEdits();
+	ProcessGenerationResults();
+	DispatchGeneration(viewDirection);
+	ProcessDeferredUnloads();
+}
+
+void ChunkManager::UpdateStreamCenter(const glm::ivec3& playerChunkPos)
+{
+	const bool first = !m_HasStreamCenter;
+	const glm::ivec3 previous = m_StreamCenter;
+
+	m_StreamCenter = playerChunkPos;
+	m_HasStreamCenter = true;
+	m_PendingSorted = false;
+
+	m_PendingChunks.erase(std::remove_if(m_PendingChunks.begin(), m_PendingChunks.end(),
+		[&](const glm::ivec3& pos) { return !ChunkInRange(playerChunkPos, pos); }), m_PendingChunks.end());
 
+	if (!first)
+		UnloadFarChunks(playerChunkPos);
+
+	// Only the chunks entering the range are new, everything else is loaded or pending already.
 	for (int dz = -RENDER_DISTANCE; dz <= RENDER_DISTANCE; ++dz)
 	{
 		for (int dx = -RENDER_DISTANCE; dx <= RENDER_DISTANCE; ++dx)
 		{
 			glm::ivec3 cpos = playerChunkPos + glm::ivec3(dx * CHUNK_SIZE, 0, dz * CHUNK_SIZE);
 
-			if (!ChunkInRange(playerChunkPos, cpos))
+			if (!first && ChunkInRange(previous, cpos))
 				continue;
 
-			RequestChunk(cpos);
+			m_PendingChunks.push_back(cpos);
+		}
+	}
+
+	// Unloaded, or the neighbour they waited for left the range.
+	for (auto it = m_AwaitingNeighbors.begin(); it != m_AwaitingNeighbors.end();)
+	{
+		if (m_EntityMap.find(*it) == m_EntityMap.end())
+		{
+			it = m_AwaitingNeighbors.erase(it);
+		}
+		else if (NeighborsReady(*it))
+		{
+			EnqueueMesh(*it);
+			it = m_AwaitingNeighbors.erase(it);
+		}
+		else
+		{
+			++it;
 		}
 	}
+}
 
-	UnloadFarChunks(playerChunkPos);
+float ChunkManager::GetStreamPriority(const glm::ivec3& chunkPos, const glm::vec3& viewDirection) const
+{
+	const glm::vec2 delta = glm::vec2(chunkPos.x - m_StreamCenter.x, chunkPos.z - m_StreamCenter.z) / float(CHUNK_SIZE);
+	const float distanceSq = glm::dot(delta, delta);
+	if (distanceSq == 0.0f)
+		return 0.0f;
+
+	// Chunks behind the camera weigh up to three times their distance.
+	const float facing = glm::dot(delta, glm::vec2(viewDirection.x, viewDirection.z)) / std::sqrt(distanceSq);
+	return distanceSq * (2.0f - facing);
+}
+
+void ChunkManager::DispatchGeneration(const glm::vec3& viewDirection)
+{
+	if (m_PendingChunks.empty())
+		return;
+
+	glm::vec3 direction = glm::vec3(viewDirection.x, 0.0f, viewDirection.z);
+	const float length = glm::length(direction);
+	direction = length > 1e-4f ? direction / length : glm::vec3(0.0f);
+
+	const bool turned = length > 1e-4f && glm::dot(direction, m_PendingSortDirection) < kResortDirectionCos;
+	if (!m_PendingSorted || turned)
+	{
+		std::sort(m_PendingChunks.begin(), m_PendingChunks.end(), [&](const glm::ivec3& a, const glm::ivec3& b) {
+			return GetStreamPriority(a, direction) > GetStreamPriority(b, direction);
+			});
+
+		m_PendingSorted = true;
+		m_PendingSortDirection = direction;
+	}
+
+	while (!m_PendingChunks.empty() && m_GenerationInFlight.load() < static_cast<int>(m_MaxGenerationInFlight))
+	{
+		RequestChunk(m_PendingChunks.back());
+		m_PendingChunks.pop_back();
+	}
 }
 
 void ChunkManager::RequestChunk(const glm::ivec3& chunkPos)
@@ -209,6 +338,9 @@ void ChunkManager::RequestChunk(const glm::ivec3& chunkPos)
 	std::string name = "Chunk_" + std::to_string(chunkPos.x) + "_" + std::to_string(chunkPos.y) + "_" + std::to_string(chunkPos.z);
 	QuasarEngine::Entity entity = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->CreateEntity(name);
 
+	// Chunk meshes are built in local space.
+	entity.GetComponent<QuasarEngine::TransformComponent>().SetPosition(glm::vec3(chunkPos));
+
 	entity.AddComponent<QuasarEngine::MeshComponent>();
 	QuasarEngine::MaterialSpecification spec;
 	spec.AlbedoTexture = "Assets/Textures/dark_grass_block_top.png";
@@ -220,17 +352,145 @@ void ChunkManager::RequestChunk(const glm::ivec3& chunkPos)
 
 	m_EntityMap.emplace(chunkPos, entity.GetUUID());
 
-	m_GenerationPool.Enqueue([this, chunkPos]() {
-		AsyncGenerateBlocks(chunkPos);
+	++m_GenerationInFlight;
+	m_IOPool.Enqueue([this, chunkPos]() {
+		AsyncLoadBlocks(chunkPos);
+		});
+}
+
+void ChunkManager::EnqueueMesh(const glm::ivec3& chunkPos, bool urgent)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
+		// A queued job has not read the blocks yet, it will pick this change up too.
+		auto [queued, inserted] = m_MeshQueued.try_emplace(chunkPos, urgent);
+		if (!inserted)
+		{
+			queued->second = queued->second || urgent;
+			return;
+		}
+	}
+
+	m_MeshPool.Enqueue([this, chunkPos]() {
+		AsyncGenerateMesh(chunkPos);
+		});
+}
+
+void ChunkManager::AsyncLoadBlocks(const glm::ivec3& chunkPos)
+{
+	QE_PROFILE_FUNCTION();
+
+	{
+		// The chunk left the range while the job was queued.
+		std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
+		if (m_EntityMap.find(chunkPos) == m_EntityMap.end())
+		{
+			--m_GenerationInFlight;
+			return;
+		}
+	}
+
+	ChunkBlocksResult result;
+	result.position = chunkPos;
+	result.maxHeight = 0;
+	result.fromDisk = true;
+
+	if (!m_Regions.Load(chunkPos, result.blocks, result.maxHeight))
+	{
+		// Never saved, or unreadable: generate it again.
+		m_GenerationPool.Enqueue([this, chunkPos]() {
+			AsyncGenerateBlocks(chunkPos);
+			--m_GenerationInFlight;
+			});
+		return;
+	}
+
+	++m_LoadedFromDisk;
+
+	{
+		std::lock_guard<std::mutex> lock(m_GenResultMutex);
+		m_GenResults.push(std::move(result));
+	}
+
+	--m_GenerationInFlight;
+}
+
+void ChunkManager::SaveChunk(const Chunk& chunk, const glm::ivec3& chunkPos)
+{
+	++m_PendingSaves;
+	m_IOPool.Enqueue([this, chunkPos, blocks = chunk.CopyBlocks(), maxHeight = chunk.GetMaxHeight()]() {
+		m_Regions.Save(chunkPos, blocks, maxHeight);
+		--m_PendingSaves;
 		});
 }
 
+ChunkBorder ChunkManager::GetBorder(const glm::ivec3& chunkPos) const
+{
+	ChunkBorder border;
+	std::array<uint32_t, CHUNK_HEIGHT>* sides[4] = { &border.posX, &border.negX, &border.posZ, &border.negZ };
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const Chunk* neighbor = GetChunk(chunkPos + kNeighborSides[i].offset);
+		if (!neighbor || !neighbor->CopySide(kNeighborSides[i].face ^ 1, *sides[i]))
+			sides[i]->fill(~0u);
+	}
+
+	return border;
+}
+
+bool ChunkManager::NeighborsReady(const glm::ivec3& chunkPos) const
+{
+	for (const NeighborSide& side : kNeighborSides)
+	{
+		const glm::ivec3 neighborPos = chunkPos + side.offset;
+		if (!ChunkInRange(m_StreamCenter, neighborPos))
+			continue;
+
+		const Chunk* neighbor = GetChunk(neighborPos);
+		if (!neighbor || !neighbor->HasBlocks())
+			return false;
+	}
+
+	return true;
+}
+
+void ChunkManager::MeshWhenNeighborsReady(const glm::ivec3& chunkPos)
+{
+	if (NeighborsReady(chunkPos))
+	{
+		m_AwaitingNeighbors.erase(chunkPos);
+		EnqueueMesh(chunkPos);
+	}
+	else
+	{
+		m_AwaitingNeighbors.insert(chunkPos);
+	}
+}
+
+void ChunkManager::ProcessEdits()
+{
+	// Every edit of the frame on a chunk shares one job, the mesh cache rebuilds only the dirty sections.
+	for (const glm::ivec3& chunkPos : m_EditedChunks)
+		EnqueueMesh(chunkPos, true);
+
+	m_EditedChunks.clear();
+}
+
 void ChunkManager::AsyncGenerateBlocks(const glm::ivec3& chunkPos)
 {
+	QE_PROFILE_FUNCTION();
+
+	{
+		// The chunk left the range while the job was queued.
+		std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
+		if (m_EntityMap.find(chunkPos) == m_EntityMap.end())
+			return;
+	}
+
 	ChunkBlocksResult result;
 	result.position = chunkPos;
 	result.maxHeight = 0;
-	result.blocks.fill(Block(BlockType::AIR));
 
 	int heightmap[CHUNK_SIZE][CHUNK_SIZE];
 	m_Generator->GenerateHeightmap(chunkPos, heightmap);
@@ -251,12 +511,14 @@ void ChunkManager::AsyncGenerateBlocks(const glm::ivec3& chunkPos)
 				else if (y < height - 1) type = BlockType::DIRT;
 				else                     type = BlockType::GRASS;
 
-				int idx = y * CHUNK_AREA + z * CHUNK_SIZE + x;
-				result.blocks[idx] = Block(type);
+				result.blocks.Set(x, y, z, type);
 			}
 		}
 	}
 
+	result.blocks.Optimize();
+	++m_GeneratedChunks;
+
 	{
 		std::lock_guard<std::mutex> lock(m_GenResultMutex);
 		m_GenResults.push(std::move(result));
@@ -265,6 +527,8 @@ void ChunkManager::AsyncGenerateBlocks(const glm::ivec3& chunkPos)
 
 void ChunkManager::ProcessGenerationResults()
 {
+	QE_PROFILE_FUNCTION();
+
 	std::queue<ChunkBlocksResult> localQueue;
 
 	{
@@ -288,41 +552,59 @@ void ChunkManager::ProcessGenerationResults()
 		auto& entity = entityOpt.value();
 		auto& chunk = entity.GetComponent<Chunk>();
 
-		chunk.SetBlocksFromExternal(res.blocks, res.maxHeight);
-
-		m_MeshPool.Enqueue([this, pos = res.position]() {
-			AsyncGenerateMesh(pos);
-			});
+		chunk.SetBlocksFromExternal(std::move(res.blocks), res.maxHeight);
+		chunk.SetUnsaved(!res.fromDisk);
 
-		std::array<glm::ivec3, 4> neighbors = {
-			res.position + glm::ivec3(CHUNK_SIZE, 0,          0),
-			res.position + glm::ivec3(-CHUNK_SIZE, 0,          0),
-			res.position + glm::ivec3(0,          0,  CHUNK_SIZE),
-			res.position + glm::ivec3(0,          0, -CHUNK_SIZE)
-		};
+		// Meshed once its neighbours have blocks too, so its sides are only built once.
+		MeshWhenNeighborsReady(res.position);
 
-		for (const auto& nPos : neighbors)
+		for (const NeighborSide& side : kNeighborSides)
 		{
-			std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
-			auto nit = m_EntityMap.find(nPos);
-			if (nit == m_EntityMap.end())
+			const glm::ivec3 nPos = res.position + side.offset;
+			Chunk* neighbor = GetChunk(nPos);
+			if (!neighbor || !neighbor->HasBlocks())
 				continue;
 
-			m_MeshPool.Enqueue([this, pos = nPos]() {
-				AsyncGenerateMesh(pos);
-				});
+			if (m_AwaitingNeighbors.count(nPos))
+			{
+				MeshWhenNeighborsReady(nPos);
+				continue;
+			}
+
+			// Its side toward this chunk was culled as if the chunk were solid.
+			neighbor->InvalidateMesh();
+			EnqueueMesh(nPos);
 		}
 	}
 }
 
 void ChunkManager::AsyncGenerateMesh(const glm::ivec3& chunkPos)
 {
+	QE_PROFILE_FUNCTION();
+
 	ChunkMeshResult result;
+	{
+		std::lock_guard<std::mutex> lock(m_MeshResultMutex);
+		if (!m_FreeMeshResults.empty())
+		{
+			result = std::move(m_FreeMeshResults.back());
+			m_FreeMeshResults.pop_back();
+		}
+	}
 	result.position = chunkPos;
+	result.urgent = false;
 
 	Chunk* chunk = nullptr;
+	ChunkBorder border;
 	{
 		std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
+		auto queued = m_MeshQueued.find(chunkPos);
+		if (queued != m_MeshQueued.end())
+		{
+			result.urgent = queued->second;
+			m_MeshQueued.erase(queued);
+		}
+
 		auto it = m_EntityMap.find(chunkPos);
 		if (it == m_EntityMap.end())
 			return;
@@ -332,9 +614,22 @@ void ChunkManager::AsyncGenerateMesh(const glm::ivec3& chunkPos)
 			return;
 
 		chunk = &entityOpt.value().GetComponent<Chunk>();
+		result.id = it->second;
+		++m_MeshingChunks[result.id];
+
+		// Neighbours are only unloaded under this lock, the copy is taken before any can go.
+		border = GetBorder(chunkPos);
 	}
 
-	chunk->BuildGreedyMeshData(result.vertices, result.indices);
+	result.revision = chunk->BuildMeshData(border, result.vertices, result.indices);
+	++m_MeshBuilds;
+
+	{
+		std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
+		auto busy = m_MeshingChunks.find(result.id);
+		if (--busy->second == 0)
+			m_MeshingChunks.erase(busy);
+	}
 
 	{
 		std::lock_guard<std::mutex> lock(m_MeshResultMutex);
@@ -342,48 +637,105 @@ void ChunkManager::AsyncGenerateMesh(const glm::ivec3& chunkPos)
 	}
 }
 
-void ChunkManager::ProcessMeshResults()
+void ChunkManager::UploadMeshes()
 {
-	std::queue<ChunkMeshResult> localQueue;
+	QE_PROFILE_FUNCTION();
+
 	{
 		std::lock_guard<std::mutex> lock(m_MeshResultMutex);
-		std::swap(localQueue, m_MeshResults);
+		while (!m_MeshResults.empty())
+		{
+			ChunkMeshResult res = std::move(m_MeshResults.front());
+			m_MeshResults.pop();
+
+			// A newer mesh of the same chunk replaces the one still waiting for upload.
+			// Workers can finish out of order, the revision tells which build is newer.
+			auto pending = std::find_if(m_PendingUploads.begin(), m_PendingUploads.end(),
+				[&](const ChunkMeshResult& other) { return other.position == res.position; });
+			if (pending == m_PendingUploads.end())
+			{
+				m_PendingUploads.push_back(std::move(res));
+			}
+			else if (pending->id != res.id || pending->revision < res.revision)
+			{
+				res.urgent = res.urgent || (pending->id == res.id && pending->urgent);
+				*pending = std::move(res);
+			}
+			else
+			{
+				pending->urgent = pending->urgent || res.urgent;
+			}
+		}
 	}
 
-	while (!localQueue.empty())
+	m_UploadedBytes = 0;
+	if (m_PendingUploads.empty())
+		return;
+
+	// Edits then nearest last, uploads are taken from the back.
+	auto distanceSq = [&](const glm::ivec3& pos) {
+		const glm::ivec3 delta = (pos - m_StreamCenter) / CHUNK_SIZE;
+		return delta.x * delta.x + delta.z * delta.z;
+		};
+	std::sort(m_PendingUploads.begin(), m_PendingUploads.end(), [&](const ChunkMeshResult& a, const ChunkMeshResult& b) {
+		if (a.urgent != b.urgent)
+			return b.urgent;
+		return distanceSq(a.position) > distanceSq(b.position);
+		});
+
+	const auto start = std::chrono::steady_clock::now();
+
+	while (!m_PendingUploads.empty())
 	{
-		ChunkMeshResult res = std::move(localQueue.front());
-		localQueue.pop();
+		ChunkMeshResult& res = m_PendingUploads.back();
+		const std::size_t bytes = res.vertices.size() * sizeof(ChunkVertex) + res.indices.size() * sizeof(unsigned int);
+
+		if (m_UploadedBytes > 0 && !res.urgent)
+		{
+			const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (m_UploadedBytes + bytes > kUploadBudgetBytes || elapsedMs > kUploadBudgetMs)
+				break;
+		}
 
+		// Dropped if the chunk was unloaded, or unloaded and streamed in again since the job started.
 		auto it = m_EntityMap.find(res.position);
-		if (it == m_EntityMap.end())
-			continue;
+		auto entityOpt = it != m_EntityMap.end() && it->second == res.id
+			? QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetEntityByUUID(it->second)
+			: std::nullopt;
 
-		auto entityOpt = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetEntityByUUID(it->second);
-		if (!entityOpt.has_value())
-			continue;
+		// The previous mesh stays drawn until this one replaces it.
+		Chunk* chunk = entityOpt.has_value() ? &entityOpt.value().GetComponent<Chunk>() : nullptr;
+		if (chunk && res.revision > chunk->GetUploadedRevision())
+		{
+			auto& meshComp = entityOpt.value().GetComponent<QuasarEngine::MeshComponent>();
 
-		auto& entity = entityOpt.value();
-		auto& meshComp = entity.GetComponent<QuasarEngine::MeshComponent>();
+			if (res.vertices.empty() || res.indices.empty())
+			{
+				meshComp.ClearMesh();
+			}
+			else
+			{
+				Chunk::UploadMesh(meshComp, res.vertices, res.indices);
+				m_UploadedBytes += bytes;
+			}
 
-		if (res.vertices.empty() || res.indices.empty())
-		{
-			meshComp.ClearMesh();
-			continue;
+			chunk->SetUploadedRevision(res.revision);
 		}
 
-		QuasarEngine::BufferLayout layout = {
-			{ QuasarEngine::ShaderDataType::Vec3,  "vPosition" },
-			{ QuasarEngine::ShaderDataType::Vec3,  "vNormal" },
-			{ QuasarEngine::ShaderDataType::Vec2,  "vTextureCoordinates" }
-		};
+		{
+			std::lock_guard<std::mutex> lock(m_MeshResultMutex);
+			if (m_FreeMeshResults.size() < kMaxFreeMeshResults)
+				m_FreeMeshResults.push_back(std::move(res));
+		}
 
-		meshComp.GenerateMesh(res.vertices, res.indices, layout);
+		m_PendingUploads.pop_back();
 	}
 }
 
 void ChunkManager::UnloadFarChunks(const glm::ivec3& playerChunkPos)
 {
+	QE_PROFILE_FUNCTION();
+
 	std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
 
 	for (auto it = m_EntityMap.begin(); it != m_EntityMap.end();)
@@ -393,8 +745,17 @@ void ChunkManager::UnloadFarChunks(const glm::ivec3& playerChunkPos)
 			auto entityOpt = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetEntityByUUID(it->second);
 			if (entityOpt.has_value())
 			{
-				QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->DestroyEntity(entityOpt.value().GetUUID());
+				const Chunk& chunk = entityOpt.value().GetComponent<Chunk>();
+				if (chunk.IsUnsaved())
+					SaveChunk(chunk, it->first);
 			}
+
+			if (m_MeshingChunks.count(it->second))
+				m_DeferredUnloads.push_back(it->second);
+			else
+				QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->DestroyEntity(it->second);
+
+			m_MeshQueued.erase(it->first);
 			it = m_EntityMap.erase(it);
 		}
 		else
@@ -404,6 +765,22 @@ void ChunkManager::UnloadFarChunks(const glm::ivec3& playerChunkPos)
 	}
 }
 
+void ChunkManager::ProcessDeferredUnloads()
+{
+	if (m_DeferredUnloads.empty())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_ChunkMapMutex);
+
+	m_DeferredUnloads.erase(std::remove_if(m_DeferredUnloads.begin(), m_DeferredUnloads.end(), [&](const QuasarEngine::UUID& id) {
+		if (m_MeshingChunks.count(id))
+			return false;
+
+		QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->DestroyEntity(id);
+		return true;
+		}), m_DeferredUnloads.end());
+}
+
 bool ChunkManager::ChunkInRange(const glm::ivec3& playerChunkPos, const glm::ivec3& chunkPos) const
 {
 	glm::ivec3 delta = (chunkPos - playerChunkPos) / CHUNK_SIZE;
@@ -425,4 +802,32 @@ BiomeInfos& ChunkManager::GetBiomeInfos(const BiomeType& type)
 bool ChunkManager::IsTransparent(const glm::ivec3& position)
 {
 	return m_BlockInfos[GetBlockType(position)].IsTransparent();
+}
+
+ChunkManager::Stats ChunkManager::GetStats() const
+{
+	Stats stats;
+
+	auto& registry = QuasarEngine::Renderer::Instance().m_SceneData.m_Scene->GetRegistry()->GetRegistry();
+	for (auto [e, chunk] : registry.view<Chunk>().each())
+	{
+		++stats.loadedChunks;
+		stats.blockMemory += chunk.GetMemoryUsage();
+
+		if (auto* meshComp = registry.try_get<QuasarEngine::MeshComponent>(e); meshComp && meshComp->HasMesh())
+		{
+			stats.meshMemory += meshComp->GetMesh().GetGPUMemoryUsage();
+			stats.triangles += meshComp->GetMesh().GetIndicesCount() / 3;
+		}
+	}
+
+	stats.pendingChunks = static_cast<uint32_t>(m_PendingChunks.size());
+	stats.pendingUploads = static_cast<uint32_t>(m_PendingUploads.size());
+	stats.uploadedBytes = m_UploadedBytes;
+	stats.loadedFromDisk = m_LoadedFromDisk.load();
+	stats.generatedChunks = m_GeneratedChunks.load();
+	stats.pendingSaves = static_cast<uint32_t>(m_PendingSaves.load());
+	stats.meshBuilds = m_MeshBuilds.load();
+
+	return stats;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Chunk.h"
 #include "ChunkMapping.h"
+#include "RegionFile.h"
 
 #include "../Generation/TerrainGenerator.h"
 #include "../../Utils/Math.h"
@@ -13,6 +14,7 @@
 #include <QuasarEngine/Core/UUID.h>
 
 #include <unordered_map>
+#include <unordered_set>
 #include <queue>
 #include <mutex>
 #include <atomic>
@@ -20,14 +22,19 @@
 struct ChunkBlocksResult
 {
 	glm::ivec3 position;
-	std::array<Block, CHUNK_VOLUME> blocks;
+	ChunkStorage blocks;
 	int maxHeight;
+	bool fromDisk = false;
 };
 
 struct ChunkMeshResult
 {
 	glm::ivec3 position;
-	std::vector<float> vertices;
+	QuasarEngine::UUID id = QuasarEngine::UUID::Null();
+	uint32_t revision = 0;
+	// Block edit: uploaded first and outside the per-frame budget.
+	bool urgent = false;
+	std::vector<ChunkVertex> vertices;
 	std::vector<unsigned int> indices;
 };
 
@@ -35,23 +42,53 @@ class ChunkManager
 {
 public:
     ChunkManager();
-    ~ChunkManager() = default;
+    // Saves the chunks still unsaved and waits for the pending writes.
+    ~ChunkManager();
 
     static ChunkManager* GetInstance() { return s_Instance; }
 
     void SetBlock(const glm::ivec3& position, BlockType voxel);
-    const Block* GetBlock(const glm::ivec3& position);
+    std::optional<Block> GetBlock(const glm::ivec3& position);
     const BlockType GetBlockType(const glm::ivec3& position);
 
     Chunk* GetChunk(const glm::ivec3& position);
     const Chunk* GetChunk(const glm::ivec3& position) const;
 
-    void UpdateChunks(const glm::ivec3& playerPos, float dt);
+    // Streams the chunks around the player, nearest and in front of the camera first.
+    void UpdateChunks(const glm::ivec3& playerPos, const glm::vec3& viewDirection, float dt);
+
+    // Swaps in the meshes finished by the workers, within the upload budget. Main thread with
+    // no update running: a replaced mesh may be the one the renderer is drawing.
+    void UploadMeshes();
 
     BlockInfos& GetBlockInfos(const BlockType& type);
     BiomeInfos& GetBiomeInfos(const BiomeType& type);
     bool IsTransparent(const glm::ivec3& position);
 
+    // Border rows of a chunk from its four neighbours. Missing neighbours, or ones still without
+    // blocks, read as solid: the faces toward them are built once they arrive.
+    // Main thread, or a mesh worker holding m_ChunkMapMutex.
+    ChunkBorder GetBorder(const glm::ivec3& chunkPos) const;
+
+    // Texture layer of a block face (ChunkVertex face order), read-only so mesh workers can use it.
+    uint8_t GetFaceLayer(BlockType type, int face) const { return m_FaceLayers[type][face]; }
+
+    struct Stats
+    {
+        uint32_t loadedChunks = 0;
+        std::size_t blockMemory = 0;
+        uint32_t pendingChunks = 0;
+        uint32_t pendingUploads = 0;
+        std::size_t uploadedBytes = 0;
+        std::size_t meshMemory = 0;
+        uint32_t loadedFromDisk = 0;
+        uint32_t generatedChunks = 0;
+        uint32_t pendingSaves = 0;
+        std::size_t triangles = 0;
+        uint32_t meshBuilds = 0;
+    };
+    Stats GetStats() const;
+
 private:
     static ChunkManager* s_Instance;
 
@@ -61,6 +98,7 @@ private:
 
     std::unordered_map<BlockType, BlockInfos> m_BlockInfos;
     std::unordered_map<BiomeType, BiomeInfos> m_BiomeInfos;
+    std::array<std::array<uint8_t, 6>, BlockType::BLOCK_ERROR + 1> m_FaceLayers{};
 
     std::unique_ptr<TerrainGenerator> m_Generator;
 
@@ -72,17 +110,66 @@ private:
 
     std::mutex m_MeshResultMutex;
     std::queue<ChunkMeshResult> m_MeshResults;
+    // Uploaded results whose buffers the mesh workers reuse, guarded by m_MeshResultMutex.
+    std::vector<ChunkMeshResult> m_FreeMeshResults;
 
     std::mutex m_ChunkMapMutex;
 
+    // Streaming state, owned by the main thread unless noted.
+    glm::ivec3 m_StreamCenter = glm::ivec3(0);
+    bool m_HasStreamCenter = false;
+
+    // In range but not created yet, sorted so the most urgent chunk is at the back.
+    std::vector<glm::ivec3> m_PendingChunks;
+    bool m_PendingSorted = false;
+    glm::vec3 m_PendingSortDirection = glm::vec3(0.0f);
+
+    unsigned int m_MaxGenerationInFlight;
+    std::atomic<int> m_GenerationInFlight{ 0 };
+
+    // Guarded by m_ChunkMapMutex: chunks with a mesh job queued (and whether it is urgent), and chunks a worker is meshing.
+    std::unordered_map<glm::ivec3, bool, ChunkMapping, ChunkMapping> m_MeshQueued;
+    std::unordered_map<QuasarEngine::UUID, int> m_MeshingChunks;
+
+    // Out of range chunks still read by a mesh worker, destroyed once it is done.
+    std::vector<QuasarEngine::UUID> m_DeferredUnloads;
+
+    // Chunks with blocks waiting for a neighbour in range to get its own before the first mesh.
+    std::unordered_set<glm::ivec3, ChunkMapping, ChunkMapping> m_AwaitingNeighbors;
+    std::atomic<uint32_t> m_MeshBuilds{ 0 };
+
+    // Chunks touched by SetBlock this frame, remeshed together in ProcessEdits.
+    std::unordered_set<glm::ivec3, ChunkMapping, ChunkMapping> m_EditedChunks;
+
+    std::vector<ChunkMeshResult> m_PendingUploads;
+    std::size_t m_UploadedBytes = 0;
+
+    std::atomic<uint32_t> m_LoadedFromDisk{ 0 };
+    std::atomic<uint32_t> m_GeneratedChunks{ 0 };
+    std::atomic<int> m_PendingSaves{ 0 };
+
+    // Only used from m_IOPool, its single thread keeps a save ordered before any later load of the chunk.
+    RegionStorage m_Regions;
+    QuasarEngine::ThreadPool m_IOPool;
+
 private:
+    void UpdateStreamCenter(const glm::ivec3& playerChunkPos);
+    void DispatchGeneration(const glm::vec3& viewDirection);
+    float GetStreamPriority(const glm::ivec3& chunkPos, const glm::vec3& viewDirection) const;
+
     void RequestChunk(const glm::ivec3& chunkPos);
+    void EnqueueMesh(const glm::ivec3& chunkPos, bool urgent = false);
+    bool NeighborsReady(const glm::ivec3& chunkPos) const;
+    void MeshWhenNeighborsReady(const glm::ivec3& chunkPos);
     void UnloadFarChunks(const glm::ivec3& playerChunkPos);
+    void ProcessDeferredUnloads();
 
+    void ProcessEdits();
     void ProcessGenerationResults();
-    void ProcessMeshResults();
 
+    void AsyncLoadBlocks(const glm::ivec3& chunkPos);
     void AsyncGenerateBlocks(const glm::ivec3& chunkPos);
+    void SaveChunk(const Chunk& chunk, const glm::ivec3& chunkPos);
     void AsyncGenerateMesh(const glm::ivec3& chunkPos);
 
     bool ChunkInRange(const glm::ivec3& playerChunkPos, const glm::ivec3& chunkPos) const;
@@ -0,0 +1,241 @@
+#include "ChunkStorage.h"
+
+#include <cstring>
+
+ChunkSection::ChunkSection() : m_Palette{ BlockType::AIR }, m_Bits(0), m_SolidCount(0)
+{
+}
+
+void ChunkSection::Set(int index, BlockType type)
+{
+	uint32_t paletteIndex = 0;
+	while (paletteIndex < m_Palette.size() && m_Palette[paletteIndex] != type)
+		++paletteIndex;
+
+	if (paletteIndex == m_Palette.size())
+	{
+		m_Palette.push_back(type);
+
+		const int bits = BitsForPaletteSize(m_Palette.size());
+		if (bits != m_Bits)
+			Repack(bits, nullptr);
+	}
+
+	if (m_Bits == 0)
+		return;
+
+	const bool wasSolid = m_Palette[GetRaw(index)] != BlockType::AIR;
+	const bool solid = type != BlockType::AIR;
+	SetRaw(index, paletteIndex);
+
+	if (wasSolid != solid)
+	{
+		const uint32_t bit = 1u << (index % CHUNK_SIZE);
+		uint32_t& row = m_Occupancy[index / CHUNK_SIZE];
+		row = solid ? (row | bit) : (row & ~bit);
+		m_SolidCount += solid ? 1 : -1;
+	}
+}
+
+void ChunkSection::Fill(BlockType type)
+{
+	m_Palette.assign(1, type);
+	m_Data.clear();
+	m_Data.shrink_to_fit();
+	m_Occupancy.clear();
+	m_Occupancy.shrink_to_fit();
+	m_Bits = 0;
+	m_SolidCount = type == BlockType::AIR ? 0 : CHUNK_SECTION_VOLUME;
+}
+
+void ChunkSection::Optimize()
+{
+	if (m_Bits == 0)
+		return;
+
+	std::array<uint32_t, 256> counts{};
+	for (int i = 0; i < CHUNK_SECTION_VOLUME; ++i)
+		++counts[GetRaw(i)];
+
+	std::array<uint8_t, 256> remap{};
+	std::vector<BlockType> palette;
+	for (std::size_t i = 0; i < m_Palette.size(); ++i)
+	{
+		if (counts[i] == 0)
+			continue;
+
+		remap[i] = static_cast<uint8_t>(palette.size());
+		palette.push_back(m_Palette[i]);
+	}
+
+	if (palette.size() == m_Palette.size())
+		return;
+
+	if (palette.size() == 1)
+	{
+		Fill(palette[0]);
+		return;
+	}
+
+	Repack(BitsForPaletteSize(palette.size()), remap.data());
+	m_Palette = std::move(palette);
+}
+
+std::size_t ChunkSection::GetMemoryUsage() const
+{
+	return sizeof(ChunkSection) + m_Palette.capacity() * sizeof(BlockType) + m_Data.capacity() * sizeof(uint64_t)
+		+ m_Occupancy.capacity() * sizeof(uint32_t);
+}
+
+void ChunkSection::Write(std::vector<char>& out) const
+{
+	out.push_back(static_cast<char>(m_Palette.size() - 1));
+	for (BlockType type : m_Palette)
+		out.push_back(static_cast<char>(type));
+
+	const std::size_t bytes = m_Data.size() * sizeof(uint64_t);
+	const std::size_t offset = out.size();
+	out.resize(offset + bytes);
+	if (bytes > 0)
+		std::memcpy(out.data() + offset, m_Data.data(), bytes);
+}
+
+bool ChunkSection::Read(const char*& data, const char* end)
+{
+	if (data >= end)
+		return false;
+
+	const std::size_t paletteSize = static_cast<uint8_t>(*data++) + std::size_t(1);
+	if (static_cast<std::size_t>(end - data) < paletteSize)
+		return false;
+
+	std::vector<BlockType> palette(paletteSize);
+	for (auto& type : palette)
+	{
+		type = static_cast<BlockType>(static_cast<uint8_t>(*data++));
+		if (type > BlockType::BLOCK_ERROR)
+			return false;
+	}
+
+	if (paletteSize == 1)
+	{
+		Fill(palette[0]);
+		return true;
+	}
+
+	// Set and Optimize keep the width at BitsForPaletteSize of the palette, so it is not stored.
+	const int bits = BitsForPaletteSize(paletteSize);
+	const std::size_t words = static_cast<std::size_t>(CHUNK_SECTION_VOLUME) * bits / 64;
+	if (static_cast<std::size_t>(end - data) < words * sizeof(uint64_t))
+		return false;
+
+	m_Palette = std::move(palette);
+	m_Bits = bits;
+	m_Data.resize(words);
+	std::memcpy(m_Data.data(), data, words * sizeof(uint64_t));
+	data += words * sizeof(uint64_t);
+
+	return RebuildOccupancy();
+}
+
+bool ChunkSection::RebuildOccupancy()
+{
+	m_Occupancy.assign(CHUNK_SECTION_VOLUME / CHUNK_SIZE, 0u);
+	m_SolidCount = 0;
+
+	for (int i = 0; i < CHUNK_SECTION_VOLUME; ++i)
+	{
+		const uint32_t raw = GetRaw(i);
+		if (raw >= m_Palette.size())
+		{
+			Fill(BlockType::AIR);
+			return false;
+		}
+
+		if (m_Palette[raw] != BlockType::AIR)
+		{
+			m_Occupancy[i / CHUNK_SIZE] |= 1u << (i % CHUNK_SIZE);
+			++m_SolidCount;
+		}
+	}
+
+	return true;
+}
+
+void ChunkSection::SetRaw(int index, uint32_t value)
+{
+	const uint32_t bit = static_cast<uint32_t>(index) * static_cast<uint32_t>(m_Bits);
+	const uint64_t mask = ((uint64_t(1) << m_Bits) - 1) << (bit & 63);
+
+	uint64_t& word = m_Data[bit >> 6];
+	word = (word & ~mask) | (uint64_t(value) << (bit & 63));
+}
+
+void ChunkSection::Repack(int bits, const uint8_t* remap)
+{
+	if (m_Bits == 0)
+		m_Occupancy.assign(CHUNK_SECTION_VOLUME / CHUNK_SIZE, m_Palette[0] == BlockType::AIR ? 0u : ~0u);
+
+	std::vector<uint64_t> data(static_cast<std::size_t>(CHUNK_SECTION_VOLUME) * bits / 64, 0);
+
+	for (int i = 0; i < CHUNK_SECTION_VOLUME; ++i)
+	{
+		uint32_t value = m_Bits ? GetRaw(i) : 0u;
+		if (remap)
+			value = remap[value];
+
+		const uint32_t bit = static_cast<uint32_t>(i) * static_cast<uint32_t>(bits);
+		data[bit >> 6] |= uint64_t(value) << (bit & 63);
+	}
+
+	m_Data = std::move(data);
+	m_Bits = bits;
+}
+
+int ChunkSection::BitsForPaletteSize(std::size_t size)
+{
+	// Power-of-two widths so an entry never straddles two words.
+	if (size <= 1) return 0;
+	if (size <= 2) return 1;
+	if (size <= 4) return 2;
+	if (size <= 16) return 4;
+	return 8;
+}
+
+void ChunkStorage::Fill(BlockType type)
+{
+	for (auto& section : m_Sections)
+		section.Fill(type);
+}
+
+void ChunkStorage::Optimize()
+{
+	for (auto& section : m_Sections)
+		section.Optimize();
+}
+
+std::size_t ChunkStorage::GetMemoryUsage() const
+{
+	std::size_t bytes = 0;
+	for (const auto& section : m_Sections)
+		bytes += section.GetMemoryUsage();
+	return bytes;
+}
+
+void ChunkStorage::Write(std::vector<char>& out) const
+{
+	for (const auto& section : m_Sections)
+		section.Write(out);
+}
+
+bool ChunkStorage::Read(const char* data, std::size_t size)
+{
+	const char* end = data + size;
+	for (auto& section : m_Sections)
+	{
+		if (!section.Read(data, end))
+			return false;
+	}
+
+	return data == end;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../Constants.h"
+#include "../Blocks/BlockType.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+static_assert(CHUNK_SIZE == 32, "Occupancy rows are stored as 32-bit masks");
+
+// One CHUNK_SIZE x CHUNK_SECTION_HEIGHT x CHUNK_SIZE slice of a chunk.
+// Blocks are indices into a small palette, bit-packed with the fewest bits able to
+// address it. A section with a single palette entry stores no block data at all.
+// Mixed sections also keep one occupancy row per (y, z): bit x is set for solid blocks.
+class ChunkSection
+{
+public:
+    ChunkSection();
+
+    BlockType Get(int index) const
+    {
+        if (m_Bits == 0)
+            return m_Palette[0];
+
+        return m_Palette[GetRaw(index)];
+    }
+
+    void Set(int index, BlockType type);
+    void Fill(BlockType type);
+
+    // Drops palette entries that are no longer referenced and repacks with the smallest width.
+    void Optimize();
+
+    bool IsUniform() const { return m_Bits == 0; }
+    BlockType GetUniformType() const { return m_Palette[0]; }
+
+    bool IsEmpty() const { return m_SolidCount == 0; }
+    bool IsFull() const { return m_SolidCount == CHUNK_SECTION_VOLUME; }
+
+    uint32_t GetRow(int y, int z) const
+    {
+        if (m_Bits == 0)
+            return m_Palette[0] == BlockType::AIR ? 0u : ~0u;
+
+        return m_Occupancy[y * CHUNK_SIZE + z];
+    }
+
+    int GetBitsPerBlock() const { return m_Bits; }
+    std::size_t GetMemoryUsage() const;
+
+    // Palette then packed data, occupancy is rebuilt on load. Read returns false on malformed input.
+    void Write(std::vector<char>& out) const;
+    bool Read(const char*& data, const char* end);
+
+    static int ToIndex(int x, int y, int z) { return y * CHUNK_AREA + z * CHUNK_SIZE + x; }
+
+private:
+    uint32_t GetRaw(int index) const
+    {
+        const uint32_t bit = static_cast<uint32_t>(index) * static_cast<uint32_t>(m_Bits);
+        return static_cast<uint32_t>(m_Data[bit >> 6] >> (bit & 63)) & ((1u << m_Bits) - 1u);
+    }
+
+    void SetRaw(int index, uint32_t value);
+    void Repack(int bits, const uint8_t* remap);
+    bool RebuildOccupancy();
+
+    static int BitsForPaletteSize(std::size_t size);
+
+    std::vector<BlockType> m_Palette;
+    std::vector<uint64_t> m_Data;
+    std::vector<uint32_t> m_Occupancy;
+    int m_Bits = 0;
+    int m_SolidCount = 0;
+};
+
+// Block storage of a whole chunk column, one paletted section per CHUNK_SECTION_HEIGHT layers.
+class ChunkStorage
+{
+public:
+    BlockType Get(int x, int y, int z) const
+    {
+        return m_Sections[y / CHUNK_SECTION_HEIGHT].Get(ChunkSection::ToIndex(x, y % CHUNK_SECTION_HEIGHT, z));
+    }
+
+    void Set(int x, int y, int z, BlockType type)
+    {
+        m_Sections[y / CHUNK_SECTION_HEIGHT].Set(ChunkSection::ToIndex(x, y % CHUNK_SECTION_HEIGHT, z), type);
+    }
+
+    void Fill(BlockType type);
+    void Optimize();
+
+    // Occupancy row of layer y, 0 above and below the column.
+    uint32_t GetRow(int y, int z) const
+    {
+        if (y < 0 || y >= CHUNK_HEIGHT)
+            return 0u;
+
+        return m_Sections[y / CHUNK_SECTION_HEIGHT].GetRow(y % CHUNK_SECTION_HEIGHT, z);
+    }
+
+    const ChunkSection& GetSection(int section) const { return m_Sections[section]; }
+
+    std::size_t GetMemoryUsage() const;
+
+    void Write(std::vector<char>& out) const;
+    bool Read(const char* data, std::size_t size);
+
+private:
+    std::array<ChunkSection, CHUNK_SECTION_COUNT> m_Sections;
+};
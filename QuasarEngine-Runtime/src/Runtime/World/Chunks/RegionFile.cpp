@@ -0,0 +1,300 @@
+#include "RegionFile.h"
+
+#include <QuasarEngine/Core/Logger.h>
+#include <QuasarEngine/Tools/Utils.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	constexpr char kRegionMagic[4] = { 'Q', 'R', 'E', 'G' };
+	constexpr uint32_t kRegionVersion = 1;
+
+	constexpr uint32_t kSectorSize = 512;
+	constexpr uint32_t kTableOffset = sizeof(kRegionMagic) + sizeof(uint32_t);
+	constexpr uint32_t kHeaderSize = kTableOffset + REGION_CHUNK_COUNT * 2 * sizeof(uint32_t);
+
+	// Region files kept open, the oldest ones are closed past this.
+	constexpr std::size_t kMaxOpenRegions = 16;
+
+	int FloorDiv(int value, int divisor)
+	{
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+}
+
+uint32_t RegionFile::SectorAlign(uint32_t bytes)
+{
+	return (bytes + kSectorSize - 1) / kSectorSize * kSectorSize;
+}
+
+bool RegionFile::Open(const std::filesystem::path& path, bool create)
+{
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec))
+	{
+		if (!create)
+			return false;
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+
+		out.write(kRegionMagic, sizeof(kRegionMagic));
+		out.write(reinterpret_cast<const char*>(&kRegionVersion), sizeof(kRegionVersion));
+
+		const std::vector<char> table(kHeaderSize - kTableOffset, 0);
+		out.write(table.data(), table.size());
+		if (!out)
+			return false;
+	}
+
+	m_File.open(path, std::ios::binary | std::ios::in | std::ios::out);
+	if (!m_File)
+		return false;
+
+	char magic[sizeof(kRegionMagic)];
+	uint32_t version = 0;
+	m_File.read(magic, sizeof(magic));
+	m_File.read(reinterpret_cast<char*>(&version), sizeof(version));
+	m_File.read(reinterpret_cast<char*>(m_Table.data()), sizeof(Entry) * m_Table.size());
+	if (!m_File || std::memcmp(magic, kRegionMagic, sizeof(magic)) != 0 || version != kRegionVersion)
+	{
+		m_File.close();
+		return false;
+	}
+
+	const auto fileSize = static_cast<uint64_t>(std::filesystem::file_size(path, ec));
+
+	// Entries pointing outside the file (interrupted write) read as missing chunks.
+	m_Sectors.assign(SectorAlign(kHeaderSize) / kSectorSize, 1);
+	for (Entry& entry : m_Table)
+	{
+		if (entry.size == 0)
+			continue;
+
+		if (ec || entry.offset < SectorAlign(kHeaderSize) || entry.offset % kSectorSize != 0
+			|| uint64_t(entry.offset) + entry.size > fileSize)
+		{
+			entry = Entry{};
+			continue;
+		}
+
+		MarkSectors(entry, 1);
+	}
+
+	return true;
+}
+
+uint32_t RegionFile::Allocate(uint32_t bytes)
+{
+	const size_t count = SectorAlign(bytes) / kSectorSize;
+
+	size_t run = 0;
+	for (size_t i = 0; i < m_Sectors.size(); ++i)
+	{
+		run = m_Sectors[i] ? 0 : run + 1;
+		if (run == count)
+			return static_cast<uint32_t>((i + 1 - count) * kSectorSize);
+	}
+
+	// The free run at the tail, if any, is extended.
+	const size_t start = m_Sectors.size() - run;
+	m_Sectors.resize(start + count, 0);
+	return static_cast<uint32_t>(start * kSectorSize);
+}
+
+void RegionFile::MarkSectors(const Entry& entry, uint8_t used)
+{
+	const size_t first = entry.offset / kSectorSize;
+	const size_t last = first + SectorAlign(entry.size) / kSectorSize;
+	if (m_Sectors.size() < last)
+		m_Sectors.resize(last, 0);
+
+	std::fill(m_Sectors.begin() + first, m_Sectors.begin() + last, used);
+}
+
+bool RegionFile::Read(int index, std::vector<char>& blob)
+{
+	const Entry& entry = m_Table[index];
+	if (entry.size == 0)
+		return false;
+
+	blob.resize(entry.size);
+	m_File.seekg(entry.offset);
+	m_File.read(blob.data(), entry.size);
+	if (!m_File)
+	{
+		m_File.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool RegionFile::Write(int index, const std::vector<char>& blob)
+{
+	if (blob.empty() || blob.size() > std::numeric_limits<uint32_t>::max() - kSectorSize)
+		return false;
+
+	if (static_cast<uint64_t>(m_Sectors.size()) * kSectorSize + blob.size() > std::numeric_limits<uint32_t>::max())
+		return false;
+
+	const Entry previous = m_Table[index];
+
+	// The old sectors are still marked used, so the new blob never lands on them.
+	Entry entry;
+	entry.size = static_cast<uint32_t>(blob.size());
+	entry.offset = Allocate(entry.size);
+	MarkSectors(entry, 1);
+
+	// The blob goes first so an interrupted write leaves the old entry valid.
+	m_File.seekp(entry.offset);
+	m_File.write(blob.data(), blob.size());
+	m_File.seekp(kTableOffset + index * sizeof(Entry));
+	m_File.write(reinterpret_cast<const char*>(&entry), sizeof(Entry));
+	m_File.flush();
+	if (!m_File)
+	{
+		m_File.clear();
+		MarkSectors(entry, 0);
+		return false;
+	}
+
+	if (previous.size != 0)
+		MarkSectors(previous, 0);
+
+	m_Table[index] = entry;
+	return true;
+}
+
+RegionStorage::RegionStorage(std::filesystem::path directory) : m_Directory(std::move(directory))
+{
+}
+
+RegionFile* RegionStorage::GetRegion(const glm::ivec3& chunkPos, bool create, int& index)
+{
+	const int cx = FloorDiv(chunkPos.x, CHUNK_SIZE);
+	const int cz = FloorDiv(chunkPos.z, CHUNK_SIZE);
+	const glm::ivec2 region(FloorDiv(cx, REGION_SIZE), FloorDiv(cz, REGION_SIZE));
+
+	index = (cz - region.y * REGION_SIZE) * REGION_SIZE + (cx - region.x * REGION_SIZE);
+
+	auto it = m_Regions.find(region);
+	if (it != m_Regions.end())
+		return it->second.get();
+
+	if (create)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(m_Directory, ec);
+	}
+
+	const std::string name = "r." + std::to_string(region.x) + "." + std::to_string(region.y) + ".qreg";
+	std::unique_ptr<RegionFile> file = OpenRegion(m_Directory / name, create);
+	if (!file)
+		return nullptr;
+
+	// Streaming moves across regions slowly, dropping them all is enough to bound the handles.
+	if (m_Regions.size() >= kMaxOpenRegions)
+		m_Regions.clear();
+
+	return m_Regions.emplace(region, std::move(file)).first->second.get();
+}
+
+std::unique_ptr<RegionFile> RegionStorage::OpenRegion(const std::filesystem::path& path, bool create)
+{
+	auto file = std::make_unique<RegionFile>();
+	if (file->Open(path, create))
+		return file;
+
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec))
+		return nullptr;
+
+	// Bad magic, another version or a truncated header: saving into it would drop every edit.
+	// It is moved aside rather than deleted, and the region starts over.
+	std::filesystem::path aside = path;
+	aside += ".corrupt";
+	std::filesystem::remove(aside, ec);
+	std::filesystem::rename(path, aside, ec);
+	if (ec)
+	{
+		Q_ERROR("Region file " + path.string() + " is unreadable and cannot be moved aside: " + ec.message());
+		return nullptr;
+	}
+
+	Q_WARNING("Region file " + path.string() + " is unreadable, moved to " + aside.filename().string());
+
+	if (!create || !file->Open(path, true))
+		return nullptr;
+
+	return file;
+}
+
+bool RegionStorage::Load(const glm::ivec3& chunkPos, ChunkStorage& blocks, int& maxHeight)
+{
+	int index = 0;
+	RegionFile* region = GetRegion(chunkPos, false, index);
+	if (!region || !region->Contains(index))
+		return false;
+
+	std::vector<char> blob;
+	if (!region->Read(index, blob))
+		return false;
+
+	std::vector<char> data;
+	try
+	{
+		data = QuasarEngine::Utils::decompress(blob);
+	}
+	catch (const std::runtime_error&)
+	{
+		return false;
+	}
+
+	int32_t height = 0;
+	if (data.size() < sizeof(height))
+		return false;
+
+	std::memcpy(&height, data.data(), sizeof(height));
+	if (!blocks.Read(data.data() + sizeof(height), data.size() - sizeof(height)))
+		return false;
+
+	maxHeight = height;
+	return true;
+}
+
+bool RegionStorage::Save(const glm::ivec3& chunkPos, const ChunkStorage& blocks, int maxHeight)
+{
+	int index = 0;
+	RegionFile* region = GetRegion(chunkPos, true, index);
+	if (!region)
+		return false;
+
+	std::vector<char> data(sizeof(int32_t));
+	const int32_t height = maxHeight;
+	std::memcpy(data.data(), &height, sizeof(height));
+	blocks.Write(data);
+
+	std::vector<char> blob;
+	try
+	{
+		blob = QuasarEngine::Utils::compress(data);
+	}
+	catch (const std::runtime_error&)
+	{
+		return false;
+	}
+
+	return region->Write(index, blob);
+}
+
+void RegionStorage::Close()
+{
+	m_Regions.clear();
+}
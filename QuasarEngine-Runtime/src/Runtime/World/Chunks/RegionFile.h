@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ChunkStorage.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+constexpr int REGION_SIZE = 32;
+constexpr int REGION_CHUNK_COUNT = REGION_SIZE * REGION_SIZE;
+
+// One file holding the chunks of a REGION_SIZE x REGION_SIZE area.
+// Layout: header (magic, version), an offset table of REGION_CHUNK_COUNT entries, then one
+// zlib-compressed blob per chunk starting on a sector boundary. A blob is always written to
+// free sectors and the table entry switched over afterwards, so an interrupted write leaves
+// the previous blob readable. The sectors it leaves are free again for later writes.
+class RegionFile
+{
+public:
+    bool Open(const std::filesystem::path& path, bool create);
+
+    bool Read(int index, std::vector<char>& blob);
+    bool Write(int index, const std::vector<char>& blob);
+
+    bool Contains(int index) const { return m_Table[index].size != 0; }
+
+    uint64_t GetSectorCount() const { return m_Sectors.size(); }
+
+private:
+    struct Entry
+    {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    static uint32_t SectorAlign(uint32_t bytes);
+
+    // First fit among the free sectors, growing the file when nothing fits.
+    uint32_t Allocate(uint32_t bytes);
+    void MarkSectors(const Entry& entry, uint8_t used);
+
+    std::fstream m_File;
+    std::array<Entry, REGION_CHUNK_COUNT> m_Table{};
+
+    // One flag per sector of the file, header included: 1 while something lives there.
+    std::vector<uint8_t> m_Sectors;
+};
+
+// Chunk blocks persisted in region files under a directory. Not thread-safe: the chunk
+// manager only calls it from its single IO thread, which also orders a save before a later load.
+class RegionStorage
+{
+public:
+    explicit RegionStorage(std::filesystem::path directory);
+
+    bool Load(const glm::ivec3& chunkPos, ChunkStorage& blocks, int& maxHeight);
+    bool Save(const glm::ivec3& chunkPos, const ChunkStorage& blocks, int maxHeight);
+
+    // Closes every open region file.
+    void Close();
+
+private:
+    struct RegionKey
+    {
+        size_t operator()(const glm::ivec2& k) const { return std::hash<int>()(k.x) ^ (std::hash<int>()(k.y) << 1); }
+    };
+
+    RegionFile* GetRegion(const glm::ivec3& chunkPos, bool create, int& index);
+    std::unique_ptr<RegionFile> OpenRegion(const std::filesystem::path& path, bool create);
+
+    std::filesystem::path m_Directory;
+    std::unordered_map<glm::ivec2, std::unique_ptr<RegionFile>, RegionKey> m_Regions;
+};
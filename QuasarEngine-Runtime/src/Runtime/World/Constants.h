@@ -5,6 +5,10 @@ constexpr int CHUNK_HEIGHT = 256;
 constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
 constexpr int CHUNK_VOLUME = CHUNK_AREA * CHUNK_HEIGHT;
 
+constexpr int CHUNK_SECTION_HEIGHT = 16;
+constexpr int CHUNK_SECTION_COUNT = CHUNK_HEIGHT / CHUNK_SECTION_HEIGHT;
+constexpr int CHUNK_SECTION_VOLUME = CHUNK_AREA * CHUNK_SECTION_HEIGHT;
+
 constexpr int RENDER_DISTANCE = 30;
 
 constexpr int NUMBER_OF_CHUNKS_TO_GENERATE = 2;
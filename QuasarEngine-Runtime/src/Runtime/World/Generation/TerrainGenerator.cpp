@@ -9,7 +9,13 @@
 #include <glm/gtx/spline.hpp>
 #include <string>
 
-TerrainGenerator::TerrainGenerator() : seed(8173561), perlin(seed)
+namespace
+{
+	constexpr float kHeightFrequency = 0.001f;
+	constexpr std::int32_t kHeightOctaves = 6;
+}
+
+TerrainGenerator::TerrainGenerator() : seed(8173561), perlin(seed), perlinBatch(perlin)
 {
 	continetalnessCurve = loadCurve("Assets/Curves/continentalness.csv");
 	//erosionCurve = loadCurve("Assets/Curves/erosion.csv");
@@ -89,9 +95,12 @@ std::vector<glm::vec2> TerrainGenerator::loadCurve(const std::string& path)
 
 int TerrainGenerator::GetHeight(glm::vec2 pos)
 {
-	const float frequency = 0.001f;
+	return NoiseToHeight(perlin.octave2D(pos.x * kHeightFrequency, pos.y * kHeightFrequency, kHeightOctaves));
+}
 
-	float n = perlin.octave2D(pos.x * frequency, pos.y * frequency, 6);
+int TerrainGenerator::NoiseToHeight(double noise)
+{
+	float n = static_cast<float>(noise);
 
 	n = (n + 1.0f) * 0.5f;
 
@@ -107,14 +116,25 @@ int TerrainGenerator::GetHeight(glm::vec2 pos)
 
 void TerrainGenerator::GenerateHeightmap(const glm::ivec3& chunkPos, int outHeight[CHUNK_SIZE][CHUNK_SIZE])
 {
+	std::array<double, CHUNK_AREA> noiseX;
+	std::array<double, CHUNK_AREA> noiseZ;
+	std::array<double, CHUNK_AREA> noise;
+
+	// Coordinates are computed in float exactly like GetHeight so both give the same heights.
 	for (int x = 0; x < CHUNK_SIZE; ++x)
 	{
 		for (int z = 0; z < CHUNK_SIZE; ++z)
 		{
-			glm::ivec2 worldXZ(chunkPos.x + x, chunkPos.z + z);
-			outHeight[x][z] = GetHeight(worldXZ);
+			noiseX[x * CHUNK_SIZE + z] = static_cast<float>(chunkPos.x + x) * kHeightFrequency;
+			noiseZ[x * CHUNK_SIZE + z] = static_cast<float>(chunkPos.z + z) * kHeightFrequency;
 		}
 	}
+
+	perlinBatch.Octave2D(noiseX.data(), noiseZ.data(), CHUNK_AREA, kHeightOctaves, 0.5, noise.data());
+
+	for (int x = 0; x < CHUNK_SIZE; ++x)
+		for (int z = 0; z < CHUNK_SIZE; ++z)
+			outHeight[x][z] = NoiseToHeight(noise[x * CHUNK_SIZE + z]);
 }
 
 float TerrainGenerator::GetY(float noise_value, const glm::vec2& pos, const std::vector<glm::vec2>& list)
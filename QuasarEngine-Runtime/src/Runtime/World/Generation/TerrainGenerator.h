@@ -5,6 +5,7 @@
 
 #include <QuasarEngine/Tools/Math.h>
 #include <QuasarEngine/Tools/PerlinNoise.h>
+#include <QuasarEngine/Tools/PerlinNoiseBatch.h>
 
 #include <glm/glm.hpp>
 
@@ -16,6 +17,7 @@ public:
 	
 	int GetHeight(glm::vec2 pos);
 
+	// Same heights as GetHeight, the whole tile goes through one batched noise evaluation.
 	void GenerateHeightmap(const glm::ivec3& chunkPos, int outHeight[CHUNK_SIZE][CHUNK_SIZE]);
 
 	void GenerateCave();
@@ -23,6 +25,8 @@ public:
 
 	BiomeType GetBiome(glm::vec2 pos);
 private:
+	static int NoiseToHeight(double noise);
+
 	float GetNoiseHeight(glm::vec2 pos);
 	float GetPerlin(glm::vec2 pos);
 
@@ -43,4 +47,5 @@ private:
 
 	const siv::PerlinNoise::seed_type seed;
 	const siv::PerlinNoise perlin; //{seed}
+	const QuasarEngine::PerlinNoiseBatch perlinBatch;
 };
\ No newline at end of file
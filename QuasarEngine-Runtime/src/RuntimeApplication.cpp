@@ -25,6 +25,7 @@ namespace QuasarEngine
 		spec.Name = "Runtime";
 		spec.CommandLineArgs = args;
 		spec.EnableImGui = true;
+		spec.PipelinedFrames = true;
 
 		return new RuntimeApplication(spec);
 	}
@@ -10,14 +10,20 @@ project "QuasarEngine-Units"
 	files
 	{
 		"src/**.h",
-		"src/**.cpp"
+		"src/**.cpp",
+
+		"../QuasarEngine-Runtime/src/Runtime/World/Chunks/ChunkStorage.h",
+		"../QuasarEngine-Runtime/src/Runtime/World/Chunks/ChunkStorage.cpp",
+		"../QuasarEngine-Runtime/src/Runtime/World/Chunks/RegionFile.h",
+		"../QuasarEngine-Runtime/src/Runtime/World/Chunks/RegionFile.cpp"
 	}
 
 	includedirs
 	{
 		"src",
 		
-		"%{IncludeDir.QuasarEngineCore}"
+		"%{IncludeDir.QuasarEngineCore}",
+		"../QuasarEngine-Runtime/src"
 	}
 
 	links
@@ -4,13 +4,44 @@
 #include <cassert>
 #include <memory>
 #include <numeric>
+#include <algorithm>
 #include <thread>
+#include <mutex>
+#include <random>
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+#include <type_traits>
+
+#include <glm/gtc/matrix_transform.hpp>
 
 #include <QuasarEngine/Memory/Pointer.h>
 
 #include <QuasarEngine/Thread/JobSystem.h>
+#include <QuasarEngine/Thread/SharedQueueJobPool.h>
+#include <QuasarEngine/Thread/WorkStealingJobPool.h>
 #include <QuasarEngine/Thread/ThreadPool.h>
 
+#include <QuasarEngine/Tools/PerlinNoiseBatch.h>
+#include <QuasarEngine/Tools/Profiler.h>
+
+#include <QuasarEngine/Shader/ShaderCache.h>
+
+#include <QuasarEngine/Resources/IBLBake.h>
+#include <QuasarEngine/Resources/ModelCache.h>
+#include <QuasarEngine/Resources/TextureCompression.h>
+
+#include <QuasarEngine/ECS/Registry.h>
+#include <QuasarEngine/Entity/Entity.h>
+#include <QuasarEngine/Entity/Components/TransformComponent.h>
+#include <QuasarEngine/Entity/Components/WorldTransformComponent.h>
+
+#include <QuasarEngine/Renderer/RenderQueue.h>
+#include <QuasarEngine/Resources/Materials/Material.h>
+
+#include <Runtime/World/Chunks/ChunkStorage.h>
+#include <Runtime/World/Chunks/RegionFile.h>
+
 namespace QuasarEngine
 {
     struct MyObject
@@ -217,6 +248,7 @@ namespace QuasarEngine
         QuasarEngine::JobSystem jobSystem;
 
         std::vector<int> values;
+        std::mutex valuesMutex;
         values.reserve(4);
 
         auto [futA, jobA] = jobSystem.SubmitWithHandle(
@@ -224,8 +256,9 @@ namespace QuasarEngine
             QuasarEngine::JobPoolType::GENERAL,
             {},
             "JobA",
-            [&values]() {
+            [&values, &valuesMutex]() {
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                std::lock_guard<std::mutex> lock(valuesMutex);
                 values.push_back(10);
             }
         );
@@ -235,8 +268,9 @@ namespace QuasarEngine
             QuasarEngine::JobPoolType::GENERAL,
             {},
             "JobB",
-            [&values]() {
+            [&values, &valuesMutex]() {
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                std::lock_guard<std::mutex> lock(valuesMutex);
                 values.push_back(20);
             }
         );
@@ -270,6 +304,72 @@ namespace QuasarEngine
         std::cout << "TestDependencies OK\n\n";
     }
 
+    void TestDependencyGraph()
+    {
+        std::cout << "==== TestDependencyGraph ====\n";
+
+        JobSystem jobSystem;
+
+        const std::size_t layers = 200;
+        const std::size_t width = 100;
+
+        std::vector<std::atomic<int>> done(layers);
+        std::atomic<int> orderErrors{ 0 };
+
+        {
+            ScopeTimer timer("JobSystem 200x100 graph");
+
+            std::vector<Job::Ptr> previous;
+            std::vector<std::future<void>> futures;
+            futures.reserve(layers * width);
+
+            for (std::size_t l = 0; l < layers; ++l)
+            {
+                std::vector<Job::Ptr> current;
+                current.reserve(width);
+
+                for (std::size_t w = 0; w < width; ++w)
+                {
+                    std::vector<Job::Ptr> deps;
+                    if (!previous.empty())
+                    {
+                        deps.push_back(previous[w]);
+                        deps.push_back(previous[(w + 1) % width]);
+                    }
+
+                    auto [fut, job] = jobSystem.SubmitWithHandle(
+                        JobPriority::NORMAL,
+                        JobPoolType::GENERAL,
+                        std::move(deps),
+                        "GraphNode",
+                        [&done, &orderErrors, l]()
+                        {
+                            if (l > 0 && done[l - 1].load(std::memory_order_acquire) < 2)
+                                orderErrors.fetch_add(1, std::memory_order_relaxed);
+                            done[l].fetch_add(1, std::memory_order_acq_rel);
+                        }
+                    );
+
+                    futures.push_back(std::move(fut));
+                    current.push_back(job);
+                }
+
+                previous = std::move(current);
+            }
+
+            jobSystem.WaitAll();
+
+            for (auto& f : futures)
+                f.get();
+        }
+
+        for (std::size_t l = 0; l < layers; ++l)
+            assert(done[l].load() == static_cast<int>(width));
+        assert(orderErrors.load() == 0);
+
+        std::cout << "TestDependencyGraph OK\n\n";
+    }
+
     void TestStress()
     {
         std::cout << "==== TestStress ====\n";
@@ -332,6 +432,172 @@ namespace QuasarEngine
         std::cout << "TestStress OK\n\n";
     }
 
+    template <typename PoolType>
+    double RunTinyJobs(std::size_t rootCount, std::size_t childrenPerRoot)
+    {
+        const std::size_t total = rootCount * (childrenPerRoot + 1);
+        const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::atomic<std::size_t> finished{ 0 };
+        std::atomic<std::size_t> work{ 0 };
+
+        PoolType pool(JobPoolType::GENERAL, threads,
+            [&finished](const Job::Ptr&) { finished.fetch_add(1, std::memory_order_relaxed); });
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (std::size_t r = 0; r < rootCount; ++r)
+        {
+            pool.Enqueue(std::make_shared<Job>([&pool, &work, childrenPerRoot]()
+                {
+                    for (std::size_t c = 0; c < childrenPerRoot; ++c)
+                    {
+                        pool.Enqueue(std::make_shared<Job>([&work]()
+                            {
+                                work.fetch_add(1, std::memory_order_relaxed);
+                            }));
+                    }
+                }));
+        }
+
+        while (finished.load(std::memory_order_acquire) < total)
+            std::this_thread::yield();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        pool.Shutdown();
+
+        assert(work.load() == rootCount * childrenPerRoot);
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    void BenchmarkJobPools()
+    {
+        std::cout << "==== BenchmarkJobPools ====\n";
+
+        const std::size_t roots = 1000;
+        const std::size_t children = 1000;
+        const double jobs = static_cast<double>(roots * (children + 1));
+
+        const double sharedMs = RunTinyJobs<SharedQueueJobPool>(roots, children);
+        const double stealingMs = RunTinyJobs<WorkStealingJobPool>(roots, children);
+
+        std::cout << "SharedQueueJobPool  : " << sharedMs << " ms ("
+            << static_cast<long long>(jobs / sharedMs * 1000.0) << " jobs/s)\n";
+        std::cout << "WorkStealingJobPool : " << stealingMs << " ms ("
+            << static_cast<long long>(jobs / stealingMs * 1000.0) << " jobs/s)\n";
+
+        std::cout << "BenchmarkJobPools OK\n\n";
+    }
+
+    void TestParallelFor()
+    {
+        std::cout << "==== TestParallelFor ====\n";
+
+        JobSystem jobSystem;
+
+        const std::size_t N = 1'000'000;
+        std::vector<int> data(N, 0);
+
+        {
+            ScopeTimer timer("ParallelFor 1M");
+            jobSystem.ParallelFor(N, 0, [&data](std::size_t i)
+                {
+                    data[i] = static_cast<int>(i % 7);
+                });
+        }
+
+        for (std::size_t i = 0; i < N; ++i)
+            assert(data[i] == static_cast<int>(i % 7));
+
+        long long sum = 0;
+        {
+            ScopeTimer timer("ParallelReduce 1M");
+            sum = jobSystem.ParallelReduce<long long>(N, 4096, 0LL,
+                [&data](std::size_t begin, std::size_t end)
+                {
+                    long long s = 0;
+                    for (std::size_t i = begin; i < end; ++i)
+                        s += data[i];
+                    return s;
+                },
+                [](long long a, long long b) { return a + b; });
+        }
+
+        assert(sum == std::accumulate(data.begin(), data.end(), 0LL));
+
+        bool caught = false;
+        try
+        {
+            jobSystem.ParallelFor(1000, 10, [](std::size_t i)
+                {
+                    if (i == 500)
+                        throw std::runtime_error("ParallelFor failure");
+                });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        assert(caught);
+
+        std::cout << "TestParallelFor OK\n\n";
+    }
+
+    void TestTaskGraph()
+    {
+        std::cout << "==== TestTaskGraph ====\n";
+
+        JobSystem jobSystem;
+        TaskGraph graph;
+
+        std::atomic<int> physics{ 0 };
+        std::atomic<int> animation{ 0 };
+        std::atomic<int> render{ 0 };
+        std::atomic<int> orderErrors{ 0 };
+
+        auto physicsTask = graph.AddTask("Physics", [&]() { physics.fetch_add(1); });
+        auto animationTask = graph.AddTask("Animation", [&]() { animation.fetch_add(1); });
+        auto renderTask = graph.AddTask("Render", [&]()
+            {
+                if (physics.load() != render.load() + 1 || animation.load() != render.load() + 1)
+                    orderErrors.fetch_add(1);
+                render.fetch_add(1);
+            });
+
+        graph.AddDependency(renderTask, physicsTask);
+        graph.AddDependency(renderTask, animationTask);
+
+        const int frames = 1000;
+        {
+            ScopeTimer timer("TaskGraph 1000 frames");
+            for (int frame = 0; frame < frames; ++frame)
+                jobSystem.RunAndWait(graph);
+        }
+
+        assert(render.load() == frames);
+        assert(orderErrors.load() == 0);
+
+        TaskGraph cyclic;
+        auto a = cyclic.AddTask("A", []() {});
+        auto b = cyclic.AddTask("B", []() {});
+        cyclic.AddDependency(a, b);
+        cyclic.AddDependency(b, a);
+
+        bool caught = false;
+        try
+        {
+            jobSystem.RunAndWait(cyclic);
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        assert(caught);
+
+        std::cout << "TestTaskGraph OK\n\n";
+    }
+
     void TestThreadPool()
     {
         std::cout << "==== TestThreadPool ====\n";
@@ -369,6 +635,1254 @@ namespace QuasarEngine
 
         std::cout << "TestThreadPool OK\n\n";
     }
+
+    // Terrain-like column: cobble, a dirt band and grass on top of a wavy surface, air above.
+    static BlockType ChunkTestBlock(int x, int y, int z)
+    {
+        const int height = 64 + (x * 7 + z * 13) % 24;
+        if (y >= height) return BlockType::AIR;
+        if (y < height - 8) return BlockType::COBBLE;
+        if (y < height - 1) return BlockType::DIRT;
+        return BlockType::GRASS;
+    }
+
+    void TestChunkStorage()
+    {
+        std::cout << "==== TestChunkStorage ====\n";
+
+        std::vector<BlockType> dense(CHUNK_VOLUME, BlockType::AIR);
+        ChunkStorage storage;
+
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const BlockType type = ChunkTestBlock(x, y, z);
+                    dense[y * CHUNK_AREA + z * CHUNK_SIZE + x] = type;
+                    storage.Set(x, y, z, type);
+                }
+
+        std::mt19937 rng(1234);
+        for (int i = 0; i < 20000; ++i)
+        {
+            const int x = rng() % CHUNK_SIZE, y = rng() % CHUNK_HEIGHT, z = rng() % CHUNK_SIZE;
+            const BlockType type = BlockType(rng() % BlockType::BLOCK_ERROR);
+            dense[y * CHUNK_AREA + z * CHUNK_SIZE + x] = type;
+            storage.Set(x, y, z, type);
+        }
+
+        auto check = [&]() {
+            for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        assert(storage.Get(x, y, z) == dense[y * CHUNK_AREA + z * CHUNK_SIZE + x]);
+
+            // Occupancy rows drive the mesher, they must follow every Set.
+            for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                {
+                    uint32_t row = 0;
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        if (dense[y * CHUNK_AREA + z * CHUNK_SIZE + x] != BlockType::AIR)
+                            row |= 1u << x;
+                    assert(storage.GetRow(y, z) == row);
+                }
+            assert(storage.GetRow(-1, 0) == 0 && storage.GetRow(CHUNK_HEIGHT, 0) == 0);
+            };
+
+        check();
+        storage.Optimize();
+        check();
+
+        storage.Fill(BlockType::STONE);
+        for (int s = 0; s < CHUNK_SECTION_COUNT; ++s)
+            assert(storage.GetSection(s).IsUniform() && storage.GetSection(s).GetUniformType() == BlockType::STONE && storage.GetSection(s).IsFull());
+
+        std::cout << "TestChunkStorage OK\n\n";
+    }
+
+    void BenchmarkChunkStorage()
+    {
+        std::cout << "==== BenchmarkChunkStorage ====\n";
+
+        std::vector<BlockType> dense(CHUNK_VOLUME, BlockType::AIR);
+        ChunkStorage storage;
+
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const BlockType type = ChunkTestBlock(x, y, z);
+                    dense[y * CHUNK_AREA + z * CHUNK_SIZE + x] = type;
+                    storage.Set(x, y, z, type);
+                }
+        storage.Optimize();
+
+        // The greedy mesher reads every block once per face direction.
+        const int passes = 6;
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::size_t denseSolid = 0;
+        auto start = Clock::now();
+        for (int p = 0; p < passes; ++p)
+            for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        denseSolid += dense[y * CHUNK_AREA + z * CHUNK_SIZE + x] != BlockType::AIR;
+        const double denseMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        std::size_t packedSolid = 0;
+        start = Clock::now();
+        for (int p = 0; p < passes; ++p)
+            for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                        packedSolid += storage.Get(x, y, z) != BlockType::AIR;
+        const double packedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        assert(denseSolid == packedSolid);
+
+        std::cout << "Dense   : " << CHUNK_VOLUME * sizeof(BlockType) / 1024 << " KB, mesh scan " << denseMs << " ms\n";
+        std::cout << "Paletted: " << storage.GetMemoryUsage() / 1024 << " KB, mesh scan " << packedMs << " ms\n";
+
+        std::cout << "BenchmarkChunkStorage OK\n\n";
+    }
+
+    // Column tile of a chunk with the coordinates TerrainGenerator feeds the noise.
+    static void FillHeightmapTile(int chunkX, int chunkZ, std::vector<double>& x, std::vector<double>& z)
+    {
+        x.resize(CHUNK_AREA);
+        z.resize(CHUNK_AREA);
+        for (int i = 0; i < CHUNK_SIZE; ++i)
+            for (int k = 0; k < CHUNK_SIZE; ++k)
+            {
+                x[i * CHUNK_SIZE + k] = static_cast<float>(chunkX * CHUNK_SIZE + i) * 0.001f;
+                z[i * CHUNK_SIZE + k] = static_cast<float>(chunkZ * CHUNK_SIZE + k) * 0.001f;
+            }
+    }
+
+    void TestPerlinNoiseBatch()
+    {
+        std::cout << "==== TestPerlinNoiseBatch ====\n";
+
+        const siv::PerlinNoise perlin(8173561);
+        PerlinNoiseBatch batch(perlin);
+
+        // Odd count so every path also runs its tail.
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> coord(-3000.0, 3000.0);
+        std::vector<double> x(1027), y(1027);
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            x[i] = coord(rng);
+            y[i] = coord(rng);
+        }
+        x[0] = -0.5; y[0] = 0.0;
+        x[1] = 255.75; y[1] = -256.25;
+
+        std::vector<double> expected(x.size());
+        for (std::size_t i = 0; i < x.size(); ++i)
+            expected[i] = perlin.octave2D(x[i], y[i], 6);
+
+        const PerlinNoiseBatch::SimdLevel supported = PerlinNoiseBatch::GetSupportedSimdLevel();
+        for (auto level : { PerlinNoiseBatch::SimdLevel::Scalar, PerlinNoiseBatch::SimdLevel::SSE2, PerlinNoiseBatch::SimdLevel::AVX2 })
+        {
+            if (level > supported)
+                continue;
+
+            batch.SetSimdLevel(level);
+            std::vector<double> result(x.size());
+            batch.Octave2D(x.data(), y.data(), x.size(), 6, 0.5, result.data());
+
+            for (std::size_t i = 0; i < x.size(); ++i)
+                assert(result[i] == expected[i]);
+
+            std::cout << PerlinNoiseBatch::GetSimdLevelName(level) << " matches octave2D\n";
+        }
+
+        std::cout << "TestPerlinNoiseBatch OK\n\n";
+    }
+
+    void BenchmarkTerrainNoise()
+    {
+        std::cout << "==== BenchmarkTerrainNoise ====\n";
+
+        const siv::PerlinNoise perlin(8173561);
+        PerlinNoiseBatch batch(perlin);
+
+        const int radius = 8;
+        const int chunkCount = (2 * radius + 1) * (2 * radius + 1);
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::vector<double> x, z, noise(CHUNK_AREA);
+        double checksum = 0.0;
+
+        auto start = Clock::now();
+        for (int cx = -radius; cx <= radius; ++cx)
+            for (int cz = -radius; cz <= radius; ++cz)
+            {
+                FillHeightmapTile(cx, cz, x, z);
+                for (int i = 0; i < CHUNK_AREA; ++i)
+                    checksum += perlin.octave2D(x[i], z[i], 6);
+            }
+        const double scalarSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "octave2D per column: " << chunkCount / scalarSeconds << " chunks/s\n";
+
+        const PerlinNoiseBatch::SimdLevel supported = PerlinNoiseBatch::GetSupportedSimdLevel();
+        for (auto level : { PerlinNoiseBatch::SimdLevel::Scalar, PerlinNoiseBatch::SimdLevel::SSE2, PerlinNoiseBatch::SimdLevel::AVX2 })
+        {
+            if (level > supported)
+                continue;
+
+            batch.SetSimdLevel(level);
+
+            double batchChecksum = 0.0;
+            start = Clock::now();
+            for (int cx = -radius; cx <= radius; ++cx)
+                for (int cz = -radius; cz <= radius; ++cz)
+                {
+                    FillHeightmapTile(cx, cz, x, z);
+                    batch.Octave2D(x.data(), z.data(), CHUNK_AREA, 6, 0.5, noise.data());
+                    for (double n : noise)
+                        batchChecksum += n;
+                }
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            assert(batchChecksum == checksum);
+            std::cout << "Batched " << PerlinNoiseBatch::GetSimdLevelName(level) << ": " << chunkCount / seconds << " chunks/s (x" << scalarSeconds / seconds << ")\n";
+        }
+
+        std::cout << "BenchmarkTerrainNoise OK\n\n";
+    }
+
+    static void AssertSameBlocks(const ChunkStorage& a, const ChunkStorage& b)
+    {
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                assert(a.GetRow(y, z) == b.GetRow(y, z));
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    assert(a.Get(x, y, z) == b.Get(x, y, z));
+            }
+    }
+
+    void TestRegionStorage()
+    {
+        std::cout << "==== TestRegionStorage ====\n";
+
+        const auto directory = std::filesystem::temp_directory_path() / "QuasarEngineUnits" / "Regions";
+        std::filesystem::remove_all(directory);
+
+        ChunkStorage terrain;
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    terrain.Set(x, y, z, ChunkTestBlock(x, y, z));
+        terrain.Optimize();
+
+        // Player edits: scattered blocks compress worse, the blob grows past its sectors.
+        ChunkStorage edited = terrain;
+        std::mt19937 rng(77);
+        for (int i = 0; i < 20000; ++i)
+            edited.Set(rng() % CHUNK_SIZE, rng() % CHUNK_HEIGHT, rng() % CHUNK_SIZE, BlockType(rng() % BlockType::BLOCK_ERROR));
+
+        ChunkStorage empty;
+
+        // Negative and far coordinates land in other regions, 33 chunks away is the next one.
+        const glm::ivec3 origin(0, 0, 0);
+        const glm::ivec3 neighbor(CHUNK_SIZE, 0, 0);
+        const glm::ivec3 negative(-CHUNK_SIZE, 0, -33 * CHUNK_SIZE);
+        const glm::ivec3 corner(31 * CHUNK_SIZE, 0, 31 * CHUNK_SIZE);
+
+        // Save and Load are kept out of assert so they still run without it.
+        auto expectChunk = [](RegionStorage& regions, const glm::ivec3& pos, const ChunkStorage& expected, int expectedHeight) {
+            ChunkStorage loaded;
+            int maxHeight = 0;
+            const bool ok = regions.Load(pos, loaded, maxHeight);
+            assert(ok && maxHeight == expectedHeight);
+            AssertSameBlocks(loaded, expected);
+            };
+
+        {
+            RegionStorage regions(directory);
+
+            ChunkStorage missing;
+            int maxHeight = 0;
+            bool ok = !regions.Load(origin, missing, maxHeight);
+            ok &= regions.Save(origin, terrain, 87);
+            ok &= regions.Save(neighbor, empty, 0);
+            ok &= regions.Save(negative, terrain, 42);
+            ok &= regions.Save(corner, terrain, 13);
+            assert(ok);
+
+            expectChunk(regions, origin, terrain, 87);
+
+            // Larger than its old sectors: moved to the end, the neighbor stays intact.
+            ok = regions.Save(origin, edited, 88);
+            assert(ok);
+            expectChunk(regions, origin, edited, 88);
+            expectChunk(regions, neighbor, empty, 0);
+
+            // Smaller again: lands in the sectors freed above.
+            ok = regions.Save(origin, terrain, 87);
+            assert(ok);
+        }
+
+        std::size_t files = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+            files += entry.is_regular_file();
+        assert(files == 2);
+
+        {
+            RegionStorage regions(directory);
+
+            expectChunk(regions, origin, terrain, 87);
+            expectChunk(regions, neighbor, empty, 0);
+            expectChunk(regions, negative, terrain, 42);
+            expectChunk(regions, corner, terrain, 13);
+
+            ChunkStorage missing;
+            int maxHeight = 0;
+            const bool found = regions.Load(glm::ivec3(2 * CHUNK_SIZE, 0, 0), missing, maxHeight);
+            assert(!found);
+            (void)found;
+        }
+
+        // Rewrites of every size reuse freed sectors instead of growing the file.
+        {
+            RegionFile file;
+            bool ok = file.Open(directory / "churn.qreg", true);
+
+            uint64_t settled = 0;
+            for (int i = 0; i < 200; ++i)
+            {
+                const std::vector<char> blob(1000 + (i * 7919) % 20000, char(i));
+                ok &= file.Write(i % 4, blob);
+                if (i == 20)
+                    settled = file.GetSectorCount();
+            }
+            assert(ok && file.GetSectorCount() <= settled + 2 * (20000 / 512 + 1));
+
+            std::vector<char> blob;
+            ok = file.Read(199 % 4, blob);
+            assert(ok && blob.size() == 1000 + (199 * 7919) % 20000 && blob[0] == char(199));
+        }
+
+        // A file from another version is moved aside and the region starts over.
+        {
+            const auto stale = directory / "r.0.0.qreg";
+            {
+                std::ofstream out(stale, std::ios::binary | std::ios::trunc);
+                out << "QREG\x09\x00\x00\x00 not a region";
+            }
+
+            RegionStorage regions(directory);
+            const bool ok = regions.Save(origin, terrain, 87);
+            assert(ok);
+            (void)ok;
+            expectChunk(regions, origin, terrain, 87);
+            assert(std::filesystem::exists(directory / "r.0.0.qreg.corrupt"));
+        }
+
+        std::filesystem::remove_all(directory);
+
+        std::cout << "TestRegionStorage OK\n\n";
+    }
+
+    // Same columns as ChunkManager::AsyncGenerateBlocks, heights mapped like TerrainGenerator::NoiseToHeight.
+    static int GenerateTestChunk(const PerlinNoiseBatch& batch, int chunkX, int chunkZ, ChunkStorage& blocks)
+    {
+        std::vector<double> x, z, noise(CHUNK_AREA);
+        FillHeightmapTile(chunkX, chunkZ, x, z);
+        batch.Octave2D(x.data(), z.data(), CHUNK_AREA, 6, 0.5, noise.data());
+
+        int maxHeight = 0;
+        for (int i = 0; i < CHUNK_SIZE; ++i)
+            for (int k = 0; k < CHUNK_SIZE; ++k)
+            {
+                const float n = (static_cast<float>(noise[i * CHUNK_SIZE + k]) + 1.0f) * 0.5f;
+                const int height = std::min(std::max(static_cast<int>(MIN_HEIGHT + n * (MAX_HEIGHT - MIN_HEIGHT)), 1), CHUNK_HEIGHT - 1);
+                maxHeight = std::max(maxHeight, height - 1);
+
+                for (int y = 0; y < height; ++y)
+                {
+                    BlockType type;
+                    if (y < height - 8)      type = BlockType::COBBLE;
+                    else if (y < height - 1) type = BlockType::DIRT;
+                    else                     type = BlockType::GRASS;
+
+                    blocks.Set(i, y, k, type);
+                }
+            }
+
+        blocks.Optimize();
+        return maxHeight;
+    }
+
+    void BenchmarkRegionStorage()
+    {
+        std::cout << "==== BenchmarkRegionStorage ====\n";
+
+        const auto directory = std::filesystem::temp_directory_path() / "QuasarEngineUnits" / "RegionBenchmark";
+        std::filesystem::remove_all(directory);
+
+        const siv::PerlinNoise perlin(8173561);
+        const PerlinNoiseBatch batch(perlin);
+
+        const int radius = 4;
+        const int chunkCount = (2 * radius + 1) * (2 * radius + 1);
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::vector<ChunkStorage> generated;
+        std::vector<int> heights;
+        generated.reserve(chunkCount);
+
+        auto start = Clock::now();
+        for (int cx = -radius; cx <= radius; ++cx)
+            for (int cz = -radius; cz <= radius; ++cz)
+            {
+                generated.emplace_back();
+                heights.push_back(GenerateTestChunk(batch, cx, cz, generated.back()));
+            }
+        const double generateSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::uintmax_t fileBytes = 0;
+        double saveSeconds = 0.0;
+        {
+            RegionStorage regions(directory);
+
+            start = Clock::now();
+            std::size_t i = 0;
+            for (int cx = -radius; cx <= radius; ++cx)
+                for (int cz = -radius; cz <= radius; ++cz, ++i)
+                {
+                    const bool ok = regions.Save(glm::ivec3(cx * CHUNK_SIZE, 0, cz * CHUNK_SIZE), generated[i], heights[i]);
+                    assert(ok);
+                    (void)ok;
+                }
+            saveSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+            fileBytes += entry.file_size();
+
+        RegionStorage regions(directory);
+        start = Clock::now();
+        std::size_t i = 0;
+        for (int cx = -radius; cx <= radius; ++cx)
+            for (int cz = -radius; cz <= radius; ++cz, ++i)
+            {
+                ChunkStorage loaded;
+                int maxHeight = 0;
+                const bool ok = regions.Load(glm::ivec3(cx * CHUNK_SIZE, 0, cz * CHUNK_SIZE), loaded, maxHeight);
+                assert(ok && maxHeight == heights[i]);
+                (void)ok;
+            }
+        const double loadSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        regions.Close();
+        std::filesystem::remove_all(directory);
+
+        std::cout << "Generate: " << chunkCount / generateSeconds << " chunks/s\n";
+        std::cout << "Save    : " << chunkCount / saveSeconds << " chunks/s, " << fileBytes / 1024 / chunkCount << " KB per chunk on disk\n";
+        std::cout << "Load    : " << chunkCount / loadSeconds << " chunks/s (x" << generateSeconds / loadSeconds << " vs generate)\n";
+
+        std::cout << "BenchmarkRegionStorage OK\n\n";
+    }
+
+    void TestProfiler()
+    {
+        std::cout << "==== TestProfiler ====\n";
+
+        Profiler& profiler = Profiler::Instance();
+        profiler.SetEnabled(true);
+
+        QE_PROFILE_FRAME();
+        {
+            QE_PROFILE_SCOPE("Outer");
+            {
+                QE_PROFILE_SCOPE("Inner");
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        std::thread worker([]() {
+            QE_PROFILE_THREAD("Profiler Test Worker");
+            QE_PROFILE_SCOPE("Worker");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            });
+        worker.join();
+        QE_PROFILE_FRAME();
+
+        const ProfileFrame frame = profiler.CollectLastFrame();
+
+        bool outer = false, inner = false, workerZone = false;
+        for (const ProfileThreadFrame& thread : frame.threads)
+        {
+            for (const ProfileEvent& event : thread.events)
+            {
+                const std::string name = event.name;
+                if (name == "Outer") { outer = true; assert(event.depth == 0); }
+                if (name == "Inner") { inner = true; assert(event.depth == 1); assert(event.end - event.start >= 1000000); }
+                if (name == "Worker") { workerZone = true; assert(thread.name == "Profiler Test Worker"); }
+            }
+        }
+        assert(outer && inner && workerZone);
+
+        // Exited threads hand their buffer over instead of leaking it.
+        const size_t bufferCount = profiler.GetThreadBufferCount();
+        for (int i = 0; i < 8; ++i)
+        {
+            std::thread([]() { QE_PROFILE_SCOPE("Short Lived"); }).join();
+        }
+        assert(profiler.GetThreadBufferCount() == bufferCount);
+
+        // Reading while a thread laps its buffer only ever yields whole events.
+        {
+            std::atomic<bool> stop{ false };
+            std::thread writer([&stop]() {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    QE_PROFILE_SCOPE("Lapping");
+                }
+                });
+
+            for (int i = 0; i < 200; ++i)
+            {
+                QE_PROFILE_FRAME();
+                for (const ProfileThreadFrame& thread : profiler.CollectLastFrame().threads)
+                {
+                    for (const ProfileEvent& event : thread.events)
+                    {
+                        assert(event.name != nullptr);
+                        assert(event.end >= event.start);
+                    }
+                }
+            }
+
+            stop.store(true, std::memory_order_relaxed);
+            writer.join();
+        }
+
+        auto frameHasZone = [&profiler](const std::string& zone) {
+            const ProfileFrame last = profiler.CollectLastFrame();
+            for (const ProfileThreadFrame& thread : last.threads)
+            {
+                for (const ProfileEvent& event : thread.events)
+                {
+                    if (zone == event.name)
+                        return true;
+                }
+            }
+            return false;
+            };
+
+        {
+            JobSystem jobSystem;
+
+            // Named jobs show up under their own zone; nothing is recorded while disabled.
+            QE_PROFILE_FRAME();
+            jobSystem.Submit(JobPriority::NORMAL, JobPoolType::GENERAL, {}, std::string("Profiled Job"), []() {});
+            jobSystem.ParallelFor(4096, 1, [](std::size_t) {});
+            jobSystem.WaitAll();
+            QE_PROFILE_FRAME();
+            assert(frameHasZone("Profiled Job"));
+            assert(frameHasZone("ParallelFor"));
+
+            profiler.SetEnabled(false);
+            QE_PROFILE_FRAME();
+            jobSystem.Submit(JobPriority::NORMAL, JobPoolType::GENERAL, {}, std::string("Unprofiled Job"), []() {});
+            jobSystem.WaitAll();
+            QE_PROFILE_FRAME();
+            assert(!frameHasZone("Unprofiled Job"));
+            profiler.SetEnabled(true);
+        }
+
+        {
+            ScopeTimer timer("Profiler 1M zones");
+            for (int i = 0; i < 1000000; ++i)
+            {
+                QE_PROFILE_SCOPE("Tight");
+            }
+        }
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "qe_units_trace.json";
+        const bool exported = profiler.ExportChromeTrace(path.string());
+        assert(exported); (void)exported;
+        assert(std::filesystem::file_size(path) > 0);
+        std::filesystem::remove(path);
+
+        std::cout << "TestProfiler OK\n\n";
+    }
+
+    void TestShaderCache()
+    {
+        std::cout << "==== TestShaderCache ====\n";
+
+        ShaderCache& cache = ShaderCache::Instance();
+        const auto directory = std::filesystem::temp_directory_path() / "QuasarEngineUnits" / "ShaderCache";
+        cache.SetDirectory(directory);
+        cache.Clear();
+        cache.ResetStats();
+
+        Shader::ShaderDescription desc;
+        desc.modules.push_back({ Shader::ShaderStageType::Vertex, "basic.vert.glsl", "", {} });
+        desc.modules.push_back({ Shader::ShaderStageType::Fragment, "basic.frag.glsl", "", {} });
+        desc.samplers.push_back({ "albedo_texture", 1, 0, Shader::StageToBit(Shader::ShaderStageType::Fragment) });
+
+        const std::vector<std::string> sources = { "void main() {}", "out vec4 c; void main() { c = vec4(1); }" };
+        const std::string driver = "Vendor|Renderer|4.6";
+
+        // Same inputs always give the same key, any of them changing gives another one.
+        const uint64_t key = ShaderCache::ComputeKey(desc, sources, driver);
+        assert(key == ShaderCache::ComputeKey(desc, sources, driver));
+        assert(key != ShaderCache::ComputeKey(desc, sources, "Vendor|Renderer|4.5"));
+        assert(key != ShaderCache::ComputeKey(desc, { sources[0], sources[1] + " " }, driver));
+
+        Shader::ShaderDescription rebound = desc;
+        rebound.samplers[0].binding = 3;
+        assert(key != ShaderCache::ComputeKey(rebound, sources, driver));
+
+        // Blend state is per draw and shares the program.
+        Shader::ShaderDescription blended = desc;
+        blended.blendMode = Shader::BlendMode::AlphaBlend;
+        assert(key == ShaderCache::ComputeKey(blended, sources, driver));
+
+        uint32_t format = 0;
+        std::vector<uint8_t> loaded;
+        bool ok = !cache.Load(key, format, loaded);
+
+        std::vector<uint8_t> binary(64 * 1024);
+        std::iota(binary.begin(), binary.end(), uint8_t(0));
+        ok &= cache.Store(key, 0x8E21, binary);
+        ok &= cache.Load(key, format, loaded);
+        assert(ok); (void)ok;
+        assert(format == 0x8E21 && loaded == binary);
+
+        // An entry stored under another key never answers for this one.
+        const uint64_t other = ShaderCache::ComputeKey(rebound, sources, driver);
+        assert(!cache.Load(other, format, loaded));
+
+        {
+            ScopeTimer timer("ShaderCache 1000 warm loads (64 KB)");
+            for (int i = 0; i < 1000; ++i)
+                cache.Load(key, format, loaded);
+        }
+
+        cache.Remove(key);
+        assert(!cache.Load(key, format, loaded));
+
+        cache.RecordMiss(12.0);
+        cache.RecordHit(0.5);
+        cache.RecordRejected();
+        const ShaderCacheStats stats = cache.GetStats();
+        assert(stats.hits == 1 && stats.misses == 1 && stats.rejected == 1 && stats.stores == 1);
+        assert(stats.coldMs == 12.0 && stats.warmMs == 0.5);
+
+        cache.Clear();
+        cache.ResetStats();
+        cache.SetDirectory({});
+
+        std::cout << "TestShaderCache OK\n\n";
+    }
+
+    void TestIBLBake()
+    {
+        std::cout << "==== TestIBLBake ====\n";
+
+        const auto directory = std::filesystem::temp_directory_path() / "QuasarEngineUnits" / "IBL";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        // Small sky: warm top half, cool bottom half.
+        const uint32_t width = 64, height = 32;
+        std::vector<float> sky(width * height * 3);
+        for (uint32_t y = 0; y < height; ++y)
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                float* p = &sky[(y * width + x) * 3];
+                p[0] = y >= height / 2 ? 2.0f : 0.2f;
+                p[1] = 0.5f;
+                p[2] = y >= height / 2 ? 0.2f : 1.0f;
+            }
+
+        IBLSettings settings;
+        settings.hdrPath = (directory / "sky.hdr").string();
+        settings.bakeCacheDir = directory.string();
+        settings.envRes = 32;
+        settings.irradianceRes = 8;
+        settings.prefilterRes = 32;
+        settings.brdfRes = 16;
+
+        {
+            std::ofstream hdr(settings.hdrPath, std::ios::binary);
+            hdr.write(reinterpret_cast<const char*>(sky.data()), sky.size() * sizeof(float));
+        }
+
+        IBLBakeData baked;
+        bool ok = false;
+        {
+            ScopeTimer timer("IBL CPU bake (32 env)");
+            ok = IBLBake::BakeFromEquirect(sky.data(), width, height, settings, baked);
+        }
+        assert(ok && baked.IsComplete());
+        assert(baked.prefilter.size() == IBLBake::PrefilterLevels(settings));
+
+        // +Y face sees the warm half, -Y the cool one; irradiance keeps that split but blurs it.
+        const size_t envFace = IBLBakeData::FaceFloats(settings.envRes);
+        assert(baked.environment[2 * envFace] > 1.9f && baked.environment[3 * envFace] < 0.3f);
+
+        const size_t irrFace = IBLBakeData::FaceFloats(settings.irradianceRes);
+        const float irrUp = baked.irradiance[2 * irrFace], irrDown = baked.irradiance[3 * irrFace];
+        assert(irrUp > irrDown && irrUp < 2.0f && irrDown > 0.2f);
+        assert(std::abs(baked.irradiance[2 * irrFace + 1] - 0.5f) < 0.05f);
+
+        // Split-sum terms stay within [0, 1].
+        for (float v : baked.brdf)
+            assert(v >= 0.0f && v <= 1.05f);
+
+        const uint64_t key = IBLBake::ComputeKey(settings);
+        assert(key != 0);
+
+        IBLSettings larger = settings;
+        larger.envRes = 64;
+        assert(IBLBake::ComputeKey(larger) != key);
+
+        const std::filesystem::path path = IBLBake::GetCachePath(settings, key);
+        ok = IBLBake::Save(path, key, baked);
+
+        IBLBakeData loaded;
+        {
+            ScopeTimer timer("IBL bake load");
+            ok &= IBLBake::Load(path, key, loaded);
+        }
+        assert(ok); (void)ok;
+        assert(!IBLBake::Load(path, key + 1, loaded));
+
+        assert(loaded.prefilter.size() == baked.prefilter.size());
+        for (size_t i = 0; i < baked.environment.size(); ++i)
+            assert(std::abs(loaded.environment[i] - baked.environment[i]) <= 0.002f * std::max(1.0f, baked.environment[i]));
+
+        // Offline entry point writes the same entry SkyboxHDR looks up; the raw floats are not a
+        // decodable HDR, so it must fail cleanly without leaving anything behind.
+        std::filesystem::remove(path);
+        assert(!IBLBake::BakeToCache(settings));
+        assert(!std::filesystem::exists(path));
+
+        // Unchanged path, size and mtime reuse the stored content hash; a touch alone keeps the
+        // key, new content under a new mtime changes it.
+        assert(IBLBake::ComputeKey(settings) == key);
+
+        const auto modified = std::filesystem::last_write_time(settings.hdrPath);
+        std::filesystem::last_write_time(settings.hdrPath, modified + std::chrono::seconds(1));
+        assert(IBLBake::ComputeKey(settings) == key);
+
+        sky[0] += 1.0f;
+        {
+            std::ofstream hdr(settings.hdrPath, std::ios::binary | std::ios::trunc);
+            hdr.write(reinterpret_cast<const char*>(sky.data()), sky.size() * sizeof(float));
+        }
+        std::filesystem::last_write_time(settings.hdrPath, modified + std::chrono::seconds(2));
+        assert(IBLBake::ComputeKey(settings) != key);
+
+        // Every change above rewrote the one stamp kept for this HDR.
+        size_t stamps = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+            stamps += entry.path().extension() == ".qeiblkey";
+        assert(stamps == 1); (void)stamps;
+
+        std::filesystem::remove_all(directory);
+
+        std::cout << "TestIBLBake OK\n\n";
+    }
+
+    void TestModelCache()
+    {
+        std::cout << "==== TestModelCache ====\n";
+
+        const auto directory = std::filesystem::temp_directory_path() / "QuasarEngineUnits" / "Models";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        const auto source = directory / "source.obj";
+        {
+            std::ofstream out(source, std::ios::binary);
+            out << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+        }
+
+        ModelImportOptions options;
+        const uint64_t key = ModelCache::ComputeKey(source, &options, "project");
+        assert(key != 0);
+        assert(ModelCache::ComputeKey(source, &options, "project") == key);
+        assert(ModelCache::ComputeKey(source, nullptr, "project") != key);
+        assert(ModelCache::ComputeKey(source, &options, "other") != key);
+
+        ModelImportOptions flipped = options;
+        flipped.flipUVs = true;
+        assert(ModelCache::ComputeKey(source, &flipped, "project") != key);
+
+        // Cache settings do not change what gets imported.
+        ModelImportOptions moved = options;
+        moved.cacheDir = "Elsewhere";
+        assert(ModelCache::ComputeKey(source, &moved, "project") == key);
+        assert(ModelCache::ComputeKey(directory / "missing.obj", &options, "project") == 0);
+
+        // Files the source pulls in are part of the key: OBJ material libraries and their maps, glTF buffers.
+        {
+            const auto linked = directory / "linked.obj";
+            {
+                std::ofstream out(linked, std::ios::binary);
+                out << "mtllib linked.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+            }
+            {
+                std::ofstream out(directory / "linked.mtl", std::ios::binary);
+                out << "newmtl Base\nmap_Kd -bm 1 albedo.png\n";
+            }
+            {
+                std::ofstream out(directory / "albedo.png", std::ios::binary);
+                out << "png";
+            }
+
+            const uint64_t linkedKey = ModelCache::ComputeKey(linked, &options, "project");
+            assert(linkedKey != 0);
+            assert(ModelCache::ComputeKey(linked, &options, "project") == linkedKey);
+
+            {
+                std::ofstream out(directory / "albedo.png", std::ios::binary);
+                out << "larger png";
+            }
+            const uint64_t retextured = ModelCache::ComputeKey(linked, &options, "project");
+            assert(retextured != linkedKey);
+
+            {
+                std::ofstream out(directory / "linked.mtl", std::ios::binary);
+                out << "newmtl Base\nKd 1 0 0\nmap_Kd -bm 1 albedo.png\n";
+            }
+            assert(ModelCache::ComputeKey(linked, &options, "project") != retextured);
+
+            const auto gltf = directory / "scene.gltf";
+            {
+                std::ofstream out(gltf, std::ios::binary);
+                out << R"({"buffers":[{"uri":"scene%20data.bin","byteLength":4}],"images":[{"uri":"data:image/png;base64,AAAA"}]})";
+            }
+            {
+                std::ofstream out(directory / "scene data.bin", std::ios::binary);
+                out << "abcd";
+            }
+            const uint64_t gltfKey = ModelCache::ComputeKey(gltf, nullptr, "project");
+            {
+                std::ofstream out(directory / "scene data.bin", std::ios::binary);
+                out << "abcdefgh";
+            }
+            assert(ModelCache::ComputeKey(gltf, nullptr, "project") != gltfKey);
+        }
+
+        // Root with one static mesh, child with a skinned one, 15 floats per vertex.
+        const uint32_t vertexCount = 20000;
+        std::vector<float> vertices(vertexCount * 15);
+        std::iota(vertices.begin(), vertices.end(), 0.0f);
+        std::vector<unsigned int> indices(vertexCount * 3);
+        for (size_t i = 0; i < indices.size(); ++i)
+            indices[i] = static_cast<unsigned int>((i * 7) % vertexCount);
+
+        std::vector<int> boneIDs(vertexCount * QE_MAX_BONE_INFLUENCE, 1);
+        std::vector<float> boneWeights(vertexCount * QE_MAX_BONE_INFLUENCE, 0.25f);
+
+        MaterialSpecification material;
+        material.AlbedoTexture = "Textures/albedo.png";
+        material.AOTexture = "Textures/ao.png";
+        material.Albedo = { 0.5f, 0.25f, 1.0f, 1.0f };
+        material.Roughness = 0.75f;
+
+        const glm::mat4 childTransform = glm::mat4(2.0f);
+
+        std::unordered_map<std::string, BoneInfo> bones;
+        bones["Hips"] = BoneInfo{ 0, glm::mat4(1.0f) };
+        bones["Spine"] = BoneInfo{ 1, glm::mat4(3.0f) };
+
+        AnimationClip clip;
+        clip.name = "Walk";
+        clip.duration = 30.0f;
+        clip.ticksPerSecond = 24.0f;
+        Channel channel;
+        channel.nodeName = "Spine";
+        channel.positions = { { glm::vec3(1.0f, 2.0f, 3.0f), 0.0f }, { glm::vec3(4.0f), 10.0f } };
+        channel.rotations = { { glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 0.0f } };
+        clip.channels.emplace(channel.nodeName, channel);
+
+        ModelCacheWriter writer;
+        const uint32_t root = writer.AddNode("Root", glm::mat4(1.0f), -1);
+        writer.AddMesh("Root:Body:0", "Body", material, false, vertices, indices, {}, {});
+        writer.AddNode("Child", childTransform, static_cast<int32_t>(root));
+        writer.AddMesh("Child:Skin:0", "Skin", MaterialSpecification{}, true, vertices, indices, boneIDs, boneWeights);
+        writer.SetName("Root");
+        writer.SetGlobalInverse(glm::mat4(0.5f));
+        writer.SetBones(bones, 2);
+        writer.SetClips({ clip });
+
+        const auto path = ModelCache::GetCachePath(directory, key);
+        bool ok = writer.Save(path, key);
+        assert(ok); (void)ok;
+
+        ModelCacheView view;
+        {
+            ScopeTimer timer("Model cache open");
+            ok = view.Open(path, key);
+        }
+        assert(ok);
+        assert(view.GetName() == "Root" && view.GetGlobalInverse() == glm::mat4(0.5f));
+        assert(view.GetNodeCount() == 2 && view.GetMeshCount() == 2 && view.GetBoneIdCounter() == 2);
+
+        const auto child = view.GetNode(1);
+        assert(child.name == "Child" && child.parent == 0 && child.transform == childTransform);
+        assert(child.firstMesh == 1 && child.meshCount == 1);
+
+        // Blobs are read in place from the mapping.
+        const auto body = view.GetMesh(0);
+        assert(body.key == "Root:Body:0" && !body.skinned && body.boneIDs == nullptr);
+        assert(body.vertexFloats == vertices.size() && body.indexCount == indices.size());
+        assert(std::equal(vertices.begin(), vertices.end(), body.vertices));
+        assert(std::equal(indices.begin(), indices.end(), body.indices));
+        assert(reinterpret_cast<uintptr_t>(body.vertices) % 16 == 0);
+
+        const auto skin = view.GetMesh(1);
+        assert(skin.skinned && skin.influenceCount == boneIDs.size());
+        assert(skin.boneIDs[5] == 1 && skin.boneWeights[7] == 0.25f);
+
+        const MaterialSpecification cachedMaterial = view.GetMeshMaterial(0);
+        assert(cachedMaterial.AlbedoTexture == material.AlbedoTexture && cachedMaterial.AOTexture == material.AOTexture);
+        assert(!cachedMaterial.NormalTexture && cachedMaterial.Albedo == material.Albedo && cachedMaterial.Roughness == 0.75f);
+
+        std::unordered_map<std::string, BoneInfo> cachedBones;
+        view.ReadBones(cachedBones);
+        assert(cachedBones.size() == 2 && cachedBones["Spine"].id == 1 && cachedBones["Spine"].offset == glm::mat4(3.0f));
+
+        std::vector<AnimationClip> clips;
+        view.ReadClips(clips);
+        assert(clips.size() == 1 && clips[0].name == "Walk" && clips[0].ticksPerSecond == 24.0f);
+        const Channel& cachedChannel = clips[0].channels.at("Spine");
+        assert(cachedChannel.positions.size() == 2 && cachedChannel.positions[1].value == glm::vec3(4.0f));
+        assert(cachedChannel.rotations.size() == 1 && cachedChannel.scales.empty());
+        view.Close();
+
+        // Stale key and truncated file are both misses.
+        assert(!view.Open(path, key + 1));
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+        assert(!view.Open(path, key));
+
+        std::filesystem::remove_all(directory);
+
+        std::cout << "TestModelCache OK\n\n";
+    }
+
+    void TestTextureCompression()
+    {
+        std::cout << "==== TestTextureCompression ====\n";
+
+        const uint32_t width = 70, height = 38;
+        std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4);
+        for (uint32_t y = 0; y < height; ++y)
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                uint8_t* p = &image[(static_cast<size_t>(y) * width + x) * 4];
+                p[0] = static_cast<uint8_t>(x * 255 / (width - 1));
+                p[1] = static_cast<uint8_t>(y * 255 / (height - 1));
+                p[2] = static_cast<uint8_t>((x + y) * 255 / (width + height - 2));
+                p[3] = static_cast<uint8_t>(255 - y * 4);
+            }
+
+        auto rmse = [&](const std::vector<uint8_t>& decoded, int channels) {
+            double error = 0.0;
+            for (size_t i = 0; i < image.size(); i += 4)
+                for (int c = 0; c < channels; ++c)
+                {
+                    const double d = double(decoded[i + c]) - double(image[i + c]);
+                    error += d * d;
+                }
+            return std::sqrt(error / double(image.size() / 4 * channels));
+        };
+
+        struct Case { TextureFormat format; int channels; double limit; };
+        const Case cases[] = {
+            { TextureFormat::BC1, 3, 4.0 },
+            { TextureFormat::BC3, 4, 3.5 },
+            { TextureFormat::BC5, 2, 1.0 },
+            { TextureFormat::BC7, 4, 3.0 },
+        };
+
+        for (const Case& test : cases)
+        {
+            TextureCompressionOptions options;
+            options.format = test.format;
+
+            CompressedTexture texture;
+            {
+                ScopeTimer timer(ToString(test.format).data());
+                assert(TextureCompression::Compress(image.data(), width, height, options, texture));
+            }
+
+            // 70x38 down to 1x1.
+            assert(texture.levels.size() == 7);
+            for (uint32_t level = 0; level < texture.levels.size(); ++level)
+                assert(texture.levels[level].size() == TextureCompression::GetLevelBytes(test.format, std::max(1u, width >> level), std::max(1u, height >> level)));
+
+            std::vector<uint8_t> decoded;
+            assert(TextureCompression::Decompress(texture, 0, decoded));
+            assert(decoded.size() == image.size());
+            const double error = rmse(decoded, test.channels);
+            assert(error < test.limit);
+        }
+
+        // Opaque blocks must stay exactly opaque.
+        std::vector<uint8_t> flat(16 * 4);
+        for (size_t i = 0; i < flat.size(); i += 4)
+        {
+            flat[i + 0] = 200; flat[i + 1] = 10; flat[i + 2] = 77; flat[i + 3] = 255;
+        }
+        TextureCompressionOptions flatOptions;
+        flatOptions.generateMips = false;
+        CompressedTexture flatTexture;
+        assert(TextureCompression::Compress(flat.data(), 4, 4, flatOptions, flatTexture) && flatTexture.levels.size() == 1);
+        std::vector<uint8_t> flatDecoded;
+        assert(TextureCompression::Decompress(flatTexture, 0, flatDecoded));
+        for (size_t i = 0; i < flatDecoded.size(); i += 4)
+            assert(flatDecoded[i + 3] == 255 && std::abs(int(flatDecoded[i]) - 200) <= 2);
+
+        // Unit normals survive BC5 once Z is rebuilt, as the shaders do.
+        std::vector<uint8_t> normals(image.size());
+        for (uint32_t y = 0; y < height; ++y)
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const glm::vec3 n = glm::normalize(glm::vec3(std::sin(x * 0.2f) * 0.5f, std::cos(y * 0.3f) * 0.5f, 1.0f));
+                uint8_t* p = &normals[(static_cast<size_t>(y) * width + x) * 4];
+                for (int c = 0; c < 3; ++c)
+                    p[c] = static_cast<uint8_t>(std::lround((n[c] * 0.5f + 0.5f) * 255.0f));
+                p[3] = 255;
+            }
+
+        TextureCompressionOptions normalOptions;
+        normalOptions.usage = TextureCompression::GuessUsage("Rock_Normal.png");
+        normalOptions.format = TextureCompression::ChooseFormat(normalOptions.usage, false, false);
+        assert(normalOptions.format == TextureFormat::BC5);
+
+        CompressedTexture normalTexture;
+        assert(TextureCompression::Compress(normals.data(), width, height, normalOptions, normalTexture));
+        std::vector<uint8_t> normalDecoded;
+        assert(TextureCompression::Decompress(normalTexture, 0, normalDecoded));
+        for (size_t i = 0; i < normals.size(); i += 4)
+        {
+            const glm::vec3 source = glm::normalize(glm::vec3(normals[i], normals[i + 1], normals[i + 2]) / 255.0f * 2.0f - 1.0f);
+            glm::vec3 rebuilt;
+            rebuilt.x = normalDecoded[i] / 255.0f * 2.0f - 1.0f;
+            rebuilt.y = normalDecoded[i + 1] / 255.0f * 2.0f - 1.0f;
+            rebuilt.z = std::sqrt(std::max(1.0f - rebuilt.x * rebuilt.x - rebuilt.y * rebuilt.y, 0.0f));
+            assert(glm::dot(source, rebuilt) > 0.995f);
+        }
+
+        assert(TextureCompression::ChooseFormat(TextureCompressionUsage::Color, false, true) == TextureFormat::BC1_SRGB);
+        assert(TextureCompression::ChooseFormat(TextureCompressionUsage::Color, true, false) == TextureFormat::BC7);
+        assert(TextureCompression::GuessUsage("bricks_n.png") == TextureCompressionUsage::Normal);
+        assert(TextureCompression::GuessUsage("bricks_albedo.png") == TextureCompressionUsage::Color);
+        assert(TextureCompression::GetCompressedPath("Textures/a.png") == std::filesystem::path("Textures/a.png.ktx2"));
+        assert(TextureCompression::GetCompressedPath("Textures/a.png.qasset") == std::filesystem::path("Textures/a.png.ktx2"));
+
+        // KTX2 round trip, then a truncated container is refused.
+        const auto directory = std::filesystem::temp_directory_path() / "QuasarEngineUnits" / "Textures";
+        std::filesystem::remove_all(directory);
+
+        TextureCompressionOptions options;
+        options.format = TextureFormat::BC7_SRGB;
+        options.flipped = false;
+        CompressedTexture texture;
+        assert(TextureCompression::Compress(image.data(), width, height, options, texture));
+
+        const auto path = directory / "image.ktx2";
+        assert(TextureCompression::SaveKtx2(path, texture));
+
+        CompressedTexture loaded;
+        assert(TextureCompression::LoadKtx2(path, loaded));
+        assert(loaded.format == TextureFormat::BC7_SRGB && loaded.width == width && loaded.height == height);
+        assert(!loaded.flipped && loaded.levels == texture.levels);
+
+        // The bake parameters travel with the container; a spec asking for something else is refused.
+        assert(loaded.described && loaded.srgb && loaded.usage == TextureCompressionUsage::Color);
+        TextureSpecification spec;
+        spec.internal_format = TextureFormat::SRGBA;
+        spec.flip = false;
+        assert(TextureCompression::MatchesSpecification(loaded, "image.png", spec));
+        assert(!TextureCompression::MatchesSpecification(loaded, "image_normal.png", spec));
+        spec.flip = true;
+        assert(!TextureCompression::MatchesSpecification(loaded, "image.png", spec));
+        spec.flip = false;
+        spec.internal_format = TextureFormat::RGBA;
+        assert(!TextureCompression::MatchesSpecification(loaded, "image.png", spec));
+        assert(TextureCompression::GuessUsage("bricks_n.png.qasset") == TextureCompressionUsage::Normal);
+
+        CompressedTexture undescribed = texture;
+        undescribed.described = false;
+        const auto undescribedPath = directory / "undescribed.ktx2";
+        assert(TextureCompression::SaveKtx2(undescribedPath, undescribed));
+        assert(TextureCompression::LoadKtx2(undescribedPath, loaded) && !loaded.described);
+        spec.internal_format = TextureFormat::SRGBA;
+        assert(!TextureCompression::MatchesSpecification(loaded, "image.png", spec));
+        assert(TextureCompression::LoadKtx2(path, loaded));
+
+        std::vector<uint8_t> bytes(std::filesystem::file_size(path));
+        {
+            std::ifstream in(path, std::ios::binary);
+            in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+        assert(bytes[0] == 0xAB && bytes[1] == 'K' && bytes[5] == '2');
+        assert(!TextureCompression::ParseKtx2(ByteView{ bytes.data(), bytes.size() - 1 }, loaded));
+
+        std::filesystem::remove_all(directory);
+
+        std::cout << "TestTextureCompression OK\n\n";
+    }
+
+    void TestComponentLayout()
+    {
+        std::cout << "==== TestComponentLayout ====\n";
+
+        // Plain data components: no vtable, no owner handle, the empty base folds away.
+        static_assert(std::is_empty_v<Component>);
+        static_assert(!std::is_polymorphic_v<TransformComponent>);
+        static_assert(!std::is_polymorphic_v<WorldTransformComponent>);
+        static_assert(sizeof(TransformComponent) == 3 * sizeof(glm::vec3));
+
+        struct OwnedComponent : EntityBoundComponent
+        {
+            int value = 0;
+        };
+
+        Registry registry;
+        Entity entity{ registry.CreateEntity(), &registry };
+
+        auto& tc = entity.AddComponent<TransformComponent>(glm::vec3(1.0f, 2.0f, 3.0f));
+        assert(tc.GetGlobalTransform(entity)[3] == glm::vec4(1.0f, 2.0f, 3.0f, 1.0f));
+        assert(tc.GetGlobalTransform(Entity::Null()) == tc.GetLocalTransform());
+
+        // Once a pass has run, the read is the cached world matrix.
+        auto& world = entity.AddComponent<WorldTransformComponent>();
+        world.World = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f));
+        world.CachedPosition = tc.Position;
+        world.Valid = true;
+        assert(tc.GetGlobalTransform(entity)[3] == glm::vec4(10.0f, 0.0f, 0.0f, 1.0f));
+
+        // Edits wait for the next pass rather than being re-checked on every read.
+        tc.Position.y = 5.0f;
+        assert(tc.GetGlobalTransform(entity)[3] == glm::vec4(10.0f, 0.0f, 0.0f, 1.0f));
+
+        // Components that opt into a back-reference still get it filled in.
+        auto& owned = entity.AddComponent<OwnedComponent>();
+        assert(owned.entt_entity == static_cast<entt::entity>(entity) && owned.registry == &registry);
+
+        std::cout << "TestComponentLayout OK\n\n";
+    }
+
+    void TestGlobalTransformRead()
+    {
+        std::cout << "==== TestGlobalTransformRead ====\n";
+
+        Registry registry;
+        Entity root{ registry.CreateEntity(), &registry };
+        Entity child{ registry.CreateEntity(), &registry };
+        Entity grandchild{ registry.CreateEntity(), &registry };
+
+        auto& rootTr = root.AddComponent<TransformComponent>(glm::vec3(1.0f, 0.0f, 0.0f));
+        auto& childTr = child.AddComponent<TransformComponent>(glm::vec3(0.0f, 2.0f, 0.0f));
+        auto& grandchildTr = grandchild.AddComponent<TransformComponent>(glm::vec3(0.0f, 0.0f, 3.0f));
+
+        // What a TransformSystem pass leaves behind.
+        auto settle = [&](Entity entity, const TransformComponent& tr, Entity parent) {
+            auto& world = entity.AddOrReplaceComponent<WorldTransformComponent>();
+            world.Local = tr.GetLocalTransform();
+            world.CachedPosition = tr.Position;
+            world.CachedRotation = tr.Rotation;
+            world.CachedScale = tr.Scale;
+            world.ParentHandle = parent;
+            world.World = parent ? parent.GetComponent<WorldTransformComponent>().World * world.Local : world.Local;
+            world.Valid = true;
+            world.Dirty = false;
+        };
+        settle(root, rootTr, Entity::Null());
+        settle(child, childTr, root);
+        settle(grandchild, grandchildTr, child);
+
+        assert(grandchildTr.GetGlobalTransform(grandchild)[3] == glm::vec4(1.0f, 2.0f, 3.0f, 1.0f));
+
+        // Edits since that pass show up once the next one has run, however far up they are.
+        rootTr.Position.x = 10.0f;
+        childTr.Position.y = 20.0f;
+        grandchildTr.Position.z = 30.0f;
+        assert(grandchildTr.GetGlobalTransform(grandchild)[3] == glm::vec4(1.0f, 2.0f, 3.0f, 1.0f));
+
+        settle(root, rootTr, Entity::Null());
+        settle(child, childTr, root);
+        settle(grandchild, grandchildTr, child);
+        assert(grandchildTr.GetGlobalTransform(grandchild)[3] == glm::vec4(10.0f, 20.0f, 30.0f, 1.0f));
+        assert(childTr.GetGlobalTransform(child)[3] == glm::vec4(10.0f, 20.0f, 0.0f, 1.0f));
+
+        std::cout << "TestGlobalTransformRead OK\n\n";
+    }
+
+    void TestRenderQueueSortIds()
+    {
+        std::cout << "==== TestRenderQueueSortIds ====\n";
+
+        RenderQueue::SortIdTable table;
+
+        const uint32_t a = table.Acquire(0x1000);
+        const uint32_t b = table.Acquire(0x2000);
+        assert(a != b && table.Acquire(0x1000) == a);
+
+        // Still referenced once: the id survives the first release.
+        table.Release(a);
+        assert(table.Acquire(0x1000) == a);
+        table.Release(a);
+        table.Release(a);
+        assert(table.GetLiveCount() == 1);
+
+        // Streaming far more keys than the 16-bit mesh field through keeps ids small.
+        uint32_t highest = 0;
+        for (uint64_t key = 1; key <= 200000; ++key)
+        {
+            const uint32_t id = table.Acquire(key << 8);
+            highest = std::max(highest, id);
+            table.Release(id);
+        }
+        assert(highest < 4 && table.GetLiveCount() == 1);
+
+        table.Release(b);
+        assert(table.GetLiveCount() == 0);
+
+        std::cout << "TestRenderQueueSortIds OK\n\n";
+    }
+
+    void TestMaterialContentHash()
+    {
+        std::cout << "==== TestMaterialContentHash ====\n";
+
+        MaterialSpecification spec;
+        spec.Albedo = { 0.8f, 0.2f, 0.1f, 1.0f };
+        spec.Roughness = 0.3f;
+
+        // Separate instances, as every MaterialComponent gets, batch together while they match.
+        Material a(spec), b(spec);
+        assert(a.GetContentHash() == b.GetContentHash());
+
+        b.GetAlbedo().g = 0.5f;
+        assert(a.GetContentHash() != b.GetContentHash());
+        b.GetAlbedo().g = 0.2f;
+        assert(a.GetContentHash() == b.GetContentHash());
+
+        b.SetTexture(TextureType::Normal, reinterpret_cast<Texture*>(&b));
+        assert(a.GetContentHash() != b.GetContentHash());
+        b.ResetTexture(TextureType::Normal);
+        assert(a.GetContentHash() == b.GetContentHash());
+
+        std::cout << "TestMaterialContentHash OK\n\n";
+    }
 }
 
 int main()
@@ -383,8 +1897,27 @@ int main()
     {
         QuasarEngine::TestSimpleJobs();
         QuasarEngine::TestDependencies();
+        QuasarEngine::TestDependencyGraph();
         QuasarEngine::TestStress();
+        QuasarEngine::BenchmarkJobPools();
+        QuasarEngine::TestParallelFor();
+        QuasarEngine::TestTaskGraph();
         QuasarEngine::TestThreadPool();
+        QuasarEngine::TestChunkStorage();
+        QuasarEngine::BenchmarkChunkStorage();
+        QuasarEngine::TestPerlinNoiseBatch();
+        QuasarEngine::BenchmarkTerrainNoise();
+        QuasarEngine::TestRegionStorage();
+        QuasarEngine::BenchmarkRegionStorage();
+        QuasarEngine::TestProfiler();
+        QuasarEngine::TestShaderCache();
+        QuasarEngine::TestIBLBake();
+        QuasarEngine::TestModelCache();
+        QuasarEngine::TestTextureCompression();
+        QuasarEngine::TestComponentLayout();
+        QuasarEngine::TestGlobalTransformRead();
+        QuasarEngine::TestRenderQueueSortIds();
+        QuasarEngine::TestMaterialContentHash();
     }
     catch (const std::exception& e)
     {